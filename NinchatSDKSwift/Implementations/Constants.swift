@@ -137,58 +137,7 @@ public enum QuestionnaireColorConstants {
     case ninchatQuestionnaireColorSelectBorder
 }
 
-// MARK: - Constants used within the SDK
-
-public enum Constants: String {
-    case kTestServerAddress = "api.luupi.net"
-    case kProductionServerAddress = "api.ninchat.com"
-    
-    case kCloseWindowText = "Close window"
-    case kCloseText = "Close"
-    case kJoinQueueText = "Join audience queue {{audienceQueue.queue_attrs.name}}"
-    case kQueuePositionN = "Joined audience queue {{audienceQueue.queue_attrs.name}}, you are at position {{audienceQueue.queue_position}}."
-    case kQueuePositionNext = "Joined audience queue {{audienceQueue.queue_attrs.name}}, you are next."
-    case kCloseChatText = "Close chat"
-    case kConversationEnded = "Conversation ended"
-    case kCancelDialog = "Continue chat"
-    case kAcceptDialog = "Accept"
-    case kRejectDialog = "Decline"
-    case kTextInputPlaceholderText = "Enter your message"
-    case kCallInvitationText = "You are invited to a video chat"
-    case kCallInvitationInfoText = "wants to video chat with you"
-    case kRatingTitleText = "How was our customer service?"
-    case kRatingSkipText = "Skip"
-    case kVideoMeetingText = "Video meeting"
-    case kJoinVideoMeetingText = "Join video meeting"
-    case kThisMessageWasDeletedText = "This message was deleted"
-    
-    case kRatingPositiveText = "Good"
-    case kRatingNeutralText = "Okay"
-    case kRatingNegativeText = "Poor"
-    
-    case RTCSessionDescriptionType = "type"
-    case RTCSessionDescriptionSDP = "sdp"
-    case RTCIceCandidateKeyCandidate = "candidate"
-    case RTCIceCandidateSDPMLineIndex = "sdpMLineIndex"
-    case RTCIceCandidateSDPMid = "sdpMid"
-    
-    case kNinchatImageCacheKey = "ninchatsdk.swift.VideoThumbnailImageCache"
-}
-
-enum NotificationConstants: String {
-    case kChannelMessageNotification =  "ninchatsdk.ChannelMessageNotification"
-    case kNINWebRTCSignalNotification = "ninchatsdk.NWebRTCSignalNotification"
-    case kNINChannelClosedNotification = "ninchatsdk.ChannelClosedNotification"
-    case kNINQueuedNotification = "ninchatsdk.QueuedNotification"
-}
-
-enum TimeConstants: TimeInterval {
-    case kTimerTickInterval = 0.05
-    case kMessageMaxAge = 1.0
-    case kAnimationDuration = 0.3
-    case kBannerAnimationDuration = 5.0
-    case kAnimationDelay = 1.5
-}
+// MARK: - Margins used within the SDK
 
 enum Margins: CGFloat {
     case kButtonHeight = 45.0
@@ -196,3 +145,37 @@ enum Margins: CGFloat {
     case kComposeHorizontalMargin = 60.0
     case kTextFieldPaddingHeight = 61.0
 }
+
+// MARK: - Layout of the chat message cells
+
+/// Mirrors the constraints in the channel cell xibs; shared by the cells and `ChatLayoutEngine`
+enum ChatLayoutMetrics {
+    /// Height of the sender name and timestamp container, and its height for deleted messages
+    static let infoHeight: CGFloat = 40
+    static let deletedInfoHeight: CGFloat = 7
+    /// Width of the avatar container when the avatar is visible
+    static let avatarWidth: CGFloat = 35
+    /// Container leading, container trailing, and the minimum spacing next to the bubble
+    static let horizontalMargins: CGFloat = 24
+    /// Text view insets in the bubble
+    static let bubbleInsets = UIEdgeInsets(top: 8, left: 4, bottom: 8, right: 4)
+    /// `UITextView.textContainerInset` plus `lineFragmentPadding`
+    static let textInsets = UIEdgeInsets(top: 8, left: 5, bottom: 8, right: 5)
+    /// Extra top inset applied to text views of series messages
+    static let seriesTextInset: CGFloat = 3.5
+    /// Media frames are half of the content width, at most `maxMediaWidth / 2`
+    static let maxMediaWidth: CGFloat = 400
+    static let minMediaHeight: CGFloat = 150
+
+    /// The name and timestamp are hidden for series messages, and shrunk for deleted ones
+    static func infoHeight(deleted: Bool, series: Bool) -> CGFloat {
+        if deleted { return deletedInfoHeight }
+        return series ? 0 : infoHeight
+    }
+
+    /// Size of the media frame below the info container, keeping the aspect ratio
+    static func mediaSize(width: CGFloat, aspectRatio: Double?) -> CGSize {
+        let mediaWidth = min(width, maxMediaWidth) / 2
+        return CGSize(width: mediaWidth, height: max(mediaWidth / CGFloat(aspectRatio ?? 1.0), minMediaHeight))
+    }
+}
@@ -59,13 +59,13 @@ final class NINChatDataSourceDelegateImpl: NINChatDataSourceDelegate {
 // MARK: - ChatViewDataSource
 
 extension NINChatDataSourceDelegateImpl {
+    /// The view reads the snapshot it currently shows, not the live messages
     func numberOfMessages(for view: ChatView) -> Int {
-        view.sessionManager?.chatMessages.count ?? 0
+        view.snapshot.messages.count
     }
     
     func message(at index: Int, _ view: ChatView) -> ChatMessage {
-        guard let message = view.sessionManager?.chatMessages[index] else { fatalError("Unable to fetch chat message") }
-        return message
+        view.snapshot.messages[index]
     }
 }
 
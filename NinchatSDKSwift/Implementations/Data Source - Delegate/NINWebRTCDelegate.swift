@@ -40,17 +40,17 @@ final class NINWebRTCDelegateImpl: NINWebRTCDelegate {
         self.remoteVideoDelegate = remoteVideoDelegate
         
         self.onConnectionStateChange = { client, newState in
-            debugger("WebRTC new state: \(newState.description)")
+            logger.debug(.rtc, "WebRTC new state: \(newState.description)")
         }
         
         self.onLocalCaptureCreate = { [weak self] client, capturer in
-            debugger("didCreateLocalCapturer: \(String(describing: capturer))")
+            logger.debug(.rtc, "didCreateLocalCapturer: \(String(describing: capturer))")
             self?.onLocalCapture?(capturer)
         }
         
         /** Called when the video call is initiated and the remote video track is available. */
         self.onRemoteVideoTrackReceive = { [weak self] client, remoteVideoTrack in
-            debugger("NINCHAT: didReceiveRemoteVideoTrack: \(String(describing: remoteVideoTrack))")
+            logger.debug(.rtc, "didReceiveRemoteVideoTrack: \(String(describing: remoteVideoTrack))")
             
             #if RTC_SUPPORTS_METAL
             let remoteView = RTCMTLVideoView(frame: .zero)
@@ -64,7 +64,7 @@ final class NINWebRTCDelegateImpl: NINWebRTCDelegate {
         }
         
         self.onError = { [weak self] client, error in
-            debugger("NINCHAT: didGetError: \(String(describing: error))")
+            logger.error(.rtc, "didGetError: \(String(describing: error))")
             self?.onActionError?(error)
         }
     }
@@ -5,14 +5,10 @@
 //
 
 import Foundation
-import NinchatLowLevelClient
 
-extension Array where Element==Int {
-    func decodeAndPerform<T:Decodable>(onPayload payload: NINLowLevelClientPayload, type: T.Type, successClosure: @escaping (T) -> Void) throws {
-        try self.compactMap({ index -> Data? in
-                    payload.get(index)
-                })
-                .map({ data -> NINResult<T> in
+extension Array where Element==Data {
+    func decodeAndPerform<T:Decodable>(type: T.Type, successClosure: @escaping (T) -> Void) throws {
+        try self.map({ data -> NINResult<T> in
                     data.decode()
                 })
                 .map({ result -> (T?, Error?) in
@@ -0,0 +1,569 @@
+//
+// Copyright (c) 26.12.2019 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+import AnyCodable
+
+enum NINLowLevelClientActions: String {
+    case deleteUser = "delete_user"
+    case describeRealmQueues = "describe_realm_queues"
+    case describeQueue = "describe_queue"
+    case requestAudience = "request_audience"
+    case sendFile = "send_file"
+    case describeFile = "describe_file"
+    case describeChannel = "describe_channel"
+    case partChannel = "part_channel"
+    case loadHistory = "load_history"
+    case updateMember = "update_member"
+    case sendMessage = "send_message"
+    case beginICE = "begin_ice"
+    case registerAudience = "register_audience"
+    case discoverJitsi = "discover_jitsi"
+}
+
+enum HistoryOrder: Int {
+    typealias RawValue = Int
+
+    case DESC   = -1    // requests newer messages first
+    case ASC    = 1     // requests older messages first
+}
+
+extension ClientProps {
+    static func initiate(action: NINLowLevelClientActions? = nil, name: String? = nil) -> ClientProps {
+        var props = ClientProps()
+        if let action = action {
+            props.setAction(action)
+        }
+        if let name = name {
+            props.name = .success(name)
+        }
+
+        return props
+    }
+
+    static func initiate(credentials: NINSessionCredentials) -> ClientProps {
+        var props = ClientProps()
+        props.set(value: credentials.userID, forKey: "user_id")
+        props.set(value: credentials.userAuth, forKey: "user_auth")
+
+        return props
+    }
+
+    static func initiate(preQuestionnaireAnswers dictionary: [String:AnyHashable]) -> ClientProps {
+        let metadata = dictionary.reduce(into: ClientProps()) { (metadata: inout ClientProps, tuple: (key: String, value: Any)) in
+            metadata.set(value: tuple.value, forKey: tuple.key)
+        }
+        return ClientProps.initiate(metadata: ["pre_answers": metadata])
+    }
+
+    /**
+    * Currently supported value types: String, Int, Double, Bool, ClientProps, [String] and [ClientProps]
+    */
+    static func initiate<T>(metadata: [String:T]) -> ClientProps {
+        metadata.reduce(into: ClientProps()) { (props: inout ClientProps, tuple: (key: String, value: T)) in
+            props.set(value: tuple.value, forKey: tuple.key)
+        }
+    }
+}
+
+protocol NINLowLevelSessionProps {
+    var sessionID: NINResult<String> { get }
+    var actionID: NINResult<Int> { get }
+    var error: Error? { get }
+    var event: NINResult<String> { get }
+    var siteSecret: NINResult<String> { set get }
+    var name: NINResult<String> { set get }
+
+    mutating func setAction(_ action: NINLowLevelClientActions)
+}
+
+extension ClientProps: NINLowLevelSessionProps {
+    var sessionID: NINResult<String> {
+        get { self.get(forKey: "session_id") }
+    }
+
+    var actionID: NINResult<Int> {
+        get { self.get(forKey: "action_id") }
+    }
+
+    var error: Error? {
+        let errorType: NINResult<String> = self.get(forKey: "error_type")
+        if case let .failure(error) = errorType { return error }
+
+        guard errorType.value != "" else { return nil }
+        return NinchatError(type: errorType.value, props: self)
+    }
+
+    var event: NINResult<String> {
+        get { self.get(forKey: "event") }
+    }
+
+    var siteSecret: NINResult<String> {
+        get { self.get(forKey: "site_secret") }
+        set { self.set(value: newValue.value, forKey: "site_secret") }
+    }
+
+    var name: NINResult<String> {
+        get { self.get(forKey: "name") }
+        set { self.set(value: newValue.value, forKey: "name") }
+    }
+
+    var closed: NINResult<Bool> {
+        get { self.get(forKey: "closed") }
+    }
+
+    mutating func setAction(_ action: NINLowLevelClientActions) {
+        logger.debug(.network, "Set action: \(action)")
+        self.set(value: action.rawValue, forKey: "action")
+    }
+}
+
+protocol NINLowLevelMetadataProps {
+    /// According to https://github.com/somia/mobile/issues/287
+    /// When metadata is set and it is not null, it is saved in the UserDefaults
+    /// When metadata is required, it is loaded from UserDefaults
+    ///     if no metadata is saved, it means either it was provided null, or was cleared
+    /// Both go through `AudienceMetadataStore.shared`, which keeps the metadata in memory
+
+    static func saveMetadata(_ metadata: ClientProps?)
+    static func loadMetadata() -> ClientProps?
+}
+
+extension ClientProps: NINLowLevelMetadataProps {
+    static func saveMetadata(_ metadata: ClientProps?) {
+        /// If the metadata is not null, it is saved in the UserDefaults
+        AudienceMetadataStore.shared.replace(with: metadata)
+    }
+    
+    static func loadMetadata() -> ClientProps? {
+        AudienceMetadataStore.shared.props()
+    }
+}
+
+protocol NINLowLevelQueueProps {
+    var queueName: NINResult<String> { get }
+    var realmQueue: NINResult<ClientProps> { get }
+    var userQueues: NINResult<ClientProps> { get }
+    var queuePosition: NINResult<Int> { get }
+    var queueClosed: NINResult<Bool> { get }
+    var queueUpload: NINResult<Bool> { get }
+    var queueAttributes: NINResult<ClientProps> { get }
+
+    var queueID: NINResult<String> { set get }
+    var realmID: NINResult<String> { set get }
+    var queuesID: NINResult<[String]> { set get }
+    var metadata: NINResult<ClientProps> { set get }
+}
+
+extension ClientProps: NINLowLevelQueueProps {
+    var queueName: NINResult<String> {
+        switch self.queueAttributes {
+        case .success(let attributes):
+             return attributes.name
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var realmQueue: NINResult<ClientProps> {
+        get { self.get(forKey: "realm_queues") }
+    }
+
+    var userQueues: NINResult<ClientProps> {
+        get { self.get(forKey: "user_queues") }
+    }
+
+    var queuePosition: NINResult<Int> {
+        get { self.get(forKey: "queue_position") }
+    }
+
+    var queueClosed: NINResult<Bool> {
+        switch self.queueAttributes {
+        case .success(let attributes):
+            return attributes.closed
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var queueUpload: NINResult<Bool> {
+        switch self.queueAttributes {
+        case .success(let attributes):
+            let upload: NINResult<String> = attributes.get(forKey: "upload")
+            switch upload {
+            case .success(let value):
+                return .success(QueuePermissionType(rawValue: value) == .member)
+            case .failure(let error):
+                return .failure(error)
+            }
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var queueAttributes: NINResult<ClientProps> {
+        get { self.get(forKey: "queue_attrs") }
+    }
+
+    var queueID: NINResult<String> {
+        get { self.get(forKey: "queue_id") }
+        set { self.set(value: newValue.value, forKey: "queue_id") }
+    }
+
+    var realmID: NINResult<String> {
+        get { self.get(forKey: "realm_id") }
+        set { self.set(value: newValue.value, forKey: "realm_id") }
+    }
+
+    var queuesID: NINResult<[String]> {
+        get { self.get(forKey: "queue_ids") }
+        set { self.set(value: newValue.value, forKey: "queue_ids") }
+    }
+
+    var metadata: NINResult<ClientProps> {
+        get { self.get(forKey: "audience_metadata") }
+        set { self.set(value: newValue.value, forKey: "audience_metadata") }
+    }
+
+    var jitsiRoom: NINResult<String> {
+        get { self.get(forKey: "jitsi_room") }
+    }
+
+    var jitsiToken: NINResult<String> {
+        get { self.get(forKey: "jitsi_token") }
+    }
+}
+
+protocol NINLowLevelChannelProps {
+    var channelMembers: NINResult<ClientProps> { get }
+    var channelAttributes: NINResult<ClientProps> { get }
+    var channelClosed: NINResult<Bool> { get }
+    var channelSuspended: NINResult<Bool> { get }
+    var channelAudienceMetadata: NINResult<ClientProps> { get }
+    var channelAudienceTransferred: NINResult<String> { get }
+
+    var channelID: NINResult<String> { set get }
+    var channelMemberAttributes: NINResult<ClientProps> { set get }
+}
+
+extension ClientProps: NINLowLevelChannelProps {
+    var channelMembers: NINResult<ClientProps> {
+        get { self.get(forKey: "channel_members") }
+    }
+
+    var channelAttributes: NINResult<ClientProps> {
+        get { self.get(forKey: "channel_attrs") }
+    }
+
+    var channelClosed: NINResult<Bool> {
+        switch self.channelAttributes {
+        case .success(let attributes):
+            return attributes.get(forKey: "closed")
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var channelSuspended: NINResult<Bool> {
+        switch self.channelAttributes {
+        case .success(let attributes):
+            return attributes.get(forKey: "suspended")
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var channelAudienceMetadata: NINResult<ClientProps> {
+        get { self.get(forKey: "audience_metadata") }
+    }
+
+    var channelAudienceTransferred: NINResult<String> {
+        switch self.channelAttributes {
+        case .success(let attributes):
+            return attributes.get(forKey: "audience_transferred")
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var channelIsGroup: NINResult<Bool> {
+        switch self.channelAttributes {
+        case .success(let attributes):
+            let video: NINResult<String> = attributes.get(forKey: "video")
+            switch video {
+            case .success(let value):
+                return .success(ChannelVideoType(rawValue: value) == .group)
+            case .failure(let error):
+                return .failure(error)
+            }
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var channelID: NINResult<String> {
+        get { self.get(forKey: "channel_id") }
+        set { self.set(value: newValue.value, forKey: "channel_id") }
+    }
+
+    var channelMemberAttributes: NINResult<ClientProps> {
+        get { self.get(forKey: "member_attrs") }
+        set { self.set(value: newValue.value, forKey: "member_attrs") }
+    }
+}
+
+protocol NINLowLevelUserProps {
+    var userAuth: NINResult<String> { get }
+    var iconURL: NINResult<String> { get }
+    var displayName: NINResult<String> { get }
+    var realName: NINResult<String> { get }
+    var isGuest: NINResult<Bool> { get }
+    var info: NINResult<ClientProps> { get }
+    var jobTitle: NINResult<String> { get }
+    var channels: NINResult<ClientProps> { get }
+    var preAnswers: NINResult<ClientProps> { get }
+
+    var userID: NINResult<String> { set get }
+    var userAttributes: NINResult<ClientProps> { set get }
+}
+
+extension ClientProps: NINLowLevelUserProps {
+    var userAuth: NINResult<String> {
+        get { self.get(forKey: "user_auth") }
+    }
+
+    var iconURL: NINResult<String> {
+        get { self.get(forKey: "iconurl") }
+    }
+
+    var displayName: NINResult<String> {
+        get { self.name }
+    }
+
+    var realName: NINResult<String> {
+        get { self.get(forKey: "realname") }
+    }
+
+    var isGuest: NINResult<Bool> {
+        get { self.get(forKey: "guest") }
+    }
+
+    var channels: NINResult<ClientProps> {
+        get { self.get(forKey: "user_channels") }
+    }
+
+    var userID: NINResult<String> {
+        get { self.get(forKey: "user_id") }
+        set { self.set(value: newValue.value, forKey: "user_id") }
+    }
+
+    var jobTitle: NINResult<String> {
+        get {
+            switch self.info {
+            case .success(let attr):
+                return attr.get(forKey: "job_title")
+            case .failure(let error):
+                return .failure(error)
+            }
+        }
+    }
+
+    var info: NINResult<ClientProps> {
+        get { self.get(forKey: "info") }
+    }
+
+    var userAttributes: NINResult<ClientProps> {
+        get { self.get(forKey: "user_attrs") }
+        set { self.set(value: newValue.value, forKey: "user_attrs") }
+    }
+
+    var preAnswers: NINResult<ClientProps> {
+        get { self.get(forKey: "pre_answers") }
+    }
+}
+
+protocol NINLowLevelMessageProps {
+    var messageID: NINResult<String> { get }
+    var messageUserID: NINResult<String> { get }
+    var messageTime: NINResult<Double> { get }
+    var historyLength: NINResult<Int> { get }
+    var historyOrder: NINResult<Int> { set get }
+
+    var messageType: NINResult<MessageType?> { set get }
+    var messageTypes: NINResult<[String]> { set get }
+    var writing: NINResult<Bool> { set get }
+    var recipients: NINResult<[String]> { set get }
+    var messageFold: NINResult<Bool> { set get }
+    var messageTTL: NINResult<Int> { set get }
+}
+
+extension ClientProps: NINLowLevelMessageProps {
+    var messageID: NINResult<String> {
+        get { self.get(forKey: "message_id") }
+    }
+
+    var messageUserID: NINResult<String> {
+        get { self.get(forKey: "message_user_id") }
+    }
+
+    var messageTime: NINResult<Double> {
+        get { self.get(forKey: "message_time") }
+    }
+
+    var historyLength: NINResult<Int> {
+        get { self.get(forKey: "history_length") }
+    }
+
+    var historyOrder: NINResult<Int> {
+        get { self.get(forKey: "history_order") }
+        set { self.set(value: newValue.value, forKey: "history_order") }
+    }
+
+    var messageType: NINResult<MessageType?> {
+        get {
+            let messageType: NINResult<String>? = self.get(forKey: "message_type")
+            if messageType == nil { return .success(nil) }
+            
+            switch messageType! {
+            case .success(let type):
+                return .success(MessageType(rawValue: type))
+            case .failure(let error):
+                return .failure(error)
+            }
+        }
+        set {
+            guard let type = newValue.value else { return }
+            self.set(value: type.rawValue, forKey: "message_type") 
+        }
+    }
+
+    var messageTypes: NINResult<[String]> {
+        get { self.get(forKey: "message_types") }
+        set { self.set(value: newValue.value, forKey: "message_types") }
+    }
+
+    var writing: NINResult<Bool> {
+        get { self.get(forKey: "writing") }
+        set { self.set(value: newValue.value, forKey: "writing") }
+    }
+
+    var recipients: NINResult<[String]> {
+        get { self.get(forKey: "message_recipient_ids") }
+        set { self.set(value: newValue.value, forKey: "message_recipient_ids") }
+    }
+
+    var messageFold: NINResult<Bool> {
+        get { self.get(forKey: "message_fold") }
+        set { self.set(value: newValue.value, forKey: "message_fold") }
+    }
+
+    var messageTTL: NINResult<Int> {
+        get { self.get(forKey: "message_ttl") }
+        set { self.set(value: newValue.value, forKey: "message_ttl") }
+    }
+
+    var isMessageDeleted: NINResult<Bool> {
+        get { self.get(forKey: "message_deleted") }
+        set { self.set(value: newValue.value, forKey: "message_deleted") }
+    }
+}
+
+protocol NINLowLevelICEInfoProps {
+    var serversURL: NINResult<[String]> { get }
+    var stunServers: NINResult<[ClientProps]> { get }
+    var turnServers: NINResult<[ClientProps]> { get }
+    var usernameTurnServer: NINResult<String> { get }
+    var credentialsTurnServer: NINResult<String> { get }
+}
+
+extension ClientProps: NINLowLevelICEInfoProps {
+    var serversURL: NINResult<[String]> {
+        get { self.get(forKey: "urls") }
+    }
+
+    var stunServers: NINResult<[ClientProps]> {
+        get { self.get(forKey: "stun_servers") }
+    }
+
+    var turnServers: NINResult<[ClientProps]> {
+        get { self.get(forKey: "turn_servers") }
+    }
+
+    var usernameTurnServer: NINResult<String> {
+        get { self.get(forKey: "username") }
+    }
+
+    var credentialsTurnServer: NINResult<String> {
+        get { self.get(forKey: "credential") }
+    }
+}
+
+protocol NINLowLevelFileInfoProps {
+    var fileURL: NINResult<String> { get }
+    var thumbnailURL: NINResult<String> { get }
+    var urlExpiry: NINResult<Date> { get }
+    var thumbnail: NINResult<ClientProps> { get }
+    var thumbnailSize: NINResult<CGSize> { get }
+
+    var fileID: NINResult<String> { set get }
+    var fileAttributes: NINResult<ClientProps> { set get }
+}
+
+extension ClientProps: NINLowLevelFileInfoProps {
+    var fileURL: NINResult<String> {
+        get { self.get(forKey: "file_url") }
+    }
+
+    var thumbnailURL: NINResult<String> {
+        get { self.get(forKey: "thumbnail_url") }
+    }
+
+    var urlExpiry: NINResult<Date> {
+        let expiry: NINResult<Double> = self.get(forKey: "url_expiry")
+        switch expiry {
+        case .success(let timeInterval):
+            return .success(Date(timeIntervalSince1970: timeInterval))
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var thumbnail: NINResult<ClientProps> {
+        switch self.fileAttributes {
+        case .success(let attributes):
+            return attributes.get(forKey: "thumbnail")
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var thumbnailSize: NINResult<CGSize> {
+        switch self.thumbnail {
+        case .success(let thumbnail):
+            let width: NINResult<Int> = thumbnail.get(forKey: "width")
+            let height: NINResult<Int> = thumbnail.get(forKey: "height")
+
+            switch (width, height) {
+            case (.success(let widthValue), .success(let heightValue)):
+                return .success(CGSize(width: widthValue, height: heightValue))
+            default:
+                return .success(CGSize(width: 1.0, height: 1.0))
+            }
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    var fileID: NINResult<String> {
+        get { self.get(forKey: "file_id") }
+        set { self.set(value: newValue.value, forKey: "file_id") }
+    }
+
+    var fileAttributes: NINResult<ClientProps> {
+        get { self.get(forKey: "file_attrs") }
+        set { self.set(value: newValue.value, forKey: "file_attrs") }
+    }
+}
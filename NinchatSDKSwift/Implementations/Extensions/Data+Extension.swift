@@ -16,6 +16,14 @@ public enum NINResult<Value> {
         }
         fatalError("Error in getting value: \(self)")
     }
+
+    /// The value, or nil if it is missing, e.g. for optional parameters
+    var optional: Value? {
+        if case let .success(value) = self {
+            return value
+        }
+        return nil
+    }
 }
 
 extension Data {
@@ -42,12 +42,13 @@ extension Date {
 }
 
 extension DateFormatter {
-    static var shortTime: DateFormatter {
+    /// Shared, as creating a formatter is expensive; formatting is thread-safe
+    static let shortTime: DateFormatter = {
         let formatter = DateFormatter()
         formatter.dateStyle = .none
         formatter.timeStyle = .short
         formatter.timeZone = .current
         
         return formatter
-    }
+    }()
 }
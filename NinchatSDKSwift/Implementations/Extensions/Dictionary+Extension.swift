@@ -19,7 +19,7 @@ extension Dictionary where Key==String {
         guard let type = self[Constants.RTCSessionDescriptionType.rawValue] as? String,
               let sdp = self[Constants.RTCSessionDescriptionSDP.rawValue] as? String
             else {
-            debugger("** ERROR: Constructing RTCSessionDescription from incomplete or invalid data"); return nil
+            logger.error(.rtc, "Constructing RTCSessionDescription from incomplete or invalid data"); return nil
         }
         
         return RTCSessionDescription(type: RTCSessionDescription.type(for: type), sdp: sdp)
@@ -27,10 +27,10 @@ extension Dictionary where Key==String {
     
     var toRTCIceCandidate: RTCIceCandidate? {
         guard let candidate = self[Constants.RTCIceCandidateKeyCandidate.rawValue] as? String else {
-            debugger("** ERROR: missing '\(Constants.RTCIceCandidateKeyCandidate.rawValue)' key in dictionary for RTCIceCandidate"); return nil
+            logger.error(.rtc, "Missing '\(Constants.RTCIceCandidateKeyCandidate.rawValue)' key in dictionary for RTCIceCandidate"); return nil
         }
         guard let lineIndex = self[Constants.RTCIceCandidateSDPMLineIndex.rawValue] as? String else {
-            debugger("** ERROR: missing '\(Constants.RTCIceCandidateSDPMLineIndex.rawValue)' key in dictionary for RTCIceCandidate"); return nil
+            logger.error(.rtc, "Missing '\(Constants.RTCIceCandidateSDPMLineIndex.rawValue)' key in dictionary for RTCIceCandidate"); return nil
         }
         
         return RTCIceCandidate(sdp: candidate, sdpMLineIndex: Int32(lineIndex)!, sdpMid: self[Constants.RTCIceCandidateSDPMid.rawValue] as? String)
@@ -57,18 +57,3 @@ extension Dictionary where Key==String, Value==AnyHashable {
         return (result.count > 0) ? result : nil
     }
 }
-
-extension Dictionary where Key==String {
-    func find<T>(_ key: String) -> [T] {
-        var keys: [T] = []
-        
-        if let value = self[key] as? T {
-            keys.append(value)
-        }
-        self.values.compactMap({ $0 as? [String:Any] }).forEach({
-            keys.append(contentsOf: $0.find(key))
-        })
-        
-        return keys
-    }
-}
@@ -9,11 +9,10 @@ import Foundation
 extension UserDefaults {
     enum Keys: String {
         case metadata
+        case siteConfigurations
     }
     
-    static var ninchat: UserDefaults {
-        UserDefaults(suiteName: "com.ninchat.sdk.swift")!
-    }
+    static let ninchat: UserDefaults = UserDefaults(suiteName: "com.ninchat.sdk.swift")!
     
     static func save<T:Any>(_ value: T, key: Keys) {
         UserDefaults.ninchat.set(value, forKey: key.rawValue)
@@ -32,11 +31,11 @@ extension UserDefaults {
     // MARK: - Helper
     
     /// migrate value from 'standard' to 'ninchat'
-    private static func migrate(key: Keys) {
+    static func migrate(key: Keys, to target: UserDefaults = .ninchat) {
         let value = UserDefaults.standard.value(forKey: key.rawValue)
         if value == nil { return }
         
-        self.save(value, key: key)
+        target.set(value, forKey: key.rawValue)
         UserDefaults.standard.removeObject(forKey: key.rawValue)
     }
 }
@@ -0,0 +1,45 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+extension ProcessInfo {
+    /// The OS version, e.g. "14.4" or "14.4.1"
+    var systemVersion: String {
+        let version = self.operatingSystemVersion
+        let systemVersion = "\(version.majorVersion).\(version.minorVersion)"
+        return (version.patchVersion > 0) ? systemVersion + ".\(version.patchVersion)" : systemVersion
+    }
+
+    /// The hardware model, e.g. "iPhone13,2"
+    var deviceModel: String {
+        if let simulatorModelIdentifier = self.environment["SIMULATOR_MODEL_IDENTIFIER"] {
+            return simulatorModelIdentifier
+        }
+
+        var sysinfo = utsname()
+        uname(&sysinfo) // ignore return value
+        return withUnsafeBytes(of: &sysinfo.machine) { bytes in
+            String(decoding: bytes.prefix(while: { $0 != 0 }), as: UTF8.self)
+        }
+    }
+
+    /// Memory the app uses, in bytes, as the system accounts it against the app's limit
+    var memoryFootprint: UInt64? {
+        #if canImport(Darwin)
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<integer_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        return (result == KERN_SUCCESS) ? info.phys_footprint : nil
+        #else
+        return nil
+        #endif
+    }
+}
@@ -38,7 +38,7 @@ extension String {
         do {
             return try NSMutableAttributedString(data: data, options: [.documentType: document], documentAttributes: nil)
         } catch {
-            debugger("error in string conversion. \(error.localizedDescription)")
+            logger.error(.general, "Error in string conversion. \(error.localizedDescription)")
             return nil
         }
     }
@@ -64,13 +64,17 @@ extension String {
         return attrString
     }
     
+    /// Compiled once, `containsTags` is evaluated for every rendered text
+    private static let tagsRegex = try? NSRegularExpression(pattern: "(<\\w+>|<\\w+/>|</\\w+>|<\\w+\\s[^<>]*>)", options: .caseInsensitive)
+
     var containsTags: Bool {
-        do {
-            let regex = try NSRegularExpression(pattern: "(<\\w+>|<\\w+/>|</\\w+>)", options: .caseInsensitive)
-            return regex.matches(in: self, range: NSRange(location: 0, length: self.count)).count > 0
-        } catch {
-            return false
-        }
+        /// Skip the regex for texts that cannot contain any tag
+        guard self.contains("<") else { return false }
+        return String.tagsRegex?.firstMatch(in: self, range: NSRange(self.startIndex..., in: self)) != nil
+    }
+
+    var containsImages: Bool {
+        self.range(of: "<img", options: .caseInsensitive) != nil
     }
 
     var localized: String {
@@ -95,7 +99,7 @@ extension String {
                 String(self[Range($0.range, in: self)!])
             }
         } catch {
-            debugger("Error in extracting regex with pattern: \(pattern): \(error)"); return nil
+            logger.error(.general, "Error in extracting regex with pattern: \(pattern): \(error)"); return nil
         }
     }
 
@@ -22,14 +22,43 @@ extension UITextView {
     }
     
     func setAttributed(text: String, font: UIFont?, color: UIColor? = nil, width: CGFloat? = nil) {
-        if text.containsTags {
-            self.attributedText = text.htmlAttributedString(withFont: font, alignment: self.textAlignment, color: color ?? self.textColor, width: width)
-        } else {
-            self.setPlain(text: text, font: font)
+        guard text.containsTags else {
+            self.setPlain(text: text, font: font); return
+        }
+
+        let style = HTMLStyle(font: font, alignment: self.textAlignment, color: color ?? self.textColor, width: width)
+        let renderer = HTMLRenderer.shared
+        if let rendered = renderer.cached(text, style: style) {
+            self.pendingHTML = nil
+            self.attributedText = rendered; return
+        }
+
+        /// Text-only content is cheap to render natively on the spot,
+        /// embedded images are fetched in the background and swapped in later
+        self.attributedText = renderer.render(text, style: style)
+        guard renderer.cached(text, style: style) == nil else { self.pendingHTML = nil; return }
+
+        self.pendingHTML = text
+        renderer.render(text, style: style) { [weak self] rendered in
+            /// The view might have been reused for another text meanwhile
+            guard self?.pendingHTML == text else { return }
+            self?.pendingHTML = nil
+            self?.attributedText = rendered
         }
     }
     
     func setPlain(text: String, font: UIFont?) {
+        self.pendingHTML = nil
         self.attributedText = text.plainString(withFont: font, alignment: self.textAlignment, color: self.textColor)
     }
 }
+
+private var pendingHTMLKey: UInt8 = 0
+
+extension UITextView {
+    /// The HTML text being rendered in the background for this view, if any
+    fileprivate var pendingHTML: String? {
+        get { objc_getAssociatedObject(self, &pendingHTMLKey) as? String }
+        set { objc_setAssociatedObject(self, &pendingHTMLKey, newValue, .OBJC_ASSOCIATION_COPY_NONATOMIC) }
+    }
+}
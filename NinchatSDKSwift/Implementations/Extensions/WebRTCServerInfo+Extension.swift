@@ -0,0 +1,14 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+import WebRTC
+
+extension WebRTCServerInfo {
+    var iceServer: RTCIceServer! {
+        RTCIceServer(urlStrings: [self.url], username: self.username ?? "", credential: self.credential ?? "")
+    }
+}
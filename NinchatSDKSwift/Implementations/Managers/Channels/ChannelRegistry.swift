@@ -0,0 +1,178 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/**
+ * The state of one channel of the session: its messages, members and the
+ * actions waiting for their messages.
+ *
+ * Events are applied to the state of the channel they belong to, whether or
+ * not it is the one shown, so a transfer or a second conversation does not
+ * mix up or drop the messages of the other channel.
+ */
+final class ChannelState {
+    /// nil for the state shown before any channel is joined
+    let channelID: String?
+    private(set) var messageStore: ChatMessageStore
+    var members: [String:ChannelUser] = [:]
+    var agent: ChannelUser?
+    /// Members writing in the channel, whether or not it is shown
+    var writing: Set<String> = []
+    /// Compose messages by their contents, and the `ui/action` messages waiting for them
+    var compose = ComposeActionStore()
+    /// Messages of the requested history that are still on their way; -1 when no history is expected
+    var expectedHistoryLength = -1
+    /// Kept up to date only while the registry `indexesMessages`
+    var searchIndex = MessageSearchIndex()
+    /// Messages of a batch whose rest is still on its way, published at once with its last message
+    private var batch: [ChatMessage] = []
+    private var batchIDs: Set<String> = []
+    private var batchChannelMessages = 0
+    /// When the last message was held, and the check that publishes the batch if the rest never arrives
+    private(set) var lastHeldAt = DispatchTime.now()
+    var batchDeadline: DispatchWorkItem?
+
+    init(channelID: String?, messageStore: ChatMessageStore = ChatMessageStore()) {
+        self.channelID = channelID
+        self.messageStore = messageStore
+    }
+
+    var snapshot: ChatSnapshot {
+        self.messageStore.snapshot
+    }
+
+    var hasPendingBatch: Bool {
+        !self.batch.isEmpty
+    }
+
+    /// The message is either published or held in the pending batch
+    func contains(messageID: String) -> Bool {
+        self.batchIDs.contains(messageID) || self.messageStore.contains(messageID: messageID)
+    }
+
+    /// Number of `ChannelMessage`s, published or held in the pending batch
+    var channelMessageCount: Int {
+        self.messageStore.channelMessageCount + self.batchChannelMessages
+    }
+
+    /// Holds the message until the rest of its batch has arrived
+    func hold(_ message: ChatMessage) {
+        self.lastHeldAt = .now()
+        self.batch.append(message)
+        self.batchIDs.insert(message.messageID)
+        if message is ChannelMessage { self.batchChannelMessages += 1 }
+    }
+
+    /// The held messages, to be published; the batch starts over
+    func takeBatch() -> [ChatMessage] {
+        defer {
+            self.batch.removeAll()
+            self.batchIDs.removeAll()
+            self.batchChannelMessages = 0
+            self.batchDeadline?.cancel()
+            self.batchDeadline = nil
+        }
+        return self.batch
+    }
+
+    /// Nothing has been published to the messages yet
+    fileprivate var isPristine: Bool {
+        self.snapshot.version == 0
+    }
+
+    /// Continues from the messages and members of the given state, as one conversation.
+    /// The messages keep their version, so the views have nothing to reload.
+    fileprivate func adopt(_ other: ChannelState) {
+        self.messageStore = ChatMessageStore(snapshot: other.snapshot)
+        self.searchIndex = other.searchIndex
+        self.compose = other.compose
+        self.members.merge(other.members) { mine, _ in mine }
+        self.agent = self.agent ?? other.agent
+    }
+}
+
+/**
+ * Keeps the states of the session's channels keyed by channelID, and the one
+ * currently shown.
+ *
+ * Switching between known channels is O(1) and keeps their states as they are;
+ * the views are handed a reload to the newly shown messages.
+ */
+final class ChannelRegistry {
+    private var storage: [String:ChannelState] = [:]
+
+    /// The state shown in the chat view
+    private(set) var current = ChannelState(channelID: nil)
+
+    /// Keeps a search index of every channel's messages. Off by default; turning it on indexes the messages so far.
+    var indexesMessages = false {
+        didSet {
+            guard self.indexesMessages != oldValue else { return }
+            ([self.current] + self.all).forEach { state in
+                if self.indexesMessages {
+                    state.searchIndex.rebuild(from: state.snapshot.messages)
+                } else {
+                    state.searchIndex.removeAll()
+                }
+            }
+        }
+    }
+
+    var count: Int {
+        self.storage.count
+    }
+
+    var all: [ChannelState] {
+        Array(self.storage.values)
+    }
+
+    subscript(channelID: String) -> ChannelState? {
+        self.storage[channelID]
+    }
+
+    func contains(_ channelID: String) -> Bool {
+        self.storage[channelID] != nil
+    }
+
+    /// The state of the channel, created if the channel is not yet known
+    func state(for channelID: String) -> ChannelState {
+        if let state = self.storage[channelID] { return state }
+
+        let state = ChannelState(channelID: channelID)
+        self.storage[channelID] = state
+        return state
+    }
+
+    /// Shows the channel, and returns the snapshot and diff the views need to show it, if they need any.
+    /// A channel shown for the first time continues from the current messages if `carryOver` is set,
+    /// e.g. after a transfer; otherwise it starts from its own.
+    @discardableResult
+    func activate(channelID: String, carryOver: Bool) -> (snapshot: ChatSnapshot, diff: ChatSnapshotDiff)? {
+        let previous = self.current
+        let state = self.state(for: channelID)
+        guard state !== previous else { return nil }
+        self.current = state
+
+        if carryOver, state.isPristine {
+            state.adopt(previous); return nil
+        }
+        /// The views follow the versions of the previous store
+        return state.messageStore.republish(after: previous.snapshot.version)
+    }
+
+    /// Drops the channel's state, unless it is the one shown
+    func remove(channelID: String) {
+        guard self.current.channelID != channelID else { return }
+        self.storage.removeValue(forKey: channelID)
+    }
+
+    /// Drops every state; the versions continue, so the views do not take the new messages as stale
+    func removeAll() {
+        self.storage.removeAll()
+        self.current = ChannelState(channelID: nil, messageStore: ChatMessageStore(snapshot: ChatSnapshot(version: self.current.snapshot.version, messages: [])))
+    }
+}
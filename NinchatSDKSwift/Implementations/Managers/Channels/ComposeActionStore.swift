@@ -0,0 +1,80 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/**
+ * Pairs the `ui/action` messages of a channel with their `ui/compose` messages.
+ *
+ * Compose messages are indexed by the IDs of their contents, and actions that
+ * arrive before their compose message wait keyed by their target's ID. Each
+ * action is matched once, when the later of the two arrives, in O(1), so
+ * replaying a history of bot conversations stays linear.
+ */
+struct ComposeActionStore {
+    typealias Match = (messageID: String, action: ComposeUIAction)
+
+    /// The most recent compose message holding each content, by content ID
+    private var messages: [String:String] = [:]
+    /// Every compose message holding each content, to fall back to once the most recent one is removed
+    private var owners: [String:Set<String>] = [:]
+    /// Actions waiting for their compose message, by target ID
+    private var waiting: [String:ComposeUIAction] = [:]
+
+    /// Actions waiting for their compose message
+    var pending: [ComposeUIAction] {
+        Array(self.waiting.values)
+    }
+
+    /// The compose message the action targets; nil keeps the action waiting for it.
+    /// An action for a target that is already waiting is dropped.
+    mutating func match(_ action: ComposeUIAction) -> String? {
+        let key = ComposeActionStore.key(action.target)
+        if let messageID = self.messages[key] { return messageID }
+
+        if self.waiting[key] == nil { self.waiting[key] = action }
+        return nil
+    }
+
+    /// Indexes the compose message, and returns the actions that were waiting for it.
+    /// A content ID reused by several messages stays with the most recent one.
+    mutating func insert(_ message: ComposeMessage) -> [Match] {
+        message.content.compactMap { content -> Match? in
+            let key = ComposeActionStore.key(content)
+            self.owners[key, default: []].insert(message.messageID)
+            if let messageID = self.messages[key], messageID > message.messageID { return nil }
+            self.messages[key] = message.messageID
+            return self.waiting.removeValue(forKey: key).map { (messageID: message.messageID, action: $0) }
+        }
+    }
+
+    /// A content ID reused by an older message goes back to the most recent of those left
+    mutating func remove(_ message: ComposeMessage) {
+        message.content.forEach { content in
+            let key = ComposeActionStore.key(content)
+            self.owners[key]?.remove(message.messageID)
+            if self.owners[key]?.isEmpty ?? false { self.owners.removeValue(forKey: key) }
+            if self.messages[key] == message.messageID { self.messages[key] = self.owners[key]?.max() }
+        }
+    }
+
+    /// Applies the changes between two consecutive snapshots, and returns the actions matched by new compose messages
+    mutating func apply(_ diff: ChatSnapshotDiff, from old: ChatSnapshot, to new: ChatSnapshot) -> [Match] {
+        diff.removed.compactMap { old.messages[$0] as? ComposeMessage }.forEach { self.remove($0) }
+        return diff.inserted.compactMap { new.messages[$0] as? ComposeMessage }.flatMap { self.insert($0) }
+    }
+
+    mutating func removeAll() {
+        self.messages.removeAll()
+        self.owners.removeAll()
+        self.waiting.removeAll()
+    }
+
+    /// Contents are told apart by their ID, as in `ComposeContent.==`
+    private static func key(_ content: ComposeContent) -> String {
+        content.id ?? ""
+    }
+}
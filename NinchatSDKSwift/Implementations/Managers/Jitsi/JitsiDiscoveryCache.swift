@@ -0,0 +1,116 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Keeps the result of `discover_jitsi` for the current group channel so joining the meeting
+/// does not wait for the round trip.
+///
+/// The credentials are discovered speculatively once a group channel is joined and kept until the
+/// token expires (read from its `exp` claim, or `fallbackTTL` if it has none) or the channel changes.
+/// Callers asking while a discovery is in flight are completed by it. The cache is used on the main thread.
+final class JitsiDiscoveryCache {
+    typealias Fetch = (@escaping CompletionWithJitsiCredentials) throws -> Void
+
+    private struct Entry {
+        let channelID: String
+        let credentials: JitsiCredentials
+        let expiry: Date
+    }
+
+    private let fallbackTTL: TimeInterval
+    /// Credentials expiring sooner than this are discovered again
+    private let expiryMargin: TimeInterval
+    private let now: () -> Date
+    /// The channel the credentials are discovered for
+    private let channelID: () -> String?
+    private let fetch: Fetch
+    private var entry: Entry?
+    private var inFlight: (channelID: String, waiters: [CompletionWithJitsiCredentials])?
+
+    init(fallbackTTL: TimeInterval = 300, expiryMargin: TimeInterval = 30, now: @escaping () -> Date = Date.init, channelID: @escaping () -> String?, fetch: @escaping Fetch) {
+        self.fallbackTTL = fallbackTTL
+        self.expiryMargin = expiryMargin
+        self.now = now
+        self.channelID = channelID
+        self.fetch = fetch
+    }
+
+    /// Valid credentials of the current channel
+    var cached: JitsiCredentials? {
+        guard let entry = self.entry, entry.channelID == self.channelID(), entry.expiry.timeIntervalSince(self.now()) > self.expiryMargin else { return nil }
+        return entry.credentials
+    }
+
+    var isDiscovering: Bool {
+        self.inFlight != nil && self.inFlight?.channelID == self.channelID()
+    }
+
+    /// Starts discovering unless valid credentials are cached or a discovery is in flight
+    func prefetch() {
+        guard let channelID = self.channelID(), self.cached == nil, !self.isDiscovering else { return }
+
+        logger.debug(.jitsi, "Discovering credentials ahead of joining")
+        self.request(channelID: channelID, completion: nil)
+    }
+
+    /// Completes immediately with the cached credentials, or once they are discovered
+    func credentials(completion: @escaping CompletionWithJitsiCredentials) {
+        guard let channelID = self.channelID() else {
+            completion(.failure(NINSessionExceptions.noActiveChannel)); return
+        }
+        if let credentials = self.cached {
+            completion(.success(credentials)); return
+        }
+        self.request(channelID: channelID, completion: completion)
+    }
+
+    func invalidate() {
+        self.entry = nil
+    }
+
+    private func request(channelID: String, completion: CompletionWithJitsiCredentials?) {
+        if let inFlight = self.inFlight, inFlight.channelID == channelID {
+            if let completion = completion { self.inFlight?.waiters.append(completion) }
+            return
+        }
+        /// A discovery for another channel is still running, its result is dropped
+        self.complete(with: nil)
+        self.inFlight = (channelID, completion.map { [$0] } ?? [])
+
+        do {
+            try self.fetch { [weak self] result in
+                guard let `self` = self, self.inFlight?.channelID == channelID else { return }
+                if case let .success(credentials) = result {
+                    let expiry = JitsiDiscoveryCache.expiry(of: credentials.token) ?? self.now().addingTimeInterval(self.fallbackTTL)
+                    self.entry = Entry(channelID: channelID, credentials: credentials, expiry: expiry)
+                }
+                self.complete(with: result)
+            }
+        } catch {
+            self.complete(with: .failure(error))
+        }
+    }
+
+    private func complete(with result: NINResult<JitsiCredentials>?) {
+        let waiters = self.inFlight?.waiters ?? []
+        self.inFlight = nil
+        waiters.forEach { $0(result) }
+    }
+
+    /// Reads the `exp` claim of a JWT
+    static func expiry(of token: String) -> Date? {
+        let parts = token.split(separator: ".")
+        guard parts.count == 3 else { return nil }
+
+        var payload = parts[1].replacingOccurrences(of: "-", with: "+").replacingOccurrences(of: "_", with: "/")
+        payload += String(repeating: "=", count: (4 - payload.count % 4) % 4)
+        guard let data = Data(base64Encoded: payload),
+              let claims = (try? JSONSerialization.jsonObject(with: data)) as? [String:Any],
+              let exp = (claims["exp"] as? NSNumber)?.doubleValue else { return nil }
+        return Date(timeIntervalSince1970: exp)
+    }
+}
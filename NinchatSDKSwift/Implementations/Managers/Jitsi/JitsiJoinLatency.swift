@@ -0,0 +1,43 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Time the user waits from tapping join until the group meeting is joined
+struct JitsiJoinLatency {
+    let startedAt: Date
+    /// Whether the credentials were discovered before the user tapped join
+    var prefetched: Bool = false
+    var credentialsAt: Date?
+    var loadStartedAt: Date?
+    var joinedAt: Date?
+
+    init(startedAt: Date = Date()) {
+        self.startedAt = startedAt
+    }
+
+    /// Waiting for `discover_jitsi`
+    var discovery: TimeInterval? {
+        self.credentialsAt.map { $0.timeIntervalSince(self.startedAt) }
+    }
+
+    /// Loading the meeting page until the conference is joined
+    var load: TimeInterval? {
+        guard let loadStartedAt = self.loadStartedAt, let joinedAt = self.joinedAt else { return nil }
+        return joinedAt.timeIntervalSince(loadStartedAt)
+    }
+
+    var total: TimeInterval? {
+        self.joinedAt.map { $0.timeIntervalSince(self.startedAt) }
+    }
+
+    var summary: String {
+        func ms(_ interval: TimeInterval?) -> String {
+            interval.map { "\(Int($0 * 1000))ms" } ?? "-"
+        }
+        return "total: \(ms(self.total)), discovery: \(ms(self.discovery))\(self.prefetched ? " (prefetched)" : ""), load: \(ms(self.load))"
+    }
+}
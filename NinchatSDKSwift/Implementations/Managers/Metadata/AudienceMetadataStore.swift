@@ -0,0 +1,131 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/**
+ * Holds the audience metadata in memory and persists it in the background.
+ *
+ * According to https://github.com/somia/mobile/issues/287 the metadata is kept
+ * until the user joins a queue or the session ends normally, so a resumed
+ * session can still send it. The in-memory copy is the source of truth; the
+ * UserDefaults copy is only read once, when the store is created.
+ *
+ * Writes are coalesced: changes made before the previous write has started
+ * are persisted together. The metadata is converted to `ClientProps`
+ * only when it is sent to the server.
+ */
+final class AudienceMetadataStore {
+    static let shared = AudienceMetadataStore()
+    static let preAnswersKey = "pre_answers"
+
+    private enum Write {
+        case save([String:Any])
+        case remove
+    }
+
+    private var values: [String:Any]?
+    private var pendingWrite: Write?
+    private let defaults: UserDefaults
+    private let lock = DispatchQueue(label: "com.ninchat.sdk.swift.metadata")
+    private let writeQueue = DispatchQueue(label: "com.ninchat.sdk.swift.metadata.write", qos: .utility)
+
+    init(defaults: UserDefaults = .ninchat) {
+        self.defaults = defaults
+
+        UserDefaults.migrate(key: .metadata, to: defaults)
+        if let json = defaults.string(forKey: UserDefaults.Keys.metadata.rawValue) {
+            self.values = AudienceMetadataStore.decode(json)
+        }
+    }
+
+    var isEmpty: Bool {
+        self.lock.sync { self.values == nil }
+    }
+
+    /// Answers given in the pre-audience questionnaire
+    var preAnswers: [String:AnyHashable] {
+        self.lock.sync {
+            (self.values?[AudienceMetadataStore.preAnswersKey] as? [String:Any])?.compactMapValues { $0 as? AnyHashable } ?? [:]
+        }
+    }
+
+    /// Replaces the metadata; nil keeps the current one, as the host app may not provide it when resuming
+    func replace(with metadata: ClientProps?) {
+        guard let metadata = metadata, let values = AudienceMetadataStore.values(of: metadata) else { return }
+        self.update { $0 = values }
+    }
+
+    func set(preAnswers: ClientProps?) {
+        let answers = preAnswers.flatMap { AudienceMetadataStore.values(of: $0) }
+        self.update { values in
+            var target = values ?? [:]
+            target[AudienceMetadataStore.preAnswersKey] = answers
+            values = target
+        }
+    }
+
+    func removeAll() {
+        self.update { $0 = nil }
+    }
+
+    /// The metadata to be sent with `request_audience` or `register_audience`
+    func props() -> ClientProps? {
+        guard let values = self.lock.sync(execute: { self.values }), let json = AudienceMetadataStore.encode(values) else { return nil }
+        return try? ClientProps(json: json)
+    }
+
+    /// Waits for the scheduled writes
+    func flush() {
+        self.writeQueue.sync {}
+    }
+
+    // MARK: - Persistence
+
+    private func update(_ transform: (inout [String:Any]?) -> Void) {
+        let schedule: Bool = self.lock.sync {
+            transform(&self.values)
+
+            let scheduled = self.pendingWrite != nil
+            self.pendingWrite = self.values.map { .save($0) } ?? .remove
+            return !scheduled
+        }
+        guard schedule else { return }
+
+        self.writeQueue.async {
+            let write: Write? = self.lock.sync {
+                defer { self.pendingWrite = nil }
+                return self.pendingWrite
+            }
+
+            switch write {
+            case .save(let values):
+                guard let json = AudienceMetadataStore.encode(values) else { return }
+                self.defaults.set(json, forKey: UserDefaults.Keys.metadata.rawValue)
+            case .remove:
+                self.defaults.removeObject(forKey: UserDefaults.Keys.metadata.rawValue)
+            case .none:
+                break
+            }
+        }
+    }
+
+    // MARK: - Conversion
+
+    private static func values(of props: ClientProps) -> [String:Any]? {
+        AudienceMetadataStore.decode(props.json)
+    }
+
+    private static func decode(_ json: String) -> [String:Any]? {
+        guard let data = json.data(using: .utf8) else { return nil }
+        return (try? JSONSerialization.jsonObject(with: data)) as? [String:Any]
+    }
+
+    private static func encode(_ values: [String:Any]) -> String? {
+        guard let data = try? JSONSerialization.data(withJSONObject: values) else { return nil }
+        return String(data: data, encoding: .utf8)
+    }
+}
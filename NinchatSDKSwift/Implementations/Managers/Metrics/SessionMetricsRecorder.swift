@@ -0,0 +1,95 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Measures the session's `NINSessionMetrics`.
+///
+/// Intervals are measured on the monotonic uptime clock, and an interval is recorded by its first
+/// `end` only, so e.g. only the first message after joining a channel counts. The backlog and byte
+/// counters are updated from the low level client's thread too, hence the lock.
+final class SessionMetricsRecorder {
+    enum Interval: CaseIterable {
+        case startup
+        case firstScreen
+        case sessionOpen
+        case firstQueuePosition
+        case firstMessage
+        case historyLoad
+    }
+
+    /// Set before the session starts
+    var isEnabled = false
+    /// Called on the main thread whenever an interval is recorded
+    var onUpdate: ((NINSessionMetrics) -> Void)?
+
+    private let now: () -> TimeInterval
+    private let lock = DispatchQueue(label: "com.ninchat.sdk.swift.metrics")
+    private var started: [Interval:TimeInterval] = [:]
+    private var metrics = NINSessionMetrics()
+
+    init(now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) {
+        self.now = now
+    }
+
+    var snapshot: NINSessionMetrics {
+        self.lock.sync { self.metrics }
+    }
+
+    func start(_ interval: Interval) {
+        guard self.isEnabled else { return }
+
+        let now = self.now()
+        self.lock.sync { self.started[interval] = now }
+    }
+
+    func end(_ interval: Interval) {
+        guard self.isEnabled else { return }
+
+        let now = self.now()
+        let metrics: NINSessionMetrics? = self.lock.sync {
+            guard let start = self.started.removeValue(forKey: interval) else { return nil }
+
+            let duration = now - start
+            switch interval {
+            case .startup: self.metrics.startupDuration = duration
+            case .firstScreen: self.metrics.timeToFirstScreen = duration
+            case .sessionOpen: self.metrics.sessionOpenDuration = duration
+            case .firstQueuePosition: self.metrics.timeToFirstQueuePosition = duration
+            case .firstMessage: self.metrics.timeToFirstMessage = duration
+            case .historyLoad: self.metrics.historyLoadDuration = duration
+            }
+            return self.metrics
+        }
+        if let metrics = metrics {
+            self.onUpdate?(metrics)
+        }
+    }
+
+    /// An event is received, on the low level client's thread
+    func eventReceived() {
+        guard self.isEnabled else { return }
+        self.lock.sync {
+            self.metrics.eventBacklog += 1
+            self.metrics.maxEventBacklog = max(self.metrics.maxEventBacklog, self.metrics.eventBacklog)
+        }
+    }
+
+    func eventHandled() {
+        guard self.isEnabled else { return }
+        self.lock.sync { self.metrics.eventBacklog = max(0, self.metrics.eventBacklog - 1) }
+    }
+
+    func sent(bytes: Int) {
+        guard self.isEnabled else { return }
+        self.lock.sync { self.metrics.bytesSent += Int64(bytes) }
+    }
+
+    func received(bytes: Int) {
+        guard self.isEnabled else { return }
+        self.lock.sync { self.metrics.bytesReceived += Int64(bytes) }
+    }
+}
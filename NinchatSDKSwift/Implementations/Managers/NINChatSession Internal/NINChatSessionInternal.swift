@@ -7,20 +7,6 @@
 import UIKit
 import NinchatLowLevelClient
 
-// MARK: - Internal helper methods
-
-protocol NINChatSessionInternalDelegate: AnyObject {
-    func log(value: String)
-    func log(format: String, _ args: CVarArg...)
-    func onLowLevelEvent(event: NINLowLevelClientProps, payload: NINLowLevelClientPayload, lastReply: Bool)
-    func onDidEnd()
-    func onResumeFailed() -> Bool
-    func override(imageAsset key: AssetConstants) -> UIImage?
-    func override(colorAsset key: ColorConstants) -> UIColor?
-    func override(layerAsset key: CALayerConstant) -> CALayer?
-    func override(questionnaireAsset key: QuestionnaireColorConstants) -> UIColor?
-}
-
 extension NINChatSession: NINChatSessionInternalDelegate {
     func log(value: String) {
         DispatchQueue.main.async { [weak self] in
@@ -29,24 +15,32 @@ extension NINChatSession: NINChatSessionInternalDelegate {
         }
     }
 
-    func log(format: String, _ args: CVarArg...) {
+    /// The host app is given the low level client's objects, converted back from the values
+    func onLowLevelEvent(event: ClientProps, payload: ClientPayload, lastReply: Bool) {
+        DispatchQueue.main.async { [weak self] in
+            guard let `self` = self, let delegate = self.delegate, let params = try? NINLowLevelClientProps(event) else { return }
+            delegate.ninchat(self, onLowLevelEvent: params, payload: NINLowLevelClientPayload(payload), lastReply: lastReply)
+        }
+    }
+    
+    func onCallStatistics(_ statistics: NINCallStatistics) {
         DispatchQueue.main.async { [weak self] in
             guard let `self` = self else { return }
-            self.delegate?.ninchat(self, didOutputSDKLog: String(format: format, args))
+            self.delegate?.ninchat(self, didUpdateCallStatistics: statistics)
         }
     }
 
-    func onLowLevelEvent(event: NINLowLevelClientProps, payload: NINLowLevelClientPayload, lastReply: Bool) {
+    func onSessionMetrics(_ metrics: NINSessionMetrics) {
         DispatchQueue.main.async { [weak self] in
             guard let `self` = self else { return }
-            self.delegate?.ninchat(self, onLowLevelEvent: event, payload: payload, lastReply: lastReply)
+            self.delegate?.ninchat(self, didUpdateMetrics: metrics)
         }
     }
-    
+
     func onDidEnd() {
         /// According to https://github.com/somia/mobile/issues/287
         /// Clear metadata from the UserDefaults on a normal close
-        UserDefaults.remove(forKey: .metadata)
+        AudienceMetadataStore.shared.removeAll()
 
         DispatchQueue.main.async { [weak self] in
             guard let `self` = self else { return }
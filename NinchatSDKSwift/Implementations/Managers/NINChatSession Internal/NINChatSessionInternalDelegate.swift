@@ -0,0 +1,35 @@
+//
+// Copyright (c) 5.1.2020 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+#if !NINCHAT_CORE
+import UIKit
+#endif
+
+// MARK: - Internal helper methods
+
+/// The asset overrides are left out of the `NinchatCore` package, which has no views
+protocol NINChatSessionInternalDelegate: AnyObject {
+    func log(value: String)
+    func onLowLevelEvent(event: ClientProps, payload: ClientPayload, lastReply: Bool)
+    func onCallStatistics(_ statistics: NINCallStatistics)
+    func onSessionMetrics(_ metrics: NINSessionMetrics)
+    func onDidEnd()
+    func onResumeFailed() -> Bool
+    #if !NINCHAT_CORE
+    func override(imageAsset key: AssetConstants) -> UIImage?
+    func override(colorAsset key: ColorConstants) -> UIColor?
+    func override(layerAsset key: CALayerConstant) -> CALayer?
+    func override(questionnaireAsset key: QuestionnaireColorConstants) -> UIColor?
+    #endif
+}
+
+extension NINChatSessionInternalDelegate {
+    /// Records the message in the SDK log and outputs it to the host application
+    func log(_ category: NINLogCategory, _ message: @autoclosure () -> String, level: NINLogLevel = .info) {
+        logger.log(level, category, message(), output: { [weak self] in self?.log(value: $0) })
+    }
+}
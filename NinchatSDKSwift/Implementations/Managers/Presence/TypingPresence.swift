@@ -0,0 +1,157 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/**
+ * Tracks which channel members are typing, keyed by userID.
+ *
+ * A writing flag expires if it is not refreshed within `timeout`, so a
+ * lost `channel_member_updated` event does not leave the indicator on.
+ * The state is ephemeral and is kept apart from the chat messages.
+ */
+final class TypingPresence {
+    struct Entry {
+        let user: ChannelUser
+        /// When the user started typing, used for ordering
+        let since: Date
+        let expiry: Date
+    }
+
+    private var entries: [String:Entry] = [:]
+    private var expiryWorkItem: DispatchWorkItem?
+    private let timeout: TimeInterval
+    private let queue: DispatchQueue
+    private let now: () -> Date
+
+    /// Called with the typing users, earliest first, whenever the set changes
+    var onChange: (([Entry]) -> Void)?
+
+    init(timeout: TimeInterval = 30.0, queue: DispatchQueue = .main, now: @escaping () -> Date = Date.init) {
+        self.timeout = timeout
+        self.queue = queue
+        self.now = now
+    }
+
+    var typing: [Entry] {
+        self.entries.values.sorted { $0.since < $1.since }
+    }
+
+    func isTyping(userID: String) -> Bool {
+        self.entries[userID] != nil
+    }
+
+    /// Applies an inbound writing flag; refreshing an existing flag only extends its expiry
+    func update(user: ChannelUser, isWriting: Bool) {
+        let now = self.now()
+        if isWriting {
+            let changed = self.entries[user.userID] == nil
+            self.entries[user.userID] = Entry(user: user, since: self.entries[user.userID]?.since ?? now, expiry: now.addingTimeInterval(self.timeout))
+            self.scheduleExpiry()
+            if changed { self.onChange?(self.typing) }
+        } else if self.entries.removeValue(forKey: user.userID) != nil {
+            self.scheduleExpiry()
+            self.onChange?(self.typing)
+        }
+    }
+
+    /// Drops the flags that were not refreshed in time
+    func expire() {
+        let now = self.now()
+        let expired = self.entries.filter { $0.value.expiry <= now }.keys
+        expired.forEach { self.entries.removeValue(forKey: $0) }
+
+        /// The timer may fire ahead of the earliest expiry, it is armed again for the entries left
+        self.scheduleExpiry()
+        if !expired.isEmpty { self.onChange?(self.typing) }
+    }
+
+    func removeAll() {
+        self.expiryWorkItem?.cancel()
+        self.expiryWorkItem = nil
+        guard !self.entries.isEmpty else { return }
+
+        self.entries.removeAll()
+        self.onChange?([])
+    }
+
+    /// A single timer for the earliest expiry, instead of one per user
+    private func scheduleExpiry() {
+        self.expiryWorkItem?.cancel()
+        guard let next = self.entries.values.map({ $0.expiry }).min() else {
+            self.expiryWorkItem = nil; return
+        }
+
+        let workItem = DispatchWorkItem { [weak self] in self?.expire() }
+        self.expiryWorkItem = workItem
+        self.queue.asyncAfter(deadline: .now() + max(next.timeIntervalSince(self.now()), 0), execute: workItem)
+    }
+}
+
+/**
+ * Rate-limits the outbound writing state (`update_member`).
+ *
+ * Only changes are sent, at most one per `interval`; quick toggles within the
+ * interval are coalesced into the latest state. A writing state that is not
+ * refreshed within `idleTimeout` falls back to not writing.
+ */
+final class WritingStateDebouncer {
+    private let interval: TimeInterval
+    private let idleTimeout: TimeInterval
+    private let queue: DispatchQueue
+    private let send: (Bool) -> Void
+
+    private var sentState = false
+    private var pendingState: Bool?
+    private var lastSent: DispatchTime = .init(uptimeNanoseconds: 0)
+    private var flushWorkItem: DispatchWorkItem?
+    private var idleWorkItem: DispatchWorkItem?
+
+    init(interval: TimeInterval = 1.0, idleTimeout: TimeInterval = 20.0, queue: DispatchQueue = .main, send: @escaping (Bool) -> Void) {
+        self.interval = interval
+        self.idleTimeout = idleTimeout
+        self.queue = queue
+        self.send = send
+    }
+
+    deinit {
+        self.flushWorkItem?.cancel()
+        self.idleWorkItem?.cancel()
+    }
+
+    func update(isWriting: Bool) {
+        self.idleWorkItem?.cancel()
+        if isWriting {
+            let workItem = DispatchWorkItem { [weak self] in self?.update(isWriting: false) }
+            self.idleWorkItem = workItem
+            self.queue.asyncAfter(deadline: .now() + self.idleTimeout, execute: workItem)
+        }
+
+        self.pendingState = isWriting
+        guard self.flushWorkItem == nil else { return }
+
+        let elapsed = Double(DispatchTime.now().uptimeNanoseconds - self.lastSent.uptimeNanoseconds) / 1_000_000_000
+        if elapsed >= self.interval {
+            self.flush()
+        } else {
+            let workItem = DispatchWorkItem { [weak self] in self?.flush() }
+            self.flushWorkItem = workItem
+            self.queue.asyncAfter(deadline: .now() + (self.interval - elapsed), execute: workItem)
+        }
+    }
+
+    private func flush() {
+        self.flushWorkItem = nil
+        guard let state = self.pendingState else { return }
+        self.pendingState = nil
+
+        /// skip if the status has not changed
+        guard state != self.sentState else { return }
+        self.sentState = state
+        self.lastSent = .now()
+        self.send(state)
+    }
+}
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/**
+ * Keeps the realm's queues keyed by queueID.
+ *
+ * Lookups are O(1) and queue events are applied as in-place deltas. The list
+ * order is the order in which the queues were first described. Audience queues
+ * are derived from the configured IDs instead of being copied on every change.
+ */
+final class QueueRegistry {
+    typealias Observer = (Events, Queue, Error?) -> Void
+
+    private var storage: [String:Queue] = [:]
+    private var order: [String] = []
+    private var audienceSet: Set<String>?
+    /// Observers of a single queue, keyed by queueID and then by the receiver
+    private var observers: [String:[String:Observer]] = [:]
+    /// Observers of any queue, keyed by the receiver
+    private var anyQueueObservers: [String:Observer] = [:]
+
+    /// The queues the user gets to pick from; nil means all of the realm's queues
+    var audienceIDs: [String]? {
+        didSet { self.audienceSet = self.audienceIDs.map { Set($0) } }
+    }
+
+    var all: [Queue] {
+        self.order.compactMap { self.storage[$0] }
+    }
+
+    var audience: [Queue] {
+        (self.audienceIDs ?? self.order).compactMap { self.storage[$0] }
+    }
+
+    var count: Int {
+        self.storage.count
+    }
+
+    subscript(queueID: String) -> Queue? {
+        self.storage[queueID]
+    }
+
+    func contains(_ queueID: String) -> Bool {
+        self.storage[queueID] != nil
+    }
+
+    /// Returns the queue only if it is one of the audience queues
+    func audienceQueue(_ queueID: String) -> Queue? {
+        guard self.audienceSet?.contains(queueID) ?? true else { return nil }
+        return self.storage[queueID]
+    }
+
+    // MARK: - Updates
+
+    /// Adds the queue if it is not already known
+    @discardableResult
+    func insert(_ queue: Queue) -> Bool {
+        guard self.storage[queue.queueID] == nil else { return false }
+
+        self.storage[queue.queueID] = queue
+        self.order.append(queue.queueID)
+        return true
+    }
+
+    /// Applies the delta in place and returns the queue; nil if the queue is unknown.
+    /// Observers of the queue are notified with `.queueUpdated` if anything changed.
+    @discardableResult
+    func update(queueID: String, position: Int? = nil, isClosed: Bool? = nil) -> Queue? {
+        guard var queue = self.storage[queueID] else { return nil }
+
+        let old = queue
+        if let position = position { queue.position = position }
+        if let isClosed = isClosed { queue.isClosed = isClosed }
+        guard queue.position != old.position || queue.isClosed != old.isClosed else { return queue }
+
+        self.storage[queueID] = queue
+        self.observers[queueID]?.values.forEach { $0(.queueUpdated, queue, nil) }
+        return queue
+    }
+
+    func removeAll() {
+        self.storage.removeAll()
+        self.order.removeAll()
+        self.audienceIDs = nil
+    }
+
+    // MARK: - Observers
+
+    /// Observes a single queue, or any queue if `queueID` is nil, e.g. to be enqueued by a transfer
+    /// to a queue that is not known in advance. A receiver is bound once per scope; later bindings
+    /// are ignored.
+    func bind(receiver: String, queueID: String? = nil, observer: @escaping Observer) {
+        if let queueID = queueID {
+            guard self.observers[queueID]?[receiver] == nil else { return }
+            self.observers[queueID, default: [:]][receiver] = observer
+        } else {
+            guard self.anyQueueObservers[receiver] == nil else { return }
+            self.anyQueueObservers[receiver] = observer
+        }
+    }
+
+    func unbind(receiver: String) {
+        self.anyQueueObservers.removeValue(forKey: receiver)
+        self.observers.keys.forEach { self.observers[$0]?.removeValue(forKey: receiver) }
+        self.observers = self.observers.filter { !$0.value.isEmpty }
+    }
+
+    func unbindAll() {
+        self.observers.removeAll()
+        self.anyQueueObservers.removeAll()
+    }
+
+    /// Notifies the observers of the queue and the observers of any queue
+    func notify(_ event: Events, queue: Queue, error: Error?) {
+        self.observers[queue.queueID]?.values.forEach { $0(event, queue, error) }
+        self.anyQueueObservers.values.forEach { $0(event, queue, error) }
+    }
+}
+
+/**
+ * Collects unknown queue IDs seen within `window` and describes them in one
+ * `describe_realm_queues` request. Every caller is completed once the single
+ * response arrives.
+ */
+final class QueueDescribeBatcher {
+    private let window: TimeInterval
+    private let queue: DispatchQueue
+    private let describe: ([String], @escaping (Error?) -> Void) throws -> Void
+
+    private var pendingIDs: [String] = []
+    private var completions: [(Error?) -> Void] = []
+    private var workItem: DispatchWorkItem?
+
+    init(window: TimeInterval = 0.1, queue: DispatchQueue = .main, describe: @escaping ([String], @escaping (Error?) -> Void) throws -> Void) {
+        self.window = window
+        self.queue = queue
+        self.describe = describe
+    }
+
+    deinit {
+        self.workItem?.cancel()
+    }
+
+    func request(queueID: String, completion: @escaping (Error?) -> Void) {
+        if !self.pendingIDs.contains(queueID) {
+            self.pendingIDs.append(queueID)
+        }
+        self.completions.append(completion)
+        guard self.workItem == nil else { return }
+
+        let workItem = DispatchWorkItem { [weak self] in self?.flush() }
+        self.workItem = workItem
+        self.queue.asyncAfter(deadline: .now() + self.window, execute: workItem)
+    }
+
+    func cancel() {
+        self.workItem?.cancel()
+        self.workItem = nil
+        self.pendingIDs.removeAll()
+        self.completions.removeAll()
+    }
+
+    private func flush() {
+        let ids = self.pendingIDs
+        let completions = self.completions
+        self.cancel()
+
+        do {
+            try self.describe(ids) { error in
+                completions.forEach { $0(error) }
+            }
+        } catch {
+            completions.forEach { $0(error) }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Steps the local capture quality down on a poor connection and back up once it recovers.
+///
+/// Stepping down needs `degradeAfter` consecutive poor samples and stepping up needs `upgradeAfter`
+/// consecutive good samples, with stricter limits for good than for poor, so the quality does not
+/// flap around a threshold. Counting starts over after every change.
+final class AdaptiveCaptureController {
+    enum Level: Int, CaseIterable, CustomStringConvertible {
+        case low
+        case medium
+        case high
+
+        var width: Int32 {
+            switch self {
+            case .low: return 320
+            case .medium: return 480
+            case .high: return 640
+            }
+        }
+        var height: Int32 {
+            switch self {
+            case .low: return 240
+            case .medium: return 360
+            case .high: return 480
+            }
+        }
+        var framesPerSecond: Int32 {
+            switch self {
+            case .low: return 15
+            case .medium: return 20
+            case .high: return 30
+            }
+        }
+        /// Outgoing bitrate the level needs, in kbit/s
+        var minimumBitrate: Double {
+            switch self {
+            case .low: return 0
+            case .medium: return 300
+            case .high: return 600
+            }
+        }
+
+        var description: String {
+            "\(self.width)x\(self.height)@\(self.framesPerSecond)"
+        }
+    }
+
+    struct Limits {
+        /// Poor above these
+        var poorPacketLoss: Double = 0.08
+        var poorRoundTripTime: Double = 500
+        /// Good below these
+        var goodPacketLoss: Double = 0.02
+        var goodRoundTripTime: Double = 300
+        /// The available bitrate must exceed the next level's need by this factor to step up
+        var upgradeBitrateMargin: Double = 1.5
+        var degradeAfter: Int = 2
+        var upgradeAfter: Int = 5
+    }
+
+    private let limits: Limits
+    private var poorSamples = 0
+    private var goodSamples = 0
+    private(set) var level: Level
+
+    init(level: Level = .high, limits: Limits = Limits()) {
+        self.level = level
+        self.limits = limits
+    }
+
+    /// Returns the new level if the sample decides a change
+    func update(with statistics: NINCallStatistics) -> Level? {
+        if self.isPoor(statistics) {
+            self.poorSamples += 1
+            self.goodSamples = 0
+        } else if self.isGood(statistics) {
+            self.goodSamples += 1
+            self.poorSamples = 0
+        } else {
+            self.poorSamples = 0
+            self.goodSamples = 0
+        }
+
+        if self.poorSamples >= self.limits.degradeAfter, let lower = Level(rawValue: self.level.rawValue - 1) {
+            return self.change(to: lower)
+        } else if self.goodSamples >= self.limits.upgradeAfter, let higher = Level(rawValue: self.level.rawValue + 1) {
+            return self.change(to: higher)
+        }
+        return nil
+    }
+
+    private func change(to level: Level) -> Level {
+        self.level = level
+        self.poorSamples = 0
+        self.goodSamples = 0
+        return level
+    }
+
+    private func isPoor(_ statistics: NINCallStatistics) -> Bool {
+        if statistics.packetLoss > self.limits.poorPacketLoss { return true }
+        if let rtt = statistics.roundTripTime, rtt > self.limits.poorRoundTripTime { return true }
+        if let available = statistics.availableOutgoingBitrate, available < self.level.minimumBitrate { return true }
+        return false
+    }
+
+    private func isGood(_ statistics: NINCallStatistics) -> Bool {
+        guard statistics.packetLoss < self.limits.goodPacketLoss else { return false }
+        if let rtt = statistics.roundTripTime, rtt >= self.limits.goodRoundTripTime { return false }
+        if let higher = Level(rawValue: self.level.rawValue + 1), let available = statistics.availableOutgoingBitrate,
+           available < higher.minimumBitrate * self.limits.upgradeBitrateMargin {
+            return false
+        }
+        return true
+    }
+}
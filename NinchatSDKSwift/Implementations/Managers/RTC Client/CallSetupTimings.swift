@@ -0,0 +1,71 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Timestamps of the steps a video call goes through until media is flowing.
+/// Only the first occurrence of each step is recorded.
+final class CallSetupTimings {
+    enum Stage: Int, CaseIterable, CustomStringConvertible {
+        /// The `call` signal was received
+        case call
+        /// The `offer` signal was received
+        case offer
+        /// The ICE servers were available for the peer connection
+        case iceServers
+        /// The local answer was sent
+        case answer
+        /// The ICE connection reached the connected state
+        case connected
+
+        var description: String {
+            switch self {
+            case .call: return "call"
+            case .offer: return "offer"
+            case .iceServers: return "ice servers"
+            case .answer: return "answer"
+            case .connected: return "connected"
+            }
+        }
+    }
+
+    private let now: () -> Date
+    private(set) var marks: [Stage:Date] = [:]
+    var onCompleted: ((CallSetupTimings) -> Void)?
+
+    init(now: @escaping () -> Date = Date.init) {
+        self.now = now
+    }
+
+    func mark(_ stage: Stage) {
+        guard self.marks[stage] == nil else { return }
+        self.marks[stage] = self.now()
+
+        if stage == .connected {
+            self.onCompleted?(self)
+        }
+    }
+
+    /// Time between the two steps, nil if either one is not recorded
+    func interval(from start: Stage, to end: Stage) -> TimeInterval? {
+        guard let startDate = self.marks[start], let endDate = self.marks[end] else { return nil }
+        return endDate.timeIntervalSince(startDate)
+    }
+
+    /// Time from the first recorded step until the connection
+    var total: TimeInterval? {
+        guard let first = Stage.allCases.first(where: { self.marks[$0] != nil }) else { return nil }
+        return self.interval(from: first, to: .connected)
+    }
+
+    var summary: String {
+        let recorded = Stage.allCases.filter { self.marks[$0] != nil }
+        let steps = zip(recorded, recorded.dropFirst()).compactMap { start, end -> String? in
+            self.interval(from: start, to: end).map { "\(start)→\(end): \(Int($0 * 1000))ms" }
+        }
+        return steps.joined(separator: ", ")
+    }
+}
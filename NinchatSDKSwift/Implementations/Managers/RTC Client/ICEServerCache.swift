@@ -0,0 +1,88 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Keeps the result of `begin_ice` so the STUN/TURN round trip is not on the critical path of a call.
+///
+/// The servers are fetched speculatively when a call is received and reused by the following calls
+/// until `ttl` passes. Callers asking while a fetch is in flight are completed by that fetch.
+/// Failures are not kept. The cache is used on the main thread.
+final class ICEServerCache {
+    typealias Servers = (stunServers: [WebRTCServerInfo]?, turnServers: [WebRTCServerInfo]?)
+    typealias Completion = (Error?, [WebRTCServerInfo]?, [WebRTCServerInfo]?) -> Void
+    typealias Fetch = (@escaping Completion) throws -> Void
+
+    private let ttl: TimeInterval
+    private let now: () -> Date
+    private let fetch: Fetch
+    private var servers: Servers?
+    private var fetchedAt: Date?
+    private var waiters: [Completion]?
+
+    init(ttl: TimeInterval = 600, now: @escaping () -> Date = Date.init, fetch: @escaping Fetch) {
+        self.ttl = ttl
+        self.now = now
+        self.fetch = fetch
+    }
+
+    /// The servers fetched less than `ttl` ago
+    var cached: Servers? {
+        guard let servers = self.servers, let fetchedAt = self.fetchedAt, self.now().timeIntervalSince(fetchedAt) < self.ttl else { return nil }
+        return servers
+    }
+
+    var isFetching: Bool {
+        self.waiters != nil
+    }
+
+    /// Starts fetching the servers unless valid ones are cached or a fetch is in flight
+    func prefetch() {
+        guard self.cached == nil, !self.isFetching else { return }
+
+        logger.debug(.rtc, "Prefetching ICE servers")
+        self.request(nil)
+    }
+
+    /// Completes immediately with the cached servers, or once the servers are fetched
+    func servers(completion: @escaping Completion) {
+        if let servers = self.cached {
+            completion(nil, servers.stunServers, servers.turnServers); return
+        }
+        self.request(completion)
+    }
+
+    func invalidate() {
+        self.servers = nil
+        self.fetchedAt = nil
+    }
+
+    private func request(_ completion: Completion?) {
+        if self.isFetching {
+            if let completion = completion { self.waiters?.append(completion) }
+            return
+        }
+        self.waiters = completion.map { [$0] } ?? []
+
+        do {
+            try self.fetch { [weak self] error, stunServers, turnServers in
+                guard let `self` = self else { return }
+                if error == nil {
+                    self.servers = (stunServers, turnServers)
+                    self.fetchedAt = self.now()
+                }
+
+                let waiters = self.waiters ?? []
+                self.waiters = nil
+                waiters.forEach { $0(error, stunServers, turnServers) }
+            }
+        } catch {
+            let waiters = self.waiters ?? []
+            self.waiters = nil
+            waiters.forEach { $0(error, nil, nil) }
+        }
+    }
+}
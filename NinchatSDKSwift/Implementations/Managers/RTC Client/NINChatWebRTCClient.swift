@@ -101,9 +101,11 @@ protocol NINChatWebRTCClientDelegate {
 protocol NINChatWebRTCClient {
     var disableLocalAudio: Bool! { get set }
     var disableLocalVideo: Bool! { get set }
+    var setupTimings: CallSetupTimings? { get set }
     
     init(sessionManager: NINChatSessionManager?, operatingMode: OperatingMode, stunServers: [WebRTCServerInfo]?, turnServers: [WebRTCServerInfo]?, candidates: [RTCIceCandidate]?, delegate: NINChatWebRTCClientDelegate?)
     
     func start(with rtc: RTCSignal?) throws
+    func add(candidate: RTCIceCandidate)
     func disconnect()
 }
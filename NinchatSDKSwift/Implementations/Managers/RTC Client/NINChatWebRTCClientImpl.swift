@@ -45,6 +45,13 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
     /// RTP senders for local audio/video tracks
     private var localAudioSender: RTCRtpSender?
     private var localVideoSender: RTCRtpSender?
+    /// Source of the local video, its output is adapted to the connection quality
+    private var localVideoSource: RTCVideoSource?
+    /// Periodic connection statistics and the capture quality they drive
+    private var statsSampler: WebRTCStatsSampler?
+    private let captureController = AdaptiveCaptureController()
+    /// Remote candidates received before the remote description was set
+    private var pendingCandidates: [RTCIceCandidate] = []
 
     private var sessionDelegate: NINChatSessionInternalDelegate? {
         self.sessionManager?.delegate
@@ -69,6 +76,7 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
             #endif
         }
     }
+    var setupTimings: CallSetupTimings?
     
     init(sessionManager: NINChatSessionManager?, operatingMode: OperatingMode, stunServers: [WebRTCServerInfo]?, turnServers: [WebRTCServerInfo]?, candidates: [RTCIceCandidate]?, delegate: NINChatWebRTCClientDelegate?) {
         
@@ -89,14 +97,11 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
             dic[item.rawValue] = item.description
         }
         
-        /// Initiate peerConnection and add queued ICE Candidates
+        /// Initiate peerConnection, candidates received so far are added once the remote description is set
         self.initiatePeerConnection()
-        for candidate in candidates ?? [] {
-            debugger("WebRTC: Adding candidate: \(candidate) to peerConnection: \(String(describing: peerConnection))")
-            self.peerConnection?.add(candidate)
-        }
+        self.pendingCandidates = candidates ?? []
         
-        sessionManager?.delegate?.log(value: "Creating new `NINChatWebRTCClient` in the '\(operatingMode.description)' mode")
+        sessionManager?.delegate?.log(.rtc, "Creating new `NINChatWebRTCClient` in the '\(operatingMode.description)' mode")
         NotificationCenter.default.addObserver(self, selector: #selector(didSessionRouteChange(_:)), name: AVAudioSession.routeChangeNotification, object: nil)
     }
     
@@ -104,16 +109,16 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
         guard self.peerConnectionFactory != nil else { throw NINWebRTCExceptions.invalidState }
         guard self.sessionManager != nil else { throw NINSessionExceptions.noActiveSession }
         
-        debugger("WebRTC: Starting..")
+        logger.debug(.rtc, "Starting..")
         sessionManager?.onRTCClientSignal = { [weak self] type, user, signal in
             switch type {
             case .candidate:
-                debugger("WebRTC: Candidate received")
+                logger.debug(.rtc, "Candidate received")
                 guard let iceCandidate = signal?.candidate?.toRTCIceCandidate else { return }
-                self?.peerConnection?.add(iceCandidate)
+                self?.add(candidate: iceCandidate)
             case .answer:
                 guard let sdp = signal?.sdp, sdp.values.count > 0, let description = sdp.toRTCSessionDescription else { return }
-                debugger("WebRTC: Setting remote description from Answer with SDP: \(description)")
+                logger.debug(.rtc, "Setting remote description from Answer with SDP: \(description)")
                 self?.peerConnection?.setRemoteDescription(description) { error in
                     self?.didSetSessionDescription(with: error)
                 }
@@ -131,16 +136,16 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
         switch operatingMode {
         case .caller:
             /// We are the 'caller', ie. the connection initiator; create a connection offer
-            debugger("WebRTC: making a call.")
+            logger.debug(.rtc, "Making a call.")
             self.peerConnection?.offer(for: self.defaultOfferOrAnswerConstraints) { [weak self] (sdp, error) in
-                debugger("WebRTC: Created SDK offer with error: \(String(describing: error))")
+                logger.debug(.rtc, "Created SDK offer with error: \(String(describing: error))")
                 self?.didCreateSessionDescription(sdp: sdp, error: error)
             }
         case .callee:
             /// We are the 'callee', ie. we are answering.
-            debugger("WebRTC: answering a call.")
+            logger.debug(.rtc, "Answering a call.")
             guard let description = rtc?.sdp?.toRTCSessionDescription else { return }
-            debugger("WebRTC: Setting remote description from Offer.")
+            logger.debug(.rtc, "Setting remote description from Offer.")
             self.peerConnection?.setRemoteDescription(description) { [weak self] error in
                 self?.didSetSessionDescription(with: error)
             }
@@ -149,14 +154,34 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
         }
     }
     
+    /// Applies the remote candidate as soon as the peer connection can take it
+    func add(candidate: RTCIceCandidate) {
+        guard self.peerConnection?.remoteDescription != nil else {
+            self.pendingCandidates.append(candidate); return
+        }
+        logger.debug(.rtc, "Adding candidate: \(candidate) to peerConnection")
+        self.peerConnection?.add(candidate)
+    }
+
+    private func addPendingCandidates() {
+        guard self.peerConnection?.remoteDescription != nil, !self.pendingCandidates.isEmpty else { return }
+
+        let candidates = self.pendingCandidates
+        self.pendingCandidates.removeAll()
+        candidates.forEach { self.add(candidate: $0) }
+    }
+
     func disconnect() {
-        self.sessionDelegate?.log(value: "WebRTC: Client disconnecting.")
+        self.sessionDelegate?.log(.rtc, "Client disconnecting.")
         
         self.stopLocalCapture()
         self.deallocate()
     }
 
     private func deallocate() {
+        self.statsSampler?.stop()
+        self.statsSampler = nil
+        self.localVideoSource = nil
         self.localStream = nil
         self.localCapture = nil
 
@@ -172,6 +197,8 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
 
         self.localAudioSender = nil
         self.localVideoSender = nil
+        self.pendingCandidates.removeAll()
+        self.setupTimings = nil
         self.localAudioTrack = nil
         self.localVideoTrack = nil
 
@@ -187,23 +214,23 @@ final class NINChatWebRTCClientImpl: NSObject, NINChatWebRTCClient {
     }
 
     deinit {
-        debugger("`NINChatWebRTCClient` deallocated")
+        logger.debug(.rtc, "`NINChatWebRTCClient` deallocated")
     }
 }
 
 extension NINChatWebRTCClientImpl {
     private func initiatePeerConnection() {
         /// Configure & create our RTC peer connection
-        debugger("WebRTC: Configuring & initializing RTC Peer Connection")
+        logger.debug(.rtc, "Configuring & initializing RTC Peer Connection")
         let constraints = RTCMediaConstraints(mandatoryConstraints: nil, optionalConstraints: ["DtlsSrtpKeyAgreement": "true"])
         let configuration = RTCConfiguration()
         configuration.iceServers = self.iceServers ?? []
         
         #if NIN_USE_PLANB_SEMANTICS
-        debugger("WebRTC: Configuring peer connection for PlanB SDP semantics.")
+        logger.debug(.rtc, "Configuring peer connection for PlanB SDP semantics.")
         configuration.sdpSemantics = .planB /// <-- Legacy RTC impl support
         #else
-        debugger("WebRTC: Configuring peer connection for Unified Plan SDP semantics.")
+        logger.debug(.rtc, "Configuring peer connection for Unified Plan SDP semantics.")
         configuration.sdpSemantics = .unifiedPlan
         #endif
         
@@ -237,10 +264,10 @@ extension NINChatWebRTCClientImpl {
                 
                 return nil
             }).filter({ $0 != nil }).last ?? availableFormats.first else {
-                self.sessionDelegate?.log(value: "** ERROR No valid formats for device: \(device)"); return
+                self.sessionDelegate?.log(.rtc, "No valid formats for device: \(device)", level: .error); return
             }
             
-            debugger("WebRTC: Starting local video capturing..")
+            logger.debug(.rtc, "Starting local video capturing..")
             let fps = fmin(format.videoSupportedFrameRateRanges
                                                         .map({ $0.maxFrameRate })
                                                         .sorted(by: { $0 > $1 })
@@ -248,16 +275,16 @@ extension NINChatWebRTCClientImpl {
             
             self.localCapture?.startCapture(with: device, format: format, fps: Int(fps)) { [weak self] (error: Error?) in
                 if let error = error {
-                    self?.sessionDelegate?.log(value: "** ERROR failed to start local capture: \(error)"); return
+                    self?.sessionDelegate?.log(.rtc, "Failed to start local capture: \(error)", level: .error); return
                 }
-                debugger("Local capture started OK.")
+                logger.debug(.rtc, "Local capture started OK.")
             }
         }
     }
     
     private func stopLocalCapture() {
         DispatchQueue.main.async {
-            debugger("WebRTC: Stopping local video capturing..")
+            logger.debug(.rtc, "Stopping local video capturing..")
             self.localCapture?.stopCapture()
         }
     }
@@ -265,14 +292,15 @@ extension NINChatWebRTCClientImpl {
     private func didSetSessionDescription(with error: Error?) {
         DispatchQueue.main.async {
             if let error = error {
-                debugger("WebRTC: got set session error: \(error)")
+                logger.error(.rtc, "Got set session error: \(error)")
                 self.disconnect()
                 self.delegate?.onError?(self, error)
                 return
             }
-            
+            self.addPendingCandidates()
+
             guard self.operatingMode == .callee, self.peerConnection?.localDescription == nil else { return }
-            debugger("WebRTC: Creating answer")
+            logger.debug(.rtc, "Creating answer")
             self.peerConnection?.answer(for: self.defaultOfferOrAnswerConstraints) { [weak self] (sdp, error) in
                 self?.didCreateSessionDescription(sdp: sdp, error: error)
             }
@@ -282,14 +310,14 @@ extension NINChatWebRTCClientImpl {
     private func didCreateSessionDescription(sdp: RTCSessionDescription?, error: Error?) {
         DispatchQueue.main.async {
             if let error = error {
-                debugger("WebRTC: got create session error: \(error)")
+                logger.error(.rtc, "Got create session error: \(error)")
                 self.disconnect()
                 self.delegate?.onError?(self, error)
                 return
             }
             
             guard let sdp = sdp, self.peerConnection?.localDescription?.type != sdp.type else { return }
-            debugger("WebRTC: Setting local description")
+            logger.debug(.rtc, "Setting local description")
             self.peerConnection?.setLocalDescription(sdp) { [weak self] error in
                 self?.didSetSessionDescription(with: error)
             }
@@ -297,20 +325,22 @@ extension NINChatWebRTCClientImpl {
             /// Decide what type of signaling message to send based on the SDP type
             let typeMap: [RTCSdpType:MessageType] = [.offer:.offer, .answer:.answer]
             guard let messageType = typeMap[sdp.type] else {
-                debugger("WebRTC: Unknown SDP type: \(sdp.type)"); return
+                logger.debug(.rtc, "Unknown SDP type: \(sdp.type)"); return
             }
             
             /// Send signaling message about the offer/answer
-            debugger("WebRTC: Sending RTC signaling message of type: \(messageType)")
+            logger.debug(.rtc, "Sending RTC signaling message of type: \(messageType)")
             do {
-                try self.sessionManager?.send(type: messageType, payload: ["sdp":sdp.toDictionary]) { error in
+                try self.sessionManager?.send(type: messageType, payload: ["sdp":sdp.toDictionary]) { [weak self] error in
                     if let error = error {
-                        debugger("WebRTC: Message send error - `completion`: \(error)")
+                        logger.error(.rtc, "Message send error - `completion`: \(error)")
                         Toast.show(message: .error("Failed to send RTC signaling message"))
+                    } else if messageType == .answer {
+                        self?.setupTimings?.mark(.answer)
                     }
                 }
             } catch {
-                debugger("WebRTC: Message send error - `sessionManager.send`: \(error)")
+                logger.error(.rtc, "Message send error - `sessionManager.send`: \(error)")
             }
         }
     }
@@ -321,12 +351,12 @@ extension NINChatWebRTCClientImpl {
 extension NINChatWebRTCClientImpl {
     private func createMediaSenders() {
         DispatchQueue.main.async {
-            debugger("WebRTC: Configuring local audio & video sources")
+            logger.debug(.rtc, "Configuring local audio & video sources")
 
             self.createVideoSender()
             self.createAudioSender()
 
-            debugger("WebRTC: Local media senders configured.")
+            logger.debug(.rtc, "Local media senders configured.")
         }
     }
 
@@ -340,10 +370,10 @@ extension NINChatWebRTCClientImpl {
             self.localStream?.addAudioTrack(audioTrack)
             
             /// Add the local audio track to the peer connection
-            debugger("WebRTC: Adding audio track to our peer connection.")
+            logger.debug(.rtc, "Adding audio track to our peer connection.")
             self.localAudioSender = self.peerConnection?.add(audioTrack, streamIds: [self.kStreamId])
             if self.localAudioSender == nil {
-                debugger("** ERROR: Failed to add audio track")
+                logger.error(.rtc, "Failed to add audio track")
             }
         }
     }
@@ -351,6 +381,7 @@ extension NINChatWebRTCClientImpl {
     /// Create local video track and add it to the peer connection
     private func createVideoSender() {
         let videoSource = self.peerConnectionFactory?.videoSource()
+        self.localVideoSource = videoSource
         #if !targetEnvironment(simulator)
         /// Camera capture only works on the device, not the simulator
         self.localCapture = RTCCameraVideoCapturer(delegate: videoSource!)
@@ -363,10 +394,10 @@ extension NINChatWebRTCClientImpl {
             self.localStream?.addVideoTrack(videoTrack)
             
             /// Add the local video track to the peer connection
-            debugger("WebRTC: Adding video track to our peer connection")
+            logger.debug(.rtc, "Adding video track to our peer connection")
             self.localVideoSender = self.peerConnection?.add(videoTrack, streamIds: [self.kStreamId])
             if self.localVideoSender == nil {
-                debugger("** ERROR: Failed to add video track")
+                logger.error(.rtc, "Failed to add video track")
             }
         }
         
@@ -379,6 +410,30 @@ extension NINChatWebRTCClientImpl {
     }
 }
 
+// MARK: - Statistics
+
+extension NINChatWebRTCClientImpl {
+    private func startStatistics() {
+        guard self.statsSampler == nil, let peerConnection = self.peerConnection else { return }
+
+        let sampler = WebRTCStatsSampler(peerConnection: peerConnection)
+        sampler.onSample = { [weak self] statistics in
+            self?.sessionDelegate?.onCallStatistics(statistics)
+            if let level = self?.captureController.update(with: statistics) {
+                self?.adaptCapture(to: level)
+            }
+        }
+        self.statsSampler = sampler
+        sampler.start()
+    }
+
+    /// Scales the captured frames instead of restarting the capture
+    private func adaptCapture(to level: AdaptiveCaptureController.Level) {
+        logger.debug(.rtc, "Adapting local video to \(level)")
+        self.localVideoSource?.adaptOutputFormat(toWidth: level.width, height: level.height, fps: level.framesPerSecond)
+    }
+}
+
 /// Force the audio output to Speaker. Look at issue #61 for `NinchatSDK`
 extension NINChatWebRTCClientImpl {
     /// The issue with the output: `https://github.com/somia/ninchat-sdk-ios/issues/61` and `https://github.com/somia/mobile/issues/302`
@@ -386,7 +441,7 @@ extension NINChatWebRTCClientImpl {
     @objc
     private func didSessionRouteChange(_ notification: Notification) {
         if let userInfo = notification.userInfo, let reasonKey = userInfo[AVAudioSessionRouteChangeReasonKey] as? UInt, let reason = AVAudioSession.RouteChangeReason(rawValue: reasonKey) {
-            debugger("Route Changed: \(userInfo)")
+            logger.debug(.rtc, "Route Changed: \(userInfo)")
             
             /// Force Speaker in case the app tries to use earning as the output
             if RTCAudioSession.sharedInstance().currentRoute.outputs.first?.portType.rawValue ?? "" == "Receiver" || AVAudioSession.sharedInstance().currentRoute.outputs.first?.portType.rawValue ?? "" == "Receiver" {
@@ -396,7 +451,7 @@ extension NINChatWebRTCClientImpl {
                         try AVAudioSession.sharedInstance().overrideOutputAudioPort(.speaker)
                         try RTCAudioSession.sharedInstance().overrideOutputAudioPort(.speaker)
                     } catch {
-                        debugger("WebRTC: Failed to change the output to device's speaker - `didSessionRouteChange(_:)`: \(error)")
+                        logger.error(.rtc, "Failed to change the output to device's speaker - `didSessionRouteChange(_:)`: \(error)")
                     }
                 }
                 RTCAudioSession.sharedInstance().unlockForConfiguration()
@@ -407,65 +462,69 @@ extension NINChatWebRTCClientImpl {
 
 extension NINChatWebRTCClientImpl: RTCPeerConnectionDelegate {
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didAdd stream: RTCMediaStream) {
-        debugger("WebRTC: Received stream \(stream.streamId) with \(stream.videoTracks.count) video tracks and \(stream.audioTracks.count) audio tracks")
+        logger.debug(.rtc, "Received stream \(stream.streamId) with \(stream.videoTracks.count) video tracks and \(stream.audioTracks.count) audio tracks")
         
         #if NIN_USE_PLANB_SEMANTICS
         DispatchQueue.main.async {
             if let track = stream.videoTracks.first {
                 self.delegate?.onRemoteVideoTrackReceive?(self, track)
             }
-            debugger("** ERROR: no video tracks in `didAddStream:`")
+            logger.error(.rtc, "No video tracks in `didAddStream:`")
         }
         #endif
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didStartReceivingOn transceiver: RTCRtpTransceiver) {
         if let track = transceiver.receiver.track {
-            debugger("WebRTC: Now receiving \(track.kind) on track \(track.trackId).")
+            logger.debug(.rtc, "Now receiving \(track.kind) on track \(track.trackId).")
         }
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didRemove stream: RTCMediaStream) {
-        debugger("WebRTC: removed stream: \(stream)")
+        logger.debug(.rtc, "Removed stream: \(stream)")
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didOpen dataChannel: RTCDataChannel) {
-        debugger("WebRTC: opened data channel: \(dataChannel)")
+        logger.debug(.rtc, "Opened data channel: \(dataChannel)")
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didGenerate candidate: RTCIceCandidate) {
         DispatchQueue.main.async {
             _ = try? self.sessionManager?.send(type: .candidate, payload: ["candidate":candidate.toDictionary]) { error in
-                if let error = error { debugger("WebRTC: ERROR: Failed to send ICE candidate: \(error)") }
+                if let error = error { logger.error(.rtc, "Failed to send ICE candidate: \(error)") }
             }
         }
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didChange newState: RTCIceConnectionState) {
         let newConnectionState = ConnectionState(rawValue: newState.rawValue)!
-        debugger("WebRTC: ICE connection state changed: \(newConnectionState.description)")
+        logger.debug(.rtc, "ICE connection state changed: \(newConnectionState.description)")
         
         DispatchQueue.main.async {
+            if newConnectionState == .connected || newConnectionState == .completed {
+                self.setupTimings?.mark(.connected)
+                self.startStatistics()
+            }
             self.delegate?.onConnectionStateChange?(self, newConnectionState)
         }
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didChange newState: RTCIceGatheringState) {
-        debugger("WebRTC: ICE gathering state changed: \(GatheringState(rawValue: newState.rawValue)!.description)")
+        logger.debug(.rtc, "ICE gathering state changed: \(GatheringState(rawValue: newState.rawValue)!.description)")
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didChange stateChanged: RTCSignalingState) {
-        debugger("WebRTC: ICE signaling state changed: \(SignalingState(rawValue: stateChanged.rawValue)!.description)")
+        logger.debug(.rtc, "ICE signaling state changed: \(SignalingState(rawValue: stateChanged.rawValue)!.description)")
     }
     
     internal func peerConnection(_ peerConnection: RTCPeerConnection, didRemove candidates: [RTCIceCandidate]) {
-        debugger("WebRTC: Removed ICE candidates: \(candidates)")
+        logger.debug(.rtc, "Removed ICE candidates: \(candidates)")
     }
     
     internal func peerConnectionShouldNegotiate(_ peerConnection: RTCPeerConnection) {
         /// TODO see:
         /// https://stackoverflow.com/questions/31165316/webrtc-renegotiate-the-peer-connection-to-switch-streams
         /// https://stackoverflow.com/questions/29511602/how-to-exchange-streams-from-two-peerconnections-with-offer-answer/29530757#29530757
-        debugger("WebRTC: **WARNING** renegotiation needed - unimplemented!")
+        logger.warning(.rtc, "Renegotiation needed - unimplemented!")
     }
 }
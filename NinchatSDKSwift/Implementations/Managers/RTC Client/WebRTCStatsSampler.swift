@@ -0,0 +1,136 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+import WebRTC
+
+/// Samples the statistics of a peer connection periodically and turns the cumulative counters
+/// into rates. Parsing is kept apart from `RTCStatisticsReport` so recorded traces can be replayed.
+final class WebRTCStatsSampler {
+    /// A single entry of a statistics report, e.g. an `outbound-rtp` stream
+    struct Entry {
+        let type: String
+        let values: [String:Any]
+
+        func double(_ key: String) -> Double? {
+            (self.values[key] as? NSNumber)?.doubleValue
+        }
+        func string(_ key: String) -> String? {
+            self.values[key] as? String
+        }
+        var kind: String? {
+            self.string("kind") ?? self.string("mediaType")
+        }
+    }
+
+    /// Cumulative counters of the previous sample
+    private struct Counters {
+        var bytesSent: Double = 0
+        var bytesReceived: Double = 0
+        var packetsLost: Double = 0
+        var packetsReceived: Double = 0
+        var timestamp: TimeInterval = 0
+    }
+
+    typealias Source = (@escaping ([Entry]) -> Void) -> Void
+
+    private let interval: TimeInterval
+    private let queue: DispatchQueue
+    private let now: () -> TimeInterval
+    private let source: Source
+    private var counters: Counters?
+    private var workItem: DispatchWorkItem?
+
+    var onSample: ((NINCallStatistics) -> Void)?
+
+    init(interval: TimeInterval = 2.0, queue: DispatchQueue = .main, now: @escaping () -> TimeInterval = { Date().timeIntervalSince1970 }, source: @escaping Source) {
+        self.interval = interval
+        self.queue = queue
+        self.now = now
+        self.source = source
+    }
+
+    convenience init(peerConnection: RTCPeerConnection, interval: TimeInterval = 2.0) {
+        self.init(interval: interval) { [weak peerConnection] completion in
+            peerConnection?.statistics { report in
+                completion(report.statistics.values.map { Entry(type: $0.type, values: $0.values) })
+            }
+        }
+    }
+
+    deinit {
+        self.workItem?.cancel()
+    }
+
+    func start() {
+        guard self.workItem == nil else { return }
+        self.schedule()
+    }
+
+    func stop() {
+        self.workItem?.cancel()
+        self.workItem = nil
+        self.counters = nil
+    }
+
+    private func schedule() {
+        let workItem = DispatchWorkItem { [weak self] in
+            self?.source { entries in
+                self?.queue.async {
+                    guard let `self` = self, self.workItem != nil else { return }
+                    if let statistics = self.sample(entries) {
+                        self.onSample?(statistics)
+                    }
+                    self.schedule()
+                }
+            }
+        }
+        self.workItem = workItem
+        self.queue.asyncAfter(deadline: .now() + self.interval, execute: workItem)
+    }
+
+    /// Converts a report into statistics; the first report only sets the baseline of the rates
+    func sample(_ entries: [Entry]) -> NINCallStatistics? {
+        let timestamp = self.now()
+        let outbound = entries.filter { $0.type == "outbound-rtp" }
+        let inbound = entries.filter { $0.type == "inbound-rtp" }
+        let pair = entries.first { $0.type == "candidate-pair" && $0.string("state") == "succeeded" && ($0.values["nominated"] as? NSNumber)?.boolValue ?? false }
+        let remoteInbound = entries.filter { $0.type == "remote-inbound-rtp" }
+        let video = outbound.first { $0.kind == "video" }
+
+        let current = Counters(bytesSent: outbound.compactMap { $0.double("bytesSent") }.reduce(0, +),
+                               bytesReceived: inbound.compactMap { $0.double("bytesReceived") }.reduce(0, +),
+                               packetsLost: inbound.compactMap { $0.double("packetsLost") }.reduce(0, +),
+                               packetsReceived: inbound.compactMap { $0.double("packetsReceived") }.reduce(0, +),
+                               timestamp: timestamp)
+        defer { self.counters = current }
+        guard let previous = self.counters, current.timestamp > previous.timestamp else { return nil }
+
+        let elapsed = current.timestamp - previous.timestamp
+        func rate(_ bytes: Double, _ previousBytes: Double) -> Double {
+            max(bytes - previousBytes, 0) * 8 / elapsed / 1000
+        }
+
+        /// Loss reported by the other side for our streams matters for what we send; fall back to what we receive
+        let lost = max(current.packetsLost - previous.packetsLost, 0)
+        let received = max(current.packetsReceived - previous.packetsReceived, 0)
+        let packetLoss = remoteInbound.compactMap { $0.double("fractionLost") }.max() ?? ((lost + received) > 0 ? lost / (lost + received) : 0)
+
+        let roundTripTime = pair?.double("currentRoundTripTime") ?? remoteInbound.compactMap { $0.double("roundTripTime") }.max()
+        var frameSize: CGSize?
+        if let width = video?.double("frameWidth"), let height = video?.double("frameHeight") {
+            frameSize = CGSize(width: width, height: height)
+        }
+
+        return NINCallStatistics(outgoingBitrate: rate(current.bytesSent, previous.bytesSent),
+                                 incomingBitrate: rate(current.bytesReceived, previous.bytesReceived),
+                                 availableOutgoingBitrate: pair?.double("availableOutgoingBitrate").map { $0 / 1000 },
+                                 roundTripTime: roundTripTime.map { $0 * 1000 },
+                                 packetLoss: packetLoss,
+                                 framesPerSecond: video?.double("framesPerSecond"),
+                                 frameSize: frameSize)
+    }
+}
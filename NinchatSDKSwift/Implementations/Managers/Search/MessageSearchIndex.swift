@@ -0,0 +1,200 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/**
+ * An inverted index over the text and attachment names of a channel's messages.
+ *
+ * Terms are folded to lower case and stripped of diacritics, so "paiva" finds "Päivä",
+ * and every term of a query matches as a prefix. The index is updated with the diffs
+ * of the message store instead of being rebuilt. It is a value type, so a channel that
+ * continues another one shares its index until either of them changes.
+ *
+ * Only the terms of each message are encoded; the lookups are rebuilt when decoded,
+ * e.g. when stored along with the messages.
+ */
+struct MessageSearchIndex {
+    /// Terms of each indexed message, to take them off the postings when the message changes
+    private var documents: [String:[String]] = [:]
+    /// Messages by term
+    private var postings: [String:Set<String>] = [:]
+    /// Terms in order, for prefix lookups. Terms that are no longer used are dropped on the next merge.
+    private var sortedTerms: [String] = []
+    /// New terms, merged into `sortedTerms` by the next search, so a history load does not keep reordering them
+    private var newTerms: [String] = []
+
+    /// Indexed messages
+    var count: Int {
+        self.documents.count
+    }
+
+    // MARK: - Updates
+
+    /// Indexes the message, replacing its earlier terms
+    mutating func index(_ message: ChatMessage) {
+        self.remove(messageID: message.messageID)
+
+        let terms = Set(MessageSearchIndex.searchableText(of: message).flatMap { MessageSearchIndex.terms(in: $0) })
+        guard !terms.isEmpty else { return }
+
+        self.documents[message.messageID] = Array(terms)
+        terms.forEach { term in
+            if self.postings[term] == nil { self.newTerms.append(term) }
+            self.postings[term, default: []].insert(message.messageID)
+        }
+    }
+
+    mutating func remove(messageID: String) {
+        guard let terms = self.documents.removeValue(forKey: messageID) else { return }
+
+        terms.forEach { term in
+            self.postings[term]?.remove(messageID)
+            if self.postings[term]?.isEmpty ?? false { self.postings.removeValue(forKey: term) }
+        }
+    }
+
+    /// Applies the changes between two consecutive snapshots of the messages
+    mutating func apply(_ diff: ChatSnapshotDiff, from old: ChatSnapshot, to new: ChatSnapshot) {
+        diff.removed.forEach { self.remove(messageID: old.messages[$0].messageID) }
+        (diff.inserted + diff.updated).forEach { self.index(new.messages[$0]) }
+    }
+
+    mutating func rebuild(from messages: [ChatMessage]) {
+        self.removeAll()
+        messages.forEach { self.index($0) }
+    }
+
+    mutating func removeAll() {
+        self.documents.removeAll()
+        self.postings.removeAll()
+        self.sortedTerms.removeAll()
+        self.newTerms.removeAll()
+    }
+
+    // MARK: - Search
+
+    /// IDs of the messages matching every term of the query as a prefix, most recent first
+    mutating func search(_ query: String, limit: Int = 50) -> [String] {
+        let queryTerms = Set(MessageSearchIndex.terms(in: query))
+        guard !queryTerms.isEmpty, limit > 0 else { return [] }
+        self.mergeNewTerms()
+
+        /// Longer prefixes match fewer messages, which keeps the intersections small
+        var matches: Set<String>?
+        for prefix in queryTerms.sorted(by: { $0.count > $1.count }) {
+            let found = self.messages(withPrefix: prefix)
+            matches = matches.map { $0.intersection(found) } ?? found
+            if matches?.isEmpty ?? true { return [] }
+        }
+        return MessageSearchIndex.mostRecent(matches ?? [], limit: limit)
+    }
+}
+
+// MARK: - Terms
+
+extension MessageSearchIndex {
+    /// Words of the text, folded for matching
+    static func terms(in text: String) -> [String] {
+        text.folding(options: [.caseInsensitive, .diacriticInsensitive, .widthInsensitive], locale: nil)
+            .components(separatedBy: CharacterSet.alphanumerics.inverted)
+            .filter { !$0.isEmpty }
+    }
+
+    private static func searchableText(of message: ChatMessage) -> [String] {
+        guard let message = message as? TextMessage, !message.isDeleted else { return [] }
+        return [message.content, message.attachment?.name].compactMap { $0 }
+    }
+
+    private func messages(withPrefix prefix: String) -> Set<String> {
+        var result = Set<String>()
+        var index = self.lowerBound(of: prefix)
+        while index < self.sortedTerms.count, self.sortedTerms[index].hasPrefix(prefix) {
+            if let messages = self.postings[self.sortedTerms[index]] {
+                result = result.isEmpty ? messages : result.union(messages)
+            }
+            index += 1
+        }
+        return result
+    }
+
+    private func lowerBound(of term: String) -> Int {
+        var (low, high) = (0, self.sortedTerms.count)
+        while low < high {
+            let middle = (low + high) / 2
+            if self.sortedTerms[middle] < term { low = middle + 1 } else { high = middle }
+        }
+        return low
+    }
+
+    /// Merges the new terms in one pass, dropping duplicates and the terms no message uses anymore
+    private mutating func mergeNewTerms() {
+        guard !self.newTerms.isEmpty else { return }
+
+        let added = self.newTerms.sorted()
+        self.newTerms.removeAll()
+
+        var merged: [String] = []
+        merged.reserveCapacity(self.sortedTerms.count + added.count)
+        var (i, j) = (0, 0)
+        while i < self.sortedTerms.count || j < added.count {
+            let term: String
+            if j == added.count || (i < self.sortedTerms.count && self.sortedTerms[i] <= added[j]) {
+                term = self.sortedTerms[i]; i += 1
+            } else {
+                term = added[j]; j += 1
+            }
+            if merged.last != term, self.postings[term] != nil { merged.append(term) }
+        }
+        self.sortedTerms = merged
+    }
+
+    /// The `limit` greatest message IDs, greatest first, without sorting every match;
+    /// message IDs grow with time, as in `sortAndMap(_:)`
+    private static func mostRecent(_ ids: Set<String>, limit: Int) -> [String] {
+        guard ids.count > limit else { return ids.sorted(by: >) }
+
+        var top: [String] = []
+        top.reserveCapacity(limit + 1)
+        for id in ids {
+            if top.count == limit, let last = top.last, id <= last { continue }
+
+            var (low, high) = (0, top.count)
+            while low < high {
+                let middle = (low + high) / 2
+                if top[middle] > id { low = middle + 1 } else { high = middle }
+            }
+            top.insert(id, at: low)
+            if top.count > limit { top.removeLast() }
+        }
+        return top
+    }
+}
+
+// MARK: - Codable
+
+extension MessageSearchIndex: Codable {
+    enum CodingKeys: String, CodingKey {
+        case documents
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        let documents = try container.decode([String:[String]].self, forKey: .documents)
+
+        self.init()
+        self.documents = documents
+        documents.forEach { messageID, terms in
+            terms.forEach { self.postings[$0, default: []].insert(messageID) }
+        }
+        self.newTerms = Array(self.postings.keys)
+    }
+
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(self.documents, forKey: .documents)
+    }
+}
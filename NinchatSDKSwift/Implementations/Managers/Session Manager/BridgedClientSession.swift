@@ -0,0 +1,119 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+import NinchatLowLevelClient
+
+/// Adapts the Go client's session to `LowLevelClientSession`.
+///
+/// The parameters and payloads of the events are copied into values on the client's thread, before
+/// they are handed over, so the Go objects are released as soon as the callback returns. Actions are
+/// converted to the client's objects only when they are sent.
+final class BridgedClientSession: NSObject, LowLevelClientSession {
+    let session: NINLowLevelClientSession
+    private weak var handler: LowLevelClientHandler?
+    private let bridgedObjects: BridgedObjectTracker
+
+    init(session: NINLowLevelClientSession = NINLowLevelClientSession(), bridgedObjects: BridgedObjectTracker = .shared) {
+        self.session = session
+        self.bridgedObjects = bridgedObjects
+        super.init()
+    }
+
+    func setAddress(_ address: String?) {
+        self.session.setAddress(address)
+    }
+
+    func setHeader(_ key: String?, value: String?) {
+        self.session.setHeader(key, value: value)
+    }
+
+    func setParams(_ params: ClientProps) throws {
+        let props = try NINLowLevelClientProps(params)
+        self.bridgedObjects.track(props)
+        try self.session.setParams(props)
+    }
+
+    func setHandler(_ handler: LowLevelClientHandler) {
+        self.handler = handler
+        self.session.setOnSessionEvent(self)
+        self.session.setOnEvent(self)
+        self.session.setOnClose(self)
+        self.session.setOnLog(self)
+        self.session.setOnConnState(self)
+    }
+
+    func open() throws {
+        try self.session.open()
+    }
+
+    /// The handlers are dropped as well, as the client's session keeps them
+    func close() {
+        self.session.close()
+        self.session.setOnSessionEvent(nil)
+        self.session.setOnEvent(nil)
+        self.session.setOnClose(nil)
+        self.session.setOnLog(nil)
+        self.session.setOnConnState(nil)
+    }
+
+    func send(_ param: ClientProps, _ payload: ClientPayload?) throws -> Int {
+        let props = try NINLowLevelClientProps(param)
+        let payload = payload.map { NINLowLevelClientPayload($0) }
+        self.bridgedObjects.track(props)
+        self.bridgedObjects.track(payload)
+
+        var actionID: Int64 = 0
+        try self.session.send(props, payload: payload, actionId: &actionID)
+        return Int(actionID)
+    }
+}
+
+extension BridgedClientSession: NINLowLevelClientSessionEventHandlerProtocol {
+    func onSessionEvent(_ params: NINLowLevelClientProps?) {
+        guard let params = params else { return }
+        do {
+            let props = try ClientProps(params)
+            self.bridgedObjects.track(params, site: "onSessionEvent(\(props.event.optional ?? ""))")
+            self.handler?.onSessionEvent(props)
+        } catch {
+            logger.error(.event, "Error in copying the session event: \(error)")
+        }
+    }
+}
+
+extension BridgedClientSession: NINLowLevelClientEventHandlerProtocol {
+    func onEvent(_ params: NINLowLevelClientProps?, payload: NINLowLevelClientPayload?, lastReply: Bool) {
+        guard let params = params else { return }
+        do {
+            let props = try ClientProps(params)
+            let site = "onEvent(\(props.event.optional ?? ""))"
+            self.bridgedObjects.track(params, site: site)
+            self.bridgedObjects.track(payload, site: site)
+            self.handler?.onEvent(props, payload: payload?.frames ?? [], lastReply: lastReply)
+        } catch {
+            logger.error(.event, "Error in copying the event: \(error)")
+        }
+    }
+}
+
+extension BridgedClientSession: NINLowLevelClientCloseHandlerProtocol {
+    func onClose() {
+        self.handler?.onClose()
+    }
+}
+
+extension BridgedClientSession: NINLowLevelClientLogHandlerProtocol {
+    func onLog(_ msg: String?) {
+        self.handler?.onLog(msg ?? "")
+    }
+}
+
+extension BridgedClientSession: NINLowLevelClientConnStateHandlerProtocol {
+    func onConnState(_ state: String?) {
+        self.handler?.onConnState(state ?? "")
+    }
+}
@@ -0,0 +1,38 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Receives all the callbacks of a low level client session, on the client's thread
+protocol LowLevelClientHandler: AnyObject {
+    func onSessionEvent(_ params: ClientProps)
+    func onEvent(_ params: ClientProps, payload: ClientPayload, lastReply: Bool)
+    func onClose()
+    func onLog(_ msg: String)
+    func onConnState(_ state: String)
+}
+
+/// The session of the low level client as the session manager uses it.
+///
+/// The session logic reaches the Go client only through this protocol and exchanges plain values
+/// with it, so it can be built without the client and run against an in-process one in unit tests
+/// and benchmarks, without a server. `BridgedClientSession` adapts the Go client's session.
+protocol LowLevelClientSession: AnyObject {
+    func setAddress(_ address: String?)
+    func setHeader(_ key: String?, value: String?)
+    func setParams(_ params: ClientProps) throws
+    func setHandler(_ handler: LowLevelClientHandler)
+    func open() throws
+    func close()
+    /// Returns the action's id
+    func send(_ param: ClientProps, _ payload: ClientPayload?) throws -> Int
+}
+
+extension LowLevelClientSession {
+    func send(_ param: ClientProps) throws -> Int {
+        try self.send(param, nil)
+    }
+}
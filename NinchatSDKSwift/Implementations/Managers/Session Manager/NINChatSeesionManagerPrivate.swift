@@ -4,31 +4,29 @@
 // license that can be found in the LICENSE file.
 //
 
-import UIKit
-import NinchatLowLevelClient
+import Foundation
 
 // MARK: - Private helper functions - delegates
 
 extension NINChatSessionManagerImpl {
-    internal func didFindRealmQueues(param: NINLowLevelClientProps) throws {
-        delegate?.log(value: "Realm queues found")
+    internal func didFindRealmQueues(param: ClientProps) throws {
+        delegate?.log(.session, "Realm queues found")
 
         let actionID = param.actionID
         do {
             if case let .failure(error) = param.realmQueue { throw error }
 
-            let queuesParser = NINChatClientPropsParser()
             let realmQueues = param.realmQueue.value
-            try realmQueues.accept(queuesParser)
-
-            self.queues.append(contentsOf: queuesParser.properties.keys.compactMap({ [weak self] key in
-                guard let `self` = self else { return nil }
-                
-                /// Add the queue only if it is not already available
-                guard !self.queues.contains(where: { $0.queueID == key } ) else { return nil }
-                
-                if let queue = try? realmQueues.getObject(key),
-                   case let .success(queueName) = queue.queueName,
+            realmQueues.keys.forEach { key in
+                let object: NINResult<ClientProps> = realmQueues.get(forKey: key)
+                guard let queue = object.optional else { return }
+
+                /// Known queues are updated in place
+                if self.queueRegistry.contains(key) {
+                    self.queueRegistry.update(queueID: key, position: queue.queuePosition.optional, isClosed: queue.queueClosed.optional)
+                    return
+                }
+                if case let .success(queueName) = queue.queueName,
                    case let .success(queueClosed) = queue.queueClosed,
                    case let .success(queueUploadPermission) = queue.queueUpload {
                     var target = Queue(
@@ -42,69 +40,73 @@ extension NINChatSessionManagerImpl {
                     if case let .success(queuePosition) = queue.queuePosition {
                         target.position = queuePosition
                     }
-                    return target
+                    self.queueRegistry.insert(target)
                 }
-                return nil
-            }))
+            }
 
             /// Form the list of audience queues; if audienceQueues is specified in siteConfig, we use those;
             /// if not, we use the complete list of queues.
-            if let audienceQueueIDs = self.siteConfiguration.audienceQueues {
-                self.audienceQueues = audienceQueueIDs.compactMap { [weak self] id in
-                    /// Returns the queue with given id
-                    self?.queues.filter({ $0.queueID == id }).compactMap({ $0 }).first
-                }
-            }
+            self.queueRegistry.audienceIDs = self.siteConfiguration.audienceQueues
             self.onActionID?(actionID, nil)
         } catch {
             self.onActionID?(actionID, error)
         }
     }
 
-    internal func didUpdateQueue(type: String, param: NINLowLevelClientProps) throws {
+    internal func didUpdateQueue(type: String, param: ClientProps) throws {
         if case let .failure(error) = param.queueID { throw error }
         let type = Events(rawValue: type)!
 
+        let queueID = param.queueID.value
+        let queuePosition = param.queuePosition, isClosed = param.queueClosed.optional
+
         func updateQueueClosures() throws {
-            guard let queue = self.queues.first(where: { $0.queueID == param.queueID.value }) else { throw NINSessionExceptions.noQueueFound }
+            /// 'queue_position' and 'queue_attrs' are optional, apply whatever the event carries
+            guard let queue = self.queueRegistry.update(queueID: queueID, position: queuePosition.optional, isClosed: isClosed) else { throw NINSessionExceptions.noQueueFound }
 
-            if case let .failure(error) = param.queuePosition {
-                self.queueUpdateBoundClosures.values.forEach({ $0(type, queue, error) }); return
+            if case let .failure(error) = queuePosition {
+                self.queueRegistry.notify(type, queue: queue, error: error); return
             }
-            let position = param.queuePosition.value
+            let position = queuePosition.value
             if type == .audienceEnqueued {
                 guard self.currentQueueID == nil else { throw NINSessionExceptions.hasActiveQueue }
 
                 self.currentQueueID = queue.queueID
-                self.queueUpdateBoundClosures.values.forEach({ $0(type, queue, nil) })
+                self.queueRegistry.notify(type, queue: queue, error: nil)
             }
             self.onProgress?(queue, position, type, nil)
         }
 
-        if self.queues.contains(where: { $0.queueID == param.queueID.value }) {
+        if self.queueRegistry.contains(queueID) {
             /// The queue is already described
             try updateQueueClosures()
         } else {
             /// First, we need to describe the queue to avoid issues like `https://github.com/somia/mobile/issues/216`
-            try self.describe(queuesID: [param.queueID.value]) { _ in
+            /// Unknown queues seen in a short window are described in one request
+            self.queueDescriber.request(queueID: queueID) { _ in
                 do {
                     try updateQueueClosures()
                 } catch {
-                    debugger(error.localizedDescription)
+                    logger.error(.event, error.localizedDescription)
                 }
             }
         }
     }
 
-    internal func didUpdateUser(param: NINLowLevelClientProps) throws {
+    internal func didUpdateUser(param: ClientProps) throws {
         guard self.currentChannelID != nil else { throw NINSessionExceptions.noActiveChannel }
         if case let .failure(error) = param.userID { throw error }
         if case let .failure(error) = param.userAttributes { throw error }
 
-        parse(userAttr: param.userAttributes.value, userID: param.userID.value)
+        /// The user's attributes are the same on every channel the user is a member of
+        let userID = param.userID.value
+        let channels = self.channels.all.filter { $0.members[userID] != nil }
+        (channels.isEmpty ? [self.channels.current] : channels).forEach {
+            self.parse(userAttr: param.userAttributes.value, userID: userID, in: $0)
+        }
     }
 
-    internal func didFindFile(param: NINLowLevelClientProps) throws {
+    internal func didFindFile(param: ClientProps) throws {
         if case let .failure(error) = param.fileURL { throw error }
         var fileInfoDictionary: [String:AnyHashable] = ["url": param.fileURL.value, "aspectRatio": 1, "urlExpiry": Date()]
 
@@ -123,49 +125,42 @@ extension NINChatSessionManagerImpl {
         self.onActionFileInfo?(param.actionID, fileInfoDictionary, nil)
     }
 
-    internal func didDeleteUser(param: NINLowLevelClientProps) throws {
+    internal func didDeleteUser(param: ClientProps) throws {
         if case let .failure(error) = param.userID { throw error }
 
         let userID = param.userID.value
         if userID == myUserID {
-            delegate?.log(value: "Current user deleted.")
+            delegate?.log(.session, "Current user deleted.")
         }
 
         self.onActionID?(param.actionID, nil)
     }
 
-    internal func didJoinChannel(param: NINLowLevelClientProps) throws {
+    internal func didJoinChannel(param: ClientProps) throws {
         guard currentQueueID != nil else { throw NINSessionExceptions.noActiveQueue }
         if case let .failure(error) = param.channelID { throw error }
 
         var message: String? = nil
+        let channel = self.channels.state(for: param.channelID.value)
 
         /// Extract the channel members' data
         if case let .failure(error) = param.channelMembers { throw error }
-        do {
-            let parser = NINChatClientPropsParser()
-            try param.channelMembers.value.accept(parser)
-            
-            parser.properties
-                    .compactMap({ dict in
-                        (dict.key, dict.value) as? (String,NINLowLevelClientProps)
-                    })
-                    .map({ key, value in
-                        (key, value.userAttributes.value)
-                    })
-                    .forEach({ [weak self] userID, attributes in
-                        self?.parse(userAttr: attributes, userID: userID)
-                    })
-        } catch {
-            debugger(error.localizedDescription)
-        }
+        let members = param.channelMembers.value
+        members.keys
+                .compactMap({ userID -> (String, ClientProps)? in
+                    let member: NINResult<ClientProps> = members.get(forKey: userID)
+                    return member.optional.map { (userID, $0) }
+                })
+                .map({ key, value in
+                    (key, value.userAttributes.value)
+                })
+                .forEach({ [weak self] userID, attributes in
+                    self?.parse(userAttr: attributes, userID: userID, in: channel)
+                })
 
         if case let .success(metadata) = param.channelAudienceMetadata {
-            if case let .success(answers) = metadata.preAnswers {
-                let parser = NINChatClientPropsParser()
-                try? answers.accept(parser)
-
-                message = parser.properties.first(where: { $0.key == "message" })?.value as? String
+            if case let .success(answers) = metadata.preAnswers, case let .string(text)? = answers["message"] {
+                message = text
             }
         }
 
@@ -182,33 +177,42 @@ extension NINChatSessionManagerImpl {
 
         /// Signal channel join event to the asynchronous listener
         self.onChannelJoined?()
+        self.prefetchJitsiCredentials()
     }
 
     internal func didJoinChannel(channelID: String, message: String?, _ audienceTransferred: Bool, _ channelClosed: Bool) throws {
-        delegate?.log(value: "Joined channel ID: \(channelID)")
+        delegate?.log(.session, "Joined channel ID: \(channelID)")
+        self.metrics.start(.firstMessage)
 
-        /// Set the currently active channel
+        /// Clear the messages of the previous channel,
+        /// if only it was successfully closed.
+        let previous = self.channels.current
+        if channelClosed {
+            _ = previous.takeBatch()
+            self.commit(notify: false, in: previous) { $0.removeAll() }
+            self.typingPresence.removeAll()
+        }
+
+        /// Set the currently active channel, and show it.
+        /// A channel joined after a transfer or a rejoin continues the conversation shown so far.
         self.currentChannelID = channelID
-        self.backgroundChannelID = nil
+        let shown = self.channels.activate(channelID: channelID, carryOver: !channelClosed)
+        if self.channels.current !== previous {
+            /// Typing follows the shown channel
+            self.typingPresence.removeAll()
+            let channel = self.channels.current
+            channel.writing.compactMap { channel.members[$0] }.forEach { self.typingPresence.update(user: $0, isWriting: true) }
+        }
+        if let shown = shown {
+            self.onMessagesChanged?(shown.snapshot, shown.diff)
+        }
 
         /// Get the queue we are joining
-        self.describedQueue = self.queues
-                .compactMap({ $0 })
-                .filter({ [weak self] queue in
-                    queue.queueID == self?.currentQueueID
-                })
-                .first
+        self.describedQueue = self.currentQueueID.flatMap { self.queueRegistry[$0] }
 
         /// We are no longer in the queue; clear the queue reference
         self.currentQueueID = nil
 
-        /// Clear current list of messages and users
-        /// If only the previous channel was successfully closed.
-        if channelClosed {
-            chatMessages.removeAll()
-            channelUsers.removeAll()
-        }
-
         /// Remove meta message related to channel closed if there are any
         if let metaMessage = self.chatMessages.first(where: { $0.messageID.contains("zzzzzzclose") }) {
             self.removeMessage(atIndex: 0)
@@ -224,128 +228,134 @@ extension NINChatSessionManagerImpl {
         }
     }
 
-    internal func didPartChannel(param: NINLowLevelClientProps) throws {
+    internal func didPartChannel(param: ClientProps) throws {
         if case let .failure(error) = param.channelID { throw error }
+        /// No more events are expected for the channel; the shown one is kept until another is joined
+        self.channels.remove(channelID: param.channelID.value)
         self.onActionChannel?(param.actionID, param.channelID.value)
     }
 
-    internal func didUpdateChannel(param: NINLowLevelClientProps) throws {
-        guard currentChannelID != nil || backgroundChannelID != nil else { throw NINSessionExceptions.noActiveChannel }
+    internal func didUpdateChannel(param: ClientProps) throws {
+        guard currentChannelID != nil || self.channels.count > 0 else { throw NINSessionExceptions.noActiveChannel }
         if case let .failure(error) = param.channelID { throw error }
 
         let channelID = param.channelID.value
-        guard channelID == currentChannelID || channelID == backgroundChannelID else {
-            debugger("Got channel_updated for wrong channel: \(channelID)"); return
+        guard let channel = self.channels[channelID] else {
+            logger.debug(.event, "Got channel_updated for unknown channel: \(channelID)"); return
         }
 
-        if case let .success(isGroup) = param.channelIsGroup {
+        if case let .success(isGroup) = param.channelIsGroup, channel === self.channels.current {
             isGroupVideoChannel = isGroup
+            self.prefetchJitsiCredentials()
         }
 
         /// In case of "channel transfer", the corresponded function: "didPartChannel(param:)" is called after this function.
         /// Thus, We will send meta message only if the channel was actually closed, not parted.
+        let isClosed = param.channelClosed.value || param.channelSuspended.value
         DispatchQueue.main.asyncAfter(deadline: .now() + 1.0) { [weak self] in
             guard let `self` = self else { return }
-            guard param.channelClosed.value || param.channelSuspended.value else { return }
+            guard isClosed else { return }
 
             let text = self.translate(key: Constants.kConversationEnded.rawValue, formatParams: [:])
             let closeTitle = self.translate(key: Constants.kCloseChatText.rawValue, formatParams: [:])
-            self.add(message: MetaMessage(timestamp: Date(), messageID: "zzzzzzclose\(channelID)", text: text ?? "", closeChatButtonTitle: closeTitle))
+            self.add(message: MetaMessage(timestamp: Date(), messageID: "zzzzzzclose\(channelID)", text: text ?? "", closeChatButtonTitle: closeTitle), to: channel)
+
+            /// A channel closed in the background, e.g. the one the audience was transferred from, does not end the chat
+            guard channel === self.channels.current else { return }
+            self.typingPresence.removeAll()
             self.onChannelClosed?()
         }
     }
 
-    internal func didFindChannel(param: NINLowLevelClientProps) throws {
+    internal func didFindChannel(param: ClientProps) throws {
         if case let .failure(error) = param.channelID { throw error }
         guard param.channelID.value == self.currentChannelID else { throw NINSessionExceptions.noActiveChannel }
+        let channel = self.channels.state(for: param.channelID.value)
 
         if case let .success(isGroup) = param.channelIsGroup {
             isGroupVideoChannel = isGroup
         }
 
         if case let .failure(error) = param.channelMembers { throw error }
-        let memberParser = NINChatClientPropsParser()
-        try param.channelMembers.value.accept(memberParser)
-
-        memberParser.properties.keys.forEach { [weak self] userID in
-            if let member = memberParser.properties[userID] as? NINLowLevelClientProps, case let .success(attributes) = member.userAttributes {
-                self?.parse(userAttr: attributes, userID: userID)
+        let members = param.channelMembers.value
+        members.keys.forEach { [weak self] userID in
+            let member: NINResult<ClientProps> = members.get(forKey: userID)
+            if case let .success(attributes) = member.optional?.userAttributes {
+                self?.parse(userAttr: attributes, userID: userID, in: channel)
             }
         }
         self.onActionID?(param.actionID, nil)
     }
 
     /// Processes the response to the WebRTC connectivity ICE query
-    internal func didBeginICE(param: NINLowLevelClientProps) throws {
+    internal func didBeginICE(param: ClientProps) throws {
 
         /// Parse the STUN server list
         if case let .failure(error) = param.stunServers { throw error }
-        let stunServersParam = param.stunServers.value
-        let stunServers = try [Int](0..<stunServersParam.length()).map({ index -> NINLowLevelClientProps in
-            stunServersParam.get(index)!
-        }).compactMap({ prop -> NINLowLevelClientStrings in
+        let stunServers = try param.stunServers.value.map({ prop -> [String] in
             if case let .failure(error) = prop.serversURL { throw error }
             return prop.serversURL.value
-        }).compactMap({ servers -> ([Int], NINLowLevelClientStrings) in
-            ([Int](0..<servers.length()), servers)
-        }).map({ (indexArray, serversArray) -> [WebRTCServerInfo] in
-            indexArray.map { WebRTCServerInfo(url: serversArray.get($0), username: nil, credential: nil) }
+        }).map({ servers -> [WebRTCServerInfo] in
+            servers.map { WebRTCServerInfo(url: $0, username: nil, credential: nil) }
         }).reduce([], +)
 
 
         /// Parse the TURN server list
         if case let .failure(error) = param.turnServers { throw error }
-        let turnServersParam = param.turnServers.value
-        let turnServers = try [Int](0..<turnServersParam.length()).map({ index -> NINLowLevelClientProps in
-            turnServersParam.get(index)!
-        }).compactMap({ prop -> (NINLowLevelClientStrings, String, String) in
+        let turnServers = try param.turnServers.value.map({ prop -> ([String], String, String) in
             if case let .failure(error) = prop.serversURL { throw error }
             if case let .failure(error) = prop.usernameTurnServer { throw error }
             if case let .failure(error) = prop.credentialsTurnServer { throw error }
 
             return (prop.serversURL.value, prop.usernameTurnServer.value, prop.credentialsTurnServer.value)
-        }).compactMap({ (servers, userName, credential) -> ([Int], NINLowLevelClientStrings, String, String) in
-            ([Int](0..<servers.length()), servers, userName, credential)
-        }).map({ (indexArray, serversArray, userName, credential) -> [WebRTCServerInfo] in
-            indexArray.map { WebRTCServerInfo(url: serversArray.get($0), username: userName, credential: credential) }
+        }).map({ (servers, userName, credential) -> [WebRTCServerInfo] in
+            servers.map { WebRTCServerInfo(url: $0, username: userName, credential: credential) }
         }).reduce([], +)
 
         self.onActionSevers?(param.actionID, stunServers, turnServers)
     }
 
-    internal func didLoadHistory(param: NINLowLevelClientProps) throws {
+    internal func didLoadHistory(param: ClientProps) throws {
         if case let .failure(error) = param.historyLength { throw error }
         if param.historyLength.value > 0 {
-            self.expectedHistoryLength = param.historyLength.value
+            self.channel(of: param)?.expectedHistoryLength = param.historyLength.value
+        } else {
+            /// An empty history, no messages follow
+            self.metrics.end(.historyLoad)
         }
     }
 
-    internal func didReceiveMessage(param: NINLowLevelClientProps, payload: NINLowLevelClientPayload) throws {
+    internal func didReceiveMessage(param: ClientProps, payload: ClientPayload) throws {
         try didGetMessage(param: param, payload: payload, update: false)
     }
 
-    internal func didUpdateMessage(param: NINLowLevelClientProps, payload: NINLowLevelClientPayload) throws {
+    internal func didUpdateMessage(param: ClientProps, payload: ClientPayload) throws {
         try didGetMessage(param: param, payload: payload, update: true)
     }
 
-    private func didGetMessage(param: NINLowLevelClientProps, payload: NINLowLevelClientPayload, update: Bool) throws {
+    private func didGetMessage(param: ClientProps, payload: ClientPayload, update: Bool) throws {
         if case let .failure(error) = param.messageType { throw error }
-        debugger("\(update ? "Updated" : "Received") message of type \(String(describing: param.messageType.value))")
+        logger.debug(.event, "\(update ? "Updated" : "Received") message of type \(String(describing: param.messageType.value))")
 
         /// handle transfers
         if param.messageType.value == .part {
             try self.handlePart(param: param, payload: payload); return
         }
         
-        guard currentChannelID != nil || backgroundChannelID != nil else { throw NINSessionExceptions.noActiveChannel }
+        guard currentChannelID != nil || self.channels.count > 0 else { throw NINSessionExceptions.noActiveChannel }
         if case let .failure(error) = param.actionID { throw error }
         let actionID = param.actionID
+        guard let channel = self.channel(of: param) else {
+            /// The action was answered, even though its channel is gone
+            if actionID.value != 0 { self.onActionID?(actionID, nil) }
+            return
+        }
 
         do {
             if update {
-                try self.handleUpdate(param: param, actionID: actionID.value, payload: payload)
+                try self.handleUpdate(param: param, actionID: actionID.value, payload: payload, in: channel)
             } else {
-                try self.handleInbound(param: param, actionID: actionID.value, payload: payload)
+                try self.handleInbound(param: param, actionID: actionID.value, payload: payload, in: channel)
             }
             if actionID.value != 0 { self.onActionID?(actionID, nil) }
         } catch {
@@ -353,36 +363,31 @@ extension NINChatSessionManagerImpl {
         }
     }
 
-    internal func didUpdateMember(param: NINLowLevelClientProps) throws {
+    internal func didUpdateMember(param: ClientProps) throws {
         if case let .failure(error) = param.channelID { throw error }
 
         let actionID = param.actionID
         do {
             let channelID = param.channelID.value
-            guard channelID == currentChannelID || channelID == backgroundChannelID else {
-                self.delegate?.log(value: "Error: Got event for wrong channel: \(channelID)"); return
+            guard let channel = self.channels[channelID] else {
+                self.delegate?.log(.event, "Got event for unknown channel: \(channelID)", level: .error); return
             }
 
             if case let .failure(error) = param.userID { throw error }
             let userID = param.userID.value
-            guard let messageUser = channelUsers[userID] else {
-                self.delegate?.log(value: "Update from unknown user: \(userID)"); return
+            guard let messageUser = channel.members[userID] else {
+                self.delegate?.log(.event, "Update from unknown user: \(userID)"); return
             }
             
             if userID != myUserID {
                 if case let .failure(error) = param.channelMemberAttributes { throw error }
                 if case let .failure(error) = param.channelMemberAttributes.value.writing { throw error }
                 let isWriting = param.channelMemberAttributes.value.writing.value
+                if isWriting { channel.writing.insert(userID) } else { channel.writing.remove(userID) }
 
-                /// Check if that user already has a 'writing' message
-                let writingMessage = chatMessages.first(where: { ($0 as? UserTypingMessage)?.user?.userID == userID }) as? UserTypingMessage
-                if isWriting, writingMessage == nil {
-                    /// There's no 'typing' message for this user yet, lets create one
-                    /// The value for message id is inspired from the Android SDK
-                    self.add(message: UserTypingMessage(timestamp: Date(), messageID: "zzzzzwriting\(userID)", user: messageUser))
-                } else if writingMessage != nil, let index = chatMessages.firstIndex(where: { $0 is UserTypingMessage }) {
-                    /// There's a 'typing' message for this user - lets remove that.
-                    self.removeMessage(atIndex: index)
+                /// Typing is shown as an overlay for the shown channel, it does not go through the messages
+                if channel === self.channels.current {
+                    self.typingPresence.update(user: messageUser, isWriting: isWriting)
                 }
             }
             
@@ -392,11 +397,27 @@ extension NINChatSessionManagerImpl {
         }
     }
 
-    internal func didRegisterAudience(param: NINLowLevelClientProps) throws {
+    internal func didRegisterAudience(param: ClientProps) throws {
         self.onActionID?(param.actionID, param.error)
     }
 
-    internal func didDiscoverJitsi(param: NINLowLevelClientProps) throws {
+    /// The state of the event's channel; events that name no channel belong to the shown one.
+    /// States are created only when a channel is joined or found, so late events of a parted channel are dropped.
+    internal func channel(of param: ClientProps) -> ChannelState? {
+        guard case let .success(channelID) = param.channelID, !channelID.isEmpty else { return self.channels.current }
+        guard let channel = self.channels[channelID] else {
+            self.delegate?.log(.event, "Got event for unknown channel: \(channelID)", level: .error); return nil
+        }
+        return channel
+    }
+
+    /// Discover the meeting credentials while the user has not yet decided to join
+    internal func prefetchJitsiCredentials() {
+        guard self.isGroupVideoChannel == true else { return }
+        self.jitsiDiscovery.prefetch()
+    }
+
+    internal func didDiscoverJitsi(param: ClientProps) throws {
         if case let .success(room) = param.jitsiRoom, case let .success(token) = param.jitsiToken {
             self.onActionJitsiDiscovered?(param.actionID, .success((room: room, token: token)))
         } else {
@@ -411,7 +432,7 @@ extension NINChatSessionManagerImpl {
     /// Deletes the current user.
     internal func deleteCurrentUser(completion: @escaping (Error?) -> Void) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
-        let param = NINLowLevelClientProps.initiate(action: .deleteUser)
+        let param = ClientProps.initiate(action: .deleteUser)
         
         do {
             let actionID = try session.send(param)
@@ -421,67 +442,144 @@ extension NINChatSessionManagerImpl {
         }
     }
     
-    internal func add<T: ChatMessage>(message: T, remained: NINResult<Int>? = .success(0)) {
-        /// Guard against the same message getting added multiple times
-
-        debugger("trying to add the message: \(message.messageID)")
-        if self.chatMessages.contains(where: { $0.messageID == message.messageID }) { return }
-        self.chatMessages.insert(message, at: 0)
-
-        defer {
-            /// Apply Compose Actions if there is any associated one AND the history is loaded completely
-            if self.expectedHistoryLength == -1, self.composeActions.count > 0 {
-                self.composeActions.forEach { [weak self] action in
-                    self?.addCompose(action: action)
-                }
-            }
+    /// Adds the message to the channel's messages; the views are notified only for the shown channel
+    @discardableResult
+    internal func add<T: ChatMessage>(message: T, remained: NINResult<Int>? = .success(0), to channel: ChannelState? = nil) -> Bool {
+        let channel = channel ?? self.channels.current
+        let isShown = channel === self.channels.current
+        self.eventTracer.mark(.decoded)
+        logger.debug(.event, "Trying to add the message: \(message.messageID)")
+        /// The last message of a batch completes it, as long as no history is expected
+        let endsBatch: Bool
+        if case let .success(length) = remained { endsBatch = channel.expectedHistoryLength <= 0 && length == 0 } else { endsBatch = false }
+        if channel.contains(messageID: message.messageID) {
+            /// A batch may end with a message that is already known
+            if endsBatch { self.publishBatch(in: channel) }
+            return false
         }
+        self.metrics.end(.firstMessage)
 
-        debugger("expected history length: \(self.expectedHistoryLength)")
-        debugger("current messages: \(self.chatMessages.filter({ $0 is ChannelMessage }).count)")
+        let channelMessages = channel.channelMessageCount + ((message is ChannelMessage) ? 1 : 0)
+        logger.debug(.event, "Expected history length: \(channel.expectedHistoryLength), current messages: \(channelMessages)")
 
-        if self.expectedHistoryLength > 0, self.expectedHistoryLength <= self.chatMessages.filter({ $0 is ChannelMessage }).count {
+        if channel.expectedHistoryLength > 0, channel.expectedHistoryLength <= channelMessages {
             /// We are loading a history that needs to `reload` corresponded chat view
-            self.chatMessages = self.sortAndMap()
-            self.onHistoryLoaded?(self.expectedHistoryLength)
-            self.expectedHistoryLength = -1
-            debugger("history loaded")
-        } else if expectedHistoryLength <= 0, case let .success(length) = remained, length == 0 {
+            let batch = channel.takeBatch()
+            self.commit(in: channel) { $0 = self.sortAndMap([message] + batch + $0) }
+            if isShown { self.onHistoryLoaded?(channel.expectedHistoryLength) }
+            channel.expectedHistoryLength = -1
+            self.metrics.end(.historyLoad)
+            logger.debug(.event, "History loaded")
+        } else if endsBatch {
             /// We are not waiting for a history result
             /// Thus, we will update the view with the index of received message
-            self.chatMessages = self.sortAndMap()
-            self.onMessageAdded?(chatMessages.firstIndex(where: { $0.messageID == message.messageID }) ?? -1)
-            debugger("message added")
+            let batch = channel.takeBatch()
+            let snapshot = self.commit(in: channel) { $0 = self.sortAndMap([message] + batch + $0) }
+            if isShown { self.onMessageAdded?(snapshot.messages.firstIndex(where: { $0.messageID == message.messageID }) ?? -1) }
+            logger.debug(.event, "Message added")
+        } else {
+            /// The rest of the batch is on its way; it is published at once, so the batch is sorted and diffed once
+            channel.hold(message)
+            if channel.batchDeadline == nil { self.scheduleBatchDeadline(in: channel) }
         }
+        return true
     }
 
-    internal func addCompose(action: ComposeUIAction) {
-        /// Check if the corresponded message is already added
-        if let composeMessage = self.chatMessages.compactMap({ $0 as? ComposeMessage }).first(where: { $0.content.contains(action.target) }) {
-            self.applyCompose(action: action, to: composeMessage)
+    /// Publishes the messages held for a batch, ahead of another change to the published messages
+    internal func publishBatch(in channel: ChannelState) {
+        guard channel.hasPendingBatch else { return }
+
+        let batch = channel.takeBatch()
+        self.commit(in: channel) { $0 = self.sortAndMap(batch + $0) }
+    }
+
+    /// Publishes the messages held for a batch whose last message is not going to arrive, e.g. after an
+    /// error, and stops waiting for the rest of the history
+    internal func flushBatch(in channel: ChannelState) {
+        guard channel.hasPendingBatch else { return }
+
+        logger.debug(.event, "Publishing an incomplete batch")
+        self.publishBatch(in: channel)
+        if channel.expectedHistoryLength > 0 {
+            channel.expectedHistoryLength = -1
+            if channel === self.channels.current { self.onHistoryLoaded?(channel.snapshot.messages.count) }
         }
-        /// Add the action to a list waiting to get the corresponded compose message later
-        else {
-            /// Guard against the same compose action getting added multiple times
-            if self.composeActions.contains(where: { $0.target == action.target }) { return }
-            self.composeActions.append(action)
+    }
+
+    /// Checks for the batch's progress once `batchTimeout` has passed since the last held message
+    private func scheduleBatchDeadline(in channel: ChannelState, after delay: TimeInterval? = nil) {
+        let workItem = DispatchWorkItem { [weak self, weak channel] in
+            guard let self = self, let channel = channel, channel.hasPendingBatch else { return }
+
+            let idle = Double(DispatchTime.now().uptimeNanoseconds - channel.lastHeldAt.uptimeNanoseconds) / 1_000_000_000
+            if idle < self.batchTimeout {
+                self.scheduleBatchDeadline(in: channel, after: self.batchTimeout - idle)
+            } else {
+                self.flushBatch(in: channel)
+            }
+        }
+        channel.batchDeadline = workItem
+        DispatchQueue.main.asyncAfter(deadline: .now() + (delay ?? self.batchTimeout), execute: workItem)
+    }
+
+    /// Publishes a new version of the channel's messages, and notifies the views with its diff
+    /// if `notify` is set and the channel is the shown one.
+    /// Compose actions that were waiting for an added compose message are applied afterwards.
+    @discardableResult
+    internal func commit(updated ids: Set<String> = [], notify: Bool = true, in channel: ChannelState? = nil, _ transform: (inout [ChatMessage]) -> Void) -> ChatSnapshot {
+        let channel = channel ?? self.channels.current
+        /// A batch still held is published first, so it is not left behind the change
+        self.publishBatch(in: channel)
+
+        let previous = channel.snapshot
+        let (snapshot, diff) = channel.messageStore.update(updated: ids, transform)
+        if self.channels.indexesMessages {
+            channel.searchIndex.apply(diff, from: previous, to: snapshot)
+        }
+        let matches = channel.compose.apply(diff, from: previous, to: snapshot)
+        if notify, !diff.isEmpty, channel === self.channels.current {
+            self.eventTracer.committed(version: snapshot.version)
+            self.onMessagesChanged?(snapshot, diff)
         }
+        matches.forEach { self.applyCompose(action: $0.action, to: $0.messageID, in: channel) }
+        return snapshot
     }
 
-    internal func applyCompose(action: ComposeUIAction, to message: ComposeMessage) {
+    /// Refreshes an already added message once its attachment is described
+    internal func didDescribeAttachment(messageID: String, in channel: ChannelState? = nil) {
+        let channel = channel ?? self.channels.current
+        /// A pending history result reloads the whole view anyway
+        guard channel.expectedHistoryLength <= 0 else { return }
+        self.publishBatch(in: channel)
+        guard let index = channel.snapshot.messages.firstIndex(where: { $0.messageID == messageID }) else { return }
+
+        self.commit(updated: [messageID], in: channel) { _ in }
+        if channel === self.channels.current { self.onMessageUpdated?(index) }
+    }
+
+    internal func addCompose(action: ComposeUIAction, in channel: ChannelState? = nil) {
+        /// Apply the action if the corresponded message is already added,
+        /// otherwise it waits for the message, see `commit(updated:notify:in:_:)`
+        let channel = channel ?? self.channels.current
+        guard let messageID = channel.compose.match(action) else { return }
+        self.applyCompose(action: action, to: messageID, in: channel)
+    }
+
+    /// Only the actions of the shown channel reach the views
+    internal func applyCompose(action: ComposeUIAction, to messageID: String, in channel: ChannelState) {
+        guard channel === self.channels.current else { return }
         /// use message id instead of index, as the index for the last message is always 0
-        self.onComposeActionUpdated?(message.messageID, action)
-        self.composeActions.removeAll(where: { $0.target == action.target })
+        self.onComposeActionUpdated?(messageID, action)
     }
     
     internal func removeMessage(atIndex index: Int) {
-        chatMessages.remove(at: index)
+        self.commit { $0.remove(at: index) }
         self.onMessageRemoved?(index)
     }
     
     internal func part(channel ID: String, completion: @escaping CompletionWithError) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
-        let param = NINLowLevelClientProps.initiate(action: .partChannel)
+        var param = ClientProps.initiate(action: .partChannel)
         param.channelID = .success(ID)
         
         do {
@@ -493,13 +591,13 @@ extension NINChatSessionManagerImpl {
     }
     
     internal func disconnect() {
-        self.delegate?.log(value: "disconnect: Closing Ninchat session.")
+        self.delegate?.log(.session, "Disconnect: Closing Ninchat session.")
 
         self.session?.close()
         self.session = nil
     }
 
-    internal func parse(userAttr: NINLowLevelUserProps, userID: String) {
+    internal func parse(userAttr: NINLowLevelUserProps, userID: String, in channel: ChannelState? = nil) {
         /// TODO: Add result checking for attributes to avoid fatal error
 
         var info: ChannelUserInfo?
@@ -513,17 +611,18 @@ extension NINChatSessionManagerImpl {
                 iconURL: userAttr.iconURL.value,
                 guest: userAttr.isGuest.value,
                 info: info)
-        self.channelUsers[userID] = user
+        let channel = channel ?? self.channels.current
+        channel.members[userID] = user
 
         if userID != self.myUserID {
-            self.agent = user
+            channel.agent = user
         }
     }
 
-    internal func sortAndMap() -> [ChatMessage] {
-        self.chatMessages.sort { $0.messageID > $1.messageID }
-        return self.chatMessages.map { [weak self] message in
-            if var msg = message as? ChannelMessage, let msgIndex = self?.chatMessages.firstIndex(where: { $0.messageID == msg.messageID }), msgIndex < (self?.chatMessages.count ?? 0) - 1, let prevMsg = self?.chatMessages[msgIndex + 1] as? ChannelMessage {
+    internal func sortAndMap(_ messages: [ChatMessage]) -> [ChatMessage] {
+        let sorted = messages.sorted { $0.messageID > $1.messageID }
+        return sorted.enumerated().map { msgIndex, message in
+            if var msg = message as? ChannelMessage, msgIndex < sorted.count - 1, let prevMsg = sorted[msgIndex + 1] as? ChannelMessage {
                 let prevTextMsg = prevMsg as? TextMessage
                 let textMsg = msg as? TextMessage
                 let bothFromSameUser = msg.sender?.userID == prevMsg.sender?.userID
@@ -545,69 +644,57 @@ extension NINChatSessionManagerImpl {
     }
 
     /** Determines if it is possible to resume the session in case it is still alive. */
-    internal func canResumeSession(param: NINLowLevelClientProps) -> Bool {
+    internal func canResumeSession(param: ClientProps) -> Bool {
         if case .failure = param.channels { return false }
         let userChannels = param.channels.value
 
-        do {
-            let parser = NINChatClientPropsParser()
-            try userChannels.accept(parser)
-            parser.properties.keys.forEach {
-                let channel: NINResult<NINLowLevelClientProps> = userChannels.get(forKey: $0)
-                if case .failure = channel { return }
-
-                /// Extract target channel
-                if case .failure = channel.value.channelClosed { return }
-                if !channel.value.channelClosed.value {
-                    self.currentChannelID = $0
-
-                    /// Extract target queue
-                    if case .failure = channel.value.channelAttributes { return}
-                    if case .failure = channel.value.channelAttributes.value.queueID { return }
-                    self.currentQueueID = channel.value.channelAttributes.value.queueID.value
-                }
+        userChannels.keys.forEach {
+            let channel: NINResult<ClientProps> = userChannels.get(forKey: $0)
+            if case .failure = channel { return }
 
-                /// Extract target realm
-                if case .failure = channel.value.realmID { return }
-                self.realmID = channel.value.realmID.value
+            /// Extract target channel
+            if case .failure = channel.value.channelClosed { return }
+            if !channel.value.channelClosed.value {
+                self.currentChannelID = $0
+
+                /// Extract target queue
+                if case .failure = channel.value.channelAttributes { return}
+                if case .failure = channel.value.channelAttributes.value.queueID { return }
+                self.currentQueueID = channel.value.channelAttributes.value.queueID.value
             }
 
-            /// Check if target queue and target channels are found
-            return self.currentChannelID != nil && self.currentQueueID != nil && self.realmID != nil
-        } catch {
-            return false
+            /// Extract target realm
+            if case .failure = channel.value.realmID { return }
+            self.realmID = channel.value.realmID.value
         }
+
+        /// Check if target queue and target channels are found
+        return self.currentChannelID != nil && self.currentQueueID != nil && self.realmID != nil
     }
 
     /** Determines if the user is waiting to join a queue. */
     internal func userWaitingInQueue(param: NINLowLevelQueueProps) -> Bool {
         if case .failure = param.userQueues { return false }
         let userQueues = param.userQueues.value
-        do {
-            let parser = NINChatClientPropsParser()
-            try userQueues.accept(parser)
-            parser.properties.keys.forEach {
-                let queue: NINResult<NINLowLevelClientProps> = userQueues.get(forKey: $0)
-                if case .failure = queue { return }
-
-                /// Check position in the queue
-                if case .failure = queue.value.queuePosition { return }
-                if queue.value.queuePosition.value > 0 {
-                    self.currentQueueID = $0
-                }
+        userQueues.keys.forEach {
+            let queue: NINResult<ClientProps> = userQueues.get(forKey: $0)
+            if case .failure = queue { return }
+
+            /// Check position in the queue
+            if case .failure = queue.value.queuePosition { return }
+            if queue.value.queuePosition.value > 0 {
+                self.currentQueueID = $0
             }
-
-            return self.currentQueueID != nil && self.realmID != nil
-        } catch {
-            return false
         }
+
+        return self.currentQueueID != nil && self.realmID != nil
     }
 }
 
 // MARK: - Private helper functions - handlers
 
 extension NINChatSessionManagerImpl {
-    internal func handleInbound(param: NINLowLevelClientProps, actionID: Int, payload: NINLowLevelClientPayload) throws {
+    internal func handleInbound(param: ClientProps, actionID: Int, payload: ClientPayload, in channel: ChannelState? = nil) throws {
         if case let .failure(error) = param.messageID { throw error }
         if case let .failure(error) = param.messageUserID { throw error }
         if case let .failure(error) = param.messageTime { throw error }
@@ -616,10 +703,11 @@ extension NINChatSessionManagerImpl {
         let messageID = param.messageID.value
         let messageUserID = param.messageUserID.value
         let messageTime = param.messageTime.value
-        let messageUser = self.channelUsers[messageUserID]
+        let channel = channel ?? self.channels.current
+        let messageUser = channel.members[messageUserID]
 
         func adjustHistoryLength() {
-            if self.expectedHistoryLength > 0 { self.expectedHistoryLength -= 1 }
+            if channel.expectedHistoryLength > 0 { channel.expectedHistoryLength -= 1 }
         }
 
         guard let messageType = param.messageType.value else { return }
@@ -628,43 +716,46 @@ extension NINChatSessionManagerImpl {
             try self.handleRTCSignal(type: messageType, user: messageUser, actionID: actionID, payload: payload)
         case .text, .file:
             if case .success(true) = param.isMessageDeleted {
-                self.handleDeleted(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload)
+                self.handleDeleted(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload, in: channel)
             } else {
-                try self.handleInbound(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload)
+                try self.handleInbound(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload, in: channel)
             }
         case .compose:
-            try self.handleCompose(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload)
+            try self.handleCompose(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload, in: channel)
         case .channel:
             try self.handleChannel(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload)
         case .uiAction:
-            try self.handleUIAction(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload)
+            try self.handleUIAction(message: messageID, user: messageUser, time: messageTime, actionID: actionID, remained: param.historyLength, payload: payload, in: channel)
             adjustHistoryLength()
         default:
-            debugger("Ignoring unsupported message type: \(messageType.rawValue)")
+            logger.debug(.event, "Ignoring unsupported message type: \(messageType.rawValue)")
             adjustHistoryLength()
         }
 
     }
 
-    internal func handleUpdate(param: NINLowLevelClientProps, actionID: Int, payload: NINLowLevelClientPayload) throws {
+    internal func handleUpdate(param: ClientProps, actionID: Int, payload: ClientPayload, in channel: ChannelState? = nil) throws {
         if case let .failure(error) = param.messageID { throw error }
         let messageID = param.messageID.value
+        let channel = channel ?? self.channels.current
+        self.publishBatch(in: channel)
+        let messages = channel.snapshot.messages
         guard
             case let .success(isMessageDeleted) = param.isMessageDeleted,
-            let messageIdx = self.chatMessages.firstIndex(where: { $0.messageID == messageID }),
-            var message = self.chatMessages[messageIdx] as? TextMessage
+            let messageIdx = messages.firstIndex(where: { $0.messageID == messageID }),
+            var message = messages[messageIdx] as? TextMessage
         else {
             return
         }
         message.isDeleted = isMessageDeleted
-        self.chatMessages[messageIdx] = message
-        self.onMessageUpdated?(messageIdx)
+        self.commit(in: channel) { $0[messageIdx] = message }
+        if channel === self.channels.current { self.onMessageUpdated?(messageIdx) }
     }
 
-    internal func handleRTCSignal(type: MessageType, user: ChannelUser?, actionID: Int, payload: NINLowLevelClientPayload) throws {
+    internal func handleRTCSignal(type: MessageType, user: ChannelUser?, actionID: Int, payload: ClientPayload) throws {
         /// This message originates from me; we can ignore it.
         if actionID != 0 { return }
-        try [Int](0..<payload.length()).decodeAndPerform(onPayload: payload, type: RTCSignal.self) { [weak self] (signal: RTCSignal) in
+        try payload.decodeAndPerform(type: RTCSignal.self) { [weak self] (signal: RTCSignal) in
             if  [.offer, .call, .pickup, .hangup].filter({ $0 == type }).count > 0 {
                 self?.onRTCSignal?(type, user, signal)
             } else if [.candidate, .answer].filter({ $0 == type }).count > 0 {
@@ -673,65 +764,70 @@ extension NINChatSessionManagerImpl {
         }
     }
 
-    internal func handleDeleted(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: NINLowLevelClientPayload) {
-        self.add(message: TextMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self.myUserID, sender: user, content: nil, attachment: nil, isDeleted: true), remained: remained)
+    internal func handleDeleted(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: ClientPayload, in channel: ChannelState? = nil) {
+        self.add(message: TextMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self.myUserID, sender: user, content: nil, attachment: nil, isDeleted: true), remained: remained, to: channel)
     }
 
-    internal func handleInbound(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: NINLowLevelClientPayload) throws {
-        try [Int](0..<payload.length()).decodeAndPerform(onPayload: payload, type: ChatMessagePayload.self) { [weak self] (message: ChatMessagePayload) in
-            debugger("Received Chat message with payload: \(message)")
+    internal func handleInbound(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: ClientPayload, in channel: ChannelState? = nil) throws {
+        try payload.decodeAndPerform(type: ChatMessagePayload.self) { [weak self] (message: ChatMessagePayload) in
+            logger.debug(.event, "Received Chat message with payload: \(message)")
             var hasAttachment = false
             if let files = message.files, files.count > 0 {
                 files.forEach { [weak self] file in
-                    self?.delegate?.log(value: "Got file with MIME type: \(String(describing: file.attributes.type))")
-                    let fileInfo = FileInfo(fileID: file.id, name: file.attributes.name, mimeType: file.attributes.type, size: file.attributes.size)
+                    self?.delegate?.log(.event, "Got file with MIME type: \(String(describing: file.attributes.type))")
+                    let fileInfo = FileInfo(fileID: file.id, name: file.attributes.name, mimeType: file.attributes.type, size: file.attributes.size, aspectRatio: file.attributes.thumbnail?.aspectRatio)
                     hasAttachment = fileInfo.isImage || fileInfo.isVideo || fileInfo.isPDF
 
                     /// Only process certain files at this point
                     guard hasAttachment else { return }
+
+                    /// Add the message as a placeholder right away, so neither the history nor
+                    /// the order of messages waits for `describe_file` to complete.
+                    guard self?.add(message: TextMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self?.myUserID, sender: user, content: nil, attachment: fileInfo), remained: remained, to: channel) ?? false else { return }
                     fileInfo.updateInfo(session: self) { [weak self] error, didRefreshNetwork in
-                        guard error == nil else { return }
-                        self?.add(message: TextMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self?.myUserID, sender: user, content: nil, attachment: fileInfo), remained: remained)
+                        guard error == nil, didRefreshNetwork else { return }
+                        self?.didDescribeAttachment(messageID: id, in: channel)
                     }
                 }
             }
 
             /// Only allocate a new message now if there is text and no attachment
             if let text = message.text, !text.isEmpty, !hasAttachment {
-                self?.add(message: TextMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self?.myUserID, sender: user, content: text, attachment: nil), remained: remained)
+                self?.add(message: TextMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self?.myUserID, sender: user, content: text, attachment: nil), remained: remained, to: channel)
             }
         }
     }
     
-    internal func handleChannel(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: NINLowLevelClientPayload) throws {
-        try [Int](0..<payload.length()).decodeAndPerform(onPayload: payload, type: ChatChannelPayload.self) { (channel: ChatChannelPayload) in
-            debugger("Received a Channel message with payload: \(channel)")
+    internal func handleChannel(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: ClientPayload) throws {
+        try payload.decodeAndPerform(type: ChatChannelPayload.self) { (channel: ChatChannelPayload) in
+            logger.debug(.event, "Received a Channel message with payload: \(channel)")
         }
     }
     
-    internal func handleCompose(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: NINLowLevelClientPayload) throws {
-        try [Int](0..<payload.length()).decodeAndPerform(onPayload: payload, type: [ComposeContent].self) { [weak self] (compose: [ComposeContent]) in
-            debugger("Received Compose message with payload: \(compose)")
+    internal func handleCompose(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: ClientPayload, in channel: ChannelState? = nil) throws {
+        try payload.decodeAndPerform(type: [ComposeContent].self) { [weak self] (compose: [ComposeContent]) in
+            logger.debug(.event, "Received Compose message with payload: \(compose)")
             guard compose.filter({ $0.element != .button && $0.element != .select }).count == 0 else {
-                debugger("Found ui/compose object with unhandled element, discarding message"); return
+                logger.debug(.event, "Found ui/compose object with unhandled element, discarding message"); return
             }
-            self?.add(message: ComposeMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self?.myUserID, sender: user, content: compose), remained: remained)
+            self?.add(message: ComposeMessage(timestamp: Date(timeIntervalSince1970: time), messageID: id, mine: user?.userID == self?.myUserID, sender: user, content: compose), remained: remained, to: channel)
         }
     }
 
-    internal func handleUIAction(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: NINLowLevelClientPayload) throws {
-        try [Int](0..<payload.length()).decodeAndPerform(onPayload: payload, type: ComposeUIAction.self) { [weak self] (action: ComposeUIAction) in
-            self?.addCompose(action: action)
+    internal func handleUIAction(message id: String, user: ChannelUser?, time: Double, actionID: Int, remained: NINResult<Int>, payload: ClientPayload, in channel: ChannelState? = nil) throws {
+        try payload.decodeAndPerform(type: ComposeUIAction.self) { [weak self] (action: ComposeUIAction) in
+            self?.addCompose(action: action, in: channel)
         }
     }
 
-    internal func handlePart(param: NINLowLevelClientProps, payload: NINLowLevelClientPayload) throws {
-        debugger("Received a Part message with payload: \(payload)")
+    internal func handlePart(param: ClientProps, payload: ClientPayload) throws {
+        logger.debug(.event, "Received a Part message with payload: \(payload)")
     }
 
-    @objc
-    internal func handleError(param: NINLowLevelClientProps) throws {
-        debugger.error(param.error as? NinchatError)
+    internal func handleError(param: ClientProps) throws {
+        logger.error(.event, param.error as? NinchatError)
+        /// The rest of a batch may never arrive
+        self.channels.all.forEach { self.flushBatch(in: $0) }
         self.onActionID?(param.actionID, param.error)
     }
 }
@@ -5,7 +5,6 @@
 //
 
 import Foundation
-import NinchatLowLevelClient
 
 typealias CompletionWithError = (Error?) -> Void
 typealias CompletionWithCredentials = (NINSessionCredentials?, _ resume: ResumeMode?, Error?) -> Void
@@ -29,7 +28,7 @@ enum ResumeMode {
 
 protocol NINChatSessionConnectionManager: AnyObject {
     /** Low-level chat session reference. */
-    var session: NINLowLevelClientSession? { get }
+    var session: LowLevelClientSession? { get }
     
     /** Whether or not this session is connected. */
     var connected: Bool! { get }
@@ -37,6 +36,9 @@ protocol NINChatSessionConnectionManager: AnyObject {
     /** Fetch site's configuration using given `server address` in the initialization */
     func fetchSiteConfiguration(config key: String, environments: [String]?, completion: @escaping CompletionWithError)
 
+    /** Uses the site configuration cached by an earlier fetch, if there is one, until it is fetched again. */
+    func loadCachedSiteConfiguration(config key: String, environments: [String]?) -> Bool
+
     /** Discover Jitsi's room and token given `server address` and `channel id` in the initialization */
     func discoverJitsi(completion: @escaping CompletionWithJitsiCredentials) throws
     
@@ -54,6 +56,12 @@ protocol NINChatSessionConnectionManager: AnyObject {
     
     /** Deallocate a session by resetting local variables */
     func deallocateSession()
+
+    /** Closes the low-level session without ending the chat, e.g. to open it again. */
+    func disconnect()
+
+    /** Closes the low-level session and drops its queues, channels and user, e.g. to open another one. */
+    func resetSession()
     
     /** Runs ICE (Interactive Connectivity Establishment) for WebRTC connection negotiations. */
     func beginICE(completion: @escaping (Error?, [WebRTCServerInfo]?, [WebRTCServerInfo]?) -> Void) throws
@@ -61,7 +69,7 @@ protocol NINChatSessionConnectionManager: AnyObject {
     /** Register audience questionnaire answers in some the given queue's statistics
       * More info: `https://github.com/somia/customer/wiki/Questionnaires#pseudo-targets-register-complete`
      */
-    func registerAudience(queue ID: String, answers: NINLowLevelClientProps, completion: @escaping CompletionWithError) throws
+    func registerAudience(queue ID: String, answers: ClientProps, completion: @escaping CompletionWithError) throws
 
     /**
      * Closes the chat by shutting down the session.
@@ -86,6 +94,9 @@ protocol NINChatSessionMessenger: AnyObject {
     */
     var chatMessages: [ChatMessage]! { get }
 
+    /** The current version of `chatMessages`; safe to read from any thread. */
+    var messageSnapshot: ChatSnapshot { get }
+
     /* A reference to currently described queue, used for setting queue permissions within the chat view. */
     var describedQueue: Queue? { get }
 
@@ -97,6 +108,15 @@ protocol NINChatSessionMessenger: AnyObject {
     * To satisfy the issue `https://github.com/somia/mobile/issues/218`
     */
     var composeActions: [ComposeUIAction] { get }
+
+    /** Keeps a search index of the messages of every channel, for `searchMessages(matching:limit:)`. Off by default. */
+    var indexesMessages: Bool { get set }
+
+    /**
+    * IDs of the shown channel's messages that match every word of the query as a prefix,
+    * ignoring case and diacritics, most recent first.
+    */
+    func searchMessages(matching query: String, limit: Int) -> [String]
     
     /** Indicate whether or not the user is currently typing into the chat. */
     func update(isWriting: Bool, completion: @escaping CompletionWithError) throws
@@ -104,8 +124,8 @@ protocol NINChatSessionMessenger: AnyObject {
     /** Sends chat message to the active chat channel. */
     func send(message: String, completion: @escaping CompletionWithError) throws
     
-    /** Sends a ui/action response to the current channel. */
-    func send(action: ComposeContentViewProtocol, completion: @escaping CompletionWithError) throws
+    /** Sends a ui/action response to the current channel, targeting the given compose content. */
+    func send(action target: [AnyHashable:Any], completion: @escaping CompletionWithError) throws
     
     /** Sends a file to the chat. */
     func send(attachment: String, data: Data, completion: @escaping CompletionWithError) throws
@@ -143,6 +163,7 @@ protocol NINChatSessionManagerDelegate: AnyObject {
     var onMessageUpdated: ((_ index: Int) -> Void)? { get set }
     var onMessageRemoved: ((_ index: Int) -> Void)? { get set }
     var onHistoryLoaded: ((_ length: Int) -> Void)? { get set }
+    var onMessagesChanged: ((_ snapshot: ChatSnapshot, _ diff: ChatSnapshotDiff) -> Void)? { get set }
     var onSessionDeallocated: (() -> Void)? { get set }
     var onChannelClosed: (() -> Void)? { get set }
     var onRTCSignal: ((MessageType, ChannelUser?, _ signal: RTCSignal?) -> Void)? { get set }
@@ -150,21 +171,28 @@ protocol NINChatSessionManagerDelegate: AnyObject {
     var onComposeActionUpdated: ((_ id: String, _ action: ComposeUIAction) -> Void)? { get set }
 
     func bindQueueUpdate<T: QueueUpdateCapture>(closure: @escaping (Events, Queue, Error?) -> Void, to receiver: T)
+    func bindQueueUpdate<T: QueueUpdateCapture>(queueID: String, closure: @escaping (Events, Queue, Error?) -> Void, to receiver: T)
     func unbindQueueUpdateClosure<T: QueueUpdateCapture>(from receiver: T)
 }
 
 protocol NINChatSessionManager: NINChatSessionConnectionManager, NINChatSessionMessenger, NINChatDevHelper, NINChatSessionAttachment, NINChatSessionTranslation, NINChatSessionManagerDelegate {
+    /** Available queues for the realm_id, keyed by queueID. */
+    var queueRegistry: QueueRegistry { get }
+
     /** List of available queues for the realm_id. */
-    var queues: [Queue]! { get set }
+    var queues: [Queue]! { get }
     
     /** List of Audience queues. These are the queues the user gets to pick from in the UI. */
-    var audienceQueues: [Queue]! { get set }
+    var audienceQueues: [Queue]! { get }
+
+    /** Initiated metadata for the current session, kept in memory. */
+    var metadataStore: AudienceMetadataStore { get }
 
-    /** Initiated metadata for the current session. */
-    var audienceMetadata: NINLowLevelClientProps? { get }
+    /** Initiated metadata for the current session, converted on every access. Meant to be sent to the server. */
+    var audienceMetadata: ClientProps? { get }
 
     /** Submitted answers for "preAudienceQuestionnaire" configurations. */
-    var preAudienceQuestionnaireMetadata: NINLowLevelClientProps! { get set }
+    var preAudienceQuestionnaireMetadata: ClientProps! { get set }
 
     /** Site configuration. */
     var siteConfiguration: SiteConfiguration! { get }
@@ -183,9 +211,27 @@ protocol NINChatSessionManager: NINChatSessionConnectionManager, NINChatSessionM
     /** My user's attributes */
     var myUser: ChannelUser? { get }
 
+    /** Channel members that are currently typing. */
+    var typingPresence: TypingPresence { get }
+
+    /** STUN/TURN servers of the session, fetched ahead of the calls and reused between them. */
+    var iceServerCache: ICEServerCache { get }
+
+    /** Group meeting credentials of the current channel, discovered once the channel is joined. */
+    var jitsiDiscovery: JitsiDiscoveryCache { get }
+
+    /** Latency of the events from the low level client until they are shown. */
+    var eventTracer: EventTracer { get }
+
+    /** The events from the low level client, recorded when enabled to be replayed later. */
+    var eventRecorder: EventRecorder { get }
+
+    /** Durations, backlog and traffic of the session, measured when enabled. */
+    var metrics: SessionMetricsRecorder { get }
+
     /** Whether the current channel supports group video call or not. */
     var isGroupVideoChannel: Bool? { get }
 
     /** Default initializer for NinchatSessionManager. */
-    init(session: NINChatSessionInternalDelegate?, serverAddress: String, audienceMetadata: NINLowLevelClientProps?, configuration: NINSiteConfiguration?)
+    init(session: NINChatSessionInternalDelegate?, serverAddress: String, audienceMetadata: ClientProps?, configuration: NINSiteConfiguration?)
 }
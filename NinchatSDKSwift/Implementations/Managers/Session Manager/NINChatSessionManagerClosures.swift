@@ -14,17 +14,20 @@ protocol NINChatSessionManagerClosureHandler {
     func bindICEServer(action id: Int?, closure: @escaping (Error?, [WebRTCServerInfo]?, [WebRTCServerInfo]?) -> Void)
 }
 
+/// A bound closure is removed once its action is answered, so the tables only hold the actions in flight
 extension NINChatSessionManagerImpl: NINChatSessionManagerClosureHandler {
+    /// The closures still waiting for their actions
+    internal var pendingActionClosures: Int {
+        self.actionBoundClosures.count + self.actionJitsiBoundClosures.count + self.actionFileBoundClosures.count + self.actionChannelBoundClosures.count + self.actionICEServersBoundClosures.count
+    }
+
     internal func bind(action id: Int?, closure: @escaping (Error?) -> Void) {
         guard let id = id else { return }
         self.actionBoundClosures[id] = closure
         
         if self.onActionID == nil {
             self.onActionID = { [weak self] result, error in
-                if let targetClosure = self?.actionBoundClosures.filter({
-                    guard case let .success(id) = result else { return false }
-                    return $0.key == id
-                }).first?.value {
+                if case let .success(id) = result, let targetClosure = self?.actionBoundClosures.removeValue(forKey: id) {
                     targetClosure(error)
                 }
             }
@@ -37,10 +40,7 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerClosureHandler {
 
         if self.onActionJitsiDiscovered == nil {
             self.onActionJitsiDiscovered = { [weak self] actionId, result in
-                if let targetClosure = self?.actionJitsiBoundClosures.filter({
-                    guard case let .success(id) = actionId else { return false }
-                    return $0.key == id
-                }).first?.value {
+                if case let .success(id) = actionId, let targetClosure = self?.actionJitsiBoundClosures.removeValue(forKey: id) {
                     targetClosure(result)
                 }
             }
@@ -53,10 +53,7 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerClosureHandler {
         
         if self.onActionFileInfo == nil {
             self.onActionFileInfo = { [weak self] result, fileInfo, error in
-                if let targetClosure = self?.actionFileBoundClosures.filter({
-                    guard case let .success(id) = result else { return false }
-                    return $0.key == id
-                }).first?.value {
+                if case let .success(id) = result, let targetClosure = self?.actionFileBoundClosures.removeValue(forKey: id) {
                     targetClosure(error, fileInfo)
                 }
             }
@@ -69,10 +66,7 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerClosureHandler {
 
         if self.onActionChannel == nil {
             self.onActionChannel = { [weak self] result, channelID in
-                if let targetClosure = self?.actionChannelBoundClosures.filter({
-                    guard case let .success(id) = result else { return false }
-                    return $0.key == id
-                }).first?.value {
+                if case let .success(id) = result, let targetClosure = self?.actionChannelBoundClosures.removeValue(forKey: id) {
                     targetClosure(nil)
                 }
             }
@@ -85,11 +79,7 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerClosureHandler {
 
         if self.onActionSevers == nil {
             self.onActionSevers = { [weak self] result, stunServers, turnServers in
-                if let targetClosure = self?.actionICEServersBoundClosures.filter({
-                    guard case let .success(id) = result else { return false }
-                    return $0.key == id
-                }).first?.value {
-
+                if case let .success(id) = result, let targetClosure = self?.actionICEServersBoundClosures.removeValue(forKey: id) {
                     targetClosure(nil, stunServers, turnServers)
                 }
             }
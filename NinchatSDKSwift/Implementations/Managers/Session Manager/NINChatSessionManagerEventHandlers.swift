@@ -5,7 +5,6 @@
 //
 
 import Foundation
-import NinchatLowLevelClient
 
 enum Events: String {
     case channelFound = "channel_found"
@@ -38,8 +37,8 @@ enum Events: String {
 }
 
 protocol NINChatSessionManagerEventHandlers {
-    func onSessionEvent(param: NINLowLevelClientProps)
-    func onEvent(param: NINLowLevelClientProps, payload: NINLowLevelClientPayload, lastReplay: Bool)
+    func onSessionEvent(param: ClientProps)
+    func onEvent(param: ClientProps, payload: ClientPayload, lastReplay: Bool)
     func onCloseEvent()
     func onLogEvent(value: String)
     func onConnStateEvent(state: String)
@@ -47,28 +46,24 @@ protocol NINChatSessionManagerEventHandlers {
 
 extension NINChatSessionManagerImpl: NINChatSessionManagerEventHandlers {
     internal func setEventHandlers() {
-        self.session?.setOnSessionEvent(self)
-        self.session?.setOnEvent(self)
-        self.session?.setOnClose(self)
-        self.session?.setOnLog(self)
-        self.session?.setOnConnState(self)
+        self.session?.setHandler(self)
     }
     
-    func onSessionEvent(param: NINLowLevelClientProps) {
+    func onSessionEvent(param: ClientProps) {
         do {
             if case let .failure(error) = param.event { throw error }
 
             let event = param.event.value
-            debugger("session event handler: \(event)")
+            logger.debug(.event, "Session event handler: \(event)")
             if let eventType = Events(rawValue: event) {
                 switch eventType {
                 case .error:
-                    debugger.error(param.error as? NinchatError)
+                    logger.error(.event, param.error as? NinchatError)
                     self.onActionSessionEvent?(nil, eventType, param.error)
                 case .sessionCreated:
                     let credentials = try NINSessionCredentials(params: param)
                     self.myUserID = credentials.userID
-                    self.delegate?.log(value: "Session created - my user ID is: \(String(describing: credentials.userID))")
+                    self.delegate?.log(.session, "Session created - my user ID is: \(String(describing: credentials.userID))")
 
                     /// Check if the user is waiting in a queue - `https://github.com/somia/mobile/issues/266`
                     ///     1. describe the queue which user is waiting in
@@ -88,7 +83,7 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerEventHandlers {
                             do {
                                 try self?.describe(channel: self?.currentChannelID ?? "") { [weak self] error in
                                     guard error == nil else { self?.onActionSessionEvent?(credentials, eventType, error); return }
-                                    guard let channelID = self?.currentChannelID else { debugger("Error in getting current channel id"); return }
+                                    guard let channelID = self?.currentChannelID else { logger.error(.event, "Error in getting current channel id"); return }
 
                                     try? self?.didJoinChannel(channelID: channelID, message: nil, false, true)
                                     self?.onActionSessionEvent?(credentials, eventType, nil)
@@ -109,15 +104,16 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerEventHandlers {
                 }
             }
         } catch {
-            debugger("Error occurred: \(error)")
+            logger.error(.event, "Error occurred: \(error)")
         }
     }
 
-    func onEvent(param: NINLowLevelClientProps, payload: NINLowLevelClientPayload, lastReplay: Bool) {
+    func onEvent(param: ClientProps, payload: ClientPayload, lastReplay: Bool) {
         do {
             if case let .failure(error) = param.event { throw error }
             let event = param.event.value
-            debugger("event handler: \(event)")
+            self.eventTracer.current?.event = event
+            logger.debug(.event, "Event handler: \(event)")
 
             if let eventType = Events(rawValue: event) {
                 switch eventType {
@@ -161,7 +157,7 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerEventHandlers {
             /// Forward the event to the SDK
             self.delegate?.onLowLevelEvent(event: param, payload: payload, lastReply: lastReplay)
         } catch {
-            debugger("error in parsing the event: \(error.localizedDescription)")
+            logger.error(.event, "Error in parsing the event: \(error.localizedDescription)")
         }
     }
     
@@ -170,7 +166,7 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerEventHandlers {
     }
     
     func onLogEvent(value: String) {
-        debugger("** GO SDK output: \(value)")
+        logger.debug(.network, "GO SDK output: \(value)")
     }
     
     func onConnStateEvent(state: String) {
@@ -178,43 +174,45 @@ extension NINChatSessionManagerImpl: NINChatSessionManagerEventHandlers {
     }
 }
 
-extension NINChatSessionManagerImpl: NINLowLevelClientSessionEventHandlerProtocol {
-    func onSessionEvent(_ params: NINLowLevelClientProps?) {
+/// Called on the low level client's thread, with the values already copied out of the client's objects
+extension NINChatSessionManagerImpl: LowLevelClientHandler {
+    func onSessionEvent(_ params: ClientProps) {
+        self.eventRecorder.record(session: params)
         DispatchQueue.main.async {
-            self.onSessionEvent(param: params!)
+            self.onSessionEvent(param: params)
         }
     }
-}
 
-extension NINChatSessionManagerImpl: NINLowLevelClientEventHandlerProtocol {
-    func onEvent(_ params: NINLowLevelClientProps?, payload: NINLowLevelClientPayload?, lastReply: Bool) {
+    func onEvent(_ params: ClientProps, payload: ClientPayload, lastReply: Bool) {
+        let trace = self.eventTracer.begin()
+        self.eventRecorder.record(event: params, payload: payload, lastReply: lastReply)
+        if self.metrics.isEnabled {
+            self.metrics.eventReceived()
+            self.metrics.received(bytes: payload.reduce(0) { $0 + $1.count })
+        }
         DispatchQueue.main.async {
-            self.onEvent(param: params!, payload: payload!, lastReplay: lastReply)
+            self.eventTracer.dispatch(trace) {
+                self.onEvent(param: params, payload: payload, lastReplay: lastReply)
+            }
+            self.metrics.eventHandled()
         }
     }
-}
 
-extension NINChatSessionManagerImpl: NINLowLevelClientCloseHandlerProtocol {
     func onClose() {
         DispatchQueue.main.async {
             self.onCloseEvent()
         }
     }
-}
 
-extension NINChatSessionManagerImpl: NINLowLevelClientLogHandlerProtocol {
-    func onLog(_ msg: String?) {
+    func onLog(_ msg: String) {
         DispatchQueue.main.async {
-            self.onLogEvent(value: msg!)
+            self.onLogEvent(value: msg)
         }
     }
-}
 
-extension NINChatSessionManagerImpl: NINLowLevelClientConnStateHandlerProtocol {
-    func onConnState(_ state: String?) {
+    func onConnState(_ state: String) {
         DispatchQueue.main.async {
-            self.onConnStateEvent(state: state!)
+            self.onConnStateEvent(state: state)
         }
     }
 }
-
@@ -4,9 +4,7 @@
 // license that can be found in the LICENSE file.
 //
 
-import UIKit
 import Foundation
-import NinchatLowLevelClient
 
 protocol NINChatSessionManagerInternalActions {
     var onActionSessionEvent: ((NINSessionCredentials?, Events, Error?) -> Void)? { get set }
@@ -22,12 +20,21 @@ protocol NINChatSessionManagerInternalActions {
 
 final class NINChatSessionManagerImpl: NSObject, NINChatSessionManager, NINChatDevHelper, NINChatSessionManagerInternalActions {
     internal var serviceManager = ServiceManager()
-    internal var channelUsers: [String:ChannelUser] = [:]
+    internal var siteConfigurationCache = SiteConfigurationCache()
+    /// The states of the session's channels, and the one shown
+    internal let channels = ChannelRegistry()
+    /// A held batch is published once no more of it has arrived for this long
+    internal var batchTimeout: TimeInterval = TimeConstants.kBatchTimeout.rawValue
+    internal var channelUsers: [String:ChannelUser] {
+        self.channels.current.members
+    }
     internal var currentQueueID: String?
+    /// The channel the user is in; the one shown stays in `channels` after it is parted
     internal var currentChannelID: String?
-    internal var backgroundChannelID: String?
     internal var myUserID: String?
-    internal var expectedHistoryLength = -1
+    internal var expectedHistoryLength: Int {
+        self.channels.current.expectedHistoryLength
+    }
 
     // MARK: - NINChatSessionManagerInternalActions
     
@@ -48,11 +55,19 @@ final class NINChatSessionManagerImpl: NSObject, NINChatSessionManager, NINChatD
     internal var actionFileBoundClosures: [Int: (Error?, [String:Any]?) -> Void] = [:]
     internal var actionChannelBoundClosures: [Int: (Error?) -> Void] = [:]
     internal var actionICEServersBoundClosures: [Int: (Error?, [WebRTCServerInfo]?, [WebRTCServerInfo]?) -> Void] = [:]
-    internal var queueUpdateBoundClosures: [String: (Events, Queue, Error?) -> Void] = [:]
 
     // MARK: - NINChatSessionConnectionManager variables
     
-    var session: NINLowLevelClientSession?
+    var session: LowLevelClientSession?
+    /// Creates the low level client's session when a session is opened.
+    /// The `NinchatCore` package is built without the Go client, and has to be given one.
+    internal var makeLowLevelSession: () -> LowLevelClientSession = {
+        #if NINCHAT_CORE
+        fatalError("No low level client session is set")
+        #else
+        return BridgedClientSession()
+        #endif
+    }
     var connected: Bool! {
         self.session != nil
     }
@@ -60,10 +75,41 @@ final class NINChatSessionManagerImpl: NSObject, NINChatSessionManager, NINChatD
     // MARK: - NINChatSessionManager variables
     
     var realmID: String?
-    var chatMessages: [ChatMessage]! = []
+    /// Versioned copies of the shown channel's messages, published along with their diffs
+    var messageStore: ChatMessageStore {
+        self.channels.current.messageStore
+    }
+    var messageSnapshot: ChatSnapshot {
+        self.messageStore.snapshot
+    }
+    /// Typing state of the other channel members, kept apart from the messages
+    let typingPresence = TypingPresence()
+    /// `begin_ice` results, shared by the calls of the session
+    lazy var iceServerCache = ICEServerCache { [weak self] completion in
+        guard let `self` = self else { throw NINSessionExceptions.noActiveSession }
+        try self.beginICE(completion: completion)
+    }
+    /// `discover_jitsi` results of the current group channel
+    lazy var jitsiDiscovery = JitsiDiscoveryCache(channelID: { [weak self] in self?.currentChannelID }) { [weak self] completion in
+        guard let `self` = self else { throw NINSessionExceptions.noActiveSession }
+        try self.discoverJitsi(completion: completion)
+    }
+    let eventTracer = EventTracer()
+    let eventRecorder = EventRecorder()
+    let metrics = SessionMetricsRecorder()
+    /// Setting the messages replaces them as a new version without notifying the views
+    var chatMessages: [ChatMessage]! {
+        get { self.messageSnapshot.messages }
+        set { self.commit(notify: false) { $0 = newValue ?? [] } }
+    }
     var describedQueue: Queue?
-    var agent: ChannelUser?
-    var composeActions: [ComposeUIAction] = []
+    var agent: ChannelUser? {
+        get { self.channels.current.agent }
+        set { self.channels.current.agent = newValue }
+    }
+    var composeActions: [ComposeUIAction] {
+        self.channels.current.compose.pending
+    }
     var isGroupVideoChannel: Bool?
 
     var myUser: ChannelUser? {
@@ -76,6 +122,7 @@ final class NINChatSessionManagerImpl: NSObject, NINChatSessionManager, NINChatD
     var onMessageUpdated: ((_ index: Int) -> Void)?
     var onMessageRemoved: ((_ index: Int) -> Void)?
     var onHistoryLoaded: ((_ length: Int) -> Void)?
+    var onMessagesChanged: ((_ snapshot: ChatSnapshot, _ diff: ChatSnapshotDiff) -> Void)?
     var onSessionDeallocated: (() -> Void)?
     var onChannelClosed: (() -> Void)?
     var onRTCSignal: ((MessageType, ChannelUser?, _ signal: RTCSignal?) -> Void)?
@@ -83,42 +130,48 @@ final class NINChatSessionManagerImpl: NSObject, NINChatSessionManager, NINChatD
     var onComposeActionUpdated: ((_ id: String, _ action: ComposeUIAction) -> Void)?
     
     func bindQueueUpdate<T: QueueUpdateCapture>(closure: @escaping (Events, Queue, Error?) -> Void, to receiver: T) {
-        guard queueUpdateBoundClosures.keys.filter({ $0 == receiver.desc }).count == 0 else { return }
-        queueUpdateBoundClosures[receiver.desc] = closure
+        self.queueRegistry.bind(receiver: receiver.desc, observer: closure)
+    }
+
+    func bindQueueUpdate<T: QueueUpdateCapture>(queueID: String, closure: @escaping (Events, Queue, Error?) -> Void, to receiver: T) {
+        self.queueRegistry.bind(receiver: receiver.desc, queueID: queueID, observer: closure)
     }
 
     func unbindQueueUpdateClosure<T: QueueUpdateCapture>(from receiver: T) {
-        self.queueUpdateBoundClosures.removeValue(forKey: receiver.desc)
+        self.queueRegistry.unbind(receiver: receiver.desc)
     }
 
     // MARK: - NINChatSessionManager
     
-    private(set) weak var audienceMetadata: NINLowLevelClientProps? {
-        set {
-            NINLowLevelClientProps.saveMetadata(newValue)
-        }
-        get {
-            NINLowLevelClientProps.loadMetadata()
-        }
+    /// Metadata is kept in memory and only converted when it is sent
+    let metadataStore: AudienceMetadataStore = .shared
+    var audienceMetadata: ClientProps? {
+        self.metadataStore.props()
     }
     weak var delegate: NINChatSessionInternalDelegate?
-    var queues: [Queue]! = [] {
-        didSet {
-            self.audienceQueues = self.queues
-        }
+    /// The realm's queues keyed by queueID
+    let queueRegistry = QueueRegistry()
+    /// Unknown queues seen in queue events are described together
+    internal lazy var queueDescriber = QueueDescribeBatcher { [weak self] ids, completion in
+        try self?.describe(queuesID: ids, completion: completion)
+    }
+    var queues: [Queue]! {
+        self.queueRegistry.all
+    }
+    var audienceQueues: [Queue]! {
+        self.queueRegistry.audience
     }
-    var audienceQueues: [Queue]! = []
     var siteConfiguration: SiteConfiguration!
     var givenConfiguration: NINSiteConfiguration?
-    weak var preAudienceQuestionnaireMetadata: NINLowLevelClientProps! {
-        didSet {
-            let metadata = self.audienceMetadata ?? NINLowLevelClientProps()
-            metadata.set(value: preAudienceQuestionnaireMetadata, forKey: "pre_answers")
-            
-            /// Since metadata is loaded from the UserDefaults instead of memory,
-            /// it is necessary to update its value after pre_answers are set
-            NINLowLevelClientProps.saveMetadata(metadata)
+    /// Converted as it is set, so the answers are kept as plain values
+    var preAudienceQuestionnaireMetadata: ClientProps! {
+        get {
+            let answers = self.metadataStore.preAnswers
+            guard !answers.isEmpty, let data = try? JSONSerialization.data(withJSONObject: answers) else { return nil }
+
+            return try? ClientProps(json: String(decoding: data, as: UTF8.self))
         }
+        set { self.metadataStore.set(preAnswers: newValue) }
     }
     var appDetails: String?
     
@@ -127,24 +180,27 @@ final class NINChatSessionManagerImpl: NSObject, NINChatSessionManager, NINChatD
     var serverAddress: String!
     var siteSecret: String?
     
-    init(session: NINChatSessionInternalDelegate?, serverAddress: String, audienceMetadata: NINLowLevelClientProps? = nil, configuration: NINSiteConfiguration?) {
+    init(session: NINChatSessionInternalDelegate?, serverAddress: String, audienceMetadata: ClientProps? = nil, configuration: NINSiteConfiguration?) {
         super.init()
 
         self.delegate = session
         self.serverAddress = serverAddress
         self.givenConfiguration = configuration
-        self.audienceMetadata = audienceMetadata
+        self.metadataStore.replace(with: audienceMetadata)
+        self.metrics.onUpdate = { [weak self] metrics in
+            self?.delegate?.onSessionMetrics(metrics)
+        }
     }
     
     /** Designed for test and internal purposes. */
-    convenience init(session: NINChatSessionInternalDelegate?, serverAddress: String, siteSecret: String?, audienceMetadata: NINLowLevelClientProps? = nil, configuration: NINSiteConfiguration? = nil) {
+    convenience init(session: NINChatSessionInternalDelegate?, serverAddress: String, siteSecret: String?, audienceMetadata: ClientProps? = nil, configuration: NINSiteConfiguration? = nil) {
         self.init(session: session, serverAddress: serverAddress, audienceMetadata: audienceMetadata, configuration: configuration)
         self.siteSecret = siteSecret
     }
     
     deinit {
         self.disconnect()
-        debugger("`NINChatSessionManager` deallocated.")
+        logger.debug(.session, "`NINChatSessionManager` deallocated.")
     }
 }
 
@@ -160,10 +216,10 @@ extension NINChatSessionManagerImpl {
         }
         
         /// Device OS
-        details += " (ios " + UIDevice.current.systemVersion + "; "
+        details += " (ios " + ProcessInfo.processInfo.systemVersion + "; "
         
         /// Device Model
-        details += UIDevice.current.deviceType + ")"
+        details += ProcessInfo.processInfo.deviceModel + ")"
         
         /// User given details
         if let appDetails = self.appDetails {
@@ -179,39 +235,59 @@ extension NINChatSessionManagerImpl {
         self.serviceManager.perform(request) { [weak self] result in
             guard let `self` = self else { return }
             
-            switch result {
-            case .success(let config):
-                debugger("Got site config: \(String(describing: config.toDictionary))")
-                self.siteConfiguration = SiteConfigurationImpl(configuration: config.toDictionary, environments: environments)
-                self.siteConfiguration.override(configuration: self.givenConfiguration)
-                completion(nil)
-            case .failure(let error):
-                completion(error)
+            /// The configuration may be read on the main thread while it is revalidated
+            DispatchQueue.main.async {
+                switch result {
+                case .success(let config):
+                    let dictionary = config.toDictionary
+                    logger.debug(.network, "Got site config: \(String(describing: dictionary))")
+                    self.siteConfiguration = SiteConfigurationImpl(configuration: dictionary, environments: environments)
+                    self.siteConfiguration.override(configuration: self.givenConfiguration)
+                    if let dictionary = dictionary {
+                        self.siteConfigurationCache.save(dictionary, for: key, serverAddress: self.serverAddress)
+                    }
+                    completion(nil)
+                case .failure(let error):
+                    completion(error)
+                }
             }
         }
     }
 
+    func loadCachedSiteConfiguration(config key: String, environments: [String]?) -> Bool {
+        guard let cached = self.siteConfigurationCache.configuration(for: key, serverAddress: self.serverAddress) else { return false }
+
+        logger.debug(.session, "Using the cached site config of \(key) until it is revalidated")
+        self.siteConfiguration = SiteConfigurationImpl(configuration: cached, environments: environments)
+        self.siteConfiguration.override(configuration: self.givenConfiguration)
+        return true
+    }
+
     func openSession(completion: @escaping CompletionWithCredentials) throws {
-        delegate?.log(value: "Opening new chat session using server address: \(serverAddress!)")
-        try self.initiateSession(params: NINLowLevelClientProps.initiate(), completion: completion)
+        delegate?.log(.session, "Opening new chat session using server address: \(serverAddress!)")
+        try self.initiateSession(params: ClientProps.initiate(), completion: completion)
     }
 
     func continueSession(credentials: NINSessionCredentials, completion: @escaping CompletionWithCredentials) throws {
-        delegate?.log(value: "Resume session using user ID: \(credentials.userID)")
-        try self.initiateSession(params: NINLowLevelClientProps.initiate(credentials: credentials), completion: completion)
+        delegate?.log(.session, "Resume session using user ID: \(credentials.userID)")
+        try self.initiateSession(params: ClientProps.initiate(credentials: credentials), completion: completion)
     }
 
-    internal func initiateSession(params: NINLowLevelClientProps, completion: @escaping CompletionWithCredentials) throws {
+    internal func initiateSession(params: ClientProps, completion: @escaping CompletionWithCredentials) throws {
+        var params = params
+        self.metrics.start(.sessionOpen)
+
         /// Wait for the session creation event
         self.onActionSessionEvent = { [weak self] credentials, event, error in
             guard let `self` = self else { return }
             
             if event == .sessionCreated {
+                self.metrics.end(.sessionOpen)
                 if self.currentChannelID != nil {
                     completion(credentials, .toChannel, error); return
                 }
                 if let queueID = self.currentQueueID {
-                    completion(credentials, .toQueue(self.queues.first(where: { $0.queueID == queueID })), error); return
+                    completion(credentials, .toQueue(self.queueRegistry[queueID]), error); return
                 }
                 completion(credentials, nil, error)
             } else if event == .error {
@@ -236,19 +312,19 @@ extension NINChatSessionManagerImpl {
         }
 
         if let userName = self.siteConfiguration.userName {
-            params.userAttributes = .success(NINLowLevelClientProps.initiate(name: userName))
+            params.userAttributes = .success(ClientProps.initiate(name: userName))
         }
 
-        let messageType = NINLowLevelClientStrings()
-        messageType.append(MessageType.file.rawValue)
-        messageType.append(MessageType.text.rawValue)
-        messageType.append(MessageType.metadata.rawValue)
-        messageType.append(MessageType.rtc.rawValue)
-        messageType.append(MessageType.ui.rawValue)
-        messageType.append(MessageType.info.rawValue)
-        params.messageTypes = .success(messageType)
+        params.messageTypes = .success([
+            MessageType.file.rawValue,
+            MessageType.text.rawValue,
+            MessageType.metadata.rawValue,
+            MessageType.rtc.rawValue,
+            MessageType.ui.rawValue,
+            MessageType.info.rawValue
+        ])
 
-        self.session = NINLowLevelClientSession()
+        self.session = self.makeLowLevelSession()
         self.session?.setAddress(self.serverAddress)
         self.session?.setHeader("User-Agent", value: self.sdkDetails)
         self.setEventHandlers()
@@ -260,14 +336,12 @@ extension NINChatSessionManagerImpl {
     func describe(queuesID: [String]?, completion: @escaping CompletionWithError) throws {
         guard let realmID = self.realmID, let session = self.session else { throw NINSessionExceptions.noActiveSession }
 
-        let param = NINLowLevelClientProps.initiate(action: .describeRealmQueues)
+        var param = ClientProps.initiate(action: .describeRealmQueues)
         param.realmID = .success(realmID)
         
         if let queuesID = queuesID {
             /// Parameter should be set only if there are any queues passed to the function
-            param.queuesID = .success(queuesID.reduce(into: NINLowLevelClientStrings()) { list, id in
-                list.append(id)
-            })
+            param.queuesID = .success(queuesID)
         }
 
         do {
@@ -281,11 +355,12 @@ extension NINChatSessionManagerImpl {
     func join(queue ID: String, progress: @escaping (Queue?, Error?, Int) -> Void, completion: @escaping Completion) throws {
         
         func performJoin() throws {
-            delegate?.log(value: "Joining queue \(ID)..")
-            self.onChannelJoined = {
+            delegate?.log(.session, "Joining queue \(ID)..")
+            self.metrics.start(.firstQueuePosition)
+            self.onChannelJoined = { [weak self] in
                 /// According to https://github.com/somia/mobile/issues/287
                 /// Clear metadata from the UserDefaults on a successful join
-                UserDefaults.remove(forKey: .metadata)
+                self?.metadataStore.removeAll()
 
                 completion()
             }
@@ -294,10 +369,10 @@ extension NINChatSessionManagerImpl {
             if self.currentQueueID == nil {
                 guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
                 
-                let param = NINLowLevelClientProps.initiate(action: .requestAudience)
+                var param = ClientProps.initiate(action: .requestAudience)
                 param.queueID = .success(ID)
 
-                if let audienceMetadata = self.audienceMetadata {
+                if let audienceMetadata = self.metadataStore.props() {
                     param.metadata = .success(audienceMetadata)
                 }
                 do {
@@ -309,17 +384,17 @@ extension NINChatSessionManagerImpl {
 
             self.onProgress = { [weak self] queue, position, event, error in
                 if (event == .queueUpdated || event == .audienceEnqueued), self?.currentQueueID == queue.queueID {
+                    self?.metrics.end(.firstQueuePosition)
                     progress(queue, error, position)
                 }
             }
         }
         
         if let currentChannel = self.currentChannelID {
-            delegate?.log(value: "Parting current channel first")
+            delegate?.log(.session, "Parting current channel first")
             
             try self.part(channel: currentChannel) { [weak self] error in
-                self?.delegate?.log(value: "Channel parted; joining queue.")
-                self?.backgroundChannelID = self?.currentChannelID
+                self?.delegate?.log(.session, "Channel parted; joining queue.")
                 self?.currentChannelID = nil
                 try? performJoin()
             }
@@ -330,7 +405,7 @@ extension NINChatSessionManagerImpl {
     
     /// Deallocate a session by resetting local variables.
     func deallocateSession() {
-        delegate?.log(value: "Session deallocation by resetting local variable")
+        delegate?.log(.session, "Session deallocation by resetting local variable")
         self.onProgress = nil
         self.onChannelJoined = nil
         self.onActionID = nil
@@ -340,25 +415,12 @@ extension NINChatSessionManagerImpl {
         self.onActionSessionEvent = nil
         self.onActionSevers = nil
 
-        self.actionBoundClosures.keys.forEach { self.actionBoundClosures.removeValue(forKey: $0) }
-        self.actionJitsiBoundClosures.keys.forEach { self.actionJitsiBoundClosures.removeValue(forKey: $0) }
-        self.queueUpdateBoundClosures.keys.forEach { self.queueUpdateBoundClosures.removeValue(forKey: $0) }
-        self.actionICEServersBoundClosures.keys.forEach { self.actionICEServersBoundClosures.removeValue(forKey: $0) }
-        self.actionChannelBoundClosures.keys.forEach { self.actionChannelBoundClosures.removeValue(forKey: $0) }
-        self.actionFileBoundClosures.keys.forEach({ self.actionFileBoundClosures.removeValue(forKey: $0) })
-        self.chatMessages.removeAll()
-        self.channelUsers.removeAll()
-        self.queues.removeAll()
+        self.queueRegistry.unbindAll()
+        self.removeSessionState()
 
         self.onRTCClientSignal = nil
         self.onRTCSignal = nil
 
-        self.backgroundChannelID = nil
-        self.currentChannelID = nil
-        self.currentQueueID = nil
-        self.myUserID = nil
-        self.isGroupVideoChannel = nil
-
         if self.session != nil {
             do {
                 try self.closeChat(endSession: true, onCompletion: nil)
@@ -368,11 +430,38 @@ extension NINChatSessionManagerImpl {
         }
         self.onSessionDeallocated?()
     }
+
+    func resetSession() {
+        delegate?.log(.session, "Session reset, closing it and dropping its state")
+        self.disconnect()
+        self.removeSessionState()
+    }
+
+    /// Drops what the session knew about its realm, queues, channels and user; the views stay bound
+    private func removeSessionState() {
+        self.actionBoundClosures.keys.forEach { self.actionBoundClosures.removeValue(forKey: $0) }
+        self.actionJitsiBoundClosures.keys.forEach { self.actionJitsiBoundClosures.removeValue(forKey: $0) }
+        self.actionICEServersBoundClosures.keys.forEach { self.actionICEServersBoundClosures.removeValue(forKey: $0) }
+        self.actionChannelBoundClosures.keys.forEach { self.actionChannelBoundClosures.removeValue(forKey: $0) }
+        self.actionFileBoundClosures.keys.forEach({ self.actionFileBoundClosures.removeValue(forKey: $0) })
+        self.channels.removeAll()
+        self.typingPresence.removeAll()
+        self.queueRegistry.removeAll()
+        self.queueDescriber.cancel()
+        self.iceServerCache.invalidate()
+        self.jitsiDiscovery.invalidate()
+
+        self.describedQueue = nil
+        self.currentChannelID = nil
+        self.currentQueueID = nil
+        self.myUserID = nil
+        self.isGroupVideoChannel = nil
+    }
     
     /// Retrieves the WebRTC ICE STUN/TURN server details
     func beginICE(completion: @escaping (Error?, [WebRTCServerInfo]?, [WebRTCServerInfo]?) -> Void) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
-        let param = NINLowLevelClientProps.initiate(action: .beginICE)
+        let param = ClientProps.initiate(action: .beginICE)
         
         do {
             let actionID = try session.send(param)
@@ -383,10 +472,10 @@ extension NINChatSessionManagerImpl {
     }
     
     /// Register audience questionnaire answers
-    func registerAudience(queue ID: String, answers: NINLowLevelClientProps, completion: @escaping CompletionWithError) throws {
+    func registerAudience(queue ID: String, answers: ClientProps, completion: @escaping CompletionWithError) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
 
-        let param = NINLowLevelClientProps.initiate(action: .registerAudience)
+        var param = ClientProps.initiate(action: .registerAudience)
         param.queueID = .success(ID)
         param.metadata = .success(answers)
 
@@ -400,7 +489,7 @@ extension NINChatSessionManagerImpl {
 
     /// Low-level shutdown of the chat's session; invalidates session resource.
     func closeChat(endSession end: Bool, onCompletion: Completion? = nil) throws {
-        delegate?.log(value: "Shutting down chat Session..")
+        delegate?.log(.session, "Shutting down chat Session..")
 
         if self.myUserID == nil {
             endSession()
@@ -447,15 +536,24 @@ extension NINChatSessionManagerImpl {
 // MARK: - NINChatSessionMessenger
 
 extension NINChatSessionManagerImpl {
+    var indexesMessages: Bool {
+        get { self.channels.indexesMessages }
+        set { self.channels.indexesMessages = newValue }
+    }
+
+    func searchMessages(matching query: String, limit: Int) -> [String] {
+        self.channels.current.searchIndex.search(query, limit: limit)
+    }
+
     func update(isWriting: Bool, completion: @escaping CompletionWithError) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
         guard let currentChannel = self.currentChannelID else { throw NINSessionExceptions.noActiveQueue }
         guard let userID = self.myUserID else { throw NINSessionExceptions.noActiveUserID }
         
-        let memberAttributes = NINLowLevelClientProps.initiate()
+        var memberAttributes = ClientProps.initiate()
         memberAttributes.writing = .success(isWriting)
         
-        let param = NINLowLevelClientProps.initiate(action: .updateMember)
+        var param = ClientProps.initiate(action: .updateMember)
         param.channelID = .success(currentChannel)
         param.userID = .success(userID)
         param.channelMemberAttributes = .success(memberAttributes)
@@ -478,26 +576,24 @@ extension NINChatSessionManagerImpl {
     }
     
     /// Sends a ui/action response to the current channel
-    func send(action: ComposeContentViewProtocol, completion: @escaping CompletionWithError) throws {
+    func send(action target: [AnyHashable:Any], completion: @escaping CompletionWithError) throws {
         guard self.session != nil else { throw NINSessionExceptions.noActiveSession }
         
-        try self.send(type: .uiAction, payload: ["action": "click", "target": action.messageDictionary], completion: completion)
+        try self.send(type: .uiAction, payload: ["action": "click", "target": target], completion: completion)
     }
     
     func send(attachment: String, data: Data, completion: @escaping CompletionWithError) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
         guard let currentChannel = self.currentChannelID else { throw NINSessionExceptions.noActiveChannel }
         
-        let fileAttributes = NINLowLevelClientProps.initiate(name: attachment)
-        let param = NINLowLevelClientProps.initiate(action: .sendFile)
+        let fileAttributes = ClientProps.initiate(name: attachment)
+        var param = ClientProps.initiate(action: .sendFile)
         param.fileAttributes = .success(fileAttributes)
         param.channelID = .success(currentChannel)
         
-        let payload = NINLowLevelClientPayload()
-        payload.append(data)
-        
         do {
-            let actionID = try session.send(param, payload)
+            let actionID = try session.send(param, [data])
+            self.metrics.sent(bytes: data.count)
             
             /// When this action completes, trigger the completion block callback
             self.bind(action: actionID, closure: completion)
@@ -512,12 +608,12 @@ extension NINChatSessionManagerImpl {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
         guard let currentChannel = self.currentChannelID else { throw NINSessionExceptions.noActiveChannel }
         
-        let param = NINLowLevelClientProps.initiate(action: .sendMessage)
+        var param = ClientProps.initiate(action: .sendMessage)
         param.messageType = .success(type)
         param.channelID = .success(currentChannel)
         
         if type == .metadata, let _ = (payload["data"] as? [String:Int])?["rating"] {
-            param.recipients = .success(NINLowLevelClientStrings())
+            param.recipients = .success([])
             param.messageFold = .success(true)
         }
         
@@ -528,10 +624,8 @@ extension NINChatSessionManagerImpl {
         
         do {
             let data = try JSONSerialization.data(withJSONObject: payload, options: .prettyPrinted)
-            let newPayload = NINLowLevelClientPayload()
-            newPayload.append(data)
-            
-            let actionID = try session.send(param, newPayload)
+            let actionID = try session.send(param, [data])
+            self.metrics.sent(bytes: data.count)
             self.bind(action: actionID, closure: completion)
             return actionID
         } catch {
@@ -544,19 +638,20 @@ extension NINChatSessionManagerImpl {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
         guard let currentChannel = self.currentChannelID else { throw NINSessionExceptions.noActiveChannel }
         
-        let param = NINLowLevelClientProps.initiate(action: .loadHistory)
+        var param = ClientProps.initiate(action: .loadHistory)
         param.channelID = .success(currentChannel)
         param.historyOrder = .success(HistoryOrder.DESC.rawValue)
 
         /// Currently we need to just load supported message types
-        let messageType = NINLowLevelClientStrings()
-        messageType.append(MessageType.file.rawValue)
-        messageType.append(MessageType.text.rawValue)
-        messageType.append(MessageType.ui.rawValue)
-        param.messageTypes = .success(messageType)
+        param.messageTypes = .success([
+            MessageType.file.rawValue,
+            MessageType.text.rawValue,
+            MessageType.ui.rawValue
+        ])
 
         do {
             let actionID = try session.send(param)
+            self.metrics.start(.historyLoad)
             self.bind(action: actionID, closure: completion)
         } catch {
             completion(error)
@@ -570,7 +665,7 @@ extension NINChatSessionManagerImpl {
     // Asynchronously retrieves file info
     func describe(file id: String, completion: @escaping (Error?, [String:Any]?) -> Void) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
-        let param = NINLowLevelClientProps.initiate(action: .describeFile)
+        var param = ClientProps.initiate(action: .describeFile)
         param.fileID = .success(id)
 
         do {
@@ -586,7 +681,7 @@ extension NINChatSessionManagerImpl {
     func describe(channel id: String, completion: @escaping CompletionWithError) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
 
-        let param = NINLowLevelClientProps.initiate(action: .describeChannel)
+        var param = ClientProps.initiate(action: .describeChannel)
         param.channelID = .success(id)
 
         do {
@@ -600,7 +695,7 @@ extension NINChatSessionManagerImpl {
     func discoverJitsi(completion: @escaping CompletionWithJitsiCredentials) throws {
         guard let session = self.session else { throw NINSessionExceptions.noActiveSession }
 
-        let param = NINLowLevelClientProps.initiate(action: .discoverJitsi)
+        var param = ClientProps.initiate(action: .discoverJitsi)
         if let channelID = self.currentChannelID {
             param.channelID = .success(channelID)
         }
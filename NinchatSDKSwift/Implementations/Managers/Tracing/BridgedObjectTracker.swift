@@ -0,0 +1,90 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+import ObjectiveC
+
+/// Counts the live objects of the low level client by type and call site.
+///
+/// Each `NINLowLevelClientProps`, `Strings`, `Objects` and `Payload` wraps a Go seq reference that
+/// pins its memory in the Go runtime until the Swift object is released. A tracked object carries a
+/// token as an associated object, which is released along with it and takes it off the count; tracking
+/// it again moves it to the new site. Until enabled, objects go without a token. Shared, as the objects
+/// are created where no session manager is at hand.
+final class BridgedObjectTracker {
+    static let shared = BridgedObjectTracker()
+
+    fileprivate struct Key: Hashable {
+        let type: String
+        let site: String
+    }
+
+    /// Read under the lock of the counts, as objects are tracked on the low level client's thread
+    var isEnabled: Bool {
+        get { self.lock.sync { self._isEnabled } }
+        set { self.lock.sync { self._isEnabled = newValue } }
+    }
+
+    private let lock = DispatchQueue(label: "com.ninchat.sdk.swift.bridge")
+    private var _isEnabled = false
+    private var counts: [Key:Int] = [:]
+    private static var tokenKey = 0
+
+    /// Most first
+    var live: [NINBridgedObjectCount] {
+        self.lock.sync { self.counts }
+            .map { NINBridgedObjectCount(type: $0.key.type, site: $0.key.site, count: $0.value) }
+            .sorted { ($0.count, $1.type, $1.site) > ($1.count, $0.type, $0.site) }
+    }
+
+    var total: Int {
+        self.lock.sync { self.counts.values.reduce(0, +) }
+    }
+
+    func track(_ object: AnyObject?, site: @autoclosure () -> String) {
+        guard let object = object else { return }
+
+        let key: Key? = self.lock.sync {
+            guard self._isEnabled else { return nil }
+            let key = Key(type: String(describing: type(of: object)), site: site())
+            self.counts[key, default: 0] += 1
+            return key
+        }
+        guard let key = key else { return }
+        objc_setAssociatedObject(object, &BridgedObjectTracker.tokenKey, Token(key: key, tracker: self), .OBJC_ASSOCIATION_RETAIN)
+    }
+
+    /// Tracks the object at the caller's file and line
+    func track(_ object: AnyObject?, file: String = #fileID, line: Int = #line) {
+        self.track(object, site: "\((file as NSString).lastPathComponent):\(line)")
+    }
+
+    func removeAll() {
+        self.lock.sync { self.counts.removeAll() }
+    }
+
+    fileprivate func release(_ key: Key) {
+        self.lock.sync {
+            guard let count = self.counts[key] else { return }
+            self.counts[key] = (count > 1) ? count - 1 : nil
+        }
+    }
+}
+
+/// Released with the tracked object, possibly on the Go runtime's thread
+private final class Token {
+    private let key: BridgedObjectTracker.Key
+    private weak var tracker: BridgedObjectTracker?
+
+    init(key: BridgedObjectTracker.Key, tracker: BridgedObjectTracker) {
+        self.key = key
+        self.tracker = tracker
+    }
+
+    deinit {
+        self.tracker?.release(self.key)
+    }
+}
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Records the events of the low level client as an `EventRecording`, to be replayed later.
+///
+/// Disabled by default; when disabled every call returns after reading `isEnabled`. Events are
+/// recorded on the low level client's thread, hence the lock. Message texts are replaced with
+/// as many `x` characters unless `scrubsMessageText` is turned off, so the recording keeps the
+/// size of the conversation but not its content. Recording stops once `capacity` is reached.
+final class EventRecorder {
+    /// Set before the session starts; read under the lock, as events are recorded on another thread
+    var isEnabled: Bool {
+        get { self.lock.sync { self._isEnabled } }
+        set { self.lock.sync { self._isEnabled = newValue } }
+    }
+    var scrubsMessageText: Bool {
+        get { self.lock.sync { self._scrubsMessageText } }
+        set { self.lock.sync { self._scrubsMessageText = newValue } }
+    }
+
+    private let capacity: Int
+    private let uptime: () -> UInt64
+    private let lock = DispatchQueue(label: "com.ninchat.sdk.swift.recorder")
+    private var _isEnabled = false
+    private var _scrubsMessageText = true
+    private var startedAt: UInt64?
+    private var entries: [EventRecording.Entry] = []
+
+    init(capacity: Int = 20_000, uptime: @escaping () -> UInt64 = { DispatchTime.now().uptimeNanoseconds }) {
+        self.capacity = capacity
+        self.uptime = uptime
+    }
+
+    var recording: EventRecording {
+        self.lock.sync { EventRecording(entries: self.entries) }
+    }
+
+    func record(session params: ClientProps) {
+        guard self.isEnabled else { return }
+        self.record(kind: .session, params: params, payload: nil, lastReply: false)
+    }
+
+    func record(event params: ClientProps, payload: ClientPayload, lastReply: Bool) {
+        guard self.isEnabled else { return }
+        self.record(kind: .event, params: params, payload: payload, lastReply: lastReply)
+    }
+
+    func removeAll() {
+        self.lock.sync {
+            self.startedAt = nil
+            self.entries.removeAll()
+        }
+    }
+
+    private func record(kind: EventRecording.Entry.Kind, params: ClientProps, payload: ClientPayload?, lastReply: Bool) {
+        let now = self.uptime()
+        let params = params.json
+
+        let scrubsMessageText = self.scrubsMessageText
+        let frames = (payload ?? []).map { frame -> Data in
+            scrubsMessageText ? self.scrubbed(frame) : frame
+        }
+        self.lock.sync {
+            guard self.entries.count < self.capacity else { return }
+            if self.entries.count == self.capacity - 1 {
+                logger.warning(.event, "Event recording is full, later events are not recorded")
+            }
+
+            let startedAt = self.startedAt ?? now
+            self.startedAt = startedAt
+            self.entries.append(EventRecording.Entry(kind: kind, offset: Double(now &- startedAt) / 1_000_000_000, params: params, payload: frames, lastReply: lastReply))
+        }
+    }
+
+    /// Replaces the text of a message frame, e.g. `{"text":"Hello"}`
+    private func scrubbed(_ frame: Data) -> Data {
+        guard var message = (try? JSONSerialization.jsonObject(with: frame)) as? [String:Any], let text = message["text"] as? String else { return frame }
+
+        message["text"] = String(repeating: "x", count: text.count)
+        return (try? JSONSerialization.data(withJSONObject: message)) ?? frame
+    }
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+enum EventRecordingError: Error {
+    case invalidEntry(line: Int)
+}
+
+/// Events received from the low level client, in the order they arrived.
+///
+/// Stored as JSON lines, one entry per line:
+///
+///     {"t":0.125,"k":"e","p":{"event":"message_received",...},"d":["{\"text\":\"...\"}"],"l":true}
+///
+/// `t` is the offset in seconds from the first entry, `k` is `s` for session events and `e` for the
+/// others, `p` the event's parameters and `l` the last reply flag. The payload frames are kept in `d`
+/// as text; the indices of binary frames, stored in base64, are listed in `b`.
+struct EventRecording {
+    struct Entry {
+        enum Kind: String {
+            case session = "s"
+            case event = "e"
+        }
+
+        let kind: Kind
+        /// Seconds since the first entry
+        let offset: TimeInterval
+        /// The parameters as JSON
+        let params: String
+        let payload: [Data]
+        let lastReply: Bool
+    }
+
+    var entries: [Entry]
+
+    init(entries: [Entry] = []) {
+        self.entries = entries
+    }
+
+    init(data: Data) throws {
+        self.entries = try String(decoding: data, as: UTF8.self)
+            .split(separator: "\n", omittingEmptySubsequences: true)
+            .enumerated()
+            .map { index, line in
+                guard let entry = Entry(line: Data(line.utf8)) else { throw EventRecordingError.invalidEntry(line: index + 1) }
+                return entry
+            }
+    }
+
+    var data: Data {
+        self.entries.reduce(into: Data()) { data, entry in
+            guard let line = entry.line else { return }
+            data.append(line)
+            data.append(0x0A)
+        }
+    }
+}
+
+extension EventRecording.Entry {
+    /// The event's type, e.g. `message_received`
+    var event: String {
+        (self.props?.event.optional).flatMap { $0.isEmpty ? nil : $0 } ?? "unknown"
+    }
+
+    var props: ClientProps? {
+        try? ClientProps(json: self.params)
+    }
+
+    fileprivate init?(line: Data) {
+        guard let dictionary = (try? JSONSerialization.jsonObject(with: line)) as? [String:Any],
+              let kind = (dictionary["k"] as? String).flatMap({ Kind(rawValue: $0) }),
+              let offset = dictionary["t"] as? Double,
+              let paramsObject = dictionary["p"],
+              let params = try? JSONSerialization.data(withJSONObject: paramsObject)
+            else { return nil }
+
+        let binary = Set(dictionary["b"] as? [Int] ?? [])
+        let frames = (dictionary["d"] as? [String] ?? []).enumerated().map { index, frame -> Data? in
+            binary.contains(index) ? Data(base64Encoded: frame) : Data(frame.utf8)
+        }
+        guard !frames.contains(where: { $0 == nil }) else { return nil }
+
+        self.init(kind: kind, offset: offset, params: String(decoding: params, as: UTF8.self), payload: frames.compactMap { $0 }, lastReply: dictionary["l"] as? Bool ?? false)
+    }
+
+    fileprivate var line: Data? {
+        guard let params = try? JSONSerialization.jsonObject(with: Data(self.params.utf8)) else { return nil }
+
+        var binary: [Int] = []
+        let frames = self.payload.enumerated().map { index, frame -> String in
+            if let text = String(data: frame, encoding: .utf8) { return text }
+            binary.append(index)
+            return frame.base64EncodedString()
+        }
+
+        var dictionary: [String:Any] = ["k": self.kind.rawValue, "t": (self.offset * 1_000_000).rounded() / 1_000_000, "p": params]
+        if !frames.isEmpty { dictionary["d"] = frames }
+        if !binary.isEmpty { dictionary["b"] = binary }
+        if self.lastReply { dictionary["l"] = true }
+        return try? JSONSerialization.data(withJSONObject: dictionary, options: [.sortedKeys])
+    }
+}
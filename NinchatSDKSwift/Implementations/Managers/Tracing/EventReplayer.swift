@@ -0,0 +1,92 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Feeds an `EventRecording` through the session manager's event handlers and measures how long
+/// handling every event takes.
+///
+/// Events are handled on the main thread, as they are in a session. At `maximum` speed they are
+/// handled back to back; at `recorded` speed each one waits for its offset in the recording.
+/// Memory is sampled after every event.
+final class EventReplayer {
+    enum Speed {
+        case recorded
+        case maximum
+    }
+
+    struct Report {
+        let events: Int
+        /// Seconds from the first event until the last one was handled
+        let duration: TimeInterval
+        /// Events handled per second
+        var throughput: Double {
+            (self.duration > 0) ? Double(self.events) / self.duration : 0
+        }
+        /// Time spent handling the events, per event type
+        let costs: [String:LatencyHistogram]
+        /// The highest memory footprint seen, in bytes
+        let peakMemory: UInt64?
+    }
+
+    private let recording: EventRecording
+    private let uptime: () -> UInt64
+    private let memoryFootprint: () -> UInt64?
+
+    init(recording: EventRecording, uptime: @escaping () -> UInt64 = { DispatchTime.now().uptimeNanoseconds }, memoryFootprint: @escaping () -> UInt64? = { ProcessInfo.processInfo.memoryFootprint }) {
+        self.recording = recording
+        self.uptime = uptime
+        self.memoryFootprint = memoryFootprint
+    }
+
+    /// At `maximum` speed the replay is done before returning, when called on the main thread
+    func replay(into handlers: NINChatSessionManagerEventHandlers, speed: Speed = .maximum, completion: @escaping (Report) -> Void) {
+        let entries = self.recording.entries
+        let startedAt = self.uptime()
+        var costs: [String:LatencyHistogram] = [:]
+        var peakMemory = self.memoryFootprint()
+
+        func handle(_ entry: EventRecording.Entry) {
+            guard let props = entry.props else { return }
+
+            let start = self.uptime()
+            switch entry.kind {
+            case .session:
+                handlers.onSessionEvent(param: props)
+            case .event:
+                handlers.onEvent(param: props, payload: entry.payload, lastReplay: entry.lastReply)
+            }
+            costs[entry.event, default: LatencyHistogram()].record(nanoseconds: self.uptime() &- start)
+
+            if let memory = self.memoryFootprint() {
+                peakMemory = max(peakMemory ?? 0, memory)
+            }
+        }
+        func finish() {
+            completion(Report(events: entries.count, duration: Double(self.uptime() &- startedAt) / 1_000_000_000, costs: costs, peakMemory: peakMemory))
+        }
+
+        switch speed {
+        case .maximum:
+            let run = {
+                entries.forEach { handle($0) }
+                finish()
+            }
+            if Thread.isMainThread { run() } else { DispatchQueue.main.async(execute: run) }
+        case .recorded:
+            let scheduledAt = DispatchTime.now()
+            func schedule(_ index: Int) {
+                guard index < entries.count else { finish(); return }
+
+                DispatchQueue.main.asyncAfter(deadline: scheduledAt + max(entries[index].offset, 0)) {
+                    handle(entries[index])
+                    schedule(index + 1)
+                }
+            }
+            schedule(0)
+        }
+    }
+}
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Monotonic timestamps of a single event on its way from the low level client to the screen
+final class EventTrace {
+    enum Stage: Int, CaseIterable, CustomStringConvertible {
+        /// The low level client called back, on its own thread
+        case received
+        /// The main queue started handling the event
+        case dispatched
+        /// The event's payload is decoded into a message
+        case decoded
+        /// A new version of the messages including the message is published
+        case committed
+        /// The chat view shows the version
+        case rendered
+
+        var description: String {
+            switch self {
+            case .received: return "received"
+            case .dispatched: return "dispatched"
+            case .decoded: return "decoded"
+            case .committed: return "committed"
+            case .rendered: return "rendered"
+            }
+        }
+    }
+
+    var event = "unknown"
+    fileprivate(set) var isFinished = false
+    /// Uptime in nanoseconds, indexed by the stage
+    private(set) var stamps = [UInt64?](repeating: nil, count: Stage.allCases.count)
+
+    init(receivedAt uptime: UInt64) {
+        self.stamps[Stage.received.rawValue] = uptime
+    }
+
+    func mark(_ stage: Stage, at uptime: UInt64) {
+        guard self.stamps[stage.rawValue] == nil else { return }
+        self.stamps[stage.rawValue] = uptime
+    }
+
+    func stamp(of stage: Stage) -> UInt64? {
+        self.stamps[stage.rawValue]
+    }
+
+    /// The recorded stages in order
+    var stages: [(stage: Stage, uptime: UInt64)] {
+        Stage.allCases.compactMap { stage in self.stamp(of: stage).map { (stage, $0) } }
+    }
+
+    /// Time from receiving the event until its last recorded stage
+    var total: UInt64 {
+        guard let first = self.stages.first, let last = self.stages.last, last.uptime >= first.uptime else { return 0 }
+        return last.uptime - first.uptime
+    }
+}
+
+/// Traces the events of the session and aggregates the time they spend in every stage per event type.
+///
+/// Events are handled on the main thread one at a time, so the event being handled is the `current`
+/// one, and the message code marks its stages on it. While tracing is off `begin()` returns nil, so
+/// there is no `current` trace to mark. Events whose messages are published wait for the chat view
+/// to show that version; the others are done once handled.
+final class EventTracer {
+    typealias Histograms = (total: LatencyHistogram, stages: [String:LatencyHistogram])
+
+    /// Set before the session starts; read from the low level client's thread
+    var isEnabled = false
+
+    private let uptime: () -> UInt64
+    private let awaitingCapacity: Int
+    private(set) var current: EventTrace?
+    /// Traces waiting for the chat view to show the given version
+    private var awaitingRender: [(version: Int, trace: EventTrace)] = []
+    private(set) var histograms: [String:Histograms] = [:]
+    private var recent: NINRingBuffer<EventTrace>
+
+    init(capacity: Int = 1000, awaitingCapacity: Int = 64, uptime: @escaping () -> UInt64 = { DispatchTime.now().uptimeNanoseconds }) {
+        self.uptime = uptime
+        self.awaitingCapacity = awaitingCapacity
+        self.recent = NINRingBuffer(capacity: capacity)
+    }
+
+    /// Starts a trace on the thread the event is received on
+    func begin() -> EventTrace? {
+        guard self.isEnabled else { return nil }
+        return EventTrace(receivedAt: self.uptime())
+    }
+
+    /// Handles the event on the main thread as the `current` one
+    func dispatch(_ trace: EventTrace?, _ handle: () -> Void) {
+        guard let trace = trace else { handle(); return }
+
+        trace.mark(.dispatched, at: self.uptime())
+        self.current = trace
+        handle()
+        self.current = nil
+
+        if !self.awaitingRender.contains(where: { $0.trace === trace }) {
+            self.finish(trace)
+        }
+    }
+
+    func mark(_ stage: EventTrace.Stage) {
+        self.current?.mark(stage, at: self.uptime())
+    }
+
+    /// The current event is published in the given version of the messages
+    func committed(version: Int) {
+        guard let trace = self.current else { return }
+
+        /// The first version including the event is the one to wait for
+        guard !self.awaitingRender.contains(where: { $0.trace === trace }) else { return }
+        trace.mark(.committed, at: self.uptime())
+        self.awaitingRender.append((version, trace))
+        /// Nothing is rendering, e.g. the chat view is not shown yet
+        while self.awaitingRender.count > self.awaitingCapacity {
+            self.finish(self.awaitingRender.removeFirst().trace)
+        }
+    }
+
+    /// The chat view shows the given version, including the ones before it
+    func rendered(version: Int) {
+        guard !self.awaitingRender.isEmpty else { return }
+
+        let now = self.uptime()
+        let (done, waiting) = (self.awaitingRender.filter { $0.version <= version }, self.awaitingRender.filter { $0.version > version })
+        self.awaitingRender = waiting
+        done.forEach {
+            $0.trace.mark(.rendered, at: now)
+            self.finish($0.trace)
+        }
+    }
+
+    func reset() {
+        self.awaitingRender.removeAll()
+        self.histograms.removeAll()
+        self.recent.removeAll()
+    }
+
+    private func finish(_ trace: EventTrace) {
+        guard !trace.isFinished else { return }
+        trace.isFinished = true
+
+        var histograms = self.histograms[trace.event] ?? (LatencyHistogram(), [:])
+        histograms.total.record(nanoseconds: trace.total)
+        let stages = trace.stages
+        zip(stages, stages.dropFirst()).forEach { start, end in
+            histograms.stages["\(start.stage)→\(end.stage)", default: LatencyHistogram()].record(nanoseconds: end.uptime &- start.uptime)
+        }
+        self.histograms[trace.event] = histograms
+        self.recent.append(trace)
+    }
+
+    // MARK: - Reporting
+
+    var latencies: [NINEventLatency] {
+        self.histograms.keys.sorted().compactMap { event in
+            guard let histograms = self.histograms[event], let total = NINEventLatency.Distribution(histograms.total) else { return nil }
+            return NINEventLatency(event: event, total: total, stages: histograms.stages.compactMapValues { NINEventLatency.Distribution($0) })
+        }
+    }
+
+    /// The latest traces in the Chrome trace event format, which Perfetto and `chrome://tracing` open
+    func exportTrace() -> Data? {
+        let events: [[String:Any]] = self.recent.elements.enumerated().flatMap { index, trace -> [[String:Any]] in
+            let stages = trace.stages
+            return zip(stages, stages.dropFirst()).map { start, end in
+                [
+                    "name": "\(start.stage)→\(end.stage)",
+                    "cat": trace.event,
+                    "ph": "X",
+                    "ts": Double(start.uptime) / 1_000,
+                    "dur": Double(end.uptime &- start.uptime) / 1_000,
+                    "pid": 1,
+                    "tid": 1,
+                    "args": ["event": trace.event, "trace": index]
+                ]
+            }
+        }
+        return try? JSONSerialization.data(withJSONObject: ["traceEvents": events, "displayTimeUnit": "ms"])
+    }
+}
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Counts latencies in power of two buckets of microseconds, so recording is constant in time and space.
+/// Percentiles are reported as the upper bound of the bucket they fall in, capped to the maximum seen.
+struct LatencyHistogram {
+    /// Bucket `i` counts latencies below `2^i` microseconds; the last one counts the rest
+    private(set) var buckets = [Int](repeating: 0, count: 32)
+    private(set) var count = 0
+    private(set) var sum: UInt64 = 0
+    private(set) var max: UInt64 = 0
+
+    mutating func record(nanoseconds: UInt64) {
+        let microseconds = nanoseconds / 1_000
+        let index = microseconds == 0 ? 0 : Swift.min(UInt64.bitWidth - microseconds.leadingZeroBitCount, self.buckets.count - 1)
+        self.buckets[index] += 1
+        self.count += 1
+        self.sum &+= nanoseconds
+        self.max = Swift.max(self.max, nanoseconds)
+    }
+
+    /// The latency below which the fraction `p` of the recorded ones are, in seconds
+    func percentile(_ p: Double) -> TimeInterval? {
+        guard self.count > 0 else { return nil }
+
+        let rank = Swift.max(1, Int((p * Double(self.count)).rounded(.up)))
+        var seen = 0
+        for (index, count) in self.buckets.enumerated() {
+            seen += count
+            if seen >= rank {
+                let upperBound = UInt64(1) << UInt64(index) * 1_000
+                return Double(Swift.min(upperBound, self.max)) / 1_000_000_000
+            }
+        }
+        return Double(self.max) / 1_000_000_000
+    }
+
+    var mean: TimeInterval? {
+        guard self.count > 0 else { return nil }
+        return Double(self.sum) / Double(self.count) / 1_000_000_000
+    }
+}
@@ -0,0 +1,17 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Live objects of the low level client of one type, created or received at one call site.
+/// Each of them holds memory in the Go runtime until it is released.
+public struct NINBridgedObjectCount: Equatable {
+    /// e.g. `NINLowLevelClientProps`
+    public let type: String
+    /// e.g. `onEvent(message_received)`, `get(channel_attrs)` or `NINChatSessionManagerImpl.swift:571`
+    public let site: String
+    public let count: Int
+}
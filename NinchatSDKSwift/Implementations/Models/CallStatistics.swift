@@ -0,0 +1,25 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Connection quality of an ongoing video call, sampled periodically
+public struct NINCallStatistics: Equatable {
+    /// Bitrate of the media sent, in kbit/s
+    public let outgoingBitrate: Double
+    /// Bitrate of the media received, in kbit/s
+    public let incomingBitrate: Double
+    /// Bitrate the connection is estimated to allow for sending, in kbit/s
+    public let availableOutgoingBitrate: Double?
+    /// Round trip time of the selected candidate pair, in milliseconds
+    public let roundTripTime: Double?
+    /// Fraction of the packets lost, between 0 and 1
+    public let packetLoss: Double
+    /// Frame rate of the local video being sent
+    public let framesPerSecond: Double?
+    /// Size of the local video being sent
+    public let frameSize: CGSize?
+}
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// An immutable version of the chat messages, ordered most recent first
+struct ChatSnapshot {
+    static let empty = ChatSnapshot(version: 0, messages: [])
+
+    let version: Int
+    let messages: [ChatMessage]
+}
+
+/// Changes between two consecutive snapshots
+struct ChatSnapshotDiff: Equatable {
+    let from: Int
+    let to: Int
+
+    /// Indices in the old snapshot
+    let removed: [Int]
+    /// Indices in the new snapshot
+    let inserted: [Int]
+    /// Indices in the new snapshot, for messages that were kept but changed
+    let updated: [Int]
+    /// The change can not be described with removes and inserts, e.g. the messages got reordered
+    let reload: Bool
+
+    var isEmpty: Bool {
+        removed.isEmpty && inserted.isEmpty && updated.isEmpty && !reload
+    }
+}
+
+/**
+ * Keeps the chat messages as copy-on-write snapshots. Each update publishes a
+ * new version, so a reader on any thread sees either the old or the new
+ * messages, never a half-applied change.
+ *
+ * Updates are expected to be serialized by the owner (the session manager);
+ * the transform gets the current messages and must not read the store itself.
+ */
+final class ChatMessageStore {
+    private var current: ChatSnapshot
+    /// IDs of the current messages, kept up to date from the diffs
+    private var ids: Set<String> = []
+    private var channelMessages = 0
+    private let queue = DispatchQueue(label: "com.ninchat.sdk.swift.messages")
+
+    /// Starts from the given version, e.g. to continue the messages of another store
+    init(snapshot: ChatSnapshot = .empty) {
+        self.current = snapshot
+        snapshot.messages.forEach { self.remember($0) }
+    }
+
+    var snapshot: ChatSnapshot {
+        self.queue.sync { self.current }
+    }
+
+    /// O(1), unlike scanning the snapshot
+    func contains(messageID: String) -> Bool {
+        self.queue.sync { self.ids.contains(messageID) }
+    }
+
+    /// Number of `ChannelMessage`s in the current snapshot
+    var channelMessageCount: Int {
+        self.queue.sync { self.channelMessages }
+    }
+
+    /// Applies the transform on a copy of the messages and publishes it as a new version.
+    /// `updated` lists messages changed in place, other changes are detected by messageID.
+    @discardableResult
+    func update(updated ids: Set<String> = [], _ transform: (inout [ChatMessage]) -> Void) -> (snapshot: ChatSnapshot, diff: ChatSnapshotDiff) {
+        self.queue.sync {
+            var messages = self.current.messages
+            transform(&messages)
+
+            let snapshot = ChatSnapshot(version: self.current.version + 1, messages: messages)
+            let diff = ChatMessageStore.diff(from: self.current, to: snapshot, updated: ids)
+            diff.removed.forEach { self.forget(self.current.messages[$0]) }
+            diff.inserted.forEach { self.remember(snapshot.messages[$0]) }
+            self.current = snapshot
+            return (snapshot, diff)
+        }
+    }
+
+    /// Publishes the same messages as a version after `version`, for readers that
+    /// followed another store and need to reload to this one.
+    @discardableResult
+    func republish(after version: Int) -> (snapshot: ChatSnapshot, diff: ChatSnapshotDiff) {
+        self.queue.sync {
+            let snapshot = ChatSnapshot(version: max(self.current.version, version) + 1, messages: self.current.messages)
+            let diff = ChatSnapshotDiff(from: version, to: snapshot.version, removed: [], inserted: [], updated: [], reload: true)
+            self.current = snapshot
+            return (snapshot, diff)
+        }
+    }
+
+    private func remember(_ message: ChatMessage) {
+        guard self.ids.insert(message.messageID).inserted else { return }
+        if message is ChannelMessage { self.channelMessages += 1 }
+    }
+
+    private func forget(_ message: ChatMessage) {
+        guard self.ids.remove(message.messageID) != nil else { return }
+        if message is ChannelMessage { self.channelMessages -= 1 }
+    }
+
+    static func diff(from old: ChatSnapshot, to new: ChatSnapshot, updated ids: Set<String> = []) -> ChatSnapshotDiff {
+        var oldIndices: [String:Int] = [:]
+        old.messages.enumerated().forEach { oldIndices[$1.messageID] = oldIndices[$1.messageID] ?? $0 }
+        let newIDs = Set(new.messages.map { $0.messageID })
+
+        let removed = old.messages.indices.filter { !newIDs.contains(old.messages[$0].messageID) }
+        let inserted = new.messages.indices.filter { oldIndices[new.messages[$0].messageID] == nil }
+
+        /// Kept messages must stay in the same relative order to be expressed as removes and inserts
+        let keptOld = old.messages.lazy.map({ $0.messageID }).filter { newIDs.contains($0) }
+        let keptNew = new.messages.lazy.map({ $0.messageID }).filter { oldIndices[$0] != nil }
+        let reload = !keptOld.elementsEqual(keptNew)
+
+        let updated = new.messages.indices.filter { index in
+            let message = new.messages[index]
+            guard let oldIndex = oldIndices[message.messageID] else { return false }
+            return ids.contains(message.messageID) || ChatMessageStore.presentationChanged(old.messages[oldIndex], message)
+        }
+        return ChatSnapshotDiff(from: old.version, to: new.version, removed: removed, inserted: inserted, updated: updated, reload: reload)
+    }
+
+    /// Series and deletion are recomputed on neighbours when messages are added
+    private static func presentationChanged(_ old: ChatMessage, _ new: ChatMessage) -> Bool {
+        if let old = old as? ChannelMessage, let new = new as? ChannelMessage, old.series != new.series {
+            return true
+        }
+        if let old = old as? TextMessage, let new = new as? TextMessage, old.isDeleted != new.isDeleted {
+            return true
+        }
+        return false
+    }
+}
@@ -5,7 +5,9 @@
 //
 
 import Foundation
+#if canImport(MobileCoreServices)
 import MobileCoreServices
+#endif
 
 struct ChatMessagePayload: Decodable {
     let text: String?
@@ -26,9 +28,10 @@ struct Attributes: Decodable {
     var name: String = ""
     var type: String = ""
     var size: Int = 0
+    var thumbnail: ThumbnailAttributes?
     
     enum CodingKeys: String, CodingKey {
-        case name, type, size
+        case name, type, size, thumbnail
     }
     
     init(from decoder: Decoder) throws {
@@ -41,17 +44,30 @@ struct Attributes: Decodable {
             type = extractType(from: name)
         }
         size = try container.decode(Int.self, forKey: .size)
+        thumbnail = try? container.decode(ThumbnailAttributes.self, forKey: .thumbnail)
     }
     
     private func extractType(from name: String) -> String {
+        #if canImport(MobileCoreServices)
         let fileExtension = (name as NSString).pathExtension.lowercased()
         if let uti = UTTypeCreatePreferredIdentifierForTag(kUTTagClassFilenameExtension, fileExtension as NSString, nil)?.takeRetainedValue() {
             if let mimetype = UTTypeCopyPreferredTagWithClass(uti, kUTTagClassMIMEType)?.takeRetainedValue() {
                 return mimetype as String
             }
         }
+        #endif
         return "application/octet-stream"
     }
 
 }
 
+/// Known dimensions of the file's thumbnail, used to lay out attachments before they are described
+struct ThumbnailAttributes: Decodable {
+    let width: Int
+    let height: Int
+
+    var aspectRatio: Double? {
+        guard width > 0, height > 0 else { return nil }
+        return Double(width) / Double(height)
+    }
+}
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+import AnyCodable
+
+enum ClientPropsError: Error {
+    case missing(key: String)
+    case type(key: String, expected: String)
+
+    var localizedDescription: String {
+        switch self {
+        case .missing(let key):
+            return "Prop \"\(key)\" is not set"
+        case .type(let key, let expected):
+            return "Prop type: \"\(key)\" is not \(expected)"
+        }
+    }
+}
+
+/// The parameters of an event or an action of the low level client, as a Swift value.
+///
+/// The session logic reads and builds these, so it does not depend on the Go client's bridged
+/// objects; they are converted where the client's session is reached. As with the Go client, numbers
+/// are kept as `Double`, and a missing number, bool or string reads as its zero value, while a
+/// missing object or array fails.
+struct ClientProps: Equatable {
+    enum Value: Equatable {
+        case bool(Bool)
+        case number(Double)
+        case string(String)
+        case strings([String])
+        case object(ClientProps)
+        case objects([ClientProps])
+    }
+
+    private(set) var values: [String:Value]
+
+    init(_ values: [String:Value] = [:]) {
+        self.values = values
+    }
+
+    var keys: Dictionary<String,Value>.Keys {
+        self.values.keys
+    }
+
+    subscript(key: String) -> Value? {
+        get { self.values[key] }
+        set { self.values[key] = newValue }
+    }
+}
+
+/// The payload frames of an event or an action
+typealias ClientPayload = [Data]
+
+// MARK: - Getters and setters
+
+extension ClientProps {
+    func get<T>(forKey key: String) -> NINResult<T> {
+        let value = self.values[key]
+        switch (T.self, value) {
+        case (is Int.Type, .number(let number)?):
+            return .success(Int(number) as! T)
+        case (is Int.Type, nil):
+            return .success(0 as! T)
+        case (is Double.Type, .number(let number)?):
+            return .success(number as! T)
+        case (is Double.Type, nil):
+            return .success(0.0 as! T)
+        case (is Bool.Type, .bool(let bool)?):
+            return .success(bool as! T)
+        case (is Bool.Type, nil):
+            return .success(false as! T)
+        case (is String.Type, .string(let string)?):
+            return .success(string as! T)
+        case (is String.Type, nil):
+            return .success("" as! T)
+        case (is [String].Type, .strings(let strings)?):
+            return .success(strings as! T)
+        case (is ClientProps.Type, .object(let object)?):
+            return .success(object as! T)
+        case (is [ClientProps].Type, .objects(let objects)?):
+            return .success(objects as! T)
+        case (is [String].Type, nil), (is ClientProps.Type, nil), (is [ClientProps].Type, nil):
+            return .failure(ClientPropsError.missing(key: key))
+        case (is Int.Type, _), (is Double.Type, _):
+            return .failure(ClientPropsError.type(key: key, expected: "a number"))
+        case (is Bool.Type, _):
+            return .failure(ClientPropsError.type(key: key, expected: "a bool"))
+        case (is String.Type, _):
+            return .failure(ClientPropsError.type(key: key, expected: "a string"))
+        case (is [String].Type, _):
+            return .failure(ClientPropsError.type(key: key, expected: "a string array"))
+        case (is ClientProps.Type, _):
+            return .failure(ClientPropsError.type(key: key, expected: "an object"))
+        case (is [ClientProps].Type, _):
+            return .failure(ClientPropsError.type(key: key, expected: "an object array"))
+        default:
+            fatalError("Error in getting requested type: \(T.self) forKey: \(key)")
+        }
+    }
+
+    mutating func set<T>(value: T, forKey key: String) {
+        if let value = value as? AnyCodable {
+            self.set(value: value.value as! AnyHashable, forKey: key)
+        } else if let value = value as? Bool {
+            self.values[key] = .bool(value)
+        } else if let value = value as? Double {
+            self.values[key] = .number(value)
+        } else if let value = value as? Int {
+            self.values[key] = .number(Double(value))
+        } else if let value = value as? String {
+            self.values[key] = .string(value)
+        } else if let value = value as? [String] {
+            self.values[key] = .strings(value)
+        } else if let value = value as? ClientProps {
+            self.values[key] = .object(value)
+        } else if let value = value as? [ClientProps] {
+            self.values[key] = .objects(value)
+        } else {
+            fatalError("Error in setting requested type: \(T.self) forKey: \(key)")
+        }
+    }
+}
+
+// MARK: - JSON
+
+extension ClientProps: Codable {
+    private struct Key: CodingKey {
+        let stringValue: String
+        var intValue: Int? { nil }
+
+        init(stringValue: String) {
+            self.stringValue = stringValue
+        }
+
+        init?(intValue: Int) {
+            return nil
+        }
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: Key.self)
+        self.values = try container.allKeys.reduce(into: [:]) { values, key in
+            /// As the Go client does not keep nulls either
+            guard try !container.decodeNil(forKey: key) else { return }
+            values[key.stringValue] = try container.decode(Value.self, forKey: key)
+        }
+    }
+
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: Key.self)
+        try self.values.forEach { key, value in
+            try container.encode(value, forKey: Key(stringValue: key))
+        }
+    }
+
+    init(json: String) throws {
+        self = try JSONDecoder().decode(ClientProps.self, from: Data(json.utf8))
+    }
+
+    /// The keys are sorted, so equal props give equal JSON
+    var json: String {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+        return (try? encoder.encode(self)).map { String(decoding: $0, as: UTF8.self) } ?? "{}"
+    }
+}
+
+extension ClientProps.Value: Codable {
+    init(from decoder: Decoder) throws {
+        let container = try decoder.singleValueContainer()
+        /// Bools are tried first, as JSON numbers do not decode as bools
+        if let bool = try? container.decode(Bool.self) {
+            self = .bool(bool)
+        } else if let number = try? container.decode(Double.self) {
+            self = .number(number)
+        } else if let string = try? container.decode(String.self) {
+            self = .string(string)
+        } else if let strings = try? container.decode([String].self) {
+            self = .strings(strings)
+        } else if let objects = try? container.decode([ClientProps].self) {
+            self = .objects(objects)
+        } else {
+            self = .object(try container.decode(ClientProps.self))
+        }
+    }
+
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.singleValueContainer()
+        switch self {
+        case .bool(let bool):
+            try container.encode(bool)
+        case .number(let number):
+            try container.encode(number)
+        case .string(let string):
+            try container.encode(string)
+        case .strings(let strings):
+            try container.encode(strings)
+        case .object(let object):
+            try container.encode(object)
+        case .objects(let objects):
+            try container.encode(objects)
+        }
+    }
+}
@@ -0,0 +1,34 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Latency of the events of one type, from the low level client until they are handled,
+/// or for messages, until they are shown in the chat view.
+public struct NINEventLatency {
+    public struct Distribution {
+        public let count: Int
+        /// In seconds
+        public let p50: TimeInterval
+        public let p90: TimeInterval
+        public let p99: TimeInterval
+        public let max: TimeInterval
+    }
+
+    /// The event type, e.g. `message_received`
+    public let event: String
+    public let total: Distribution
+    /// Latencies between consecutive stages, keyed as `received→dispatched`, `dispatched→decoded`,
+    /// `decoded→committed` and `committed→rendered`
+    public let stages: [String:Distribution]
+}
+
+extension NINEventLatency.Distribution {
+    init?(_ histogram: LatencyHistogram) {
+        guard let p50 = histogram.percentile(0.5), let p90 = histogram.percentile(0.9), let p99 = histogram.percentile(0.99) else { return nil }
+        self.init(count: histogram.count, p50: p50, p90: p90, p99: p99, max: Double(histogram.max) / 1_000_000_000)
+    }
+}
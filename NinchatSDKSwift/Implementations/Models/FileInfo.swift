@@ -15,10 +15,18 @@ final class FileInfo: Codable {
     var thumbnailUrl: String?
     var urlExpiry: Date?
     var aspectRatio: Double?
+
+    /// Completions waiting for an in-flight `describe_file` action.
+    /// The placeholder message and its cell may both ask for the same file.
+    private var pendingCompletions: [(Error?, _ didRefreshNetwork: Bool) -> Void]?
+
+    enum CodingKeys: String, CodingKey {
+        case fileID, name, mimeType, size, url, thumbnailUrl, urlExpiry, aspectRatio
+    }
     
     // MARK: - Initializer
     
-    init(fileID: String, name: String, mimeType: String, size: Int, url: String? = nil, thumbnailUrl: String? = nil, urlExpiry: Date? = nil) {
+    init(fileID: String, name: String, mimeType: String, size: Int, url: String? = nil, thumbnailUrl: String? = nil, urlExpiry: Date? = nil, aspectRatio: Double? = nil) {
         self.fileID = fileID
         self.name = name
         self.mimeType = mimeType
@@ -26,6 +34,7 @@ final class FileInfo: Codable {
         self.url = url
         self.thumbnailUrl = thumbnailUrl
         self.urlExpiry = urlExpiry
+        self.aspectRatio = aspectRatio
     }
     
     // MARK: - Getters
@@ -55,30 +64,42 @@ final class FileInfo: Codable {
     func updateInfo(session: NINChatSessionAttachment?, completion: @escaping (Error?, _ didRefreshNetwork: Bool) -> Void) {
         /// The URL must not expire within the next 15 minutes
         guard fileExpired else {
-            debugger("No need to update file, it is up to date. \(self.name ?? "")")
+            logger.debug(.network, "No need to update file, it is up to date. \(self.name ?? "")")
             completion(nil, false)
             return
         }
 
-        debugger("Must update file info; call describe_file with id: \(self.fileID ?? "") and name: \(self.name ?? "")")
+        /// Join the ongoing request, if there is any
+        guard self.pendingCompletions == nil else {
+            self.pendingCompletions?.append(completion); return
+        }
+        self.pendingCompletions = [completion]
+
+        logger.debug(.network, "Must update file info; call describe_file with id: \(self.fileID ?? "") and name: \(self.name ?? "")")
         do {
             try session?.describe(file: self.fileID) { [weak self] error, fileInfo in
                 guard let `self` = self else { return }
                 if let error = error {
-                    debugger("error in describing the file: \(error.localizedDescription)")
-                    completion(error, false)
+                    logger.error(.network, "Error in describing the file: \(error.localizedDescription)")
+                    self.complete(error, false)
                 } else if let info = fileInfo {
-                    debugger("described file with id: \(self.fileID ?? "nil") and name: \(self.name ?? "")")
+                    logger.debug(.network, "Described file with id: \(self.fileID ?? "nil") and name: \(self.name ?? "")")
 
                     self.url = info["url"] as? String
                     self.urlExpiry = info["urlExpiry"] as? Date
                     self.thumbnailUrl = info["thumbnailUrl"] as? String
                     self.aspectRatio = info["aspectRatio"] as? Double
-                    completion(nil, true)
+                    self.complete(nil, true)
                 }
             }
         } catch {
-            completion(error, false)
+            self.complete(error, false)
         }
     }
+
+    private func complete(_ error: Error?, _ didRefreshNetwork: Bool) {
+        let completions = self.pendingCompletions ?? []
+        self.pendingCompletions = nil
+        completions.forEach { $0(error, didRefreshNetwork) }
+    }
 }
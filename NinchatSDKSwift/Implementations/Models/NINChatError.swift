@@ -5,9 +5,8 @@
 //
 
 import Foundation
-import NinchatLowLevelClient
 
-public extension NINLowLevelClientProps {
+extension ClientProps {
     var ninchatError: NinchatError? {
         let errorType: NINResult<String> = self.get(forKey: "error_type")
         if case let .success(error) = errorType {
@@ -21,7 +20,7 @@ public struct NinchatError: Error {
     public var type: String = "type_not_specified"
     public var reason, sessionID, actionID, userID, identityType, identityName, channelID, realmID, queueID, tagID, messageType: String?
 
-    init(type: String, props: NINLowLevelClientProps?) {
+    init(type: String, props: ClientProps?) {
         self.type = type
 
         /// Initial optional properties
@@ -93,6 +93,12 @@ struct LogicQuestionnaire: Codable {
     let target: String
     let queueId: String?
     let tags: [String]?
+    /// Identifies the block for `QuestionnaireLogicEvaluator`, copies of the block share it
+    let id = UUID()
+
+    enum CodingKeys: String, CodingKey {
+        case and, or, target, queueId, tags
+    }
 
     var andKeys: [String]? {
         self.and?
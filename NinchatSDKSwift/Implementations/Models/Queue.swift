@@ -13,7 +13,7 @@ enum QueuePermissionType: String {
 struct Queue: Hashable {
     let queueID: String
     let name: String
-    let isClosed: Bool
+    var isClosed: Bool
     let permissions: QueuePermissions
     var position: Int
     
@@ -0,0 +1,29 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Performance figures of a chat session. Durations are in seconds and nil until measured.
+public struct NINSessionMetrics {
+    /// From starting or prewarming the SDK until it was ready to show the first screen
+    public var startupDuration: TimeInterval?
+    /// From calling `start` until the first screen appeared
+    public var timeToFirstScreen: TimeInterval?
+    /// From opening the session until the server created it
+    public var sessionOpenDuration: TimeInterval?
+    /// From requesting to join a queue until the first queue position arrived
+    public var timeToFirstQueuePosition: TimeInterval?
+    /// From joining the latest channel until its first message was added
+    public var timeToFirstMessage: TimeInterval?
+    /// From requesting the latest history until its messages were added
+    public var historyLoadDuration: TimeInterval?
+    /// Events received from the server but not yet handled
+    public var eventBacklog: Int = 0
+    public var maxEventBacklog: Int = 0
+    /// Message and file payloads; the protocol overhead is not included
+    public var bytesSent: Int64 = 0
+    public var bytesReceived: Int64 = 0
+}
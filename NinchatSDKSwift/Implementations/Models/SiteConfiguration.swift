@@ -46,6 +46,8 @@ protocol SiteConfiguration  {
     var postAudienceQuestionnaireStyle: QuestionnaireStyle { get }
     var postAudienceQuestionnaireDictionary: Array<[String:AnyHashable]>? { get }
     var postAudienceQuestionnaire: [QuestionnaireConfiguration]? { get }
+    /// Queues the configuration refers to, found once when it is parsed
+    var queueIDs: [String] { get }
     
     init(configuration: [AnyHashable : Any]?, environments: [String]?)
     mutating func override(configuration: NINSiteConfiguration?)
@@ -54,6 +56,7 @@ protocol SiteConfiguration  {
 struct SiteConfigurationImpl: SiteConfiguration {
     private let configuration: [AnyHashable : Any]?
     private let environments: [String]
+    private(set) var queueIDs: [String] = []
 
     // MARK: - NINSiteConfiguration
 
@@ -189,6 +192,7 @@ struct SiteConfigurationImpl: SiteConfiguration {
     init(configuration: [AnyHashable : Any]?, environments: [String]?) {
         self.configuration = configuration ?? [:]
         self.environments = environments ?? []
+        self.queueIDs = self.referencedQueueIDs()
     }
 
     mutating func override(configuration: NINSiteConfiguration?) {
@@ -207,6 +211,19 @@ extension SiteConfigurationImpl {
         return self.prepareEnvironments().compactMap({ self.value(for: key, at: $0, ofType: type) }).first
     }
     
+    /// Queues listed under "audienceQueues" and "audienceAutoQueue", and the ones the questionnaires
+    /// target under the "queueId" key
+    private func referencedQueueIDs() -> [String] {
+        var queues: [String] = self.audienceQueues?.filter({ !$0.isEmpty }) ?? []
+        if let autoQueue = self.audienceAutoQueue?.trimmingCharacters(in: .whitespaces), !autoQueue.isEmpty {
+            queues.append(autoQueue)
+        }
+        [self.preAudienceQuestionnaireDictionary, self.postAudienceQuestionnaireDictionary].forEach {
+            queues.append(contentsOf: $0?.flatMap({ dict -> [String] in dict.find("queueId") }) ?? [])
+        }
+        return queues.uniqued()
+    }
+
     private func prepareEnvironments() -> [String] {
         /// Start the lookup
         var environments = self.environments
@@ -222,3 +239,20 @@ extension SiteConfigurationImpl {
         return environments
     }
 }
+
+// MARK: - Helpers
+
+extension Dictionary where Key==String {
+    func find<T>(_ key: String) -> [T] {
+        var keys: [T] = []
+        
+        if let value = self[key] as? T {
+            keys.append(value)
+        }
+        self.values.compactMap({ $0 as? [String:Any] }).forEach({
+            keys.append(contentsOf: $0.find(key))
+        })
+        
+        return keys
+    }
+}
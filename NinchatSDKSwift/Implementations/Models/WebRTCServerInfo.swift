@@ -5,16 +5,12 @@
 //
 
 import Foundation
-import WebRTC
 
 struct WebRTCServerInfo {
     let url: String
     let username: String?
     let credential: String?
     
-    var iceServer: RTCIceServer! {
-        RTCIceServer(urlStrings: [self.url], username: self.username ?? "", credential: self.credential ?? "")
-    }
     var description: String {
         "WebRTC server url: \(self.url)"
     }
@@ -55,6 +55,7 @@ public enum NINSessionExceptions: Error {
     case invalidRealmConfiguration
     case invalidServerAddress
     case sessionResumptionFailed
+    case startupCancelled
     
     public var localizedDescription: String {
         switch self {
@@ -80,6 +81,8 @@ public enum NINSessionExceptions: Error {
             return "Must have server address"
         case .sessionResumptionFailed:
             return "Failed to resume the session by given credentials. Try to initiate a new session instead."
+        case .startupCancelled:
+            return "The session was deallocated before it was started"
         }
     }
 }
@@ -13,6 +13,8 @@ enum ServiceResultError: Error {
 }
 
 struct ServiceManager {
+    /// Handle the requests before the system does, e.g. to answer them in process in tests
+    var protocolClasses: [AnyClass] = []
     private var session: URLSession?
     private var configuration: URLSessionConfiguration {
         let configuration = URLSessionConfiguration.default
@@ -23,6 +25,7 @@ struct ServiceManager {
         configuration.requestCachePolicy = .reloadIgnoringLocalCacheData
         configuration.urlCredentialStorage = nil
         configuration.urlCache = nil
+        configuration.protocolClasses = self.protocolClasses + (configuration.protocolClasses ?? [])
         return configuration
     }
     
@@ -0,0 +1,63 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+// MARK: - Constants used within the SDK
+
+public enum Constants: String {
+    case kTestServerAddress = "api.luupi.net"
+    case kProductionServerAddress = "api.ninchat.com"
+    
+    case kCloseWindowText = "Close window"
+    case kCloseText = "Close"
+    case kJoinQueueText = "Join audience queue {{audienceQueue.queue_attrs.name}}"
+    case kQueuePositionN = "Joined audience queue {{audienceQueue.queue_attrs.name}}, you are at position {{audienceQueue.queue_position}}."
+    case kQueuePositionNext = "Joined audience queue {{audienceQueue.queue_attrs.name}}, you are next."
+    case kCloseChatText = "Close chat"
+    case kConversationEnded = "Conversation ended"
+    case kCancelDialog = "Continue chat"
+    case kAcceptDialog = "Accept"
+    case kRejectDialog = "Decline"
+    case kTextInputPlaceholderText = "Enter your message"
+    case kCallInvitationText = "You are invited to a video chat"
+    case kCallInvitationInfoText = "wants to video chat with you"
+    case kRatingTitleText = "How was our customer service?"
+    case kRatingSkipText = "Skip"
+    case kVideoMeetingText = "Video meeting"
+    case kJoinVideoMeetingText = "Join video meeting"
+    case kThisMessageWasDeletedText = "This message was deleted"
+    
+    case kRatingPositiveText = "Good"
+    case kRatingNeutralText = "Okay"
+    case kRatingNegativeText = "Poor"
+    
+    case RTCSessionDescriptionType = "type"
+    case RTCSessionDescriptionSDP = "sdp"
+    case RTCIceCandidateKeyCandidate = "candidate"
+    case RTCIceCandidateSDPMLineIndex = "sdpMLineIndex"
+    case RTCIceCandidateSDPMid = "sdpMid"
+    
+    case kNinchatImageCacheKey = "ninchatsdk.swift.VideoThumbnailImageCache"
+    case kNinchatHTMLCacheKey = "ninchatsdk.swift.HTMLRenderCache"
+    case kNinchatAttachmentCacheKey = "ninchatsdk.swift.AttachmentImageCache"
+}
+
+enum NotificationConstants: String {
+    case kChannelMessageNotification =  "ninchatsdk.ChannelMessageNotification"
+    case kNINWebRTCSignalNotification = "ninchatsdk.NWebRTCSignalNotification"
+    case kNINChannelClosedNotification = "ninchatsdk.ChannelClosedNotification"
+    case kNINQueuedNotification = "ninchatsdk.QueuedNotification"
+}
+
+enum TimeConstants: TimeInterval {
+    case kTimerTickInterval = 0.05
+    case kMessageMaxAge = 1.0
+    case kAnimationDuration = 0.3
+    case kBannerAnimationDuration = 5.0
+    case kAnimationDelay = 1.5
+    case kBatchTimeout = 5.0
+}
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import UIKit
+
+/**
+ * The attachment images of a chat view, by message id.
+ *
+ * Shared by the media cells instead of each cell keeping the images of every message it has
+ * shown, so reusing a cell does not grow the memory; the images are evicted by count and decoded size.
+ */
+final class AttachmentImageCache {
+    private let thumbnails = NSCache<NSString, UIImage>()
+    private let originals = NSCache<NSString, UIImage>()
+
+    /// `costLimit` is in decoded bytes, for each of the thumbnails and the full images
+    init(countLimit: Int = 100, costLimit: Int = 64 * 1024 * 1024) {
+        [self.thumbnails, self.originals].forEach {
+            $0.name = Constants.kNinchatAttachmentCacheKey.rawValue
+            $0.countLimit = countLimit
+            $0.totalCostLimit = costLimit
+        }
+    }
+
+    /// The image shown in the bubble
+    func thumbnail(for messageID: String) -> UIImage? {
+        self.thumbnails.object(forKey: messageID as NSString)
+    }
+
+    func set(thumbnail image: UIImage, for messageID: String) {
+        self.thumbnails.setObject(image, forKey: messageID as NSString, cost: image.decodedSize)
+    }
+
+    /// The full image, for the full-screen viewer
+    func original(for messageID: String) -> UIImage? {
+        self.originals.object(forKey: messageID as NSString)
+    }
+
+    func set(original image: UIImage, for messageID: String) {
+        self.originals.setObject(image, forKey: messageID as NSString, cost: image.decodedSize)
+    }
+
+    func removeAll() {
+        self.thumbnails.removeAllObjects()
+        self.originals.removeAllObjects()
+    }
+}
+
+private extension UIImage {
+    var decodedSize: Int {
+        guard let image = self.cgImage else { return Int(self.size.width * self.scale * self.size.height * self.scale) * 4 }
+        return image.bytesPerRow * image.height
+    }
+}
@@ -0,0 +1,383 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import UIKit
+
+/// Attributes applied to a rendered HTML text, used along the text as the cache key
+struct HTMLStyle {
+    let font: UIFont?
+    let alignment: NSTextAlignment
+    let color: UIColor?
+    let width: CGFloat?
+
+    fileprivate var key: String {
+        "\(font?.fontName ?? "")|\(font?.pointSize ?? 0)|\(alignment.rawValue)|\(color?.description ?? "")|\(width ?? 0)"
+    }
+}
+
+/**
+ * Renders the subset of HTML used in chat messages and site configurations
+ * (p, div, b, strong, i, em, u, a, br, img, ul, ol, li) into attributed strings.
+ *
+ * Unlike `NSAttributedString(data:options:[.documentType: .html])`, the renderer
+ * does not go through WebKit and is safe to use off the main thread.
+ */
+final class HTMLRenderer {
+    static let shared = HTMLRenderer()
+
+    private let cache = NSCache<NSString, NSAttributedString>()
+    private let images = NSCache<NSURL, UIImage>()
+    private let queue = DispatchQueue(label: "com.ninchat.sdk.swift.html", qos: .userInitiated, attributes: .concurrent)
+
+    /// Loads images embedded with `<img>` without blocking; the completion may be called on any thread
+    var imageLoader: (URL, @escaping (UIImage?) -> Void) -> Void = { url, completion in
+        url.fetchImage { data, _ in completion(data.flatMap { UIImage(data: $0) }) }
+    }
+
+    init(countLimit: Int = 500) {
+        self.cache.name = Constants.kNinchatHTMLCacheKey.rawValue
+        self.cache.countLimit = countLimit
+        self.images.countLimit = countLimit
+    }
+
+    // MARK: - Rendering
+
+    func cached(_ text: String, style: HTMLStyle) -> NSAttributedString? {
+        self.cache.object(forKey: self.key(text, style))
+    }
+
+    /// Renders the text synchronously. Images that are not loaded yet are left out,
+    /// and the result is only cached once it has every image.
+    func render(_ text: String, style: HTMLStyle) -> NSAttributedString {
+        self.renderLoaded(text, style: style).rendered
+    }
+
+    /// Renders the text in the background, loads its missing images and renders it again
+    /// with them. The result is delivered on the main thread.
+    func render(_ text: String, style: HTMLStyle, completion: @escaping (NSAttributedString) -> Void) {
+        if let cached = self.cached(text, style: style) {
+            completion(cached); return
+        }
+        self.renderWithImages(text, style: style) { rendered in
+            DispatchQueue.main.async {
+                completion(rendered)
+            }
+        }
+    }
+
+    /// Warms up the cache for texts that are about to be shown
+    func prerender(_ texts: [String], style: HTMLStyle) {
+        texts.filter({ $0.containsTags && self.cached($0, style: style) == nil }).forEach {
+            self.renderWithImages($0, style: style) { _ in }
+        }
+    }
+
+    func removeAll() {
+        self.cache.removeAllObjects()
+        self.images.removeAllObjects()
+    }
+
+    private func renderLoaded(_ text: String, style: HTMLStyle) -> (rendered: NSAttributedString, missing: [URL]) {
+        if let cached = self.cached(text, style: style) { return (cached, []) }
+
+        let (rendered, missing) = HTMLParser(text: text, style: style, image: { [images] in images.object(forKey: $0 as NSURL) }).parse()
+        if missing.isEmpty {
+            self.cache.setObject(rendered, forKey: self.key(text, style))
+        }
+        return (rendered, missing)
+    }
+
+    /// Calls the completion on the background queue; images that fail to load stay left out
+    private func renderWithImages(_ text: String, style: HTMLStyle, completion: @escaping (NSAttributedString) -> Void) {
+        self.queue.async { [weak self] in
+            guard let self = self else { return }
+            let (rendered, missing) = self.renderLoaded(text, style: style)
+            guard !missing.isEmpty else { completion(rendered); return }
+
+            let group = DispatchGroup()
+            Set(missing).forEach { url in
+                group.enter()
+                self.imageLoader(url) { [weak self] image in
+                    if let image = image { self?.images.setObject(image, forKey: url as NSURL) }
+                    group.leave()
+                }
+            }
+            group.notify(queue: self.queue) { [weak self] in
+                guard let self = self else { return }
+                completion(self.renderLoaded(text, style: style).rendered)
+            }
+        }
+    }
+
+    private func key(_ text: String, _ style: HTMLStyle) -> NSString {
+        "\(style.key)|\(text)" as NSString
+    }
+}
+
+// MARK: - Parser
+
+private struct HTMLParser {
+    private static let entities: [String:String] = ["amp": "&", "lt": "<", "gt": ">", "quot": "\"", "apos": "'", "nbsp": "\u{00A0}"]
+    private static let ignoredContent: Set<String> = ["head", "style", "script", "title"]
+
+    let text: String
+    let style: HTMLStyle
+    let image: (URL) -> UIImage?
+
+    private let output = NSMutableAttributedString()
+    private var bold = 0
+    private var italic = 0
+    private var underline = 0
+    private var links: [URL?] = []
+    private var lists: [(ordered: Bool, counter: Int)] = []
+    private var ignored: String?
+    private var pendingSpace = false
+    private var endsWithNewline = true
+    /// Images that were not loaded yet and were left out
+    private var missing: [URL] = []
+
+    init(text: String, style: HTMLStyle, image: @escaping (URL) -> UIImage?) {
+        self.text = text
+        self.style = style
+        self.image = image
+    }
+
+    func parse() -> (rendered: NSAttributedString, missing: [URL]) {
+        var parser = self
+        return (parser.run(), parser.missing)
+    }
+
+    private mutating func run() -> NSAttributedString {
+        var index = text.startIndex
+        while index < text.endIndex {
+            guard let open = text[index...].firstIndex(of: "<") else {
+                self.append(text: String(text[index...])); break
+            }
+            if open > index {
+                self.append(text: String(text[index..<open]))
+            }
+            guard let close = text[open...].firstIndex(of: ">") else {
+                /// Not a tag, but a plain '<' character
+                self.append(text: String(text[open...])); break
+            }
+            self.handle(tag: String(text[text.index(after: open)..<close]))
+            index = text.index(after: close)
+        }
+
+        /// Drop trailing line breaks left by closing blocks
+        while output.mutableString.hasSuffix("\n") {
+            output.deleteCharacters(in: NSRange(location: output.length - 1, length: 1))
+        }
+        return output
+    }
+
+    // MARK: - Tags
+
+    private mutating func handle(tag raw: String) {
+        let closing = raw.hasPrefix("/")
+        let body = raw.trimmingCharacters(in: CharacterSet(charactersIn: "/").union(.whitespacesAndNewlines))
+        let name = body.prefix(while: { !$0.isWhitespace }).lowercased()
+
+        if let ignored = self.ignored {
+            if closing, name == ignored { self.ignored = nil }
+            return
+        }
+
+        switch (name, closing) {
+        case (let name, false) where HTMLParser.ignoredContent.contains(name):
+            self.ignored = name
+        case ("p", _), ("div", _):
+            self.breakLine()
+        case ("br", _):
+            self.append(raw: "\n")
+        case ("b", false), ("strong", false):
+            bold += 1
+        case ("b", true), ("strong", true):
+            bold = max(0, bold - 1)
+        case ("i", false), ("em", false):
+            italic += 1
+        case ("i", true), ("em", true):
+            italic = max(0, italic - 1)
+        case ("u", false):
+            underline += 1
+        case ("u", true):
+            underline = max(0, underline - 1)
+        case ("a", false):
+            links.append(attributes(of: body)["href"].flatMap { URL(string: $0) })
+        case ("a", true):
+            _ = links.popLast()
+        case ("ul", false), ("ol", false):
+            self.breakLine()
+            lists.append((ordered: name == "ol", counter: 0))
+        case ("ul", true), ("ol", true):
+            _ = lists.popLast()
+            self.breakLine()
+        case ("li", false):
+            self.breakLine()
+            guard !lists.isEmpty else { break }
+            lists[lists.count - 1].counter += 1
+            let list = lists[lists.count - 1]
+            self.append(raw: list.ordered ? "\(list.counter). " : "\u{2022} ")
+        case ("li", true):
+            self.breakLine()
+        case ("img", false):
+            self.appendImage(attributes(of: body))
+        default:
+            /// Unsupported tags are dropped, their content is kept
+            break
+        }
+    }
+
+    private func attributes(of tag: String) -> [String:String] {
+        var result: [String:String] = [:]
+        var scanner = tag.drop(while: { !$0.isWhitespace })[...]
+        while !scanner.isEmpty {
+            scanner = scanner.drop(while: { $0.isWhitespace })
+            let rawName = scanner.prefix(while: { $0 != "=" && !$0.isWhitespace })
+            let name = rawName.lowercased()
+            scanner = scanner.dropFirst(rawName.count).drop(while: { $0.isWhitespace })
+            guard !name.isEmpty else { break }
+            guard scanner.first == "=" else { result[name] = ""; continue }
+
+            scanner = scanner.dropFirst().drop(while: { $0.isWhitespace })
+            if let quote = scanner.first, quote == "\"" || quote == "'" {
+                let value = scanner.dropFirst().prefix(while: { $0 != quote })
+                result[name] = HTMLParser.decode(String(value))
+                scanner = scanner.dropFirst(value.count + 2)
+            } else {
+                let value = scanner.prefix(while: { !$0.isWhitespace })
+                result[name] = HTMLParser.decode(String(value))
+                scanner = scanner.dropFirst(value.count)
+            }
+        }
+        return result
+    }
+
+    // MARK: - Content
+
+    private mutating func append(text: String) {
+        guard ignored == nil else { return }
+
+        /// Collapse whitespaces the same way browsers do
+        var collapsed = ""
+        for character in HTMLParser.decode(text) {
+            if character.isWhitespace && character != "\u{00A0}" {
+                pendingSpace = true
+            } else {
+                if pendingSpace, !collapsed.isEmpty || !endsWithNewline {
+                    collapsed.append(" ")
+                }
+                pendingSpace = false
+                collapsed.append(character)
+            }
+        }
+        guard !collapsed.isEmpty else { return }
+        output.append(NSAttributedString(string: collapsed, attributes: self.currentAttributes()))
+        endsWithNewline = false
+    }
+
+    private mutating func append(raw: String) {
+        pendingSpace = false
+        output.append(NSAttributedString(string: raw, attributes: self.currentAttributes()))
+        endsWithNewline = raw.hasSuffix("\n")
+    }
+
+    private mutating func breakLine() {
+        guard !endsWithNewline else { pendingSpace = false; return }
+        self.append(raw: "\n")
+    }
+
+    private mutating func appendImage(_ attributes: [String:String]) {
+        guard let source = attributes["src"], let url = URL(string: source) else { return }
+        guard let image = self.image(url) else { missing.append(url); return }
+
+        let attachment = NSTextAttachment()
+        attachment.image = image
+
+        var size = image.size
+        if let width = attributes["width"].flatMap({ Double($0) }), let height = attributes["height"].flatMap({ Double($0) }) {
+            size = CGSize(width: width, height: height)
+        }
+        if let maxWidth = style.width, maxWidth > 0, size.width > maxWidth {
+            size = CGSize(width: maxWidth, height: size.height * maxWidth / size.width)
+        }
+        attachment.bounds = CGRect(origin: .zero, size: size)
+        pendingSpace = false
+        output.append(NSAttributedString(attachment: attachment))
+        endsWithNewline = false
+    }
+
+    private func currentAttributes() -> [NSAttributedString.Key:Any] {
+        let paragraph = NSMutableParagraphStyle()
+        paragraph.alignment = style.alignment
+        if !lists.isEmpty {
+            paragraph.headIndent = CGFloat(lists.count) * 16.0
+            paragraph.firstLineHeadIndent = CGFloat(lists.count - 1) * 16.0
+        }
+
+        var attributes: [NSAttributedString.Key:Any] = [.paragraphStyle: paragraph]
+        if let font = self.currentFont() {
+            attributes[.font] = font
+        }
+        if let color = style.color {
+            attributes[.foregroundColor] = color
+        }
+        if underline > 0 {
+            attributes[.underlineStyle] = NSUnderlineStyle.single.rawValue
+        }
+        if let link = links.last, let url = link {
+            attributes[.link] = url
+        }
+        return attributes
+    }
+
+    private func currentFont() -> UIFont? {
+        guard let font = style.font ?? UIFont.ninchat else { return nil }
+        guard bold > 0 || italic > 0 else { return font }
+
+        var traits = font.fontDescriptor.symbolicTraits
+        if bold > 0 { traits.insert(.traitBold) }
+        if italic > 0 { traits.insert(.traitItalic) }
+        if let descriptor = font.fontDescriptor.withSymbolicTraits(traits) {
+            return UIFont(descriptor: descriptor, size: font.pointSize)
+        }
+        /// The bundled font does not resolve traits through its descriptor
+        if bold > 0, italic == 0 { return UIFont.ninchatSemiBold?.withSize(font.pointSize) ?? font }
+        if italic > 0, bold == 0 { return UIFont.ninchatItalic?.withSize(font.pointSize) ?? font }
+        return font
+    }
+
+    // MARK: - Entities
+
+    private static func decode(_ text: String) -> String {
+        guard text.contains("&") else { return text }
+
+        var result = ""
+        var index = text.startIndex
+        while let ampersand = text[index...].firstIndex(of: "&") {
+            result += text[index..<ampersand]
+            guard let semicolon = text[ampersand...].firstIndex(of: ";"), text.distance(from: ampersand, to: semicolon) <= 10 else {
+                result.append("&"); index = text.index(after: ampersand); continue
+            }
+
+            let entity = String(text[text.index(after: ampersand)..<semicolon])
+            if let value = entities[entity.lowercased()] {
+                result += value
+            } else if entity.hasPrefix("#"), let scalar = HTMLParser.scalar(String(entity.dropFirst())) {
+                result.append(Character(scalar))
+            } else {
+                result += text[ampersand...semicolon]
+            }
+            index = text.index(after: semicolon)
+        }
+        return result + text[index...]
+    }
+
+    private static func scalar(_ code: String) -> Unicode.Scalar? {
+        let value = code.lowercased().hasPrefix("x") ? UInt32(code.dropFirst(), radix: 16) : UInt32(code)
+        return value.flatMap { Unicode.Scalar($0) }
+    }
+}
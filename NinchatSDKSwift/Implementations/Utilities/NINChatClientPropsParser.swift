@@ -7,42 +7,40 @@
 import Foundation
 import NinchatLowLevelClient
 
+/// Copies the values of a `NINLowLevelClientProps` into `ClientProps`, nested objects and arrays included.
 final class NINChatClientPropsParser: NSObject, NINLowLevelClientPropVisitorProtocol {
-    
-    private(set) var properties: [String:Any?]!
-    
-    override init() {
-        super.init()
-        
-        self.properties = [:]
-    }
+
+    private(set) var properties = ClientProps()
 
     func visitBool(_ p0: String?, p1: Bool) throws {
-        self.set(key: p0, value: p1)
+        self.set(key: p0, value: .bool(p1))
     }
-    
+
     func visitNumber(_ p0: String?, p1: Double) throws {
-        self.set(key: p0, value: p1)
+        self.set(key: p0, value: .number(p1))
     }
 
     func visitObject(_ p0: String?, p1: NINLowLevelClientProps?) throws {
-        self.set(key: p0, value: p1)
+        guard let object = p1 else { return }
+        self.set(key: p0, value: .object(try ClientProps(object)))
     }
 
     func visitObjectArray(_ p0: String?, p1: NINLowLevelClientObjects?) throws {
-        self.set(key: p0, value: p1)
+        guard let objects = p1 else { return }
+        self.set(key: p0, value: .objects(try (0..<objects.length()).compactMap { objects.get($0) }.map { try ClientProps($0) }))
     }
 
     func visit(_ p0: String?, p1: String?) throws {
-        self.set(key: p0, value: p1)
+        self.set(key: p0, value: .string(p1 ?? ""))
     }
 
     func visitStringArray(_ p0: String?, p1: NINLowLevelClientStrings?) throws {
-        self.set(key: p0, value: p1)
+        guard let strings = p1 else { return }
+        self.set(key: p0, value: .strings((0..<strings.length()).map { strings.get($0) }))
     }
 
-    func set(key: String?, value: Any?) {
+    func set(key: String?, value: ClientProps.Value) {
         guard let key = key else { return }
         properties[key] = value
     }
-}
\ No newline at end of file
+}
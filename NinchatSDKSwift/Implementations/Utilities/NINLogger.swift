@@ -0,0 +1,190 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// The SDK wide logger
+let logger = NINLogger.shared
+
+enum NINLogLevel: Int, Comparable, CaseIterable, CustomStringConvertible {
+    case debug
+    case info
+    case warning
+    case error
+
+    static func < (lhs: NINLogLevel, rhs: NINLogLevel) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
+
+    var description: String {
+        switch self {
+        case .debug: return "debug"
+        case .info: return "info"
+        case .warning: return "warning"
+        case .error: return "error"
+        }
+    }
+}
+
+enum NINLogCategory: String, CaseIterable {
+    case general
+    /// Session lifecycle, queues and channels
+    case session
+    /// Events and messages received from the server
+    case event
+    /// Actions, files and the low level client
+    case network
+    case rtc
+    case jitsi
+    case questionnaire
+    case ui
+}
+
+struct NINLogEntry: CustomStringConvertible {
+    let date: Date
+    let level: NINLogLevel
+    let category: NINLogCategory
+    let message: String
+
+    var description: String {
+        "\(String(format: "%.3f", self.date.timeIntervalSince1970)) [\(self.level)] [\(self.category.rawValue)] \(self.message)"
+    }
+}
+
+/// Keeps the latest `capacity` elements, overwriting the oldest ones
+struct NINRingBuffer<Element> {
+    let capacity: Int
+    private var storage: [Element] = []
+    private var head = 0
+
+    init(capacity: Int) {
+        self.capacity = max(capacity, 1)
+        self.storage.reserveCapacity(self.capacity)
+    }
+
+    var count: Int {
+        self.storage.count
+    }
+
+    /// The elements, oldest first
+    var elements: [Element] {
+        Array(self.storage[self.head...] + self.storage[..<self.head])
+    }
+
+    mutating func append(_ element: Element) {
+        if self.storage.count < self.capacity {
+            self.storage.append(element)
+        } else {
+            self.storage[self.head] = element
+            self.head = (self.head + 1) % self.capacity
+        }
+    }
+
+    mutating func removeAll() {
+        self.storage.removeAll(keepingCapacity: true)
+        self.head = 0
+    }
+}
+
+/// Logs of the SDK.
+///
+/// Messages are `@autoclosure`s that are evaluated only if the level and the category are enabled,
+/// so disabled logs cost a comparison. Recorded entries are kept in a fixed size ring buffer that
+/// can be dumped for crash reports and support requests. In debug builds, entries are also printed.
+/// The configuration is read without locking; set it before starting a session.
+final class NINLogger {
+    static let shared = NINLogger()
+
+    /// Entries below this level are dropped without building their message
+    var minimumLevel: NINLogLevel
+    var categories: Set<NINLogCategory> = Set(NINLogCategory.allCases)
+    var isEnabled = true
+    var printsToConsole: Bool
+
+    private let lock = DispatchQueue(label: "com.ninchat.sdk.swift.log")
+    private var buffer: NINRingBuffer<NINLogEntry>
+
+    init(capacity: Int = 500) {
+        self.buffer = NINRingBuffer(capacity: capacity)
+        #if DEBUG
+        self.minimumLevel = .debug
+        self.printsToConsole = true
+        #else
+        self.minimumLevel = .info
+        self.printsToConsole = false
+        #endif
+    }
+
+    func isLoggable(_ level: NINLogLevel, _ category: NINLogCategory) -> Bool {
+        self.isEnabled && level >= self.minimumLevel && self.categories.contains(category)
+    }
+
+    func debug(_ category: NINLogCategory, _ message: @autoclosure () -> String) {
+        self.log(.debug, category, message())
+    }
+
+    func info(_ category: NINLogCategory, _ message: @autoclosure () -> String) {
+        self.log(.info, category, message())
+    }
+
+    func warning(_ category: NINLogCategory, _ message: @autoclosure () -> String) {
+        self.log(.warning, category, message())
+    }
+
+    func error(_ category: NINLogCategory, _ message: @autoclosure () -> String) {
+        self.log(.error, category, message())
+    }
+
+    func error(_ category: NINLogCategory, _ error: @autoclosure () -> NinchatError?) {
+        guard self.isLoggable(.error, category), let error = error() else { return }
+        self.log(.error, category, error.logDescription)
+    }
+
+    /// Records the message; if `output` is given, the message is passed to it instead of the console
+    func log(_ level: NINLogLevel, _ category: NINLogCategory, _ message: @autoclosure () -> String, output: ((String) -> Void)? = nil) {
+        guard self.isLoggable(level, category) else { return }
+
+        let entry = NINLogEntry(date: Date(), level: level, category: category, message: message())
+        self.lock.sync { self.buffer.append(entry) }
+
+        if let output = output {
+            output(entry.message)
+        } else if self.printsToConsole {
+            print(entry.description)
+        }
+    }
+
+    /// The recorded entries, oldest first
+    var entries: [NINLogEntry] {
+        self.lock.sync { self.buffer.elements }
+    }
+
+    func dump() -> String {
+        self.entries.map { $0.description }.joined(separator: "\n")
+    }
+
+    func removeAll() {
+        self.lock.sync { self.buffer.removeAll() }
+    }
+}
+
+extension NinchatError {
+    var logDescription: String {
+        var log = "error_type: \(self.type)"
+        if let reason = self.reason, !reason.isEmpty { log += ",   error_reason: \(reason)" }
+        if let sessionID = self.sessionID, !sessionID.isEmpty { log += ",   session_id: \(sessionID)" }
+        if let actionID = self.actionID, !actionID.isEmpty { log += ",   action_id: \(actionID)" }
+        if let userID = self.userID, !userID.isEmpty { log += ",   user_id: \(userID)" }
+        if let identityType = self.identityType, !identityType.isEmpty { log += ",   identity_type: \(identityType)" }
+        if let identityName = self.identityName, !identityName.isEmpty { log += ",   identity_name: \(identityName)" }
+        if let channelID = self.channelID, !channelID.isEmpty { log += ",   channel_id: \(channelID)" }
+        if let realmID = self.realmID, !realmID.isEmpty { log += ",   realm_id: \(realmID)" }
+        if let queueID = self.queueID, !queueID.isEmpty { log += ",   queue_id: \(queueID)" }
+        if let tagID = self.tagID, !tagID.isEmpty { log += ",   tag_id: \(tagID)" }
+        if let messageType = self.messageType, !messageType.isEmpty { log += ",   tag_id: \(messageType)" }
+        return log
+    }
+}
@@ -61,18 +61,18 @@ final class PermissionStatus {
     func grantDevicePhotoLibrary(_ onCompletion: @escaping PermissionCompletion) {
         switch PHPhotoLibrary.authorizationStatus() {
         case .authorized:
-            debugger("`Photo library` is authorized.")
+            logger.debug(.general, "`Photo library` is authorized.")
             onCompletion(nil)
         case .notDetermined:
             PHPhotoLibrary.requestAuthorization { granted in
-                debugger("User authorized the use of `Photo library`: \(granted)")
+                logger.debug(.general, "User authorized the use of `Photo library`: \(granted)")
                 granted == .authorized ? onCompletion(nil) : onCompletion(.permissionDenied)
             }
         case .restricted:
-            debugger("`Photo library` is restricted!")
+            logger.debug(.general, "`Photo library` is restricted!")
             onCompletion(.permissionRestricted)
         case .denied:
-            debugger("`Photo library` is denied!")
+            logger.debug(.general, "`Photo library` is denied!")
             onCompletion(.permissionDenied)
         default:
             onCompletion(.unknown)
@@ -84,18 +84,18 @@ final class PermissionStatus {
     private func grantMedia(media: AVMediaType, _ onCompletion: @escaping PermissionCompletion) {
         switch AVCaptureDevice.authorizationStatus(for: media) {
         case .authorized:
-            debugger("`AVCaptureDevice` is already authorized.")
+            logger.debug(.general, "`AVCaptureDevice` is already authorized.")
             onCompletion(nil)
         case .notDetermined:
             AVCaptureDevice.requestAccess(for: media) { granted in
-                debugger("User authorized the use of `AVCaptureDevice`: \(granted)")
+                logger.debug(.general, "User authorized the use of `AVCaptureDevice`: \(granted)")
                 granted ? onCompletion(nil) : onCompletion(.permissionDenied)
             }
         case .restricted:
-            debugger("`AVCaptureDevice` is restricted!")
+            logger.debug(.general, "`AVCaptureDevice` is restricted!")
             onCompletion(.permissionRestricted)
         case .denied:
-            debugger("`AVCaptureDevice` is denied!")
+            logger.debug(.general, "`AVCaptureDevice` is denied!")
             onCompletion(.permissionDenied)
         default:
             onCompletion(.unknown)
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import UIKit
+
+/// Creates the views of questionnaire pages on demand and keeps the most recently used ones.
+/// Revisiting a page that is still kept reuses its views, so the answers shown on them stay.
+/// Views are created on the main thread only.
+final class QuestionnaireElementCache {
+    private let capacity: Int
+    private let make: (Int) -> [QuestionnaireElement]?
+    private var pages: [Int:[QuestionnaireElement]] = [:]
+    /// Page indices, the most recently used last
+    private var recent: [Int] = []
+    private var prefetchWorkItem: DispatchWorkItem?
+
+    init(capacity: Int = 4, make: @escaping (Int) -> [QuestionnaireElement]?) {
+        self.capacity = max(capacity, 1)
+        self.make = make
+    }
+
+    deinit {
+        self.prefetchWorkItem?.cancel()
+    }
+
+    var count: Int {
+        self.pages.count
+    }
+
+    func contains(page: Int) -> Bool {
+        self.pages[page] != nil
+    }
+
+    /// Returns the views of the page, creating them if needed
+    func elements(at page: Int) -> [QuestionnaireElement]? {
+        if let elements = self.pages[page] {
+            self.touch(page)
+            return elements
+        }
+        guard let elements = self.make(page) else { return nil }
+
+        self.insert(elements, at: page)
+        return elements
+    }
+
+    /// Keeps the given views for the page, e.g. sections added at runtime
+    func insert(_ elements: [QuestionnaireElement], at page: Int) {
+        self.pages[page] = elements
+        self.touch(page)
+        self.evict()
+    }
+
+    /// Creates the views of the page once the current run loop is done, so showing the current page is not delayed
+    func prefetch(page: Int) {
+        self.prefetchWorkItem?.cancel()
+        guard self.pages[page] == nil else { return }
+
+        let workItem = DispatchWorkItem { [weak self] in
+            guard let `self` = self, self.pages[page] == nil, let elements = self.make(page) else { return }
+            self.insert(elements, at: page)
+        }
+        self.prefetchWorkItem = workItem
+        DispatchQueue.main.async(execute: workItem)
+    }
+
+    func removeAll() {
+        self.prefetchWorkItem?.cancel()
+        self.pages.removeAll()
+        self.recent.removeAll()
+    }
+
+    private func touch(_ page: Int) {
+        self.recent.removeAll(where: { $0 == page })
+        self.recent.append(page)
+    }
+
+    private func evict() {
+        while self.recent.count > self.capacity {
+            self.pages.removeValue(forKey: self.recent.removeFirst())
+        }
+    }
+}
@@ -4,7 +4,7 @@
 // license that can be found in the LICENSE file.
 //
 
-import UIKit
+import Foundation
 
 protocol QuestionnaireElementConnector {
     var logicContainsTags: ((LogicQuestionnaire?) -> Void)? { get set }
@@ -13,19 +13,22 @@ protocol QuestionnaireElementConnector {
     var onCompleteTargetReached: ((LogicQuestionnaire?, ElementRedirect?, _ autoApply: Bool) -> Void)? { get set }
 
     init(configurations: [QuestionnaireConfiguration], style: QuestionnaireStyle)
-    func findElementAndPageRedirect(for input: AnyHashable, in configuration: QuestionnaireConfiguration, autoApply: Bool, performClosures: Bool) -> ([QuestionnaireElement]?, Int?)
-    func findElementAndPageLogic(logic block: LogicQuestionnaire, in answers: [String:AnyHashable], autoApply: Bool, performClosures: Bool) -> ([QuestionnaireElement]?, Int?)
+    func findElementAndPageRedirect(for input: AnyHashable, in configuration: QuestionnaireConfiguration, autoApply: Bool, performClosures: Bool) -> (QuestionnairePage?, Int?)
+    func findElementAndPageLogic(logic block: LogicQuestionnaire, in answers: [String:AnyHashable], autoApply: Bool, performClosures: Bool) -> (QuestionnairePage?, Int?)
     func findConfiguration(label: String, in cfg: [QuestionnaireConfiguration]?) -> QuestionnaireConfiguration?
-    mutating func appendElements(_ elements: [QuestionnaireItems], configurations: [QuestionnaireConfiguration])
+    mutating func appendPages(_ pages: [QuestionnairePage], configurations: [QuestionnaireConfiguration])
 }
 
 struct QuestionnaireElementConnectorImpl: QuestionnaireElementConnector {
-    internal var items: [QuestionnaireItems] = []
+    /// The connector only needs the pages, their views are created by the view model when shown
+    internal var pages: [QuestionnairePage] = []
     internal var configurations: [QuestionnaireConfiguration] = []
+    internal let evaluator: QuestionnaireLogicEvaluator
 
     init(configurations: [QuestionnaireConfiguration], style: QuestionnaireStyle) {
         self.configurations = configurations
-        self.items = QuestionnaireParser(configurations: configurations, style: style).items
+        self.pages = QuestionnaireParser(configurations: configurations, style: style).pages
+        self.evaluator = QuestionnaireLogicEvaluator(configurations: configurations, pages: self.pages)
     }
 
     var logicContainsTags: ((LogicQuestionnaire?) -> Void)?
@@ -33,35 +36,36 @@ struct QuestionnaireElementConnectorImpl: QuestionnaireElementConnector {
     var onRegisterTargetReached: ((LogicQuestionnaire?, ElementRedirect?, _ autoApply: Bool) -> Void)?
     var onCompleteTargetReached: ((LogicQuestionnaire?, ElementRedirect?, _ autoApply: Bool) -> Void)?
 
-    /// Returns the element the given configuration associated to
-    /// The function is called if the `findTargetRedirectConfiguration(from:)` or `findTargetLogicConfiguration(from:)` returns valid configuration
-    internal func findTargetElement(for configuration: QuestionnaireConfiguration) -> ([QuestionnaireElement]?, Int?) {
-        for counter in 0..<items.count {
-            guard let elements = items[counter].elements?.filter({ $0.questionnaireConfiguration == configuration }), elements.count != 0 else { continue }
-            return (elements, counter)
+    /// Returns the page the given configuration associated to
+    /// Navigation looks the pages up by name using `evaluator.page(named:)`, which gives the same result without scanning the pages
+    internal func findTargetElement(for configuration: QuestionnaireConfiguration) -> (QuestionnairePage?, Int?) {
+        for counter in 0..<pages.count {
+            guard pages[counter].hasElements, !pages[counter].elementTypes.isEmpty, pages[counter].configuration == configuration else { continue }
+            return (pages[counter], counter)
         }
         return (nil,nil)
     }
 
-    mutating func appendElements(_ item: [QuestionnaireItems], configurations: [QuestionnaireConfiguration]) {
-        self.items.append(contentsOf: item)
+    mutating func appendPages(_ pages: [QuestionnairePage], configurations: [QuestionnaireConfiguration]) {
+        self.pages.append(contentsOf: pages)
         self.configurations.append(contentsOf: configurations)
+        self.evaluator.append(configurations: configurations, pages: pages)
     }
 }
 
 // MARK: - QuestionnaireElementConnector 'redirect'
 
 extension QuestionnaireElementConnectorImpl {
-    /// The function aims to extract associated index and QuestionnaireElement object for a given ElementRedirect
+    /// The function aims to extract associated index and QuestionnairePage object for a given ElementRedirect
     /// - Parameters:
     ///   - input: The value that has to be looked up in the given configuration to find associated index and element
     ///   - configuration: The configuration that holds ElementRedirect object
     ///   - autoApply: The variable declares if the '_register'/'_complete' closures are automatically applied or not.
     ///   - performClosures: The variable declares if the '_register'/'_complete' closures has to be performed or not.
-    /// - Returns: Returns associated index and QuestionnaireElement for given configuration. If the
+    /// - Returns: Returns associated index and QuestionnairePage for given configuration. If the
         /// index == nil -> No associated elements found
         /// index == -1 -> No associated elements found, but the '_register' or '_complete' block is found.
-    func findElementAndPageRedirect(for input: AnyHashable, in configuration: QuestionnaireConfiguration, autoApply: Bool, performClosures: Bool) -> ([QuestionnaireElement]?, Int?) {
+    func findElementAndPageRedirect(for input: AnyHashable, in configuration: QuestionnaireConfiguration, autoApply: Bool, performClosures: Bool) -> (QuestionnairePage?, Int?) {
         if let redirect = self.findAssociatedRedirect(for: input, in: configuration) {
             if redirect.target == "_register", performClosures {
                 self.onRegisterTargetReached?(nil, redirect, autoApply); return (nil, -1)
@@ -69,8 +73,8 @@ extension QuestionnaireElementConnectorImpl {
             if redirect.target == "_complete", performClosures {
                 self.onCompleteTargetReached?(nil, redirect, autoApply); return (nil, -1)
             }
-            if let configuration = self.findTargetRedirectConfiguration(from: redirect).0 {
-                return self.findTargetElement(for: configuration)
+            if let index = self.evaluator.page(named: redirect.target) {
+                return (self.pages[index], index)
             }
         }
         return (nil, nil)
@@ -80,21 +84,7 @@ extension QuestionnaireElementConnectorImpl {
     /// The input could be either the 'name' variable in QuestionnaireConfiguration object
     /// Or 'value' in ElementOption object
     internal func findAssociatedRedirect(for input: AnyHashable, in configuration: QuestionnaireConfiguration) -> ElementRedirect? {
-        /// The input is 'String'
-        if let strInput = input as? String,
-           let redirect = configuration
-                .redirects?
-                .filter({ ($0.pattern as? String) != nil }) /// filter only redirects with 'String' patterns
-                .first(where: { strInput.extractRegex(withPattern: $0.pattern as! String)?.count ?? 0 > 0 }) {
-            return redirect
-        } else if let redirect = configuration.redirects?.first(where: { $0.pattern ?? AnyHashable("") == input }) {
-            return redirect
-        } else if let redirect = configuration.redirects?.first(where: { $0.pattern == nil }) {
-            /// if the input was not matched with the redirect with a valid pattern,
-            /// use the one that has no patterns if there is any (which is applied to all inputs)
-            return redirect
-        }
-        return nil
+        self.evaluator.redirect(for: input, in: configuration)
     }
 
     /// Returns the configuration the given 'redirect' points to.
@@ -107,17 +97,17 @@ extension QuestionnaireElementConnectorImpl {
 // MARK: - QuestionnaireElementConnector 'logic'
 
 extension QuestionnaireElementConnectorImpl {
-    /// The function aims to extract associated index and QuestionnaireElement object for a given LogicQuestionnaire
+    /// The function aims to extract associated index and QuestionnairePage object for a given LogicQuestionnaire
     /// - Parameters:
     ///   - logic: The logic block that is under lookup.
     ///   - answers: The dictionary of currently saved answers that has to be looked through
     ///   - autoApply: The variable declares if the '_register'/'_complete' closures are automatically applied or not.
     ///   - performClosures: The variable declares if the '_register'/'_complete' closures has to be performed or not.
-    /// - Returns: Returns associated index and QuestionnaireElement for the given input in the given answers. If the
+    /// - Returns: Returns associated index and QuestionnairePage for the given input in the given answers. If the
     ///     index == nil -> No associated elements found
     ///     index == -1 -> No associated elements found, but the '_register' or '_complete' block is found.
-    func findElementAndPageLogic(logic block: LogicQuestionnaire, in answers: [String:AnyHashable], autoApply: Bool, performClosures: Bool) -> ([QuestionnaireElement]?, Int?) {
-        if block.satisfy(dictionary: answers) {
+    func findElementAndPageLogic(logic block: LogicQuestionnaire, in answers: [String:AnyHashable], autoApply: Bool, performClosures: Bool) -> (QuestionnairePage?, Int?) {
+        if self.evaluator.isSatisfied(block, answers: answers) {
             if let tags = block.tags, tags.count > 0 {
                 self.logicContainsTags?(block)
             }
@@ -134,8 +124,8 @@ extension QuestionnaireElementConnectorImpl {
             if (block.target == "_audienceRegisteredTarget" || block.target == "_close"), performClosures {
                 return (nil, -2)
             }
-            if let configuration = self.findTargetLogicConfiguration(from: block).0 {
-                return self.findTargetElement(for: configuration)
+            if let index = self.evaluator.page(named: block.target) {
+                return (self.pages[index], index)
             }
         }
         return (nil, nil)
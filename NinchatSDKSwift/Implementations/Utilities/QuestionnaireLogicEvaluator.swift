@@ -0,0 +1,187 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+import AnyCodable
+
+/// Evaluates questionnaire logic blocks and redirects against the given answers.
+///
+/// The questionnaire is compiled once: every pattern is turned into an `NSRegularExpression`,
+/// every logic block into a list of key/condition pairs, and the answer keys are indexed to the
+/// logic blocks that read them. Results of logic blocks are kept until one of the answers they
+/// depend on changes. The results are the same as `LogicQuestionnaire.satisfy(dictionary:)`
+/// and the former regex based redirect lookup.
+final class QuestionnaireLogicEvaluator {
+    struct Condition {
+        let key: String
+        let value: AnyHashable?
+        let regex: NSRegularExpression?
+
+        func matches(_ answer: AnyHashable?) -> Bool {
+            let answer = (answer?.base as? AnyCodable)?.value as? AnyHashable ?? answer
+            if let string = answer?.base as? String, let regex = self.regex, regex.firstMatch(in: string, range: NSRange(string.startIndex..., in: string)) != nil {
+                return true
+            }
+            return self.value == answer
+        }
+    }
+
+    struct Logic {
+        let and: [[Condition]]
+        let or: [[Condition]]
+
+        var keys: Set<String> {
+            Set((self.and + self.or).joined().map { $0.key })
+        }
+
+        func satisfy(_ answers: [String:AnyHashable]) -> Bool {
+            if !self.and.isEmpty {
+                guard !answers.isEmpty else { return false }
+                return self.and.contains { clause in
+                    !clause.isEmpty && clause.allSatisfy { condition in answers[condition.key].map { condition.matches($0) } ?? false }
+                }
+            } else if !self.or.isEmpty {
+                guard !answers.isEmpty else { return false }
+                return self.or.contains { clause in
+                    clause.contains { condition in answers[condition.key].map { condition.matches($0) } ?? false }
+                }
+            }
+            /// if there is no "and"/"or", the block satisfies everything
+            return true
+        }
+    }
+
+    private var configurations: [QuestionnaireConfiguration] = []
+    private var pages: [QuestionnairePage] = []
+    private var regexes: [String:NSRegularExpression] = [:]
+    private var logics: [UUID:Logic] = [:]
+    /// Answer keys mapped to the logic blocks reading them
+    private var dependents: [String:Set<UUID>] = [:]
+    private var results: [UUID:Bool] = [:]
+    private var answers: [String:AnyHashable] = [:]
+    /// Configuration names mapped to the page showing them; `nil` means the target has no page
+    private var pageIndex: [String:Int?] = [:]
+
+    init(configurations: [QuestionnaireConfiguration], pages: [QuestionnairePage]) {
+        self.append(configurations: configurations, pages: pages)
+    }
+
+    func append(configurations: [QuestionnaireConfiguration], pages: [QuestionnairePage]) {
+        self.configurations.append(contentsOf: configurations)
+        self.pages.append(contentsOf: pages)
+        self.pageIndex.removeAll()
+
+        self.compile(configurations)
+    }
+
+    // MARK: - Logic
+
+    /// Returns if the logic block is satisfied by the answers.
+    /// Only blocks reading an answer that changed since the previous call are evaluated again.
+    func isSatisfied(_ block: LogicQuestionnaire, answers: [String:AnyHashable]) -> Bool {
+        self.update(answers: answers)
+        if let result = self.results[block.id] {
+            return result
+        }
+
+        let result = self.logic(of: block).satisfy(answers)
+        self.results[block.id] = result
+        return result
+    }
+
+    private func logic(of block: LogicQuestionnaire) -> Logic {
+        if let logic = self.logics[block.id] {
+            return logic
+        }
+
+        /// Blocks that are not part of the compiled configurations, e.g. nested ones
+        let logic = self.compile(block)
+        self.logics[block.id] = logic
+        logic.keys.forEach { self.dependents[$0, default: []].insert(block.id) }
+        return logic
+    }
+
+    private func update(answers: [String:AnyHashable]) {
+        let changed = Set(answers.keys).union(self.answers.keys).filter { answers[$0] != self.answers[$0] }
+        guard !changed.isEmpty else { return }
+
+        changed.compactMap { self.dependents[$0] }.joined().forEach { self.results.removeValue(forKey: $0) }
+        self.answers = answers
+    }
+
+    // MARK: - Redirect
+
+    /// Returns the redirect of the configuration the input leads to
+    func redirect(for input: AnyHashable, in configuration: QuestionnaireConfiguration) -> ElementRedirect? {
+        guard let redirects = configuration.redirects else { return nil }
+
+        /// The input is 'String'
+        if let string = input as? String, let redirect = redirects.first(where: { redirect in
+            guard let pattern = redirect.pattern as? String, let regex = self.regex(pattern) else { return false }
+            return regex.firstMatch(in: string, range: NSRange(string.startIndex..., in: string)) != nil
+        }) {
+            return redirect
+        } else if let redirect = redirects.first(where: { $0.pattern ?? AnyHashable("") == input }) {
+            return redirect
+        }
+        /// if the input was not matched with the redirect with a valid pattern,
+        /// use the one that has no patterns if there is any (which is applied to all inputs)
+        return redirects.first(where: { $0.pattern == nil })
+    }
+
+    // MARK: - Pages
+
+    /// Returns the index of the page showing the configuration with the given name
+    func page(named name: String) -> Int? {
+        if let index = self.pageIndex[name] {
+            return index
+        }
+
+        var index: Int?
+        if let configuration = self.configurations.first(where: { $0.name == name }) {
+            index = self.pages.firstIndex(where: { $0.hasElements && !$0.elementTypes.isEmpty && $0.configuration == configuration })
+        }
+        self.pageIndex[name] = .some(index)
+        return index
+    }
+
+    // MARK: - Compilation
+
+    private func compile(_ configurations: [QuestionnaireConfiguration]) {
+        configurations.forEach { configuration in
+            configuration.redirects?.compactMap({ $0.pattern as? String }).forEach { _ = self.regex($0) }
+            if let block = configuration.logic {
+                _ = self.logic(of: block)
+            }
+            if let elements = configuration.elements {
+                self.compile(elements)
+            }
+        }
+    }
+
+    private func compile(_ block: LogicQuestionnaire) -> Logic {
+        func conditions(_ clauses: Array<[String:AnyCodable]>?) -> [[Condition]] {
+            (clauses ?? []).map { clause in
+                clause.map { key, value in
+                    let value = value.value as? AnyHashable
+                    return Condition(key: key, value: value, regex: (value as? String).flatMap { self.regex($0) })
+                }
+            }
+        }
+        return Logic(and: conditions(block.and), or: conditions(block.or))
+    }
+
+    private func regex(_ pattern: String) -> NSRegularExpression? {
+        if let regex = self.regexes[pattern] {
+            return regex
+        }
+        guard let regex = try? NSRegularExpression(pattern: pattern) else {
+            logger.error(.questionnaire, "Error in compiling questionnaire pattern: \(pattern)"); return nil
+        }
+        self.regexes[pattern] = regex
+        return regex
+    }
+}
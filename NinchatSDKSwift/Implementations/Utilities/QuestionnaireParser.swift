@@ -6,73 +6,106 @@
 
 import UIKit
 
-/// The utility aims to convert `QuestionnaireConfiguration` into corresponded UIViews and Logic blocks
-/// It is injected with configurations and return an array of [QuestionnaireItemsConverterTypes]
+/// The utility aims to convert `QuestionnaireConfiguration` into corresponded pages and Logic blocks
+/// Pages are described without any views; the UIViews of a page are created on demand using `elements(for:)`
 
 struct QuestionnaireItems {
     var elements: [QuestionnaireElement]?
     var logic: LogicQuestionnaire?
 }
 
+/// A page of the questionnaire, either a logic block or a set of elements
+struct QuestionnairePage {
+    let configuration: QuestionnaireConfiguration
+    /// Types of the views the page is made of; consecutive checkboxes are chained into a single view
+    let elementTypes: [ElementType]
+
+    var logic: LogicQuestionnaire? {
+        self.configuration.logic
+    }
+
+    var hasElements: Bool {
+        self.configuration.logic == nil
+    }
+}
+
 struct QuestionnaireParser {
-    private let configurations: [QuestionnaireConfiguration]
     private let style: QuestionnaireStyle
-    var items: [QuestionnaireItems] = []
+    let pages: [QuestionnairePage]
 
     init(configurations: [QuestionnaireConfiguration], style: QuestionnaireStyle) {
-        self.configurations = configurations
         self.style = style
+        self.pages = configurations.compactMap { QuestionnaireParser.page(of: $0) }
+    }
+
+    /// Creates the views of every page at once.
+    /// Prefer `elements(for:)` to create only the pages that are shown.
+    var items: [QuestionnaireItems] {
+        self.pages.map { QuestionnaireItems(elements: $0.hasElements ? self.elements(for: $0) : nil, logic: $0.logic) }
+    }
 
-        self.items = self.configurations.reduce(into: [], { (result: inout [QuestionnaireItems], configuration: QuestionnaireConfiguration) in
+    static func page(of configuration: QuestionnaireConfiguration) -> QuestionnairePage? {
+        if configuration.logic != nil {
+            return QuestionnairePage(configuration: configuration, elementTypes: [])
+        } else if let element = configuration.element {
+            return QuestionnairePage(configuration: configuration, elementTypes: [element])
+        } else if let elements = configuration.elements {
+            let types = elements.compactMap({ $0.element }).reduce(into: []) { (result: inout [ElementType], type: ElementType) in
+                if type == .checkbox, result.last == .checkbox { return }
+                result.append(type)
+            }
+            return QuestionnairePage(configuration: configuration, elementTypes: types)
+        }
+        return nil
+    }
 
-            var checkbox: QuestionnaireElementCheckbox?
-            func getView(from type: ElementType, index: Int) -> QuestionnaireElement? {
-                defer {
-                    if type != .checkbox { checkbox = nil }
-                }
+    func elements(for page: QuestionnairePage) -> [QuestionnaireElement] {
+        let configuration = page.configuration
 
-                switch type {
-                case .text:
-                    return generate(from: configuration, index: index, ofType: QuestionnaireElementText.self)
-                case .select:
-                    return generate(from: configuration, index: index, ofType: QuestionnaireElementSelect.self)
-                case .radio:
-                    return generate(from: configuration, index: index, ofType: QuestionnaireElementRadio.self)
-                case .textarea:
-                    return generate(from: configuration, index: index, ofType: QuestionnaireElementTextArea.self)
-                case .checkbox:
-                    // if consecutiveCheckboxes == nil => initiate and return
-                    if checkbox == nil {
-                        checkbox = generate(from: configuration, index: index, ofType: QuestionnaireElementCheckbox.self)
-                        return checkbox
-                    }
-
-                    // else => generate a checkbox item and append to the chain
-                    let element = generate(from: configuration, index: checkbox!.index+1, ofType: QuestionnaireElementCheckbox.self)
-                    checkbox?.appendView(element, configuration: configuration)
-                    return nil
-                case .input:
-                    return generate(from: configuration, index: index, ofType: QuestionnaireElementTextField.self)
-                case .likert:
-                    return generate(from: configuration, index: index, ofType: QuestionnaireElementLikert.self)
-                case .a:
-                    return generate(from: configuration, index: index, ofType: QuestionnaireElementHyperlink.self)
-                }
+        var checkbox: QuestionnaireElementCheckbox?
+        func getView(from type: ElementType, index: Int) -> QuestionnaireElement? {
+            defer {
+                if type != .checkbox { checkbox = nil }
             }
 
-            if let logic = configuration.logic {
-                result.append(QuestionnaireItems(elements: nil, logic: logic))
-            } else if let element = configuration.element, let view = getView(from: element, index: 0) {
-                result.append(QuestionnaireItems(elements: [view], logic: nil))
-            } else if let elements = configuration.elements?.compactMap({ element -> QuestionnaireElement? in
-                if let type = element.element, let index = configuration.elements?.firstIndex(of: element) {
-                    return getView(from: type, index: index)
+            switch type {
+            case .text:
+                return generate(from: configuration, index: index, ofType: QuestionnaireElementText.self)
+            case .select:
+                return generate(from: configuration, index: index, ofType: QuestionnaireElementSelect.self)
+            case .radio:
+                return generate(from: configuration, index: index, ofType: QuestionnaireElementRadio.self)
+            case .textarea:
+                return generate(from: configuration, index: index, ofType: QuestionnaireElementTextArea.self)
+            case .checkbox:
+                // if consecutiveCheckboxes == nil => initiate and return
+                if checkbox == nil {
+                    checkbox = generate(from: configuration, index: index, ofType: QuestionnaireElementCheckbox.self)
+                    return checkbox
                 }
+
+                // else => generate a checkbox item and append to the chain
+                let element = generate(from: configuration, index: checkbox!.index+1, ofType: QuestionnaireElementCheckbox.self)
+                checkbox?.appendView(element, configuration: configuration)
                 return nil
-            }) {
-                result.append(QuestionnaireItems(elements: elements, logic: nil))
+            case .input:
+                return generate(from: configuration, index: index, ofType: QuestionnaireElementTextField.self)
+            case .likert:
+                return generate(from: configuration, index: index, ofType: QuestionnaireElementLikert.self)
+            case .a:
+                return generate(from: configuration, index: index, ofType: QuestionnaireElementHyperlink.self)
+            }
+        }
+
+        if let element = configuration.element, let view = getView(from: element, index: 0) {
+            return [view]
+        }
+        return configuration.elements?.compactMap({ element -> QuestionnaireElement? in
+            if let type = element.element, let index = configuration.elements?.firstIndex(of: element) {
+                return getView(from: type, index: index)
             }
-        })
+            return nil
+        }) ?? []
     }
 }
 
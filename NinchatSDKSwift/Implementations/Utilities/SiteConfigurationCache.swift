@@ -0,0 +1,40 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+/// Keeps the latest site configuration of every server and config key, so the next start can open
+/// the session on the cached realm while the configuration is fetched again.
+struct SiteConfigurationCache {
+    private let storage: UserDefaults
+
+    init(storage: UserDefaults = .ninchat) {
+        self.storage = storage
+    }
+
+    func configuration(for key: String, serverAddress: String) -> [AnyHashable:Any]? {
+        guard let data = self.entries[self.entryKey(key, serverAddress)] else { return nil }
+        return (try? JSONSerialization.jsonObject(with: data)) as? [AnyHashable:Any]
+    }
+
+    func save(_ configuration: [String:Any], for key: String, serverAddress: String) {
+        guard let data = try? JSONSerialization.data(withJSONObject: configuration) else { return }
+
+        var entries = self.entries
+        entries[self.entryKey(key, serverAddress)] = data
+        self.storage.set(entries, forKey: UserDefaults.Keys.siteConfigurations.rawValue)
+    }
+}
+
+extension SiteConfigurationCache {
+    private var entries: [String:Data] {
+        self.storage.dictionary(forKey: UserDefaults.Keys.siteConfigurations.rawValue) as? [String:Data] ?? [:]
+    }
+
+    private func entryKey(_ key: String, _ serverAddress: String) -> String {
+        "\(serverAddress)/\(key)"
+    }
+}
@@ -13,6 +13,8 @@ enum MessageUpdateType {
     case history
     case remove(_ index: Int)
     case clean
+    /// A new version of the messages along with its changes, the chat view is updated with these
+    case snapshot(ChatSnapshot, ChatSnapshotDiff)
 }
 
 protocol NINChatRTCProtocol {
@@ -62,6 +64,7 @@ protocol NINChatViewModel: AnyObject, NINChatRTCProtocol, NINChatStateProtocol,
     var onChannelClosed: (() -> Void)? { get set }
     var onQueueUpdated: (() -> Void)? { get set }
     var onChannelMessage: ((MessageUpdateType) -> Void)? { get set }
+    var onTypingUpdated: (([TypingPresence.Entry]) -> Void)? { get set }
     var onComposeActionUpdated: ((_ id: String, _ action: ComposeUIAction) -> Void)? { get set }
 
     init(sessionManager: NINChatSessionManager)
@@ -71,8 +74,10 @@ final class NINChatViewModelImpl: NINChatViewModel {
     private unowned var sessionManager: NINChatSessionManager
     private var iceCandidates: [RTCIceCandidate] = []
     private var client: NINChatWebRTCClient?
-    private var typingStatus = false
-    private var typingStatusQueue: DispatchWorkItem?
+    private(set) var callSetupTimings: CallSetupTimings?
+    private lazy var writingState = WritingStateDebouncer { [weak self] isWriting in
+        try? self?.sessionManager.update(isWriting: isWriting) { _ in }
+    }
     private var isSelectingMedia = false
 
     var backlogMessages: String? {
@@ -86,6 +91,7 @@ final class NINChatViewModelImpl: NINChatViewModel {
     var onChannelClosed: (() -> Void)?
     var onErrorOccurred: ((Error) -> Void)?
     var onChannelMessage: ((MessageUpdateType) -> Void)?
+    var onTypingUpdated: (([TypingPresence.Entry]) -> Void)?
     var onComposeActionUpdated: ((_ id: String, _ action: ComposeUIAction) -> Void)?
 
     init(sessionManager: NINChatSessionManager) {
@@ -117,6 +123,12 @@ final class NINChatViewModelImpl: NINChatViewModel {
         self.sessionManager.onMessageRemoved = { [weak self] index in
             self?.onChannelMessage?(.remove(index))
         }
+        self.sessionManager.onMessagesChanged = { [weak self] snapshot, diff in
+            self?.onChannelMessage?(.snapshot(snapshot, diff))
+        }
+        self.sessionManager.typingPresence.onChange = { [weak self] typing in
+            self?.onTypingUpdated?(typing)
+        }
         self.sessionManager.onSessionDeallocated = { [weak self] in
             self?.onChannelMessage?(.clean)
         }
@@ -124,17 +136,6 @@ final class NINChatViewModelImpl: NINChatViewModel {
             self?.onComposeActionUpdated?(id, action)
         }
     }
-
-    private func startTimer() {
-        self.typingStatusQueue = DispatchWorkItem { [weak self] in
-            self?.updateWriting(state: false)
-        }
-        DispatchQueue.global(qos: .background).asyncAfter(deadline: .now() + .seconds(20), execute: self.typingStatusQueue!)
-    }
-
-    private func cancelTimer() {
-        self.typingStatusQueue?.cancel()
-    }
 }
 
 // MARK: - NINChatRTC
@@ -142,37 +143,55 @@ final class NINChatViewModelImpl: NINChatViewModel {
 extension NINChatViewModelImpl {
     func listenToRTCSignaling(delegate: NINChatWebRTCClientDelegate?, onCallReceived: @escaping RTCCallReceive, onCallInitiated: @escaping RTCCallInitial, onCallHangup: @escaping RTCCallHangup) {
         sessionManager.onRTCClientSignal = { [weak self] type, user, signal in
-            debugger("WebRTC: Client Signal: \(type)")
+            logger.debug(.rtc, "Client Signal: \(type)")
             guard type == .candidate else { return }
 
-            /// Queue received candidates and inject during initialization
+            /// Keep candidates received before the client exists, the client applies them once it can
             guard let iceCandidate = signal?.candidate?.toRTCIceCandidate else { return }
-            debugger("WebRTC: Adding \(iceCandidate) to queue")
-            self?.iceCandidates.append(iceCandidate)
+            if let client = self?.client {
+                client.add(candidate: iceCandidate)
+            } else {
+                logger.debug(.rtc, "Adding \(iceCandidate) to queue")
+                self?.iceCandidates.append(iceCandidate)
+            }
         }
 
         sessionManager.onRTCSignal = { [weak self] type, user, signal in
             switch type {
             case .call:
-                debugger("WebRTC: call")
+                logger.debug(.rtc, "Call signal received")
+                /// A new call, forget the client and candidates of the previous one
+                self?.client = nil
+                self?.iceCandidates.removeAll()
+                self?.callSetupTimings = self?.makeCallSetupTimings()
+                self?.callSetupTimings?.mark(.call)
+                /// Fetch the ICE servers while the user decides to pick up
+                self?.sessionManager.iceServerCache.prefetch()
                 onCallReceived(user, nil)
             case .offer:
-                do {
-                    try self?.sessionManager.beginICE { error, stunServers, turnServers in
-                        do {
-                            self?.client = NINChatWebRTCClientImpl(sessionManager: self?.sessionManager, operatingMode: .callee, stunServers: stunServers, turnServers: turnServers, candidates: self?.iceCandidates, delegate: delegate)
-                            try self?.client?.start(with: signal)
-
-                            onCallInitiated(self?.client, error)
-                        } catch {
-                            onCallInitiated(nil, error)
-                        }
+                if self?.callSetupTimings == nil {
+                    self?.callSetupTimings = self?.makeCallSetupTimings()
+                }
+                self?.callSetupTimings?.mark(.offer)
+                self?.sessionManager.iceServerCache.servers { error, stunServers, turnServers in
+                    guard let `self` = self else { return }
+                    self.callSetupTimings?.mark(.iceServers)
+
+                    do {
+                        let client = NINChatWebRTCClientImpl(sessionManager: self.sessionManager, operatingMode: .callee, stunServers: stunServers, turnServers: turnServers, candidates: self.iceCandidates, delegate: delegate)
+                        client.setupTimings = self.callSetupTimings
+                        self.iceCandidates.removeAll()
+                        self.client = client
+                        try client.start(with: signal)
+
+                        onCallInitiated(client, error)
+                    } catch {
+                        onCallInitiated(nil, error)
                     }
-                } catch {
-                    onCallInitiated(nil, error)
                 }
             case .hangup:
-                debugger("WebRTC: hang-up - closing the video call.")
+                logger.debug(.rtc, "Hang-up - closing the video call.")
+                self?.callSetupTimings = nil
                 onCallHangup()
             default:
                 break
@@ -180,6 +199,14 @@ extension NINChatViewModelImpl {
         }
     }
 
+    private func makeCallSetupTimings() -> CallSetupTimings {
+        let timings = CallSetupTimings()
+        timings.onCompleted = { [weak self] timings in
+            self?.sessionManager.delegate?.log(.rtc, "Call setup took \(Int((timings.total ?? 0) * 1000))ms (\(timings.summary))")
+        }
+        return timings
+    }
+
     func pickup(answer: Bool, unsupported: Bool? = nil, completion: @escaping (Error?) -> Void) {
         do {
             var payload = ["answer": answer]
@@ -194,9 +221,9 @@ extension NINChatViewModelImpl {
     }
 
     func hangup(completion: @escaping (Error?) -> Void) {
-        guard self.client != nil else { debugger("No WebRTC is available, skip hangup instruction"); completion(nil); return }
+        guard self.client != nil else { logger.debug(.rtc, "No WebRTC is available, skip hangup instruction"); completion(nil); return }
 
-        debugger("hangup the call...")
+        logger.debug(.rtc, "Hangup the call...")
         do {
             try self.sessionManager.send(type: .hangup, payload: [:], completion: completion)
         } catch {
@@ -206,7 +233,7 @@ extension NINChatViewModelImpl {
 
     func disconnectRTC(_ client: NINChatWebRTCClient?, completion: (() -> Void)?) {
         if let client = client {
-            debugger("webRTC: disconnect resources")
+            logger.debug(.rtc, "Disconnect resources")
             client.disconnect()
             completion?()
         }
@@ -225,7 +252,7 @@ extension NINChatViewModelImpl {
 
 extension NINChatViewModelImpl {
     func willEnterBackground() {
-        debugger("background mode, stop the video stream (if there are any)")
+        logger.debug(.session, "Background mode, stop the video stream (if there are any)")
         /// instead of dropping the connection when the app goes to the background
         /// it is better to stop video stream and let the connection be alive
         /// discussed on `https://github.com/somia/mobile/issues/295`
@@ -260,7 +287,7 @@ extension NINChatViewModelImpl {
         /// reload.
 
         if !self.isSelectingMedia {
-            debugger("getting back to foreground, reloading history")
+            logger.debug(.session, "Getting back to foreground, reloading history")
             self.loadHistory()
         }
         self.isSelectingMedia = false
@@ -280,7 +307,7 @@ extension NINChatViewModelImpl {
 
     func send(action: ComposeContentViewProtocol, completion: @escaping (Error?) -> Void) {
         do {
-            try self.sessionManager.send(action: action, completion: completion)
+            try self.sessionManager.send(action: action.messageDictionary, completion: completion)
         } catch {
             completion(error)
         }
@@ -303,20 +330,7 @@ extension NINChatViewModelImpl {
     }
 
     func updateWriting(state: Bool) {
-        self.cancelTimer()
-
-        if state {
-            /// restart timer if user is still typing
-            self.startTimer()
-        }
-
-        if typingStatus == state {
-            /// skip if the status has not changed
-            return
-        }
-        self.typingStatus = state
-
-        try? self.sessionManager.update(isWriting: state) { _ in  }
+        self.writingState.update(isWriting: state)
     }
 
     func loadHistory() {
@@ -337,7 +351,7 @@ extension NINChatViewModelImpl: QueueUpdateCapture {
 extension NINChatViewModelImpl {
     func grantVideoCallPermissions(_ completion: @escaping (Error?) -> Void) {
         Permission.grantPermission(.deviceCamera, .deviceMicrophone) { error in
-            debugger("permissions for video call granted with error: \(String(describing: error))")
+            logger.debug(.rtc, "Permissions for video call granted with error: \(String(describing: error))")
             completion(error)
         }
     }
@@ -32,7 +32,7 @@ extension NINFullScreenViewModelImpl {
     @objc
     private func didSaved(_ image: UIImage, error: Error?, context: UnsafeMutableRawPointer) {
         if let error = error {
-            self.delegate?.log(value: "Error: failed to save image to Photos album: \(error)")
+            self.delegate?.log(.ui, "Failed to save image to Photos album: \(error)", level: .error)
         }
         downloadCompletion?(error)
     }
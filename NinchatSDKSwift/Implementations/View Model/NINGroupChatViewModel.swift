@@ -12,11 +12,16 @@ protocol NINGroupChatViewModel: AnyObject, NINChatStateProtocol, NINChatMessageP
     var onChannelClosed: (() -> Void)? { get set }
     var onQueueUpdated: (() -> Void)? { get set }
     var onChannelMessage: ((MessageUpdateType) -> Void)? { get set }
+    var onTypingUpdated: (([TypingPresence.Entry]) -> Void)? { get set }
     var onComposeActionUpdated: ((_ id: String, _ action: ComposeUIAction) -> Void)? { get set }
     var onGroupVideoReadyToClose: (() -> Void)? { get set }
 
     init(sessionManager: NINChatSessionManager)
 
+    /// Join latency of the latest group meeting
+    var joinLatency: JitsiJoinLatency? { get }
+
+    func prepareVideoCall(inside parentView: UIView)
     func joinVideoCall(inside parentView: UIView, completion: @escaping (Error?) -> Void)
     func leaveVideoCall()
 }
@@ -24,9 +29,11 @@ protocol NINGroupChatViewModel: AnyObject, NINChatStateProtocol, NINChatMessageP
 final class NINGroupChatViewModelImpl: NSObject, NINGroupChatViewModel {
     private weak var sessionManager: NINChatSessionManager?
     private var jitsiVideoWebView: JitsiVideoWebView?
-    private var typingStatus = false
-    private var typingStatusQueue: DispatchWorkItem?
+    private lazy var writingState = WritingStateDebouncer { [weak self] isWriting in
+        try? self?.sessionManager?.update(isWriting: isWriting) { _ in }
+    }
     private var isSelectingMedia = false
+    private(set) var joinLatency: JitsiJoinLatency?
 
     var hasJoinedVideo: Bool {
         jitsiVideoWebView != nil
@@ -44,6 +51,7 @@ final class NINGroupChatViewModelImpl: NSObject, NINGroupChatViewModel {
     var onChannelClosed: (() -> Void)?
     var onErrorOccurred: ((Error) -> Void)?
     var onChannelMessage: ((MessageUpdateType) -> Void)?
+    var onTypingUpdated: (([TypingPresence.Entry]) -> Void)?
     var onComposeActionUpdated: ((_ id: String, _ action: ComposeUIAction) -> Void)?
     var onGroupVideoReadyToClose: (() -> Void)?
 
@@ -82,6 +90,12 @@ final class NINGroupChatViewModelImpl: NSObject, NINGroupChatViewModel {
         self.sessionManager?.onMessageRemoved = { [weak self] index in
             self?.onChannelMessage?(.remove(index))
         }
+        self.sessionManager?.onMessagesChanged = { [weak self] snapshot, diff in
+            self?.onChannelMessage?(.snapshot(snapshot, diff))
+        }
+        self.sessionManager?.typingPresence.onChange = { [weak self] typing in
+            self?.onTypingUpdated?(typing)
+        }
         self.sessionManager?.onSessionDeallocated = { [weak self] in
             self?.onChannelMessage?(.clean)
         }
@@ -90,107 +104,121 @@ final class NINGroupChatViewModelImpl: NSObject, NINGroupChatViewModel {
         }
     }
 
-    private func startTimer() {
-        self.typingStatusQueue = DispatchWorkItem { [weak self] in
-            self?.updateWriting(state: false)
+    func prepareVideoCall(inside parentView: UIView) {
+        /// The credentials are normally discovered once the channel is joined, make sure they are on the way
+        if self.sessionManager?.isGroupVideoChannel == true {
+            self.sessionManager?.jitsiDiscovery.prefetch()
         }
-        DispatchQueue.global(qos: .background).asyncAfter(deadline: .now() + .seconds(20), execute: self.typingStatusQueue!)
-    }
-
-    private func cancelTimer() {
-        self.typingStatusQueue?.cancel()
+        (parentView.subviews.first { $0 is JitsiVideoWebView } as? JitsiVideoWebView)?.prewarm()
     }
 
     func joinVideoCall(inside parentView: UIView, completion: @escaping (Error?) -> Void) {
-        do {
-            try sessionManager?.discoverJitsi { [weak self] result in
-                guard let self = self, let sessionManager = self.sessionManager else {
-                    return
-                }
-                switch result {
-                case nil:
+        guard let discovery = self.sessionManager?.jitsiDiscovery else {
+            completion(NINSessionExceptions.noActiveSession); return
+        }
+
+        var joinLatency = JitsiJoinLatency()
+        joinLatency.prefetched = discovery.cached != nil || discovery.isDiscovering
+        self.joinLatency = joinLatency
+
+        discovery.credentials { [weak self] result in
+            guard let self = self else {
+                return
+            }
+            self.joinLatency?.credentialsAt = Date()
+
+            switch result {
+            case nil:
+                completion(NinchatError(type: "unknown", props: nil))
+            case let .failure(error):
+                completion(error)
+            case let .success(credentials):
+                guard let urlRequest = self.meetingRequest(for: credentials) else {
                     completion(NinchatError(type: "unknown", props: nil))
-                case let .failure(error):
-                    completion(error)
-                case let .success(credentials):
-                    // User
-                    let user = sessionManager.myUser
-
-                    // Use imageOverrideURL or iconURL (if available) or default to nil if both are absent.
-                    let avatarConfig = AvatarConfig(forUser: sessionManager)
-                    let iconURLString = avatarConfig.imageOverrideURL ?? user?.iconURL
-
-                    // Choose nameOverride if available, otherwise use user's displayName or a default "Guest" label.
-                    let userName = !avatarConfig.nameOverride.isEmpty
-                        ? avatarConfig.nameOverride
-                        : (user?.displayName ?? "Guest".localized)
-
-                    // Get server address
-                    var serverAddress: String = sessionManager.serverAddress
-                    let apiPrefix = "api."
-                    if serverAddress.hasPrefix(apiPrefix) {
-                        let endIdx = serverAddress.index(serverAddress.startIndex, offsetBy: apiPrefix.count)
-                        serverAddress.removeSubrange(serverAddress.startIndex ..< endIdx)
-                    }
-
-                    // Construct Jitsi server address and extract domain.
-                    let jitsiServerAddress = "https://jitsi-www." + serverAddress
-                    let domain = jitsiServerAddress.replacingOccurrences(of: "https://", with: "")
-
-                    // Prepare other necessary variables.
-                    let room = credentials.room
-                    let jwt = credentials.token
-                    let displayName = userName.addingPercentEncoding(withAllowedCharacters: .urlQueryAllowed)
-
-                    // Determine the appropriate language.
-                    let supportedLanguages = ["fi", "sv", "en"]
-                    let currentLanguage = Locale.current.languageCode ?? "en"
-                    let language = supportedLanguages.contains(currentLanguage) ? currentLanguage : "en"
-
-                    // Construct the URL query items, adding displayName and avatarURL if available.
-                    var queryItems: [URLQueryItem] = [
-                        URLQueryItem(name: "jwt", value: jwt),
-                        URLQueryItem(name: "roomName", value: room),
-                        URLQueryItem(name: "domain", value: domain),
-                        URLQueryItem(name: "lang", value: language)
-                    ]
-
-                    if let encodedDisplayName = displayName {
-                        queryItems.append(URLQueryItem(name: "displayName", value: encodedDisplayName))
-                    }
-
-                    if let iconURLString = iconURLString, let avatarUrl = URL(string: iconURLString) {
-                        queryItems.append(URLQueryItem(name: "avatarURL", value: avatarUrl.absoluteString))
-                    }
-
-                    // Build the final URL.
-                    var urlComponents = URLComponents(string: "https://ninchat.com/new/jitsi-meet.html")
-                    urlComponents?.queryItems = queryItems
-
-                    // Validate and use the final URL.
-                    guard let finalUrl = urlComponents?.url else {
-                        completion(NinchatError(type: "unknown", props: nil))
-                        return
-                    }
-
-                    // If we're here, it means the URL is valid, and we can create the URLRequest.
-                    let urlRequest = URLRequest(url: finalUrl)
-                    
-                    // Add JitsiVideoWebView
-                    let jitsiVideoWebView = parentView.subviews.filter { $0 is JitsiVideoWebView }.first as? JitsiVideoWebView
-                    self.jitsiVideoWebView = jitsiVideoWebView
-                    jitsiVideoWebView?.eventsDelegate = self
-                    
-                    // Load url request
-                    jitsiVideoWebView?.loadJitsiMeeting(for: urlRequest)
-                    completion(nil)
+                    return
                 }
+
+                // Add JitsiVideoWebView
+                let jitsiVideoWebView = parentView.subviews.filter { $0 is JitsiVideoWebView }.first as? JitsiVideoWebView
+                self.jitsiVideoWebView = jitsiVideoWebView
+                jitsiVideoWebView?.eventsDelegate = self
+
+                // Load url request
+                self.joinLatency?.loadStartedAt = Date()
+                jitsiVideoWebView?.loadJitsiMeeting(for: urlRequest)
+                completion(nil)
             }
-        } catch {
-            completion(error)
         }
     }
 
+    private func meetingRequest(for credentials: JitsiCredentials) -> URLRequest? {
+        guard let sessionManager = self.sessionManager else {
+            return nil
+        }
+
+        // User
+        let user = sessionManager.myUser
+
+        // Use imageOverrideURL or iconURL (if available) or default to nil if both are absent.
+        let avatarConfig = AvatarConfig(forUser: sessionManager)
+        let iconURLString = avatarConfig.imageOverrideURL ?? user?.iconURL
+
+        // Choose nameOverride if available, otherwise use user's displayName or a default "Guest" label.
+        let userName = !avatarConfig.nameOverride.isEmpty
+            ? avatarConfig.nameOverride
+            : (user?.displayName ?? "Guest".localized)
+
+        // Get server address
+        var serverAddress: String = sessionManager.serverAddress
+        let apiPrefix = "api."
+        if serverAddress.hasPrefix(apiPrefix) {
+            let endIdx = serverAddress.index(serverAddress.startIndex, offsetBy: apiPrefix.count)
+            serverAddress.removeSubrange(serverAddress.startIndex ..< endIdx)
+        }
+
+        // Construct Jitsi server address and extract domain.
+        let jitsiServerAddress = "https://jitsi-www." + serverAddress
+        let domain = jitsiServerAddress.replacingOccurrences(of: "https://", with: "")
+
+        // Prepare other necessary variables.
+        let room = credentials.room
+        let jwt = credentials.token
+        let displayName = userName.addingPercentEncoding(withAllowedCharacters: .urlQueryAllowed)
+
+        // Determine the appropriate language.
+        let supportedLanguages = ["fi", "sv", "en"]
+        let currentLanguage = Locale.current.languageCode ?? "en"
+        let language = supportedLanguages.contains(currentLanguage) ? currentLanguage : "en"
+
+        // Construct the URL query items, adding displayName and avatarURL if available.
+        var queryItems: [URLQueryItem] = [
+            URLQueryItem(name: "jwt", value: jwt),
+            URLQueryItem(name: "roomName", value: room),
+            URLQueryItem(name: "domain", value: domain),
+            URLQueryItem(name: "lang", value: language)
+        ]
+
+        if let encodedDisplayName = displayName {
+            queryItems.append(URLQueryItem(name: "displayName", value: encodedDisplayName))
+        }
+
+        if let iconURLString = iconURLString, let avatarUrl = URL(string: iconURLString) {
+            queryItems.append(URLQueryItem(name: "avatarURL", value: avatarUrl.absoluteString))
+        }
+
+        // Build the final URL.
+        var urlComponents = URLComponents(string: "https://ninchat.com/new/jitsi-meet.html")
+        urlComponents?.queryItems = queryItems
+
+        // Validate and use the final URL.
+        guard let finalUrl = urlComponents?.url else {
+            return nil
+        }
+
+        // If we're here, it means the URL is valid, and we can create the URLRequest.
+        return URLRequest(url: finalUrl)
+    }
+
     func leaveVideoCall() {
         leaveVideoCall(force: true)
     }
@@ -212,7 +240,7 @@ final class NINGroupChatViewModelImpl: NSObject, NINGroupChatViewModel {
 
 extension NINGroupChatViewModelImpl {
     func willEnterBackground() {
-        debugger("background mode, stop the video stream (if there are any)")
+        logger.debug(.session, "Background mode, stop the video stream (if there are any)")
         /// instead of dropping the connection when the app goes to the background
         /// it is better to stop video stream and let the connection be alive
         /// discussed on `https://github.com/somia/mobile/issues/295`
@@ -251,7 +279,7 @@ extension NINGroupChatViewModelImpl {
         /// reload.
 
         if !self.isSelectingMedia {
-            debugger("getting back to foreground, reloading history")
+            logger.debug(.session, "Getting back to foreground, reloading history")
             self.loadHistory()
         }
         self.isSelectingMedia = false
@@ -271,7 +299,7 @@ extension NINGroupChatViewModelImpl {
 
     func send(action: ComposeContentViewProtocol, completion: @escaping (Error?) -> Void) {
         do {
-            try self.sessionManager?.send(action: action, completion: completion)
+            try self.sessionManager?.send(action: action.messageDictionary, completion: completion)
         } catch {
             completion(error)
         }
@@ -294,20 +322,7 @@ extension NINGroupChatViewModelImpl {
     }
 
     func updateWriting(state: Bool) {
-        self.cancelTimer()
-
-        if state {
-            /// restart timer if user is still typing
-            self.startTimer()
-        }
-
-        if typingStatus == state {
-            /// skip if the status has not changed
-            return
-        }
-        self.typingStatus = state
-
-        try? self.sessionManager?.update(isWriting: state) { _ in  }
+        self.writingState.update(isWriting: state)
     }
 
     func loadHistory() {
@@ -328,7 +343,7 @@ extension NINGroupChatViewModelImpl: QueueUpdateCapture {
 extension NINGroupChatViewModelImpl {
     func grantVideoCallPermissions(_ completion: @escaping (Error?) -> Void) {
         Permission.grantPermission(.deviceCamera, .deviceMicrophone) { error in
-            debugger("permissions for video call granted with error: \(String(describing: error))")
+            logger.debug(.jitsi, "Permissions for video call granted with error: \(String(describing: error))")
             completion(error)
         }
     }
@@ -374,4 +389,13 @@ extension NINGroupChatViewModelImpl: JitsiVideoWebViewEventsDelegate {
         leaveVideoCall(force: false)
         onGroupVideoReadyToClose?()
     }
+
+    func conferenceJoined() {
+        guard self.joinLatency?.joinedAt == nil else { return }
+        self.joinLatency?.joinedAt = Date()
+
+        if let joinLatency = self.joinLatency {
+            self.sessionManager?.delegate?.log(.jitsi, "Joined the meeting, \(joinLatency.summary)")
+        }
+    }
 }
@@ -5,7 +5,6 @@
 //
 
 import Foundation
-import NinchatLowLevelClient
 
 protocol NINQuestionnaireViewModel {
     var queue: Queue? { get set }
@@ -14,7 +13,7 @@ protocol NINQuestionnaireViewModel {
     var preventAutoRedirect: Bool { get set }
     var requirementsSatisfied: Bool { get }
     var shouldWaitForNextButton: Bool { get }
-    var questionnaireAnswers: NINLowLevelClientProps { get }
+    var questionnaireAnswers: ClientProps { get }
 
     var onErrorOccurred: ((Error) -> Void)? { get set }
     var onQuestionnaireFinished: ((Queue?, _ queueIsClosed: Bool, _ exit: Bool) -> Void)? { get set }
@@ -66,7 +65,15 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
     private var configurations: [QuestionnaireConfiguration] = []
     private let questionnaireType: AudienceQuestionnaireType
     internal var connector: QuestionnaireElementConnector!
-    private var items: [QuestionnaireItems] = []
+    private var parser: QuestionnaireParser?
+    private var pages: [QuestionnairePage] = []
+    /// Views are created only for the current page and the one likely shown next
+    private lazy var elementCache = QuestionnaireElementCache { [weak self] page in
+        guard let `self` = self, self.pages.count > page, self.pages[page].hasElements else { return nil }
+        return self.parser?.elements(for: self.pages[page])
+    }
+    /// The page whose next page was last prefetched, so it is done once per page change
+    private var prefetchedAfterPage: Int?
     internal var answers: [String:AnyHashable]! = [:]    // Holds answers saved by the user in the runtime
     internal var preAnswers: [String:AnyHashable]! = [:] // Holds answers already given by the server
 
@@ -104,7 +111,9 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
             guard let configurations = self?.configurations, let siteConfiguration = self?.sessionManager?.siteConfiguration else { return }
             let style = (questionnaireType == .pre) ? siteConfiguration.preAudienceQuestionnaireStyle : siteConfiguration.postAudienceQuestionnaireStyle
 
-            self?.items = QuestionnaireParser(configurations: configurations, style: style).items
+            let parser = QuestionnaireParser(configurations: configurations, style: style)
+            self?.parser = parser
+            self?.pages = parser.pages
         }
         let connectorOperation = BlockOperation { [weak self] in
             guard let configurations = self?.configurations, let siteConfiguration = self?.sessionManager?.siteConfiguration else { return }
@@ -112,7 +121,7 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
         }
         self.setupConnectorOperation = BlockOperation { [weak self] in
             if questionnaireType == .pre {
-                self?.preAnswers = (try? self?.extractGivenPreAnswers()) ?? [:]
+                self?.preAnswers = self?.extractGivenPreAnswers() ?? [:]
             }
         }
 
@@ -127,7 +136,7 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
             self?.submitTags(logic?.tags ?? [])
         }
         self.connector.logicContainsQueueID = { [weak self] logic in
-            self?.queue = self?.sessionManager?.queues.first(where: { $0.queueID == logic?.queueId })
+            self?.queue = logic?.queueId.flatMap { self?.sessionManager?.queueRegistry[$0] }
         }
         self.connector.onCompleteTargetReached = { [weak self] logic, redirect, autoApply in
             if self?.hasToWaitForUserConfirmation(autoApply) ?? false { return }
@@ -137,7 +146,7 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
             guard let `self` = self else { return }
             if self.hasToWaitForUserConfirmation(autoApply) || self.hasToExitQuestionnaire(logic) { return }
 
-            let targetQueue = self.sessionManager?.audienceQueues.first(where: { $0.queueID == logic?.queueId })
+            let targetQueue = logic?.queueId.flatMap { self.sessionManager?.queueRegistry.audienceQueue($0) }
             self.registerAudience(queueID: targetQueue?.queueID ?? queue.queueID) { [weak self] error in
                 if let error = error {
                     self?.onErrorOccurred?(error)
@@ -160,20 +169,13 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
         return elements.compactMap({ $0 as? QuestionnaireExitElement }).first?.isExitElement ?? false
     }
 
-    private func extractGivenPreAnswers() throws -> [String:AnyHashable] {
-        if let answersMetadata: NINResult<NINLowLevelClientProps> = sessionManager?.audienceMetadata?.get(forKey: "pre_answers"), case let .success(pre_answers) = answersMetadata {
-            let parser = NINChatClientPropsParser()
-            try pre_answers.accept(parser)
-
-            return parser.properties.compactMap({ ($0.key, $0.value) as? (String, AnyHashable) }).reduce(into: [:]) { (result: inout [String:AnyHashable], tuple: (key: String, value: AnyHashable)) in
-                result[tuple.key] = tuple.value
-            }
-        }
-        return [:]
+    private func extractGivenPreAnswers() -> [String:AnyHashable] {
+        /// Read from memory, without converting the whole metadata
+        self.sessionManager?.metadataStore.preAnswers ?? [:]
     }
 
     private func canJoinGivenQueue(withID id: String) -> (Bool, Queue?)? {
-        if let targetQueue = self.sessionManager?.queues.first(where: { $0.queueID == id }) {
+        if let targetQueue = self.sessionManager?.queueRegistry[id] {
             return (!targetQueue.isClosed, targetQueue)
         }
         return (false, nil)
@@ -182,15 +184,13 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
     private func submitTags(_ tags: [String]) {
         guard !tags.isEmpty else { return }
 
-        self.answers["tags"] = tags.reduce(into: NINLowLevelClientStrings()) { (result: inout NINLowLevelClientStrings, tag: String) in
-            result.append(tag)
-        }
+        self.answers["tags"] = tags
     }
 
     private func registerAudience(queueID: String, completion: @escaping (Error?) -> Void) {
         do {
-            let metadata = self.sessionManager?.audienceMetadata ?? NINLowLevelClientProps()
-            metadata.set(value: questionnaireAnswers, forKey: "pre_answers")
+            var metadata = self.sessionManager?.audienceMetadata ?? ClientProps()
+            metadata.set(value: questionnaireAnswers, forKey: AudienceMetadataStore.preAnswersKey)
             
             try self.sessionManager?.registerAudience(queue: queueID, answers: metadata, completion: completion)
         } catch {
@@ -202,10 +202,9 @@ final class NINQuestionnaireViewModelImpl: NINQuestionnaireViewModel {
     /// if so, it must be cleared to let re-selection
     /// as reported in `https://github.com/somia/mobile/issues/321`
     private func clearAnswersAtPage(_ page: Int) -> Bool {
-        guard self.items.count > page, page >= 0, !self.answers.isEmpty else { return false }
+        guard self.pages.count > page, page >= 0, !self.answers.isEmpty else { return false }
 
-        self.items[page]
-                .elements?
+        self.elementCache.elements(at: page)?
                 .filter({ $0.questionnaireConfiguration != nil || $0.elementConfiguration != nil })
                 .forEach({ self.removeAnswer(key: $0) })
         return true
@@ -240,7 +239,7 @@ extension NINQuestionnaireViewModelImpl {
         guard self.questionnaireType == .post else { return }
         /// if the post audience questionnaire needs to be saved
         /// the behaviour supports `https://github.com/somia/mobile/issues/386`
-        self.sessionManager?.preAudienceQuestionnaireMetadata = NINLowLevelClientProps.initiate()
+        self.sessionManager?.preAudienceQuestionnaireMetadata = ClientProps.initiate()
         self.submitPostQuestionnaireAnswers(waitForUserConfirmation: false) { [weak self] _ in
             self?.onQuestionnaireFinished?(nil, false, false)
         }
@@ -264,14 +263,14 @@ extension NINQuestionnaireViewModelImpl {
 
 // MARK :- Answers handlers
 extension NINQuestionnaireViewModelImpl {
-    var questionnaireAnswers: NINLowLevelClientProps {
+    var questionnaireAnswers: ClientProps {
         /// taken from `https://stackoverflow.com/a/43615143/7264553`
-        NINLowLevelClientProps.initiate(metadata: self.answers.filter({ $0.value as? Bool != false }).merging(self.preAnswers) { (current,new) in new })
+        ClientProps.initiate(metadata: self.answers.filter({ $0.value as? Bool != false }).merging(self.preAnswers) { (current,new) in new })
     }
     
     var requirementsSatisfied: Bool {
-        guard self.items.count > self.pageNumber else { return false }
-        guard let elements = self.items[self.pageNumber].elements else { return true } /// Return true if the current item is a logic block
+        guard self.pages.count > self.pageNumber else { return false }
+        guard let elements = self.elementCache.elements(at: self.pageNumber) else { return true } /// Return true if the current item is a logic block
 
         return elements.filter({
             if let required = $0.elementConfiguration?.required {
@@ -328,8 +327,14 @@ extension NINQuestionnaireViewModelImpl {
     }
 
     func getElements() throws -> [QuestionnaireElement] {
-        guard self.items.count > self.pageNumber else { throw NINQuestionnaireException.invalidPage(self.pageNumber) }
-        return self.items[self.pageNumber].elements ?? []
+        guard self.pages.count > self.pageNumber else { throw NINQuestionnaireException.invalidPage(self.pageNumber) }
+        defer {
+            if self.prefetchedAfterPage != self.pageNumber, self.pages.count > self.pageNumber + 1, self.pages[self.pageNumber + 1].hasElements {
+                self.prefetchedAfterPage = self.pageNumber
+                self.elementCache.prefetch(page: self.pageNumber + 1)
+            }
+        }
+        return self.elementCache.elements(at: self.pageNumber) ?? []
     }
 
     func getAnswersForElement(_ element: QuestionnaireElement, presetOnly: Bool = false) -> AnyHashable? {
@@ -348,17 +353,22 @@ extension NINQuestionnaireViewModelImpl {
     }
 
     func insertRegisteredElement(_ items: [QuestionnaireItems], configuration: [QuestionnaireConfiguration]) {
-        self.connector.appendElements(items, configurations: configuration)
+        let firstIndex = self.pages.count
+        let pages = configuration.compactMap { QuestionnaireParser.page(of: $0) }
+        self.connector.appendPages(pages, configurations: configuration)
         self.configurations.append(contentsOf: configuration)
-        self.items.append(contentsOf: items)
-        
-        
+        self.pages.append(contentsOf: pages)
+
+        /// The registered sections already have their views, keep them for the new pages
+        zip(items.indices, pages.indices).forEach { item, page in
+            guard let elements = items[item].elements else { return }
+            self.elementCache.insert(elements, at: firstIndex + page)
+        }
+
         /// if item.element != nil
         ///     - set the page number to the element
-        if let elements: Array<QuestionnaireElement> = items.first?.elements {
-            self.pageNumber = self.items
-                .compactMap({ $0.elements })
-                .lastIndex(where: { $0.isEqualToArray(elements) })!
+        if items.first?.elements != nil {
+            self.pageNumber = firstIndex
         }
         /// if items.element == nil
         ///     - find it using available function in the view model
@@ -390,11 +400,11 @@ extension NINQuestionnaireViewModelImpl {
 
     func goToNextPage() -> Bool? {
         guard !self.preventAutoRedirect, self.requirementsSatisfied else { return nil }
-        guard self.items.count > self.pageNumber + 1 else { return false }
+        guard self.pages.count > self.pageNumber + 1 else { return false }
 
-        if let logic = self.items[self.pageNumber + 1].logic {
+        if let logic = self.pages[self.pageNumber + 1].logic {
            return self.goToPage(logic: logic)
-        } else if self.items[self.pageNumber + 1].elements != nil {
+        } else if self.pages[self.pageNumber + 1].hasElements {
             return self.goToPage(page: self.pageNumber + 1)
         }
         return false
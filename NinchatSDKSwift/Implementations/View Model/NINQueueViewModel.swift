@@ -51,7 +51,7 @@ final class NINQueueViewModelImpl: NINQueueViewModel {
         do {
             try self.sessionManager.join(queue: queue.queueID, progress: { [weak self] queue, error, progress in
                 if let error = error {
-                    self?.delegate?.log(format: "Failed to join the queue: %@", error.localizedDescription)
+                    self?.delegate?.log(.session, "Failed to join the queue: \(error.localizedDescription)", level: .error)
                     self?.onQueueJoin?(error)
                 }
                 self?.onInfoTextUpdate?(self?.queueTextInfo(queue: queue, progress))
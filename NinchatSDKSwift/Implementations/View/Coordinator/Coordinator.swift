@@ -155,7 +155,7 @@ final class NINCoordinator: NSObject, Coordinator, UIAdaptivePresentationControl
         let topViewController: UIViewController
         if let resume = resume {
             topViewController = self.queueViewController(resume: resume, queue: nil)
-        } else if let queue = queue, let target = self.sessionManager.queues.filter({ $0.queueID == queue }).first {
+        } else if let queue = queue, let target = self.sessionManager.queueRegistry[queue] {
             topViewController = hasPreAudienceQuestionnaire ? self.questionnaireViewController(queue: target, questionnaireType: .pre) : self.queueViewController(queue: target)
         } else {
             topViewController = self.initialViewController
@@ -10,6 +10,9 @@ class ChatChannelCell: UITableViewCell, ChatCell, ChannelCell {
     
     internal var message: ChannelMessage?
 
+    /// Precomputed layout for the message, if any
+    var layout: ChatMessageLayout?
+
     internal var isTextMessageDeleted: Bool {
         return (self.message as? TextMessage)?.isDeleted == true
     }
@@ -41,6 +44,7 @@ class ChatChannelCell: UITableViewCell, ChatCell, ChannelCell {
 
     weak var session: (NINChatSessionAttachment & NINChatSessionTranslation)?
     var videoThumbnailManager: VideoThumbnailManager?
+    var attachmentImages: AttachmentImageCache?
     var onImageTapped: ((FileInfo, UIImage?) -> Void)?
     var onComposeSendTapped: ComposeMessageViewProtocol.OnUIComposeSendActionTapped?
     var onComposeUpdateTapped: ComposeMessageViewProtocol.OnUIComposeUpdateActionTapped?
@@ -69,16 +73,9 @@ class ChatChannelCell: UITableViewCell, ChatCell, ChannelCell {
         } else {
             self.senderNameLabel.text = "Guest".localized
         }
-        let infoContainerHeight: CGFloat
-        if isTextMessageDeleted {
-            infoContainerHeight = 7
-        } else if message.series {
-            infoContainerHeight = 0
-        } else {
-            infoContainerHeight = 40
-        }
+        let infoContainerHeight = ChatLayoutMetrics.infoHeight(deleted: isTextMessageDeleted, series: message.series)
         // Hide the name and timestamp if it's a part of series message chain or a deleted message
-        self.timeLabel.text = isTextMessageDeleted ? nil : DateFormatter.shortTime.string(from: message.timestamp)
+        self.timeLabel.text = isTextMessageDeleted ? nil : (self.layout?.timestamp ?? DateFormatter.shortTime.string(from: message.timestamp))
         self.infoContainerView.height?.constant = infoContainerHeight
         self.infoContainerView.height?.priority = .required
         self.infoContainerView.allSubviews.forEach { $0.isHidden = message.series || isTextMessageDeleted }
@@ -191,7 +188,7 @@ class ChatChannelMineCell: ChatChannelCell {
     
     private func toggleBubbleConstraints(isMyMessage: Bool, isSeries: Bool, showByConfig: Bool) {
         self.rightAvatarImageView.isHidden = isMyMessage ? (isSeries || !showByConfig) : true
-        self.rightAvatarContainer.width?.constant = (isMyMessage && showByConfig) ? 35 : 0
+        self.rightAvatarContainer.width?.constant = (isMyMessage && showByConfig) ? ChatLayoutMetrics.avatarWidth : 0
     }
 }
 
@@ -262,6 +259,6 @@ class ChatChannelOthersCell: ChatChannelCell {
     
     private func toggleBubbleConstraints(isMyMessage: Bool, isSeries: Bool, showByConfig: Bool) {
         self.leftAvatarImageView?.isHidden = isMyMessage ? true : (isSeries || !showByConfig)
-        self.leftAvatarContainer?.width?.constant = (!isMyMessage && showByConfig) ? 35 : 0
+        self.leftAvatarContainer?.width?.constant = (!isMyMessage && showByConfig) ? ChatLayoutMetrics.avatarWidth : 0
     }
 }
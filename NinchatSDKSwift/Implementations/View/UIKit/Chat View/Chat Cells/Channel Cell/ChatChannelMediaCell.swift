@@ -12,9 +12,6 @@ protocol ChannelMediaCellDelegate {
 }
 
 protocol ChannelMediaCell {
-    var cachedImage: [String:UIImage]? { get }
-    var originalImage: [String:UIImage]? { set get }
-
     /// Outlets
     var parentView: UIView! { get set }
     var messageImageViewContainer: UIView! { get set }
@@ -42,7 +39,7 @@ extension ChannelMediaCell where Self:ChatChannelCell {
             do {
                 try self?.updateAttachment(asynchronous: didRefreshNetwork || self?.messageImageView.height == nil, fromCache: false)
             } catch {
-                debugger("Error in updating attachment info: \(error)")
+                logger.error(.ui, "Error in updating attachment info: \(error)")
             }
         }
     }
@@ -81,7 +78,7 @@ extension ChannelMediaCell where Self:ChatChannelCell {
     /// asynchronous = YES implies we're calling this asynchronously from the
     /// `updateInfo(session:completion:)` completion block (meaning it did a network update)
     private func updateImage(from attachment: FileInfo, thumbnailUrl: String?, imageURL: String?, _ fromCache: Bool, _ asynchronous: Bool, _ isSeries: Bool) {
-        if fromCache, let id = self.message?.messageID, let image = self.cachedImage?[id] {
+        if fromCache, let id = self.message?.messageID, let image = self.attachmentImages?.thumbnail(for: id) {
             self.updateMessageImageView(attachment: attachment, thumbnailUrl: nil, imageURL: nil, image: image, asynchronous: asynchronous, isSeries: isSeries); return
         }
         self.updateMessageImageView(attachment: attachment, thumbnailUrl: thumbnailUrl, imageURL: imageURL, image: nil, asynchronous: asynchronous, isSeries: isSeries)
@@ -105,38 +102,38 @@ extension ChannelMediaCell where Self:ChatChannelCell {
         }
 
         /// Load the image in message image view over HTTP in the background for later uses
-        if let messageID = self.message?.messageID, self.originalImage?[messageID] == nil, let imageURL = imageURL, image == nil {
+        if let messageID = self.message?.messageID, self.attachmentImages?.original(for: messageID) == nil, let imageURL = imageURL, image == nil {
             DispatchQueue.global(qos: .background).async {
-                imageURL.fetchImage { [weak self, messageID] data, error in
-                    guard let data = data, error == nil else { return }
-                    self?.originalImage?[messageID] = UIImage(data: data)
+                imageURL.fetchImage { [weak images = self.attachmentImages, messageID] data, error in
+                    guard let data = data, error == nil, let image = UIImage(data: data) else { return }
+                    images?.set(original: image, for: messageID)
                 }
             }
         }
     }
 
     private func set(aspect ratio: Double?, _ isSeries: Bool) {
-        let width: CGFloat = min(self.contentView.bounds.width, 400) / 2, height: CGFloat = width / CGFloat(ratio ?? 1.0)
-        debugger("attachment constraints: width: \(width), height: \(height)")
+        let size = ChatLayoutMetrics.mediaSize(width: self.contentView.bounds.width, aspectRatio: ratio)
+        logger.debug(.ui, "Attachment constraints: width: \(size.width), height: \(size.height)")
 
+        /// The parent view holds the info container above the media frame
+        let height = ChatLayoutMetrics.infoHeight(deleted: false, series: isSeries) + size.height
         /// Defensive approach to avoid problems on cell reuse cases
         if self.parentView.height != nil {
-            self.parentView.height?.constant = max(height, 150.0)
+            self.parentView.height?.constant = height
         } else {
-            self.parentView.fix(height: max(height, 150.0))
+            self.parentView.fix(height: height)
         }
         if self.messageImageView.width != nil {
-            self.messageImageView.width?.constant = width
+            self.messageImageView.width?.constant = size.width
         } else {
-            self.messageImageView.fix(width: width)
+            self.messageImageView.fix(width: size.width)
         }
         self.messageImageViewContainer.top?.constant = (isSeries) ? 16 : 8
     }
 }
 
 final class ChatChannelMediaMineCell: ChatChannelMineCell, ChannelMediaCell, ChannelMediaCellDelegate {
-    var cachedImage: [String:UIImage]? = [:]
-    var originalImage: [String:UIImage]? = [:]
     @IBOutlet weak var parentView: UIView!
     @IBOutlet weak var messageImageViewContainer: UIView! {
         didSet {
@@ -162,7 +159,7 @@ final class ChatChannelMediaMineCell: ChatChannelMineCell, ChannelMediaCell, Cha
         if attachment.isVideo {
             /// Will open video player
             self.onImageTapped?(attachment, nil)
-        } else if attachment.isImage, let image = self.originalImage?[message.messageID] {
+        } else if attachment.isImage, let image = self.attachmentImages?.original(for: message.messageID) {
             /// Will show full-screen image viewer
             self.onImageTapped?(attachment, image)
         }
@@ -174,7 +171,7 @@ final class ChatChannelMediaMineCell: ChatChannelMineCell, ChannelMediaCell, Cha
     func didLoadAttachment(_ image: UIImage?, messageID: String?) -> Bool {
         guard self.messageImageView.image == nil else { return true }
         if let image = image, let id = self.message?.messageID, messageID == id {
-            self.cachedImage?[id] = image
+            self.attachmentImages?.set(thumbnail: image, for: id)
             self.messageImageView.image = image
             return true
         }
@@ -183,8 +180,6 @@ final class ChatChannelMediaMineCell: ChatChannelMineCell, ChannelMediaCell, Cha
 }
 
 final class ChatChannelMediaOthersCell: ChatChannelOthersCell, ChannelMediaCell, ChannelMediaCellDelegate {
-    var cachedImage: [String:UIImage]? = [:]
-    var originalImage: [String:UIImage]? = [:]
     @IBOutlet weak var parentView: UIView!
     @IBOutlet weak var messageImageViewContainer: UIView! {
         didSet {
@@ -210,7 +205,7 @@ final class ChatChannelMediaOthersCell: ChatChannelOthersCell, ChannelMediaCell,
         if attachment.isVideo {
             /// Will open video player
             self.onImageTapped?(attachment, nil)
-        } else if attachment.isImage, let image = self.originalImage?[message.messageID] {
+        } else if attachment.isImage, let image = self.attachmentImages?.original(for: message.messageID) {
             /// Will show full-screen image viewer
             self.onImageTapped?(attachment, image)
         }
@@ -222,7 +217,7 @@ final class ChatChannelMediaOthersCell: ChatChannelOthersCell, ChannelMediaCell,
     func didLoadAttachment(_ image: UIImage?, messageID: String?) -> Bool {
         guard self.messageImageView.image == nil else { return true }
         if let image = image, let id = self.message?.messageID, messageID == id {
-            self.cachedImage?[id] = image
+            self.attachmentImages?.set(thumbnail: image, for: id)
             self.messageImageView.image = image
             return true
         }
@@ -37,7 +37,7 @@ final class ChatChannelTextMineCell: ChatChannelMineCell, ChannelTextCell {
     }
 
     func populateText(message: TextMessage, attachment: FileInfo?) {
-        self.messageTextView.contentInset = (message.series) ? UIEdgeInsets(top: 3.5, left: 0.0, bottom: 0.0, right: 0.0) : .zero
+        self.messageTextView.contentInset = (message.series) ? UIEdgeInsets(top: ChatLayoutMetrics.seriesTextInset, left: 0.0, bottom: 0.0, right: 0.0) : .zero
         if message.isDeleted {
             let text = Constants.kThisMessageWasDeletedText.rawValue
             self.messageTextView.setPlain(
@@ -76,7 +76,7 @@ final class ChatChannelTextOthersCell: ChatChannelOthersCell, ChannelTextCell {
     }
     
     func populateText(message: TextMessage, attachment: FileInfo?) {
-        self.messageTextView.contentInset = (message.series) ? UIEdgeInsets(top: 3.5, left: 0.0, bottom: 0.0, right: 0.0) : .zero
+        self.messageTextView.contentInset = (message.series) ? UIEdgeInsets(top: ChatLayoutMetrics.seriesTextInset, left: 0.0, bottom: 0.0, right: 0.0) : .zero
         if message.isDeleted {
             let text = Constants.kThisMessageWasDeletedText.rawValue
             self.messageTextView.setPlain(
@@ -79,13 +79,13 @@ class ChatTypingCell: UITableViewCell {
 // MARK: - TypingCell
 
 extension ChatTypingCell: TypingCell {
-    func populateTyping(message: UserTypingMessage, imageAssets: NINImageAssetDictionary?, colorAssets: NINColorAssetDictionary?, agentAvatarConfig: AvatarConfig?) {
+    func populateTyping(users: [ChannelUser], since: Date, imageAssets: NINImageAssetDictionary?, colorAssets: NINColorAssetDictionary?, agentAvatarConfig: AvatarConfig?) {
         if let name = agentAvatarConfig?.nameOverride, !name.isEmpty {
             self.senderNameLabel.text = name
-        } else if let user = message.user, !user.displayName.isEmpty {
-            self.senderNameLabel.text = user.displayName
+        } else {
+            self.senderNameLabel.text = users.map({ $0.displayName }).filter({ !$0.isEmpty }).joined(separator: ", ")
         }
-        self.timeLabel?.text = DateFormatter.shortTime.string(from: message.timestamp)
+        self.timeLabel?.text = DateFormatter.shortTime.string(from: since)
 
         /// Make Image view background match the bubble color
         self.bubbleImageView.tintColor = .white
@@ -97,7 +97,7 @@ extension ChatTypingCell: TypingCell {
 
         /// Apply asset overrides
         self.applyCommon(imageAssets: imageAssets, colorAssets: colorAssets)
-        self.apply(avatar: agentAvatarConfig, imageView: self.leftAvatarImageView, url: message.user?.iconURL, overrideWith: imageAssets?[.ninchatChatAvatarLeft] ?? UIImage(named: "icon_avatar_other", in: .SDKBundle, compatibleWith: nil)!)
+        self.apply(avatar: agentAvatarConfig, imageView: self.leftAvatarImageView, url: users.first?.iconURL, overrideWith: imageAssets?[.ninchatChatAvatarLeft] ?? UIImage(named: "icon_avatar_other", in: .SDKBundle, compatibleWith: nil)!)
     }
 }
 
@@ -7,7 +7,7 @@
 import UIKit
 
 protocol TypingCell: UIView {
-    func populateTyping(message: UserTypingMessage, imageAssets: NINImageAssetDictionary?, colorAssets: NINColorAssetDictionary?, agentAvatarConfig: AvatarConfig?)
+    func populateTyping(users: [ChannelUser], since: Date, imageAssets: NINImageAssetDictionary?, colorAssets: NINColorAssetDictionary?, agentAvatarConfig: AvatarConfig?)
 }
 
 protocol LoadingCell: UIView {
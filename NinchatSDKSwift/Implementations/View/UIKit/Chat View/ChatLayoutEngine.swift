@@ -0,0 +1,153 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import UIKit
+
+/// Precomputed layout of a chat message for a given content width
+struct ChatMessageLayout: Equatable {
+    /// Total height of the row
+    let height: CGFloat
+    /// Size of the bubble content; the text or the media frame
+    let bubbleSize: CGSize
+    /// Formatted timestamp, nil if the timestamp is hidden
+    let timestamp: String?
+}
+
+/**
+ * Computes chat message layouts without instantiating any cell or view.
+ * The results are cached by messageID, together with the width and the
+ * message properties they depend on, so a change in any of them (e.g. a
+ * rotation, a deleted message or a described attachment) is recomputed.
+ *
+ * Compose and meta messages are not handled; those rows are left to
+ * Auto Layout.
+ */
+final class ChatLayoutEngine {
+    struct Configuration {
+        var font: UIFont? = .ninchat
+        var deletedFont: UIFont? = .ninchatItalic
+        var deletedText: String = Constants.kThisMessageWasDeletedText.rawValue
+        var showAgentAvatar: Bool = true
+        var showUserAvatar: Bool = true
+    }
+
+    private struct Signature: Equatable {
+        let width: CGFloat
+        let series: Bool
+        let deleted: Bool
+        let attachment: String?
+        let aspectRatio: Double?
+    }
+
+    private var entries: [String:(signature: Signature, layout: ChatMessageLayout)] = [:]
+    private let lock = DispatchQueue(label: "com.ninchat.sdk.swift.layout.cache")
+    private let queue = DispatchQueue(label: "com.ninchat.sdk.swift.layout", qos: .userInitiated)
+    private let formatter: DateFormatter = .shortTime
+
+    var configuration: Configuration {
+        didSet { self.removeAll() }
+    }
+
+    init(configuration: Configuration = Configuration()) {
+        self.configuration = configuration
+    }
+
+    var count: Int {
+        self.lock.sync { self.entries.count }
+    }
+
+    // MARK: - Layout
+
+    /// Returns the cached layout if it is still valid for the message and the width
+    func cached(_ message: ChatMessage, width: CGFloat) -> ChatMessageLayout? {
+        guard let signature = self.signature(message, width) else { return nil }
+        return self.lock.sync {
+            guard let entry = self.entries[message.messageID], entry.signature == signature else { return nil }
+            return entry.layout
+        }
+    }
+
+    /// Returns the layout for the message, computing and caching it if needed
+    func layout(for message: ChatMessage, width: CGFloat) -> ChatMessageLayout? {
+        if let cached = self.cached(message, width: width) { return cached }
+        guard let signature = self.signature(message, width), let layout = self.compute(message, width: width) else { return nil }
+
+        self.lock.sync { self.entries[message.messageID] = (signature, layout) }
+        return layout
+    }
+
+    /// Computes the layouts in the background and calls the completion on the main thread
+    func prepare(_ messages: [ChatMessage], width: CGFloat, completion: (() -> Void)? = nil) {
+        self.queue.async { [weak self] in
+            messages.forEach { _ = self?.layout(for: $0, width: width) }
+            guard let completion = completion else { return }
+            DispatchQueue.main.async {
+                completion()
+            }
+        }
+    }
+
+    func remove(messageID: String) {
+        self.lock.sync { _ = self.entries.removeValue(forKey: messageID) }
+    }
+
+    func removeAll() {
+        self.lock.sync { self.entries.removeAll() }
+    }
+
+    // MARK: - Computation
+
+    private func signature(_ message: ChatMessage, _ width: CGFloat) -> Signature? {
+        guard let message = message as? TextMessage else { return nil }
+        return Signature(width: width, series: message.series, deleted: message.isDeleted, attachment: message.attachment?.url, aspectRatio: message.attachment?.aspectRatio)
+    }
+
+    private func compute(_ message: ChatMessage, width: CGFloat) -> ChatMessageLayout? {
+        guard let message = message as? TextMessage else { return nil }
+        let metrics = ChatLayoutMetrics.self
+
+        let infoHeight = metrics.infoHeight(deleted: message.isDeleted, series: message.series)
+        let timestamp = message.isDeleted ? nil : self.formatter.string(from: message.timestamp)
+
+        /// Media messages keep a fixed aspect ratio, below the info container
+        if let attachment = message.attachment, !message.isDeleted, attachment.isImage || attachment.isVideo {
+            let mediaSize = metrics.mediaSize(width: width, aspectRatio: attachment.aspectRatio)
+            return ChatMessageLayout(height: ceil(infoHeight + mediaSize.height), bubbleSize: mediaSize, timestamp: timestamp)
+        }
+
+        let text: String
+        let font: UIFont?
+        if message.isDeleted {
+            text = self.configuration.deletedText
+            font = self.configuration.deletedFont
+        } else if let attachment = message.attachment, attachment.isPDF, let name = attachment.name {
+            text = name
+            font = self.configuration.font
+        } else {
+            text = message.content ?? ""
+            font = self.configuration.font
+        }
+
+        let showAvatar = message.isDeleted ? false : (message.mine ? self.configuration.showUserAvatar : self.configuration.showAgentAvatar)
+        let textWidth = width - metrics.horizontalMargins - (showAvatar ? metrics.avatarWidth : 0)
+            - metrics.bubbleInsets.left - metrics.bubbleInsets.right
+            - metrics.textInsets.left - metrics.textInsets.right
+        let textSize = self.size(of: text, font: font, width: max(textWidth, 1))
+
+        let bubbleHeight = textSize.height + metrics.textInsets.top + metrics.textInsets.bottom + (message.series ? metrics.seriesTextInset : 0)
+        let height = infoHeight + metrics.bubbleInsets.top + bubbleHeight + metrics.bubbleInsets.bottom
+        return ChatMessageLayout(height: ceil(height), bubbleSize: CGSize(width: textSize.width + metrics.textInsets.left + metrics.textInsets.right, height: bubbleHeight), timestamp: timestamp)
+    }
+
+    private func size(of text: String, font: UIFont?, width: CGFloat) -> CGSize {
+        guard !text.isEmpty else { return CGSize(width: 0, height: ceil(font?.lineHeight ?? 0)) }
+
+        var attributes: [NSAttributedString.Key:Any] = [:]
+        if let font = font { attributes[.font] = font }
+        let rect = (text as NSString).boundingRect(with: CGSize(width: width, height: .greatestFiniteMagnitude), options: [.usesLineFragmentOrigin, .usesFontLeading], attributes: attributes, context: nil)
+        return CGSize(width: ceil(rect.width), height: ceil(rect.height))
+    }
+}
@@ -16,18 +16,18 @@ protocol ChatViewProtocol: UIView {
     /** Chat session manager. */
     var sessionManager: NINChatSessionManager? { get set }
 
-    /** A new message was added to given index. Updates the view. */
-    func didAddMessage(at index: Int)
+    /** The messages currently shown. */
+    var snapshot: ChatSnapshot { get }
 
-    /** A message was updated at given index. Updates the view. */
-    func didUpdateMessage(at index: Int)
+    /** A new version of the messages is published. Applies the diff as one batch, or reloads if versions were skipped. */
+    func apply(_ snapshot: ChatSnapshot, diff: ChatSnapshotDiff)
 
-    /** A message was removed from given index. */
-    func didRemoveMessage(from index: Int)
-
-    /** The chat's history is loaded. */
+    /** The chat's history is loaded or cleaned. Reloads the view with the latest messages. */
     func didLoadHistory()
 
+    /** Channel members started or stopped typing. Shown below the messages, not as a message. */
+    func didUpdateTyping(_ typing: [TypingPresence.Entry])
+
     /** A compose message got updates from the server regarding its options. */
     func didUpdateComposeAction(_ id: String, with action: ComposeUIAction)
 
@@ -73,11 +73,12 @@ final class ChatView: UIView, ChatViewProtocol {
     private var userAvatarConfig: AvatarConfig!
 
     private let videoThumbnailManager = VideoThumbnailManager()
-    private var cellConstraints: Array<CGSize> = []
+    private let attachmentImages = AttachmentImageCache()
+    private let layoutEngine = ChatLayoutEngine()
+    private var layoutWidth: CGFloat = 0
     private var composeCellActions: [String:ComposeUIAction] = [:]
-
-    /// To avoid a race condition in updating the chat view
-    private let lock = NSLock()
+    private lazy var typingIndicator: ChatTypingCell = ChatTypingCell.loadFromNib()
+    private let typingContainer = UIView()
 
     // MARK: - Outlets
 
@@ -91,7 +92,6 @@ final class ChatView: UIView, ChatViewProtocol {
             tableView.register(ChatChannelMediaOthersCell.self)
             tableView.register(ChatChannelTextOthersCell.self)
 
-            tableView.register(ChatTypingCell.self)
             tableView.register(ChatMetaCell.self)
             tableView.dataSource = self
             tableView.delegate = self
@@ -113,44 +113,79 @@ final class ChatView: UIView, ChatViewProtocol {
 
             self.agentAvatarConfig = AvatarConfig(forAgent: sessionManager)
             self.userAvatarConfig = AvatarConfig(forUser: sessionManager)
+
+            let deletedText = Constants.kThisMessageWasDeletedText.rawValue
+            self.layoutEngine.configuration = ChatLayoutEngine.Configuration(
+                deletedText: self.sessionManager?.translate(key: deletedText, formatParams: [:]) ?? deletedText,
+                showAgentAvatar: self.agentAvatarConfig.show ?? false,
+                showUserAvatar: self.userAvatarConfig.show ?? false)
         }
     }
     weak var dataSource: ChatViewDataSource?
     weak var delegate: ChatViewDelegate?
+    private(set) var snapshot: ChatSnapshot = .empty
 
-    func didAddMessage(at index: Int) {
-        guard let messageCount = self.dataSource?.numberOfMessages(for: self), self.tableView.numberOfRows(inSection: 0) < messageCount else {
-            return
+    func apply(_ snapshot: ChatSnapshot, diff: ChatSnapshotDiff) {
+        guard Thread.isMainThread else {
+            DispatchQueue.main.async { [weak self] in self?.apply(snapshot, diff: diff) }; return
         }
 
-       self.tableView.insertRows(at: [IndexPath(row: index, section: 0)], with: .automatic)
-    }
-
-    func didUpdateMessage(at index: Int) {
-        guard let messageCount = self.dataSource?.numberOfMessages(for: self), self.tableView.numberOfRows(inSection: 0) == messageCount else {
-            return
+        /// An older version may arrive after a reload to a newer one
+        guard snapshot.version > self.snapshot.version else { return }
+        guard diff.from == self.snapshot.version, !diff.reload else {
+            self.reload(to: snapshot); return
         }
 
-        self.tableView.reloadRows(at: [IndexPath(row: index, section: 0)], with: .automatic)
-    }
-
-    func didRemoveMessage(from index: Int) {
-        guard let messageCount = self.dataSource?.numberOfMessages(for: self), self.tableView.numberOfRows(inSection: 0) > messageCount else {
-            return
+        self.snapshot = snapshot
+        self.tableView.performBatchUpdates({
+            self.tableView.deleteRows(at: diff.removed.map { IndexPath(row: $0, section: 0) }, with: .automatic)
+            self.tableView.insertRows(at: diff.inserted.map { IndexPath(row: $0, section: 0) }, with: .automatic)
+        })
+        if !diff.updated.isEmpty {
+            self.tableView.reloadRows(at: diff.updated.map { IndexPath(row: $0, section: 0) }, with: .automatic)
         }
-
-        self.tableView.deleteRows(at: [IndexPath(row: index, section: 0)], with: .automatic)
+        self.sessionManager?.eventTracer.rendered(version: snapshot.version)
     }
 
     func didLoadHistory() {
         DispatchQueue.main.async { [weak self] in
             guard let `self` = self else { return }
+            self.reload(to: self.sessionManager?.messageSnapshot ?? .empty)
+        }
+    }
+
+    private func reload(to snapshot: ChatSnapshot) {
+        /// Compute the layouts in the background before showing the messages
+        self.layoutEngine.prepare(snapshot.messages, width: self.tableView.bounds.width) { [weak self] in
+            /// Skip if a newer version is shown meanwhile
+            guard let `self` = self, snapshot.version > self.snapshot.version else { return }
+            self.snapshot = snapshot
             self.tableView.reloadData()
+            self.sessionManager?.eventTracer.rendered(version: snapshot.version)
+        }
+    }
+
+    func didUpdateTyping(_ typing: [TypingPresence.Entry]) {
+        guard let first = typing.first else {
+            self.tableView.tableHeaderView = nil; return
         }
+        self.typingIndicator.populateTyping(users: typing.map { $0.user }, since: first.since, imageAssets: self.imageAssets, colorAssets: self.colorAssets, agentAvatarConfig: self.agentAvatarConfig)
+
+        /// The table is upside down, so its header sits below the latest message.
+        /// The indicator is rotated like the cells, hence the container.
+        let width = self.tableView.bounds.width
+        let height = self.typingIndicator.contentView.systemLayoutSizeFitting(CGSize(width: width, height: 0), withHorizontalFittingPriority: .required, verticalFittingPriority: .fittingSizeLevel).height
+        self.typingContainer.frame = CGRect(x: 0, y: 0, width: width, height: height)
+        self.typingIndicator.bounds = self.typingContainer.bounds
+        self.typingIndicator.center = CGPoint(x: width / 2, y: height / 2)
+        if self.typingIndicator.superview == nil {
+            self.typingContainer.addSubview(self.typingIndicator)
+        }
+        self.tableView.tableHeaderView = self.typingContainer
     }
 
     func didUpdateComposeAction(_ id: String, with action: ComposeUIAction) {
-        debugger("Got ui action update for compose for message at: \(String(describing: index))")
+        logger.debug(.ui, "Got ui action update for compose for message at: \(String(describing: index))")
 
         guard self.composeCellActions[id] == nil else { return }
         self.composeCellActions[id] = action
@@ -162,8 +197,17 @@ final class ChatView: UIView, ChatViewProtocol {
 
     // MARK: - UIView
 
+    override func layoutSubviews() {
+        super.layoutSubviews()
+
+        /// Layouts are computed per content width, e.g. a rotation invalidates them
+        guard let tableView = self.tableView, tableView.bounds.width != self.layoutWidth else { return }
+        self.layoutWidth = tableView.bounds.width
+        tableView.reloadData()
+    }
+
     deinit {
-        debugger("`ChatView` deallocated")
+        logger.debug(.ui, "`ChatView` deallocated")
     }
 }
 
@@ -171,8 +215,17 @@ final class ChatView: UIView, ChatViewProtocol {
 
 extension ChatView: UITableViewDataSource, UITableViewDelegate {
     func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
-        self.cellConstraints.insert(.zero, at: 0)
-        return dataSource?.numberOfMessages(for: self) ?? 0
+        dataSource?.numberOfMessages(for: self) ?? 0
+    }
+
+    func tableView(_ tableView: UITableView, heightForRowAt indexPath: IndexPath) -> CGFloat {
+        guard let message = dataSource?.message(at: indexPath.row, self) else { return UITableView.automaticDimension }
+        return self.layoutEngine.layout(for: message, width: tableView.bounds.width)?.height ?? UITableView.automaticDimension
+    }
+
+    func tableView(_ tableView: UITableView, estimatedHeightForRowAt indexPath: IndexPath) -> CGFloat {
+        guard let message = dataSource?.message(at: indexPath.row, self) else { return UITableView.automaticDimension }
+        return self.layoutEngine.cached(message, width: tableView.bounds.width)?.height ?? UITableView.automaticDimension
     }
 
     func tableView(_ tableView: UITableView, cellForRowAt indexPath: IndexPath) -> UITableViewCell {
@@ -180,8 +233,6 @@ extension ChatView: UITableViewDataSource, UITableViewDelegate {
 
         if let channelMSG = message as? ChannelMessage {
             return setupBubbleCell(channelMSG, at: indexPath)
-        } else if let typingMSG = message as? UserTypingMessage {
-            return setupTypingCell(typingMSG, at: indexPath)
         } else if let metaMSG = message as? MetaMessage {
             return setupMetaCell(metaMSG, at: indexPath)
         }
@@ -206,9 +257,11 @@ extension ChatView: UITableViewDataSource, UITableViewDelegate {
 extension ChatView {
     private func setupBubbleCell(_ message: ChannelMessage, at indexPath: IndexPath) -> ChatChannelCell {
         let cell = self.cell(message, for: tableView, at: indexPath)
+        cell.layout = self.layoutEngine.cached(message, width: tableView.bounds.width)
         cell.session = self.sessionManager
         cell.delegate = self.sessionManager?.delegate
         cell.videoThumbnailManager = videoThumbnailManager
+        cell.attachmentImages = attachmentImages
 
         cell.onComposeSendTapped = { [weak self] composeContentView, didUpdateOptions in
             guard didUpdateOptions else { return }
@@ -240,12 +293,6 @@ extension ChatView {
         return cell
     }
 
-    private func setupTypingCell(_ message: UserTypingMessage, at indexPath: IndexPath) -> ChatTypingCell {
-        let cell: ChatTypingCell = tableView.dequeueReusableCell(forIndexPath: indexPath)
-        cell.populateTyping(message: message, imageAssets: imageAssets, colorAssets: colorAssets, agentAvatarConfig: agentAvatarConfig)
-        return cell
-    }
-
     private func setupMetaCell(_ message: MetaMessage, at indexPath: IndexPath) -> ChatMetaCell {
         let cell: ChatMetaCell = tableView.dequeueReusableCell(forIndexPath: indexPath)
         cell.delegate = self.sessionManager?.delegate
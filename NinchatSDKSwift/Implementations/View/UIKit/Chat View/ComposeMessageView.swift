@@ -69,7 +69,7 @@ final class ComposeMessageView: UIView, ComposeMessageViewProtocol {
     }
 
     func updateStates(with action: ComposeUIAction) {
-        debugger("Start updating compose states received from the server")
+        logger.debug(.ui, "Start updating compose states received from the server")
 
         self.contentViews.forEach { view in
             guard action.target == view.message, view.didUpdatedOptions, let sendButton = view.sendButton else { return }
@@ -76,7 +76,7 @@ final class QuestionnaireNavigationCell: UITableViewCell, QuestionnaireNavigatio
     func enableNavigationItems(_ satisfied: Bool, configuration cfg: QuestionnaireConfiguration) {
         guard self.configuration == cfg else { return }
         
-        debugger("Set navigation Satisfaction: \(satisfied && self.isLastItemInTable)")
+        logger.debug(.questionnaire, "Set navigation Satisfaction: \(satisfied && self.isLastItemInTable)")
         self.buttons.arrangedSubviews.compactMap({ $0 as? NINButton }).first(where: { $0.type == .next })?.isEnabled = satisfied && self.isLastItemInTable
         /// back button should not get disabled according to user inputs
         /// it is always enabled for the last item
@@ -53,7 +53,7 @@ class QuestionnaireElementRadio: UIView, QuestionnaireElementWithTitle, Question
             
             button.closure?(button)
         case .nothing:
-            debugger("Do nothing for Radio element")
+            logger.debug(.questionnaire, "Do nothing for Radio element")
         }
     }
 
@@ -188,7 +188,7 @@ extension QuestionnaireElementSelect {
         case .set:
             self.onElementOptionSelected?(self, option)
         case .nothing:
-            debugger("Do nothing for Select element")
+            logger.debug(.questionnaire, "Do nothing for Select element")
         }
 
     }
@@ -56,7 +56,7 @@ final class QuestionnaireElementTextArea: UIView, QuestionnaireElementWithTitle,
         case .set:
             self.textViewDidEndEditing(self.view)
         case .nothing:
-            debugger("Do nothing for TextArea element")
+            logger.debug(.questionnaire, "Do nothing for TextArea element")
         }
 
     }
@@ -56,7 +56,7 @@ final class QuestionnaireElementTextField: UIView, QuestionnaireElementWithTitle
         case .set:
             self.textFieldDidEndEditing(self.view)
         case .nothing:
-            debugger("Do nothing for TextField element")
+            logger.debug(.questionnaire, "Do nothing for TextField element")
         }
     }
 
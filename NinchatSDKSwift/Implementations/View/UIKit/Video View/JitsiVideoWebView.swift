@@ -10,6 +10,7 @@ import WebKit
 
 protocol JitsiVideoWebViewEventsDelegate: AnyObject {
     func readyToClose()
+    func conferenceJoined()
 }
 
 class JitsiVideoWebView: UIView {
@@ -86,6 +87,12 @@ extension JitsiVideoWebView {
 
 // MARK: - Loading Jitsi
 extension JitsiVideoWebView {
+    /// Starts the web content process before the meeting is loaded, so joining does not wait for it
+    func prewarm() {
+        guard webView.url == nil, !webView.isLoading else { return }
+        webView.loadHTMLString("<html><body style=\"background-color: black;\"></body></html>", baseURL: nil)
+    }
+
     func loadJitsiMeeting(for urlRequest: URLRequest) {
         if isDebugMode {
             let htmlContent = getJitsiVideoWebViewHtml(for: urlRequest)
@@ -106,7 +113,7 @@ extension JitsiVideoWebView {
 // MARK: - WKNavigationDelegate
 extension JitsiVideoWebView: WKNavigationDelegate {
     func webView(_ webView: WKWebView, didFailProvisionalNavigation navigation: WKNavigation!, withError error: Error) {
-        // debugger("WebView error: \(error.localizedDescription)")
+        // logger.error(.jitsi, "WebView error: \(error.localizedDescription)")
     }
 }
 
@@ -121,6 +128,8 @@ extension JitsiVideoWebView: WKUIDelegate {
 extension JitsiVideoWebView: WKScriptMessageHandler {
     func userContentController(_ userContentController: WKUserContentController, didReceive message: WKScriptMessage) {
         switch message.name {
+        case "videoConferenceJoined":
+            eventsDelegate?.conferenceJoined()
         case "videoConferenceLeft":
             eventsDelegate?.readyToClose()
         default:
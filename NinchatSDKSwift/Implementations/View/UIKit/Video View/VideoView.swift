@@ -135,7 +135,7 @@ final class VideoView: UIView, VideoViewProtocol {
     }
     
     func resizeRemoteVideo(to size: CGSize) {
-        debugger("Adjusting remote video view size")
+        logger.debug(.ui, "Adjusting remote video view size")
         let aspectRatio = (size == .zero) ? CGSize(width: 4, height: 3) : size
         let videoFrame = AVMakeRect(aspectRatio: aspectRatio, insideRect: self.videoContainerView.bounds)
         self.remoteViewWidthConstraint.constant = videoFrame.width
@@ -152,7 +152,7 @@ final class VideoView: UIView, VideoViewProtocol {
         let containerWidth = self.videoContainerView.bounds.width
         let containerHeight = self.videoContainerView.bounds.height
         guard containerWidth > 1, containerHeight > 1 else { return }
-        debugger("Adjusting local video view size")
+        logger.debug(.ui, "Adjusting local video view size")
         
         let videoRect = CGRect(x: 0, y: 0, width: containerWidth / 3, height: containerHeight / 3)
         self.localViewWidthConstraint.constant = videoRect.width
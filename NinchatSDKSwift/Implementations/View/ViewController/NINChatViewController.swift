@@ -266,7 +266,7 @@ final class NINChatViewController: UIViewController, DeallocatableViewController
         self.updateInputContainerHeight(94.0)
         
         self.inputControlsView.onTextSizeChanged = { [weak self] height in
-            debugger("new text area height: \(height + Margins.kTextFieldPaddingHeight.rawValue)")
+            logger.debug(.ui, "New text area height: \(height + Margins.kTextFieldPaddingHeight.rawValue)")
             self?.updateInputContainerHeight(height + Margins.kTextFieldPaddingHeight.rawValue)
         }
     }
@@ -298,16 +298,18 @@ final class NINChatViewController: UIViewController, DeallocatableViewController
         }
         self.viewModel.onChannelMessage = { [weak self] update in
             switch update {
-            case .insert(let index):
-                self?.chatView.didAddMessage(at: index)
-            case .update(let index):
-                self?.chatView.didUpdateMessage(at: index)
-            case .remove(let index):
-                self?.chatView.didRemoveMessage(from: index)
-            case .history, .clean:
+            case .snapshot(let snapshot, let diff):
+                self?.chatView.apply(snapshot, diff: diff)
+            case .clean:
                 self?.chatView.didLoadHistory()
+            case .insert, .update, .remove, .history:
+                /// The chat view follows the snapshots
+                break
             }
         }
+        self.viewModel.onTypingUpdated = { [weak self] typing in
+            self?.chatView.didUpdateTyping(typing)
+        }
         self.viewModel.onComposeActionUpdated = { [weak self] id, action in
             self?.chatView.didUpdateComposeAction(id, with: action)
         }
@@ -332,7 +334,7 @@ final class NINChatViewController: UIViewController, DeallocatableViewController
 
         /// send .answer response
         func answerCall(with action: ConfirmAction) {
-            debugger("accept call: \(action == .confirm)")
+            logger.debug(.rtc, "Accept call: \(action == .confirm)")
 
             switch action {
             case .cancel:
@@ -340,11 +342,11 @@ final class NINChatViewController: UIViewController, DeallocatableViewController
                     if error != nil { Toast.show(message: .error("WebRTC pickup fail".localized)) }
                 }
             case .confirm:
-                debugger("WebRTC: Grant permission for the video call")
+                logger.debug(.rtc, "Grant permission for the video call")
                 self.viewModel.grantVideoCallPermissions { error in
                     if permissionError(error) { return }
 
-                    debugger("WebRTC: Permissions granted - initializing the video call (answer)")
+                    logger.debug(.rtc, "Permissions granted - initializing the video call (answer)")
                     self.viewModel.pickup(answer: true) { error in
                         if error != nil { Toast.show(message: .error("WebRTC pickup fail".localized)) }
                     }
@@ -355,7 +357,7 @@ final class NINChatViewController: UIViewController, DeallocatableViewController
         self.viewModel.listenToRTCSignaling(delegate: chatRTCDelegate, onCallReceived: { [weak self] channel, error in
             /// accept invite silently when re-invited `https://github.com/somia/mobile/issues/232`
             guard self?.webRTCClient == nil else {
-                debugger("WebRTC: Silently accept the video call")
+                logger.debug(.rtc, "Silently accept the video call")
                 answerCall(with: .confirm); return
             }
             DispatchQueue.main.async {
@@ -412,7 +414,7 @@ final class NINChatViewController: UIViewController, DeallocatableViewController
     }
 
     private func deallocViewModel() {
-        debugger("** ** deallocate view model")
+        logger.debug(.ui, "Deallocate view model")
 
         self.viewModel.onChannelClosed = nil
         self.viewModel.onQueueUpdated = nil
@@ -554,7 +556,7 @@ extension NINChatViewController {
     }
     
     private func onCloseChatTapped() {
-        debugger("Close chat button pressed!")
+        logger.debug(.ui, "Close chat button pressed!")
         
         let confirmCloseDialog: ConfirmCloseChatView = ConfirmCloseChatView.loadFromNib()
         confirmCloseDialog.delegate = self.delegate
@@ -580,21 +582,21 @@ extension NINChatViewController {
     // MARK: - Video
     
     private func onVideoCameraTapped(with button: UIButton) {
-        self.delegate?.log(value: "Video disabled: \(!button.isSelected)")
+        self.delegate?.log(.rtc, "Video disabled: \(!button.isSelected)")
         self.viewModel.disableVideoStream(disable: !button.isSelected)
         
         button.isSelected = !button.isSelected
     }
     
     private func onVideoAudioTapped(with button: UIButton) {
-        self.delegate?.log(value: "Audio disabled: \(!button.isSelected)")
+        self.delegate?.log(.rtc, "Audio disabled: \(!button.isSelected)")
         self.viewModel.disableAudioStream(disable: !button.isSelected)
         
         button.isSelected = !button.isSelected
     }
     
     private func onVideoHangupTapped() {
-        self.delegate?.log(value: "Hang-up button pressed")
+        self.delegate?.log(.rtc, "Hang-up button pressed")
         self.viewModel?.send(type: .hangup, payload: [:]) { [weak self] error in
             self?.disconnectRTC {
                 self?.adjustConstraints(for: self?.view.bounds.size ?? .zero, withAnimation: true)
@@ -236,6 +236,7 @@ final class NINGroupChatViewController: UIViewController, DeallocatableViewContr
 
     private func setupView() {
         self.addJitsiVideoWebView()
+        self.viewModel.prepareVideoCall(inside: self.videoViewContainer)
         self.setupGestures()
         self.reloadView()
         self.updateInputContainerHeight(94.0)
@@ -248,7 +249,7 @@ final class NINGroupChatViewController: UIViewController, DeallocatableViewContr
         joinVideoInfoLabel.text = self.sessionManager?.siteConfiguration.videoMeetingInfoText
 
         self.inputControlsView.onTextSizeChanged = { [weak self] height in
-            debugger("new text area height: \(height + Margins.kTextFieldPaddingHeight.rawValue)")
+            logger.debug(.ui, "New text area height: \(height + Margins.kTextFieldPaddingHeight.rawValue)")
             self?.updateInputContainerHeight(height + Margins.kTextFieldPaddingHeight.rawValue)
         }
     }
@@ -288,28 +289,24 @@ final class NINGroupChatViewController: UIViewController, DeallocatableViewContr
                 return
             }
             switch update {
-            case .insert(let index):
-                self.chatView.didAddMessage(at: index)
-            case .update(let index):
-                self.chatView.didUpdateMessage(at: index)
-            case .remove(let index):
-                self.chatView.didRemoveMessage(from: index)
-            case .history, .clean:
-                self.chatView.didLoadHistory()
-            }
+            case .snapshot(let snapshot, let diff):
+                self.chatView.apply(snapshot, diff: diff)
 
-            switch update {
-            case .insert(let index), .update(let index):
                 let canMarkChatButtonUnread = self.viewModel.hasJoinedVideo == true
                     && self.isChatShownDuringVideo == false
-
-                if self.chatDataSourceDelegate.message(at: index, self.chatView) is TextMessage {
+                if (diff.inserted + diff.updated).contains(where: { snapshot.messages[$0] is TextMessage }) {
                     self.markChatButton(hasUnreadMessages: canMarkChatButtonUnread)
                 }
-            default:
+            case .clean:
+                self.chatView.didLoadHistory()
+            case .insert, .update, .remove, .history:
+                /// The chat view follows the snapshots
                 break
             }
         }
+        self.viewModel.onTypingUpdated = { [weak self] typing in
+            self?.chatView.didUpdateTyping(typing)
+        }
         self.viewModel.onComposeActionUpdated = { [weak self] id, action in
             self?.chatView.didUpdateComposeAction(id, with: action)
         }
@@ -341,7 +338,7 @@ final class NINGroupChatViewController: UIViewController, DeallocatableViewContr
                 self.viewModel.joinVideoCall(inside: self.videoViewContainer) { [weak self] error in
                     if error != nil {
                         // TODO: Jitsi - localize error
-                        debugger("Jitsi: join video error: \(error)")
+                        logger.error(.jitsi, "Join video error: \(error)")
                         Toast.show(message: .error("Failed to join video meeting"))
                     } else {
                         self?.moveVideoContainerToFront()
@@ -569,7 +566,7 @@ extension NINGroupChatViewController {
     }
 
     private func onCloseChatTapped() {
-        debugger("Close chat button pressed!")
+        logger.debug(.ui, "Close chat button pressed!")
 
         let confirmCloseDialog: ConfirmCloseChatView = ConfirmCloseChatView.loadFromNib()
         confirmCloseDialog.delegate = self.delegate
@@ -692,7 +689,7 @@ extension NINGroupChatViewController {
     }
 
     private func deallocViewModel() {
-        debugger("** ** deallocate view model")
+        logger.debug(.ui, "Deallocate view model")
 
         self.viewModel.onChannelClosed = nil
         self.viewModel.onQueueUpdated = nil
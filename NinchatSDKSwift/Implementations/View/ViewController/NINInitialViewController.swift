@@ -69,6 +69,12 @@ final class NINInitialViewController: UIViewController, ViewController {
         self.overrideAssets()
     }
 
+    override func viewDidAppear(_ animated: Bool) {
+        super.viewDidAppear(animated)
+        /// Only the first screen shown after starting counts
+        self.sessionManager?.metrics.end(.firstScreen)
+    }
+
     // MARK: - User actions
     
     @IBAction private func closeWindowButtonPressed(button: UIButton) {
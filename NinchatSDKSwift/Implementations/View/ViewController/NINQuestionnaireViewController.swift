@@ -88,7 +88,7 @@ final class NINQuestionnaireViewController: UIViewController, ViewController, Ke
     var viewModel: NINQuestionnaireViewModel! {
         didSet {
             viewModel.onErrorOccurred = { [weak self] error in
-                debugger("** ** SDK: error in registering audience: \(error)")
+                logger.error(.questionnaire, "Error in registering audience: \(error)")
                 if let error = error as? NinchatError, error.type == "queue_is_closed" {
                     self?.showRegisteredCompletedPage(operation: self?.closedRegisteredOperation); return
                 }
@@ -304,6 +304,11 @@ final class NINQuestionnaireViewController: UIViewController, ViewController, Ke
         self.navigationItem.setHidesBackButton(true, animated: false)
     }
 
+    override func viewDidAppear(_ animated: Bool) {
+        super.viewDidAppear(animated)
+        self.sessionManager?.metrics.end(.firstScreen)
+    }
+
     override func viewDidDisappear(_ animated: Bool) {
         super.viewDidDisappear(animated)
         self.deallocate()
@@ -314,7 +319,7 @@ final class NINQuestionnaireViewController: UIViewController, ViewController, Ke
     }
 
     func deallocate() {
-        debugger("`NINQuestionnaireViewController` deallocated")
+        logger.debug(.questionnaire, "`NINQuestionnaireViewController` deallocated")
 
         self.operationQueue.cancelAllOperations()
         self.removeKeyboardListeners()
@@ -97,8 +97,13 @@ final class NINQueueViewController: UIViewController, ViewController, HasTitleBa
         self.spin(notification: nil)
     }
 
+    override func viewDidAppear(_ animated: Bool) {
+        super.viewDidAppear(animated)
+        self.sessionManager?.metrics.end(.firstScreen)
+    }
+
     deinit {
-        debugger("`NINQueueViewController` deallocated")
+        logger.debug(.session, "`NINQueueViewController` deallocated")
         NotificationCenter.default.removeObserver(self, name: UIApplication.willEnterForegroundNotification, object: nil)
     }
 
@@ -123,13 +128,13 @@ final class NINQueueViewController: UIViewController, ViewController, HasTitleBa
         case .toChannel:
             self.viewModel.resumeMode = true
             guard let describedQueue = self.sessionManager?.describedQueue else {
-                debugger("error in getting target queue")
+                logger.error(.session, "Error in getting target queue")
                 self.spinnerImageView.isHidden = true
                 self.queueInfoTextView.isHidden = false
                 self.queueInfoTextView.setAttributed(text: "Resume error".localized, font: .ninchat)
                 return
             }
-            debugger("target queue is ready: \(String(describing: describedQueue))")
+            logger.debug(.session, "Target queue is ready: \(String(describing: describedQueue))")
             self.onQueueActionTapped?(describedQueue)
         case .registerAudience:
             self.viewModel.resumeMode = false
@@ -213,7 +218,7 @@ extension NINQueueViewController {
 
 extension NINQueueViewController {
     private func onCancelQueueTapped() {
-        debugger("cancel queue")
+        logger.debug(.session, "Cancel queue")
         try? self.sessionManager?.closeChat(endSession: true) { [weak self] in
             self?.sessionManager?.deallocateSession()
         }
@@ -0,0 +1,12 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import Foundation
+
+public protocol NINChatDevHelper {
+    var serverAddress: String! { get set }
+    var siteSecret: String? { get set }
+}
@@ -7,11 +7,6 @@
 import UIKit
 import NinchatLowLevelClient
 
-public protocol NINChatDevHelper {
-    var serverAddress: String! { get set }
-    var siteSecret: String? { get set }
-}
-
 public protocol NINChatSessionProtocol {
     typealias NinchatSessionCompletion = (NINSessionCredentials?, Error?) -> Void
 
@@ -24,10 +19,68 @@ public protocol NINChatSessionProtocol {
     var appDetails: String? { get set }
     var session: NINResult<NINLowLevelClientSession?> { get }
     var delegate: NINChatSessionDelegate? { get set }
+    /**
+    * The latest SDK log entries, oldest first.
+    * Attach them to crash reports or support requests.
+    */
+    var recentLogs: String { get }
+    /**
+    * Traces the latency of the events from the server until they are handled,
+    * or shown in the chat view. Off by default.
+    *
+    * Set this prior to calling startWithCallback:
+    */
+    var tracesEventLatency: Bool { get set }
+    /** Latency percentiles of the traced events, per event type and stage. */
+    var eventLatency: [NINEventLatency] { get }
+    /** The latest traced events in the Chrome trace event format, e.g. to be opened in Perfetto. */
+    func exportEventTrace() -> Data?
+    /**
+    * Measures the session's performance metrics. Off by default.
+    *
+    * Set this prior to calling startWithCallback:
+    */
+    var collectsMetrics: Bool { get set }
+    /** The metrics measured so far. */
+    var metrics: NINSessionMetrics { get }
+    /**
+    * Records the events from the server, e.g. to reproduce a slow conversation. Off by default.
+    * Message texts are replaced with placeholders unless `recordsMessageText` is set.
+    *
+    * Set this prior to calling startWithCallback:
+    */
+    var recordsEvents: Bool { get set }
+    var recordsMessageText: Bool { get set }
+    /** The recorded events, one JSON object per line. */
+    func exportEventRecording() -> Data?
+    /**
+    * Counts the live objects of the low level client by type and call site, e.g. to find
+    * what keeps memory in the Go runtime. Off by default; meant for debugging.
+    *
+    * Set this prior to calling startWithCallback:
+    */
+    var tracksBridgedObjects: Bool { get set }
+    /** The live objects counted so far, most first. */
+    var bridgedObjects: [NINBridgedObjectCount] { get }
+    /**
+    * Keeps a search index of the messages, as they are received. Off by default;
+    * turning it on indexes the messages received so far.
+    */
+    var indexesMessages: Bool { get set }
+    /**
+    * IDs of the current conversation's messages that match every word of the query as a prefix,
+    * ignoring case and diacritics, e.g. "paiva" finds "Päivä". Most recent first.
+    */
+    func searchMessages(matching query: String, limit: Int) -> [String]
 
     init(configKey: String, queueID: String?, environments: [String]?, metadata: NINLowLevelClientProps?, configuration: NINSiteConfiguration?, modalPresentationStyle: UIModalPresentationStyle)
     func start(completion: @escaping NinchatSessionCompletion) throws
     func start(credentials: NINSessionCredentials, completion: @escaping NinchatSessionCompletion) throws
+    /**
+    * Runs the start up to presenting the UI, e.g. at app launch, so that a later
+    * `start` with the same credentials, or without any, completes right away.
+    */
+    func prewarm(credentials: NINSessionCredentials?, completion: NinchatSessionCompletion?)
     func chatSession(within navigationController: UINavigationController?) throws -> UIViewController?
     func deallocate()
 }
@@ -39,20 +92,21 @@ extension NINChatSessionProtocol {
 
 public final class NINChatSession: NINChatSessionProtocol, NINChatDevHelper {
     lazy var sessionManager: NINChatSessionManager! = {
-        NINChatSessionManagerImpl(session: self, serverAddress: self.defaultServerAddress, audienceMetadata: self.audienceMetadata, configuration: self.configuration)
+        NINChatSessionManagerImpl(session: self, serverAddress: self.defaultServerAddress, configuration: self.configuration)
     }()
     private lazy var coordinator: Coordinator? = {
         NINCoordinator(with: self.sessionManager, delegate: self, modalPresentationStyle: self.modalPresentationStyle) { [weak self] in
             self?.deallocate()
         }
     }()
-    private weak var audienceMetadata: NINLowLevelClientProps?
     private var configuration: NINSiteConfiguration?
     private var configKey: String!
     private var queueID: String?
     private var environments: [String]?
     private var started: Bool! = false
     private var resumeMode: ResumeMode?
+    private var startup: Startup = .idle
+    private let startupQueue = DispatchQueue(label: "com.ninchat.sdk.swift.startup")
     private var sessionAlive: Bool! = false
     private var defaultServerAddress: String {
         #if NIN_USE_TEST_SERVER
@@ -79,18 +133,55 @@ public final class NINChatSession: NINChatSessionProtocol, NINChatDevHelper {
     public weak var delegate: NINChatSessionDelegate?
     public var session: NINResult<NINLowLevelClientSession?> {
         guard self.started else { return .failure(NINExceptions.apiNotStarted) }
-        return .success(self.sessionManager.session)
+        return .success((self.sessionManager.session as? BridgedClientSession)?.session)
     }
     public var appDetails: String? {
         set { sessionManager.appDetails = newValue }
         get { sessionManager.appDetails }
     }
+    public var recentLogs: String {
+        logger.dump()
+    }
+    public var tracesEventLatency: Bool {
+        set { sessionManager?.eventTracer.isEnabled = newValue }
+        get { sessionManager?.eventTracer.isEnabled ?? false }
+    }
+    public var eventLatency: [NINEventLatency] {
+        sessionManager?.eventTracer.latencies ?? []
+    }
+    public var collectsMetrics: Bool {
+        set { sessionManager?.metrics.isEnabled = newValue }
+        get { sessionManager?.metrics.isEnabled ?? false }
+    }
+    public var metrics: NINSessionMetrics {
+        sessionManager?.metrics.snapshot ?? NINSessionMetrics()
+    }
+    public var recordsEvents: Bool {
+        set { sessionManager?.eventRecorder.isEnabled = newValue }
+        get { sessionManager?.eventRecorder.isEnabled ?? false }
+    }
+    public var recordsMessageText: Bool {
+        set { sessionManager?.eventRecorder.scrubsMessageText = !newValue }
+        get { !(sessionManager?.eventRecorder.scrubsMessageText ?? true) }
+    }
+    public var tracksBridgedObjects: Bool {
+        set { BridgedObjectTracker.shared.isEnabled = newValue }
+        get { BridgedObjectTracker.shared.isEnabled }
+    }
+    public var bridgedObjects: [NINBridgedObjectCount] {
+        BridgedObjectTracker.shared.live
+    }
+    public var indexesMessages: Bool {
+        set { sessionManager?.indexesMessages = newValue }
+        get { sessionManager?.indexesMessages ?? false }
+    }
 
     public init(configKey: String, queueID: String? = nil, environments: [String]? = nil, metadata: NINLowLevelClientProps? = nil, configuration: NINSiteConfiguration? = nil, modalPresentationStyle: UIModalPresentationStyle = .fullScreen) {
         self.configKey = configKey
         self.queueID = queueID
         self.environments = environments
-        self.audienceMetadata = metadata
+        /// Converted right away, the host app need not keep the bridged object alive
+        AudienceMetadataStore.shared.replace(with: metadata.flatMap { try? ClientProps($0) })
         self.configuration = configuration
         self.modalPresentationStyle = modalPresentationStyle
         self.serverAddress = Constants.kProductionServerAddress.rawValue
@@ -100,30 +191,15 @@ public final class NINChatSession: NINChatSessionProtocol, NINChatDevHelper {
         self.deallocate()
     }
 
-    /// Performs these steps:
-    /// 1. Fetches the site configuration over a REST call
+    /// Performs these steps, overlapping the ones that do not depend on each other:
+    /// 1. Fetches the site configuration over a REST call, or uses the cached one while fetching it
     /// 2. Using that configuration, starts a new chat session
     /// 3. Retrieves the queues available for this realm (realm id from site configuration)
+    /// 4. Prepares the questionnaires
     public func start(completion: @escaping NinchatSessionCompletion) throws {
-        debugger("Starting a new chat session")
-        do {
-            try self.fetchSiteConfiguration { [weak self] error in
-                DispatchQueue.main.async {
-                    do {
-                        try self?.openChatSession() { [weak self] credentials, error in
-                            guard let `self` = self, error == nil else { completion(credentials, error); return }
-
-                            /// Prepare coordinator for starting
-                            /// This is quite important to prepare time and memory consuming tasks before the user
-                            /// starts the coordinator, otherwise he/she will face unexpected views
-                            self.coordinator?.prepareNINQuestionnaireViewModel() {
-                                completion(credentials, error)
-                            }
-                        }
-                    } catch { completion(nil, error) }
-                }
-            }
-        } catch { completion(nil, error) }
+        logger.debug(.session, "Starting a new chat session")
+        self.sessionManager.metrics.start(.firstScreen)
+        self.startup(resuming: nil, prewarm: false, completion: completion)
     }
 
     /**
@@ -132,25 +208,16 @@ public final class NINChatSession: NINChatSessionProtocol, NINChatDevHelper {
      * for using `start(completion:)` and starting a new chat session.
     */
     public func start(credentials: NINSessionCredentials, completion: @escaping NinchatSessionCompletion) throws {
-        debugger("Trying to continue given chat session")
-        do {
-            try self.fetchSiteConfiguration { [weak self] error in
-                DispatchQueue.main.async {
-                    do {
-                        try self?.openChatSession(credentials: credentials) { [weak self] credentials, error in
-                            guard let `self` = self, error == nil else { completion(credentials, error); return }
-
-                            /// Prepare coordinator for starting
-                            /// This is quite important to prepare time and memory consuming tasks before the user
-                            /// starts the coordinator, otherwise he/she will face unexpected views
-                            self.coordinator?.prepareNINQuestionnaireViewModel() {
-                                completion(credentials, error)
-                            }
-                        }
-                    } catch { completion(nil, error) }
-                }
-            }
-        } catch { completion(nil, error) }
+        logger.debug(.session, "Trying to continue given chat session")
+        self.sessionManager.metrics.start(.firstScreen)
+        self.startup(resuming: credentials, prewarm: false, completion: completion)
+    }
+
+    public func prewarm(credentials: NINSessionCredentials? = nil, completion: NinchatSessionCompletion? = nil) {
+        logger.debug(.session, "Prewarming the chat session")
+        self.startup(resuming: credentials, prewarm: true) { credentials, error in
+            completion?(credentials, error)
+        }
     }
 
     public func chatSession(within navigationController: UINavigationController?) throws -> UIViewController? {
@@ -179,46 +246,197 @@ public final class NINChatSession: NINChatSessionProtocol, NINChatDevHelper {
         self.sessionManager = nil
         self.started = false
         self.sessionAlive = false
+        /// Whoever waits for a startup still running is told it is not going to finish
+        let completions: [NinchatSessionCompletion] = self.startupQueue.sync {
+            defer { self.startup = .idle }
+            guard case let .running(_, _, completions) = self.startup else { return [] }
+            return completions
+        }
+        completions.forEach { $0(nil, NINSessionExceptions.startupCancelled) }
         self.onDidEnd()
     }
+
+    public func exportEventTrace() -> Data? {
+        sessionManager?.eventTracer.exportTrace()
+    }
+
+    public func exportEventRecording() -> Data? {
+        sessionManager?.eventRecorder.recording.data
+    }
+
+    public func searchMessages(matching query: String, limit: Int = 50) -> [String] {
+        sessionManager?.searchMessages(matching: query, limit: limit) ?? []
+    }
 }
 
 // MARK: - Private helper methods
 
-/// Shared helper
+/// Startup helpers
 extension NINChatSession {
-    private func fetchSiteConfiguration(completion: @escaping (Error?) -> Void) throws {
-        sessionManager.fetchSiteConfiguration(config: configKey, environments: environments) { error in
-            completion(error)
+    fileprivate enum Startup {
+        case idle
+        /// `prewarmed` while only `prewarm` waits for the result
+        case running(resuming: NINSessionCredentials?, prewarmed: Bool, completions: [NinchatSessionCompletion])
+        /// Prewarmed, the result is kept for the next `start`
+        case ready(resuming: NINSessionCredentials?, credentials: NINSessionCredentials?)
+    }
+
+    /// Runs the startup pipeline, unless a matching one is running or prewarmed, and shares its result
+    private func startup(resuming credentials: NINSessionCredentials?, prewarm: Bool, completion: @escaping NinchatSessionCompletion) {
+        enum Action { case run(replacingPrewarmed: Bool), wait, complete(NINSessionCredentials?), fail(Error) }
+
+        let action: Action = self.startupQueue.sync {
+            switch self.startup {
+            case .running(let resuming, let prewarmed, let completions) where resuming?.userID == credentials?.userID:
+                self.startup = .running(resuming: resuming, prewarmed: prewarmed && prewarm, completions: completions + [completion])
+                return .wait
+            case .running:
+                /// Another session is being opened
+                return .fail(NINSessionExceptions.hasActiveSession)
+            case .ready(let resuming, let result) where resuming?.userID == credentials?.userID:
+                /// A prewarmed session is handed over once
+                if !prewarm { self.startup = .idle }
+                return .complete(result)
+            case .ready:
+                /// The prewarmed session is for other credentials
+                self.startup = .running(resuming: credentials, prewarmed: prewarm, completions: [completion])
+                return .run(replacingPrewarmed: true)
+            case .idle:
+                self.startup = .running(resuming: credentials, prewarmed: prewarm, completions: [completion])
+                return .run(replacingPrewarmed: false)
+            }
+        }
+
+        switch action {
+        case .run(let replacingPrewarmed):
+            DispatchQueue.main.async {
+                if replacingPrewarmed {
+                    logger.debug(.session, "Closing the prewarmed session, it was opened for other credentials")
+                    self.sessionManager?.resetSession()
+                }
+                self.runStartup(resuming: credentials)
+            }
+        case .wait:
+            logger.debug(.session, "Joining the startup already running")
+        case .complete(let result):
+            DispatchQueue.main.async { completion(result, nil) }
+        case .fail(let error):
+            DispatchQueue.main.async { completion(nil, error) }
         }
     }
 
+    /// Without a cached configuration, the session opens once the configuration is fetched. With one,
+    /// the session opens on the cached realm right away and the configuration is revalidated meanwhile.
+    /// The questionnaires are prepared from the revalidated configuration while the queues are described.
+    private func runStartup(resuming credentials: NINSessionCredentials?) {
+        guard let sessionManager = self.sessionManager else { return }
+        sessionManager.metrics.start(.startup)
+
+        let cached = sessionManager.loadCachedSiteConfiguration(config: configKey, environments: environments)
+        let cachedRealm = cached ? sessionManager.siteConfiguration.audienceRealm : nil
+        let cachedQueues = cached ? sessionManager.siteConfiguration.queueIDs : []
+
+        /// The stages may complete on any thread, only the `notify` block runs on the main thread
+        let stages = DispatchGroup()
+        var opened: (credentials: NINSessionCredentials?, error: Error?) = (nil, nil)
+        var configurationError: Error?
+
+        func openStage() {
+            stages.enter()
+            self.openChatSession(resuming: credentials) { credentials, error in
+                opened = (credentials, error)
+                stages.leave()
+            }
+        }
+
+        if cachedRealm != nil { openStage() }
+        stages.enter()
+        sessionManager.fetchSiteConfiguration(config: configKey, environments: environments) { [weak self] error in
+            defer { stages.leave() }
+            guard let `self` = self else { return }
+
+            if let error = error {
+                guard cachedRealm != nil else { configurationError = error; return }
+                logger.warning(.session, "Continuing with the cached site config, revalidating it failed: \(error)")
+            }
+
+            /// Prepare coordinator for starting
+            /// This is quite important to prepare time and memory consuming tasks before the user
+            /// starts the coordinator, otherwise he/she will face unexpected views
+            if let coordinator = self.coordinator {
+                stages.enter()
+                coordinator.prepareNINQuestionnaireViewModel { stages.leave() }
+            }
+            if cachedRealm == nil { openStage() }
+        }
+
+        stages.notify(queue: .main) { [weak self] in
+            guard let `self` = self, let sessionManager = self.sessionManager else { return }
+            if let error = configurationError {
+                self.finishStartup(credentials: nil, error: error); return
+            }
+
+            let siteConfiguration = sessionManager.siteConfiguration
+            if let realm = cachedRealm, realm != siteConfiguration?.audienceRealm {
+                /// The session opened on a realm the site no longer uses
+                logger.warning(.session, "The realm of the site config changed, opening the session again")
+                sessionManager.resetSession()
+                self.openChatSession(resuming: credentials) { [weak self] credentials, error in
+                    self?.finishStartup(credentials: credentials, error: error)
+                }
+                return
+            }
+
+            let addedQueues = siteConfiguration?.queueIDs.filter { !cachedQueues.contains($0) } ?? []
+            guard cachedRealm != nil, credentials == nil, opened.error == nil, !addedQueues.isEmpty else {
+                self.finishStartup(credentials: opened.credentials, error: opened.error); return
+            }
+            do {
+                try sessionManager.describe(queuesID: addedQueues) { [weak self] error in
+                    if let error = error { logger.warning(.session, "Describing the queues added to the site config failed: \(error)") }
+                    self?.finishStartup(credentials: opened.credentials, error: nil)
+                }
+            } catch {
+                self.finishStartup(credentials: opened.credentials, error: nil)
+            }
+        }
+    }
+
+    private func finishStartup(credentials: NINSessionCredentials?, error: Error?) {
+        if error == nil {
+            self.sessionManager?.metrics.end(.startup)
+        }
+
+        let completions: [NinchatSessionCompletion] = self.startupQueue.sync {
+            guard case let .running(resuming, prewarmed, completions) = self.startup else { return [] }
+            self.startup = (prewarmed && error == nil) ? .ready(resuming: resuming, credentials: credentials) : .idle
+            return completions
+        }
+        completions.forEach { $0(credentials, error) }
+    }
+
+    private func openChatSession(resuming credentials: NINSessionCredentials?, completion: @escaping NinchatSessionCompletion) {
+        do {
+            if let credentials = credentials {
+                try self.openChatSession(credentials: credentials, completion: completion)
+            } else {
+                try self.openChatSession(completion: completion)
+            }
+        } catch { completion(nil, error) }
+    }
+}
+
+/// Shared helper
+extension NINChatSession {
     private func describeAllQueues(credentials: NINSessionCredentials?, resumeMode: ResumeMode?, completion: @escaping NinchatSessionCompletion) throws {
         guard Thread.isMainThread else { throw NINExceptions.mainThread }
-        var queues: [String] = []
-        
-        /// queues already mentioned in the site config under "audienceQueues" key
-        self.sessionManager.siteConfiguration.audienceQueues?.filter({ !$0.isEmpty }).forEach({ queues.append($0) })
-        /// queue already mentioned in the site config under "audienceAutoQueue" key
-        if let autoQueue = self.sessionManager.siteConfiguration.audienceAutoQueue?.trimmingCharacters(in: .whitespaces), !autoQueue.isEmpty {
-            queues.append(autoQueue)
-        }
+
+        /// queues mentioned in the site config, found when it was parsed
+        var queues: [String] = self.sessionManager.siteConfiguration.queueIDs
         /// queues not mentioned in the site config, but are injected by the host application during session initialization
         if let injectedQueue = self.queueID?.trimmingCharacters(in: .whitespaces), !injectedQueue.isEmpty {
             queues.append(injectedQueue)
         }
-        /// queues mentioned in "preAudienceQuestionnaire" as a target under the "queueId" key
-        if let preAuestionnaireQueues = self.sessionManager.siteConfiguration.preAudienceQuestionnaireDictionary?.reduce(into: [], { (queues: inout [String], dict) in
-            queues.append(contentsOf: dict.find("queueId"))
-        }).compactMap({ $0 }), !preAuestionnaireQueues.isEmpty {
-            queues.append(contentsOf: preAuestionnaireQueues)
-        }
-        /// queues mentioned in "postAudienceQuestionnaire" as a target under the "queueId" key
-        if let postAuestionnaireQueues = self.sessionManager.siteConfiguration.preAudienceQuestionnaireDictionary?.reduce(into: [], { (queues: inout [String], dict) in
-            queues.append(contentsOf: dict.find("queueId"))
-        }).compactMap({ $0 }), !postAuestionnaireQueues.isEmpty {
-            queues.append(contentsOf: postAuestionnaireQueues)
-        }
 
         /// describe all queues above
         try sessionManager.describe(queuesID: queues.uniqued()) { [weak self] error in
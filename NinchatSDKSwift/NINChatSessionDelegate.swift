@@ -25,6 +25,22 @@ public protocol NINChatSessionDelegate: AnyObject {
     * Optional method.
     */
     func ninchat(_ session: NINChatSession, onLowLevelEvent params: NINLowLevelClientProps, payload: NINLowLevelClientPayload, lastReply: Bool)
+
+    /**
+    * Reports the connection quality of an ongoing video call every few seconds.
+    * The local video quality is adapted to it by the SDK.
+    *
+    * Optional method.
+    */
+    func ninchat(_ session: NINChatSession, didUpdateCallStatistics statistics: NINCallStatistics)
+
+    /**
+    * Reports the session's performance metrics whenever a new duration is measured.
+    * Only called if `collectsMetrics` is set on the session.
+    *
+    * Optional method.
+    */
+    func ninchat(_ session: NINChatSession, didUpdateMetrics metrics: NINSessionMetrics)
     
     /**
     * This method allows the SDK user to override image assets used in the
@@ -91,6 +107,10 @@ public extension NINChatSessionDelegate {
 
     func ninchat(_ session: NINChatSession, onLowLevelEvent params: NINLowLevelClientProps, payload: NINLowLevelClientPayload, lastReply: Bool) { }
 
+    func ninchat(_ session: NINChatSession, didUpdateCallStatistics statistics: NINCallStatistics) { }
+
+    func ninchat(_ session: NINChatSession, didUpdateMetrics metrics: NINSessionMetrics) { }
+
     func ninchat(_ session: NINChatSession, overrideImageAssetForKey assetKey: AssetConstants) -> UIImage? { nil }
 
     func ninchat(_ session: NINChatSession, overrideColorAssetForKey assetKey: ColorConstants) -> UIColor? { nil }
@@ -5,7 +5,6 @@
 //
 
 import Foundation
-import NinchatLowLevelClient
 
 /* Stores Session credentials */
 public struct NINSessionCredentials: Codable {
@@ -19,8 +18,8 @@ public struct NINSessionCredentials: Codable {
     let sessionID: String?
 
 
-    /* Initiate the model using `NINLowLevelClientProps` received from server */
-    init(params: NINLowLevelClientProps) throws {
+    /* Initiate the model using the parameters received from server */
+    init(params: ClientProps) throws {
         if case let .failure(error) = params.userID { throw error }
         if case let .failure(error) = params.userAuth { throw error }
         if case let .failure(error) = params.sessionID { throw error }
@@ -4,7 +4,7 @@
 // license that can be found in the LICENSE file.
 //
 
-import UIKit
+import Foundation
 
 public protocol NINSiteConfiguration  {
     var userName: String? { get }
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+@testable import NinchatSDKSwift
+
+/// The timing of a benchmark, in seconds per run
+struct BenchmarkResult: Codable {
+    let name: String
+    let runs: Int
+    let median: TimeInterval
+    let minimum: TimeInterval
+    let maximum: TimeInterval
+}
+
+/// The stored expectations, in `Baselines.json`
+struct BenchmarkBaselines: Codable {
+    /// The allowed slowdown over a baseline, e.g. 0.25 for 25%
+    var tolerance: Double
+    /// Median seconds per run, by benchmark, as recorded on the reference machine
+    var medians: [String:TimeInterval]
+
+    static let stored: BenchmarkBaselines = {
+        guard let url = Bundle(for: BenchmarkCase.self).url(forResource: "Baselines", withExtension: "json"),
+              let data = try? Data(contentsOf: url),
+              let baselines = try? JSONDecoder().decode(BenchmarkBaselines.self, from: data)
+            else { return BenchmarkBaselines(tolerance: 0.25, medians: [:]) }
+        return baselines
+    }()
+}
+
+/**
+ * A suite of benchmarks.
+ *
+ * Every benchmark is checked against its stored median, and fails without one, and the results of the
+ * suite are written as `<suite>.json` to the directory in `NINCHAT_BENCHMARK_OUTPUT`, or to
+ * `NinchatSDKSwiftBenchmarks` in the temporary directory. With `NINCHAT_BENCHMARK_RECORD` set, nothing
+ * is checked and a `Baselines.json` including the new medians is written there too.
+ */
+class BenchmarkCase: XCTestCase {
+    private static var results: [BenchmarkResult] = []
+
+    private static var isRecording: Bool {
+        ProcessInfo.processInfo.environment["NINCHAT_BENCHMARK_RECORD"] != nil
+    }
+
+    private static var outputDirectory: URL {
+        ProcessInfo.processInfo.environment["NINCHAT_BENCHMARK_OUTPUT"].map { URL(fileURLWithPath: $0) }
+            ?? FileManager.default.temporaryDirectory.appendingPathComponent("NinchatSDKSwiftBenchmarks")
+    }
+
+    override class func tearDown() {
+        BenchmarkCase.write(BenchmarkCase.results, suite: String(describing: self))
+        BenchmarkCase.results.removeAll()
+        super.tearDown()
+    }
+
+    /// Runs `block` once to warm up and then `runs` times, each after `setUp`, and checks the median
+    @discardableResult
+    func benchmark(_ name: String, runs: Int = 10, setUp: () -> Void = {}, _ block: () -> Void, file: StaticString = #filePath, line: UInt = #line) -> BenchmarkResult {
+        setUp()
+        block()
+
+        let durations = (0..<runs).map { _ -> TimeInterval in
+            setUp()
+            let start = DispatchTime.now().uptimeNanoseconds
+            block()
+            return Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        }.sorted()
+
+        let result = BenchmarkResult(name: name, runs: runs, median: durations[durations.count / 2], minimum: durations.first ?? 0, maximum: durations.last ?? 0)
+        BenchmarkCase.results.append(result)
+
+        let baselines = BenchmarkBaselines.stored
+        guard !BenchmarkCase.isRecording else { return result }
+        if let baseline = baselines.medians[name] {
+            if result.median > baseline * (1 + baselines.tolerance) {
+                XCTFail("\(name) took \(format(result.median)), over the baseline of \(format(baseline)) by more than \(Int(baselines.tolerance * 100))%", file: file, line: line)
+            }
+        } else {
+            XCTFail("\(name) took \(format(result.median)), but has no baseline; record one with NINCHAT_BENCHMARK_RECORD", file: file, line: line)
+        }
+        return result
+    }
+
+    /// Fails if the time grows faster than `size^exponent` from the smallest to the largest size,
+    /// e.g. at most 0.3 for constant or logarithmic work, 1.3 for `n log n` and 2 for quadratic work
+    func assertGrowth(_ results: [(size: Int, result: BenchmarkResult)], atMost exponent: Double, file: StaticString = #filePath, line: UInt = #line) {
+        guard let first = results.min(by: { $0.size < $1.size }), let last = results.max(by: { $0.size < $1.size }),
+              last.size > first.size, first.result.median > 0
+            else { return }
+
+        let growth = log(last.result.median / first.result.median) / log(Double(last.size) / Double(first.size))
+        if growth > exponent {
+            XCTFail("\(last.result.name) grows as n^\(String(format: "%.2f", growth)), expected at most n^\(exponent)", file: file, line: line)
+        }
+    }
+
+    /// Loads a JSON asset of the benchmarks' bundle
+    func asset<T>(_ name: String) throws -> T? {
+        guard let url = Bundle(for: BenchmarkCase.self).url(forResource: name, withExtension: "json") else { return nil }
+        return try JSONSerialization.jsonObject(with: Data(contentsOf: url)) as? T
+    }
+
+    private func format(_ duration: TimeInterval) -> String {
+        String(format: "%.3fms", duration * 1000)
+    }
+
+    private static func write(_ results: [BenchmarkResult], suite: String) {
+        guard !results.isEmpty else { return }
+
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        do {
+            try FileManager.default.createDirectory(at: self.outputDirectory, withIntermediateDirectories: true)
+            try encoder.encode(results).write(to: self.outputDirectory.appendingPathComponent("\(suite).json"))
+
+            guard self.isRecording else { return }
+            let url = self.outputDirectory.appendingPathComponent("Baselines.json")
+            var baselines = (try? JSONDecoder().decode(BenchmarkBaselines.self, from: Data(contentsOf: url))) ?? BenchmarkBaselines.stored
+            results.forEach { baselines.medians[$0.name] = $0.median }
+            try encoder.encode(baselines).write(to: url)
+        } catch {
+            print("Could not write the results of \(suite): \(error)")
+        }
+    }
+}
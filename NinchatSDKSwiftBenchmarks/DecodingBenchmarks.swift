@@ -0,0 +1,52 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+@testable import NinchatSDKSwift
+
+final class DecodingBenchmarks: BenchmarkCase {
+    /// `realm_queues_found` into the queue models
+    func test_realm_queues() throws {
+        let queues = (0..<1_000).reduce(into: [String:Any]()) { queues, index in
+            queues["queue-\(index)"] = ["queue_attrs": ["name": "Queue \(index)", "closed": index % 10 == 0, "upload": "member"] as [String:Any], "queue_position": index % 5]
+        }
+        let data = try JSONSerialization.data(withJSONObject: ["event": "realm_queues_found", "action_id": 1, "realm_queues": queues] as [String:Any])
+        let event = try ClientProps(json: String(decoding: data, as: UTF8.self))
+
+        var sessionManager: NINChatSessionManagerImpl!
+        benchmark("propsToModel.realmQueues.1000", setUp: {
+            sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+            sessionManager.siteConfiguration = SiteConfigurationImpl(configuration: [:], environments: nil)
+        }) {
+            try? sessionManager.didFindRealmQueues(param: event)
+        }
+        XCTAssertEqual(sessionManager.queueRegistry.count, 1_000)
+    }
+
+    func test_decode_and_perform() throws {
+        let payload = try (0..<1_000).map { index in
+            try JSONSerialization.data(withJSONObject: ["text": "Message \(index) with some text to decode"])
+        }
+
+        var decoded = 0
+        benchmark("decodeAndPerform.1000", setUp: { decoded = 0 }) {
+            try? payload.decodeAndPerform(type: ChatMessagePayload.self) { _ in decoded += 1 }
+        }
+        XCTAssertEqual(decoded, 1_000)
+    }
+
+    func test_translate() {
+        let translations = (0..<500).reduce(into: [String:String]()) { $0["Key \($1) {{name}} in {{queue}}"] = "Käännös \($1) {{name}} jonossa {{queue}}" }
+        let sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        sessionManager.siteConfiguration = SiteConfigurationImpl(configuration: ["default": ["translations": translations]], environments: ["fi"])
+
+        benchmark("translate.1000") {
+            (0..<1_000).forEach { index in
+                _ = sessionManager.translate(key: "Key \(index % 500) {{name}} in {{queue}}", formatParams: ["name": "Agent", "queue": "Support"])
+            }
+        }
+    }
+}
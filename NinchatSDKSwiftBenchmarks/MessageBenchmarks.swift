@@ -0,0 +1,76 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+@testable import NinchatSDKSwift
+
+final class MessageBenchmarks: BenchmarkCase {
+    private let sizes = [1_000, 10_000, 50_000]
+    private let users = [
+        ChannelUser(userID: "agent", realName: "Agent", displayName: "Agent", iconURL: nil, guest: false, info: nil),
+        ChannelUser(userID: "guest", realName: "Guest", displayName: "Guest", iconURL: nil, guest: true, info: nil)
+    ]
+
+    func test_sort_and_map() {
+        let sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        let results = sizes.map { size -> (size: Int, result: BenchmarkResult) in
+            let messages = [message(size) as ChatMessage] + self.messages(size)
+            return (size, benchmark("sortAndMap.\(size)", runs: 5) {
+                _ = sessionManager.sortAndMap(messages)
+            })
+        }
+        assertGrowth(results, atMost: 1.3)
+    }
+
+    /// Messages received live, to a channel already holding the messages. Adding one should not
+    /// depend on the length of the history, so 100 are added per run to time more than the noise.
+    func test_add_message() {
+        let results = sizes.map { size -> (size: Int, result: BenchmarkResult) in
+            let sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+            sessionManager.commit(notify: false) { $0 = self.messages(size) }
+
+            var next = size
+            return (size, benchmark("addMessage.\(size)", runs: 5) {
+                (0..<100).forEach { _ in
+                    sessionManager.add(message: message(next))
+                    next += 1
+                }
+            })
+        }
+        assertGrowth(results, atMost: 0.3)
+    }
+
+    /// A history received newest first, each message with the number that still follow
+    func test_load_history() {
+        let results = sizes.map { size -> (size: Int, result: BenchmarkResult) in
+            let history = self.messages(size)
+            var sessionManager: NINChatSessionManagerImpl!
+
+            return (size, benchmark("loadHistory.\(size)", runs: 3, setUp: {
+                sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+                sessionManager.channels.current.expectedHistoryLength = size
+            }) {
+                history.enumerated().forEach { index, message in
+                    sessionManager.add(message: message, remained: .success(size - index - 1))
+                }
+                XCTAssertEqual(sessionManager.chatMessages.count, size)
+            })
+        }
+        assertGrowth(results, atMost: 1.3)
+    }
+}
+
+extension MessageBenchmarks {
+    /// Most recent first, as the session manager keeps them
+    private func messages(_ count: Int) -> [ChatMessage] {
+        (0..<count).reversed().map { message($0) }
+    }
+
+    /// Runs of messages from the same user, a minute apart every ten messages
+    private func message(_ index: Int) -> TextMessage {
+        TextMessage(timestamp: Date(timeIntervalSince1970: Double(index / 10) * 60), messageID: String(format: "%012d", index), mine: (index / 3) % 2 == 1, sender: users[(index / 3) % 2], content: "Message \(index)", attachment: nil)
+    }
+}
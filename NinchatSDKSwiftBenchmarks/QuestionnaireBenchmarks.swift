@@ -0,0 +1,43 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+@testable import NinchatSDKSwift
+
+final class QuestionnaireBenchmarks: BenchmarkCase {
+    private var configurations: [[String:AnyHashable]] = []
+
+    override func setUpWithError() throws {
+        let mock: [String:AnyHashable]? = try asset("questionnaire-mock")
+        configurations = try XCTUnwrap(mock?["preAudienceQuestionnaire"] as? [[String:AnyHashable]])
+    }
+
+    func test_decode_questionnaire() {
+        var questionnaire: AudienceQuestionnaire?
+        benchmark("audienceQuestionnaire.decode") {
+            questionnaire = AudienceQuestionnaire(from: configurations)
+        }
+        XCTAssertEqual(questionnaire?.questionnaireConfiguration?.count, configurations.count)
+    }
+
+    func test_connector_navigation() throws {
+        let questionnaire = try XCTUnwrap(AudienceQuestionnaire(from: configurations).questionnaireConfiguration)
+        let topics = try XCTUnwrap(questionnaire.first(where: { $0.name == "Aiheet" }))
+        let logic = try XCTUnwrap(questionnaire.first(where: { $0.name == "Riskiryhmät-Logic2" })?.logic)
+
+        benchmark("questionnaireConnector.init") {
+            _ = QuestionnaireElementConnectorImpl(configurations: questionnaire, style: .conversation)
+        }
+
+        let connector = QuestionnaireElementConnectorImpl(configurations: questionnaire, style: .conversation)
+        benchmark("questionnaireConnector.navigate.100") {
+            (0..<100).forEach { _ in
+                _ = connector.findElementAndPageRedirect(for: "Mikä on koronavirus", in: topics, autoApply: false, performClosures: false)
+                _ = connector.findElementAndPageLogic(logic: logic, in: ["Riskiryhmät-jatko": "Muut aiheet", "condition1": "satisfied"], autoApply: false, performClosures: false)
+            }
+        }
+    }
+}
@@ -0,0 +1,37 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import UIKit
+import XCTest
+@testable import NinchatSDKSwift
+
+final class RenderingBenchmarks: BenchmarkCase {
+    private let style = HTMLStyle(font: .ninchat, alignment: .left, color: .black, width: 300)
+    private let sample = """
+                         <p>Hei! <b>Tervetuloa</b> <i>chattiin</i>.</p>
+                         <p>Lue lisää <a href="https://www.ninchat.com">täältä</a> &amp; vastaa:</p>
+                         <ul><li>ensimmäinen</li><li>toinen</li></ul>
+                         """
+
+    /// Short messages, none of them cached
+    func test_render_messages() {
+        var renderer: HTMLRenderer!
+        benchmark("htmlRenderer.messages.100", setUp: { renderer = HTMLRenderer() }) {
+            (0..<100).forEach { index in
+                _ = renderer.render("\(sample)<p>\(index)</p>", style: style)
+            }
+        }
+    }
+
+    /// A long text, e.g. a site configuration's welcome text
+    func test_render_long_text() {
+        let text = String(repeating: sample, count: 100)
+        var renderer: HTMLRenderer!
+        benchmark("htmlRenderer.longText", setUp: { renderer = HTMLRenderer() }) {
+            _ = renderer.render(text, style: style)
+        }
+    }
+}
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+@testable import NinchatSDKSwift
+
+final class SearchBenchmarks: BenchmarkCase {
+    private let sizes = [1_000, 10_000, 50_000]
+    private let words = ["hei", "kiitos", "päivää", "tilaus", "lasku", "toimitus", "hello", "thanks", "order", "invoice", "delivery", "refund"]
+
+    func test_index_history() {
+        let messages = self.messages(50_000)
+        var index = MessageSearchIndex()
+        benchmark("searchIndex.build.50000", runs: 3, setUp: { index.removeAll() }) {
+            messages.forEach { index.index($0) }
+            _ = index.search("x")
+        }
+    }
+
+    func test_search() {
+        let results = sizes.map { size -> (size: Int, result: BenchmarkResult) in
+            var index = MessageSearchIndex()
+            index.rebuild(from: self.messages(size))
+            _ = index.search("x")
+
+            return (size, benchmark("searchIndex.search.\(size)") {
+                _ = index.search("tila")
+                _ = index.search("paivaa kiitos")
+                _ = index.search("del ref")
+            })
+        }
+        XCTAssertLessThan(results.last?.result.median ?? .infinity, 0.05, "Expected three searches over 50k messages to take milliseconds")
+    }
+}
+
+extension SearchBenchmarks {
+    /// Three words of the vocabulary and a number, most recent first
+    private func messages(_ count: Int) -> [ChatMessage] {
+        (0..<count).reversed().map { index in
+            let text = (0..<3).map { self.words[(index * 7 + $0 * 5) % self.words.count] }.joined(separator: " ") + " #\(index)"
+            return TextMessage(timestamp: Date(timeIntervalSince1970: Double(index) * 60), messageID: String(format: "%012d", index), mine: index % 2 == 0, sender: nil, content: text, attachment: nil)
+        }
+    }
+}
@@ -6,7 +6,6 @@
 
 import XCTest
 import WebRTC
-import NinchatLowLevelClient
 @testable import NinchatSDKSwift
 
 /// Acceptance Tests.
@@ -113,7 +112,7 @@ class NinchatSDKSwiftAcceptanceTests: XCTestCase, NINChatWebRTCClientDelegate {
 
     func testServer_04_setPreAudienceQuestionnaire() {
         let pre_answers: [String:AnyHashable] = ["Questionnaire_pre_1": "Answer_pre_1", "Questionnaire_pre_2": "Answer_pre_2"]
-        self.sessionManager.preAudienceQuestionnaireMetadata = NINLowLevelClientProps.initiate(metadata: pre_answers)
+        self.sessionManager.preAudienceQuestionnaireMetadata = ClientProps.initiate(metadata: pre_answers)
 
         XCTAssertTrue(true)
     }
@@ -354,7 +353,7 @@ extension NinchatSDKSwiftAcceptanceTests {
         hangup.assertForOverFulfill = false
 
         self.onConnectionStateChange = { client, state in
-            debugger("** New State: \(state)")
+            logger.debug(.rtc, "New State: \(state)")
             XCTAssertNotNil(client)
             if state == .connected {
                 try! self.simulateTextMessage("Now hangup to continue running tests")
@@ -410,7 +409,9 @@ extension NinchatSDKSwiftAcceptanceTests {
 extension NinchatSDKSwiftAcceptanceTests: NINChatSessionInternalDelegate {
     func log(value: String) {}
 
-    func log(format: String, _ args: CVarArg...) {}
+    func onCallStatistics(_ statistics: NINCallStatistics) {}
+
+    func onSessionMetrics(_ metrics: NINSessionMetrics) {}
 
     func onDidEnd() {}
 
@@ -424,7 +425,7 @@ extension NinchatSDKSwiftAcceptanceTests: NINChatSessionInternalDelegate {
 
     func override(layerAsset key: CALayerConstant) -> CALayer? { nil }
 
-    func onLowLevelEvent(event: NINLowLevelClientProps, payload: NINLowLevelClientPayload, lastReply: Bool) {
+    func onLowLevelEvent(event: ClientProps, payload: ClientPayload, lastReply: Bool) {
         if case let .failure(error) = event.event { self.onEvent?(nil, error); return }
         self.onEvent?(Events(rawValue: event.event.value), nil)
     }
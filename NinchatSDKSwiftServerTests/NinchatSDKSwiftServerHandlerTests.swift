@@ -17,7 +17,7 @@ final class NinchatSDKSwiftServerHandlerTests: XCTestCase {
         self.expect_session_event = self.expectation(description: "Expected to get session events")
         self.sessionManager.fetchSiteConfiguration(config: Session.configurationKey, environments: []) { _ in
             try? self.sessionManager.openSession { _,_,_ in }
-            self.sessionManager.session?.setOnSessionEvent(self)
+            (self.sessionManager.session as? BridgedClientSession)?.session.setOnSessionEvent(self)
         }
         
         waitForExpectations(timeout: 5.0)
@@ -26,7 +26,7 @@ final class NinchatSDKSwiftServerHandlerTests: XCTestCase {
     func testServer_1_clientEvents() {
         self.expect_event = self.expectation(description: "Expected to get general events")
         try! self.sessionManager.describe(queuesID: self.sessionManager.siteConfiguration.audienceQueues) { error in }
-        self.sessionManager.session?.setOnEvent(self)
+        (self.sessionManager.session as? BridgedClientSession)?.session.setOnEvent(self)
         
         waitForExpectations(timeout: 5.0)
     }
@@ -35,7 +35,7 @@ final class NinchatSDKSwiftServerHandlerTests: XCTestCase {
 
 extension NinchatSDKSwiftServerHandlerTests: NINLowLevelClientSessionEventHandlerProtocol {
     func onSessionEvent(_ params: NINLowLevelClientProps?) {
-        let event = params?.event.value
+        let event = params.flatMap { try? ClientProps($0) }?.event.value
         XCTAssertNotNil(event)
     
         let eventType = Events(rawValue: event!)
@@ -50,7 +50,7 @@ extension NinchatSDKSwiftServerHandlerTests: NINLowLevelClientEventHandlerProtoc
         XCTAssertNotNil(params)
         XCTAssertNotNil(payload)
     
-        let event = params?.event.value
+        let event = params.flatMap { try? ClientProps($0) }?.event.value
         XCTAssertNotNil(event)
     
         let eventType = Events(rawValue: event!)
@@ -5,7 +5,6 @@
 //
 
 import XCTest
-import NinchatLowLevelClient
 @testable import NinchatSDKSwift
 
 final class NinchatSDKSwiftServerQuestionnaireTests: XCTestCase {
@@ -24,8 +23,8 @@ final class NinchatSDKSwiftServerQuestionnaireTests: XCTestCase {
                 try! self.sessionManager.describe(queuesID: self.sessionManager.siteConfiguration.audienceQueues) { error in
                     XCTAssertNil(error)
 
-                    guard let answers = self.sessionManager.audienceMetadata else { XCTFail("Unable to get audience metadata"); return }
-                    answers.set(value: NINLowLevelClientProps.initiate(preQuestionnaireAnswers: ["question":"answer"]), forKey: "pre_answers")
+                    guard var answers = self.sessionManager.audienceMetadata else { XCTFail("Unable to get audience metadata"); return }
+                    answers.set(value: ClientProps.initiate(preQuestionnaireAnswers: ["question":"answer"]), forKey: "pre_answers")
 
                     try! self.sessionManager.registerAudience(queue: Session.suiteQueue, answers: answers) { error in
                         XCTAssertNil(error)
@@ -68,6 +67,6 @@ final class NinchatSDKSwiftServerQuestionnaireTests: XCTestCase {
 
 private extension NINChatSessionManagerImpl {
     func updateSecureMetadata() {
-        NINLowLevelClientProps.saveMetadata(Session.secureMetadata)
+        ClientProps.saveMetadata(Session.secureMetadata)
     }
 }
@@ -5,7 +5,6 @@
 //
 
 import XCTest
-import NinchatLowLevelClient
 @testable import NinchatSDKSwift
 
 final class NinchatSDKSwiftServerSessionTests: XCTestCase {
@@ -195,6 +194,6 @@ extension NinchatSDKSwiftServerSessionTests {
 
 private extension NINChatSessionManagerImpl {
     func updateSecureMetadata() {
-        NINLowLevelClientProps.saveMetadata(Session.secureMetadata)
+        ClientProps.saveMetadata(Session.secureMetadata)
     }
 }
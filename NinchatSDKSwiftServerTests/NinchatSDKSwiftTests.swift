@@ -78,15 +78,13 @@ final class Session {
     static var metadataSecret: String? {
         configuration.metadataSecret
     }
-    static var secureMetadata: NINLowLevelClientProps? {
+    static var secureMetadata: ClientProps? {
         guard let key = self.metadataKey, !key.isEmpty, let sec = self.metadataSecret, !sec.isEmpty else { return nil }
 
         let secMetadata = NINLowLevelClientProps()
         try? secMetadata.unmarshalJSON("{\"exp\": \(Double(Date().timeIntervalSince1970) + 1000), \"ninchat.com/metadata\": { \"key\": \"value\" } }")
         let token = secMetadata.encrypt(toJWT: key, secret: sec, error: nil)
 
-        let metadata = NINLowLevelClientProps()
-        metadata.setString("secure", val: token)
-        return metadata
+        return ClientProps.initiate(metadata: ["secure": token])
     }
 }
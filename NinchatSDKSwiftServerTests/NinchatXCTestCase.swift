@@ -5,7 +5,6 @@
 //
 
 import XCTest
-import NinchatLowLevelClient
 @testable import NinchatSDKSwift
 
 class NinchatXCTestCase: XCTestCase {
@@ -52,7 +51,7 @@ extension NinchatXCTestCase {
         sessionManager.updateSecureMetadata()
         sessionManager.fetchSiteConfiguration(config: Session.configurationKey, environments: nil) { error in
             try! sessionManager.openSession { credentials, canResume, error in
-                debugger("** ** UnitTest: credentials: \(credentials!)")
+                logger.debug(.session, "UnitTest: credentials: \(credentials!)")
                 try! sessionManager.describe(queuesID: sessionManager.siteConfiguration.audienceQueues) { error in
                     try! sessionManager.join(queue: Session.suiteQueue, progress: { queue, error, position in }, completion: {
                         completion()
@@ -86,6 +85,6 @@ extension NinchatXCTestCase {
 
 private extension NINChatSessionManagerImpl {
     func updateSecureMetadata() {
-        NINLowLevelClientProps.saveMetadata(Session.secureMetadata)
+        ClientProps.saveMetadata(Session.secureMetadata)
     }
 }
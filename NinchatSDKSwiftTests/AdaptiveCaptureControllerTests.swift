@@ -0,0 +1,82 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+@testable import NinchatSDKSwift
+
+final class AdaptiveCaptureControllerTests: XCTestCase {
+    /// (packet loss, rtt in ms, available outgoing bitrate in kbit/s) sampled every 2 seconds
+    private typealias Trace = [(Double, Double, Double)]
+
+    private let stable: Trace = Array(repeating: (0.0, 80, 1500), count: 10)
+    private let congested: Trace = [(0.0, 90, 1400), (0.12, 450, 500), (0.15, 700, 280), (0.10, 650, 250), (0.09, 600, 240), (0.11, 640, 230)]
+    private let recovering: Trace = Array(repeating: (0.01, 120, 1200), count: 12)
+    /// Alternates around the limits, too short to count as poor or good in a row
+    private let flapping: Trace = Array(repeating: [(0.09, 200, 900), (0.01, 100, 1200)], count: 6).flatMap { $0 }
+
+    func test_stable_keeps_high() {
+        let controller = AdaptiveCaptureController()
+        XCTAssertEqual(self.decisions(controller, stable), [])
+        XCTAssertEqual(controller.level, .high)
+    }
+
+    func test_congestion_steps_down() {
+        let controller = AdaptiveCaptureController()
+        XCTAssertEqual(self.decisions(controller, congested), [.medium, .low])
+        XCTAssertEqual(controller.level, .low)
+    }
+
+    func test_recovery_steps_up_slowly() {
+        let controller = AdaptiveCaptureController(level: .low)
+        /// Five good samples per step
+        XCTAssertEqual(self.decisions(controller, recovering), [.medium, .high])
+    }
+
+    func test_hysteresis() {
+        let controller = AdaptiveCaptureController(level: .medium)
+        XCTAssertEqual(self.decisions(controller, flapping), [])
+        XCTAssertEqual(controller.level, .medium)
+    }
+
+    func test_upgrade_needs_bitrate_margin() {
+        let controller = AdaptiveCaptureController(level: .medium)
+        /// 800 kbit/s is enough for high but without the margin
+        XCTAssertEqual(self.decisions(controller, Array(repeating: (0.0, 80, 800), count: 10)), [])
+    }
+
+    func test_sampler_rates() {
+        var now: TimeInterval = 0
+        let sampler = WebRTCStatsSampler(now: { now }) { _ in }
+
+        XCTAssertNil(sampler.sample(self.report(bytesSent: 0, bytesReceived: 0, lost: 0, received: 0)))
+        now = 2
+        let statistics = sampler.sample(self.report(bytesSent: 250_000, bytesReceived: 125_000, lost: 5, received: 95))
+
+        XCTAssertEqual(statistics?.outgoingBitrate, 1000)
+        XCTAssertEqual(statistics?.incomingBitrate, 500)
+        XCTAssertEqual(statistics?.packetLoss, 0.05)
+        XCTAssertEqual(statistics?.roundTripTime, 125)
+        XCTAssertEqual(statistics?.availableOutgoingBitrate, 1200)
+        XCTAssertEqual(statistics?.framesPerSecond, 30)
+        XCTAssertEqual(statistics?.frameSize, CGSize(width: 640, height: 480))
+    }
+}
+
+extension AdaptiveCaptureControllerTests {
+    private func decisions(_ controller: AdaptiveCaptureController, _ trace: Trace) -> [AdaptiveCaptureController.Level] {
+        trace.compactMap { loss, rtt, available in
+            controller.update(with: NINCallStatistics(outgoingBitrate: 0, incomingBitrate: 0, availableOutgoingBitrate: available, roundTripTime: rtt, packetLoss: loss, framesPerSecond: nil, frameSize: nil))
+        }
+    }
+
+    private func report(bytesSent: Double, bytesReceived: Double, lost: Double, received: Double) -> [WebRTCStatsSampler.Entry] {
+        [
+            WebRTCStatsSampler.Entry(type: "outbound-rtp", values: ["kind": "video", "bytesSent": NSNumber(value: bytesSent), "framesPerSecond": NSNumber(value: 30), "frameWidth": NSNumber(value: 640), "frameHeight": NSNumber(value: 480)]),
+            WebRTCStatsSampler.Entry(type: "inbound-rtp", values: ["kind": "video", "bytesReceived": NSNumber(value: bytesReceived), "packetsLost": NSNumber(value: lost), "packetsReceived": NSNumber(value: received)]),
+            WebRTCStatsSampler.Entry(type: "candidate-pair", values: ["state": "succeeded", "nominated": NSNumber(value: true), "currentRoundTripTime": NSNumber(value: 0.125), "availableOutgoingBitrate": NSNumber(value: 1_200_000)])
+        ]
+    }
+}
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class AudienceMetadataStoreTests: XCTestCase {
+    private let suiteName = "com.ninchat.sdk.swift.tests.metadata"
+    private var defaults: UserDefaults!
+
+    override func setUp() {
+        defaults = UserDefaults(suiteName: suiteName)
+        defaults.removePersistentDomain(forName: suiteName)
+    }
+
+    override func tearDown() {
+        defaults.removePersistentDomain(forName: suiteName)
+    }
+
+    func test_memory_is_source_of_truth() {
+        let store = AudienceMetadataStore(defaults: defaults)
+        XCTAssertTrue(store.isEmpty)
+        XCTAssertNil(store.props())
+
+        store.replace(with: ClientProps.initiate(metadata: ["key": "value"]))
+        XCTAssertEqual(store.props()?["key"], .string("value"))
+
+        /// nil keeps the current metadata
+        store.replace(with: nil)
+        XCTAssertFalse(store.isEmpty)
+    }
+
+    func test_preAnswers() {
+        let store = AudienceMetadataStore(defaults: defaults)
+        store.replace(with: ClientProps.initiate(metadata: ["key": "value"]))
+        store.set(preAnswers: ClientProps.initiate(metadata: ["pre-answer1": "1"]))
+
+        XCTAssertEqual(store.preAnswers["pre-answer1"], "1")
+        XCTAssertEqual(store.props()?["key"], .string("value"))
+
+        store.set(preAnswers: nil)
+        XCTAssertTrue(store.preAnswers.isEmpty)
+    }
+
+    func test_persistence() {
+        let store = AudienceMetadataStore(defaults: defaults)
+        (0..<100).forEach { index in
+            store.replace(with: ClientProps.initiate(metadata: ["key": "value-\(index)"]))
+        }
+        store.flush()
+
+        /// A new store reads what the last write persisted
+        XCTAssertEqual(AudienceMetadataStore(defaults: defaults).props()?["key"], .string("value-99"))
+
+        store.removeAll()
+        store.flush()
+        XCTAssertNil(defaults.string(forKey: UserDefaults.Keys.metadata.rawValue))
+        XCTAssertTrue(AudienceMetadataStore(defaults: defaults).isEmpty)
+    }
+
+    func test_migration() {
+        UserDefaults.standard.set("{\"key\":\"legacy\"}", forKey: UserDefaults.Keys.metadata.rawValue)
+
+        let store = AudienceMetadataStore(defaults: defaults)
+        XCTAssertEqual(store.props()?["key"], .string("legacy"))
+        XCTAssertNil(UserDefaults.standard.value(forKey: UserDefaults.Keys.metadata.rawValue))
+    }
+}
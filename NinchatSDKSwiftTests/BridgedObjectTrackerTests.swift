@@ -0,0 +1,101 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+import NinchatLowLevelClient
+@testable import NinchatSDKSwift
+
+final class BridgedObjectTrackerTests: XCTestCase {
+    private var tracker: BridgedObjectTracker!
+
+    override func setUp() {
+        tracker = BridgedObjectTracker()
+        tracker.isEnabled = true
+    }
+
+    override func tearDown() {
+        BridgedObjectTracker.shared.isEnabled = false
+        BridgedObjectTracker.shared.removeAll()
+    }
+
+    func test_disabled_tracks_nothing() {
+        tracker.isEnabled = false
+        let props = NINLowLevelClientProps()
+        tracker.track(props, site: "test")
+
+        XCTAssertEqual(tracker.total, 0)
+        XCTAssertTrue(tracker.live.isEmpty)
+    }
+
+    func test_live_objects_are_counted_by_type_and_site() {
+        autoreleasepool {
+            let props = (0..<3).map { _ in NINLowLevelClientProps() }
+            let strings = NINLowLevelClientStrings()
+            props.forEach { tracker.track($0, site: "props") }
+            tracker.track(strings, site: "strings")
+
+            XCTAssertEqual(tracker.live, [
+                NINBridgedObjectCount(type: "NINLowLevelClientProps", site: "props", count: 3),
+                NINBridgedObjectCount(type: "NINLowLevelClientStrings", site: "strings", count: 1)
+            ])
+        }
+        XCTAssertEqual(tracker.total, 0, "Expected the released objects to be off the count")
+    }
+
+    func test_tracking_again_moves_the_object() {
+        let props = NINLowLevelClientProps()
+        tracker.track(props, site: "received")
+        tracker.track(props, site: "kept")
+
+        XCTAssertEqual(tracker.live, [NINBridgedObjectCount(type: "NINLowLevelClientProps", site: "kept", count: 1)])
+    }
+
+    func test_call_site_is_the_callers_file_and_line() {
+        let props = NINLowLevelClientProps()
+        tracker.track(props); let line = #line
+
+        XCTAssertEqual(tracker.live.first?.site, "BridgedObjectTrackerTests.swift:\(line)")
+    }
+
+    func test_bridged_events_are_released_before_they_are_handled() throws {
+        let handler = ValueHandler()
+        let session = BridgedClientSession(bridgedObjects: tracker)
+        session.setHandler(handler)
+
+        try autoreleasepool {
+            let event = NINLowLevelClientProps()
+            try event.unmarshalJSON(#"{"event": "channel_updated", "channel_id": "channel", "channel_attrs": {"closed": true}}"#)
+            let payload = NINLowLevelClientPayload([Data("{}".utf8)])
+
+            session.onEvent(event, payload: payload, lastReply: true)
+            XCTAssertEqual(tracker.live.first(where: { $0.site == "onEvent(channel_updated)" })?.count, 2)
+        }
+        XCTAssertEqual(tracker.total, 0, "Expected the client's objects to be released once the values are copied")
+        XCTAssertEqual(handler.events.first?.channelClosed.value, true)
+        XCTAssertEqual(handler.payloads.first, [Data("{}".utf8)])
+    }
+}
+
+/// Keeps the values it is handed, which must not keep the client's objects alive
+private final class ValueHandler: LowLevelClientHandler {
+    private(set) var events: [ClientProps] = []
+    private(set) var payloads: [ClientPayload] = []
+
+    func onSessionEvent(_ params: ClientProps) {
+        events.append(params)
+    }
+
+    func onEvent(_ params: ClientProps, payload: ClientPayload, lastReply: Bool) {
+        events.append(params)
+        payloads.append(payload)
+    }
+
+    func onClose() {}
+
+    func onLog(_ msg: String) {}
+
+    func onConnState(_ state: String) {}
+}
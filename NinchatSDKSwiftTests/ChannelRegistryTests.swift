@@ -0,0 +1,185 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class ChannelRegistryTests: XCTestCase {
+    private var registry: ChannelRegistry!
+    private let agent = ChannelUser(userID: "11", realName: "Hassan Shahbazi", displayName: "Hassan", iconURL: "", guest: false, info: nil)
+
+    override func setUp() {
+        registry = ChannelRegistry()
+    }
+
+    func test_state_lookup() {
+        XCTAssertNil(registry.current.channelID)
+        XCTAssertNil(registry["1"])
+
+        let state = registry.state(for: "1")
+        XCTAssertTrue(registry.state(for: "1") === state)
+        XCTAssertTrue(registry["1"] === state)
+        XCTAssertEqual(registry.count, 1)
+    }
+
+    func test_first_channel_continues_the_shown_messages() {
+        registry.current.messageStore.update { $0 = [self.message("1")] }
+        let version = registry.current.snapshot.version
+
+        /// Nothing to reload, the views already show these messages
+        XCTAssertNil(registry.activate(channelID: "1", carryOver: true))
+        XCTAssertEqual(registry.current.channelID, "1")
+        XCTAssertEqual(registry.current.snapshot.version, version)
+        XCTAssertEqual(registry.current.snapshot.messages.map { $0.messageID }, ["1"])
+    }
+
+    func test_transfer_keeps_the_previous_channel() {
+        registry.activate(channelID: "1", carryOver: true)
+        registry.current.members[agent.userID] = agent
+        registry.current.messageStore.update { $0 = [self.message("1")] }
+
+        registry.activate(channelID: "2", carryOver: true)
+        registry.current.messageStore.update { $0.insert(self.message("2"), at: 0) }
+
+        XCTAssertEqual(registry.current.snapshot.messages.map { $0.messageID }, ["2", "1"])
+        XCTAssertNotNil(registry.current.members[agent.userID])
+        XCTAssertEqual(registry["1"]?.snapshot.messages.map { $0.messageID }, ["1"], "Expected the previous channel to be left as it was")
+    }
+
+    func test_closed_channel_starts_over() {
+        registry.activate(channelID: "1", carryOver: true)
+        registry.current.messageStore.update { $0 = [self.message("1")] }
+
+        let shown = registry.activate(channelID: "2", carryOver: false)
+        XCTAssertNotNil(shown)
+        XCTAssertTrue(shown?.snapshot.messages.isEmpty ?? false)
+    }
+
+    func test_switching_reloads_with_a_newer_version() {
+        registry.activate(channelID: "1", carryOver: false)
+        (0..<5).forEach { index in registry.current.messageStore.update { $0.insert(self.message("\(index)"), at: 0) } }
+        registry.state(for: "2").messageStore.update { $0 = [self.message("a")] }
+
+        let previous = registry.current.snapshot.version
+        let shown = registry.activate(channelID: "2", carryOver: true)
+        XCTAssertEqual(shown?.diff.from, previous)
+        XCTAssertEqual(shown?.diff.reload, true)
+        XCTAssertGreaterThan(shown?.snapshot.version ?? 0, previous, "Expected the views to take the messages as newer")
+        XCTAssertEqual(shown?.snapshot.messages.map { $0.messageID }, ["a"], "Expected a known channel to keep its own messages")
+
+        XCTAssertNil(registry.activate(channelID: "2", carryOver: true))
+    }
+
+    func test_remove() {
+        registry.activate(channelID: "1", carryOver: true)
+        registry.state(for: "2")
+
+        registry.remove(channelID: "1")
+        registry.remove(channelID: "2")
+        XCTAssertNotNil(registry["1"], "Expected the shown channel to be kept")
+        XCTAssertNil(registry["2"])
+
+        registry.current.messageStore.update { $0 = [self.message("1")] }
+        let version = registry.current.snapshot.version
+        registry.removeAll()
+        XCTAssertEqual(registry.count, 0)
+        XCTAssertNil(registry.current.channelID)
+        XCTAssertEqual(registry.current.snapshot.version, version)
+        XCTAssertTrue(registry.current.snapshot.messages.isEmpty)
+    }
+}
+
+// MARK: - Session manager
+
+final class ChannelRegistrySessionManagerTests: XCTestCase {
+    private var sessionManager: NINChatSessionManagerImpl!
+    private let agent = ChannelUser(userID: "11", realName: "Hassan Shahbazi", displayName: "Hassan", iconURL: "", guest: false, info: nil)
+
+    override func setUp() {
+        sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        sessionManager.channels.activate(channelID: "previous", carryOver: true)
+        sessionManager.channels.current.members[agent.userID] = agent
+        sessionManager.channels.activate(channelID: "current", carryOver: true)
+        sessionManager.currentChannelID = "current"
+    }
+
+    func test_background_messages_do_not_reach_the_views() {
+        sessionManager.onMessagesChanged = { _, _ in XCTFail("Expected no changes for the shown channel") }
+        sessionManager.onMessageAdded = { _ in XCTFail("Expected no changes for the shown channel") }
+
+        sessionManager.add(message: message("1"), to: sessionManager.channels["previous"])
+        XCTAssertEqual(sessionManager.channels["previous"]?.snapshot.messages.count, 1)
+        XCTAssertTrue(sessionManager.chatMessages.isEmpty)
+    }
+
+    func test_background_member_updates_are_applied() throws {
+        sessionManager.typingPresence.onChange = { _ in XCTFail("Expected the typing of another channel not to be shown") }
+
+        let param = try ClientProps(json: #"{"event": "channel_member_updated", "channel_id": "previous", "user_id": "11", "member_attrs": {"writing": true}}"#)
+        let actionID = self.expectation(description: "Expected the event to be handled")
+        sessionManager.onActionID = { _, error in
+            XCTAssertNil(error)
+            actionID.fulfill()
+        }
+        try sessionManager.didUpdateMember(param: param)
+        waitForExpectations(timeout: 1.0)
+
+        XCTAssertEqual(sessionManager.channels["previous"]?.writing, [agent.userID])
+        XCTAssertTrue(sessionManager.channels.current.writing.isEmpty)
+
+        /// Shown once the channel is
+        sessionManager.typingPresence.onChange = nil
+        try sessionManager.didJoinChannel(channelID: "previous", message: nil, true, false)
+        XCTAssertTrue(sessionManager.typingPresence.isTyping(userID: agent.userID))
+    }
+
+    func test_background_compose_actions_do_not_reach_the_views() {
+        sessionManager.onComposeActionUpdated = { _, _ in XCTFail("Expected the action of another channel not to be shown") }
+
+        let button = ComposeContent(className: nil, link: nil, id: "button", label: "Button", name: "button", element: .button, options: nil)
+        let previous = sessionManager.channels["previous"]
+        sessionManager.add(message: ComposeMessage(timestamp: Date(), messageID: "1", mine: false, sender: nil, content: [button]), to: previous)
+        sessionManager.addCompose(action: ComposeUIAction(action: .click, target: button), in: previous)
+    }
+
+    func test_closed_channel_is_cleared_before_the_next_is_joined() throws {
+        sessionManager.add(message: message("1"))
+        XCTAssertEqual(sessionManager.chatMessages.count, 1)
+
+        try sessionManager.didJoinChannel(channelID: "next", message: nil, false, true)
+        XCTAssertEqual(sessionManager.channels["current"]?.snapshot.messages.count, 0)
+        /// Only the meta message of the new conversation
+        XCTAssertEqual(sessionManager.chatMessages.count, 1)
+        XCTAssertTrue(sessionManager.chatMessages.first is MetaMessage)
+    }
+
+    func test_events_of_unknown_channels_are_dropped() throws {
+        var param = ClientProps()
+        param.channelID = .success("other")
+        XCTAssertNil(sessionManager.channel(of: param))
+        XCTAssertTrue(sessionManager.channel(of: ClientProps()) === sessionManager.channels.current)
+
+        /// A late event of a parted channel does not bring its state back
+        let parted = try ClientProps(json: #"{"event": "channel_parted", "channel_id": "previous"}"#)
+        try sessionManager.didPartChannel(param: parted)
+
+        let history = try ClientProps(json: #"{"event": "history_results", "channel_id": "previous", "history_length": 5}"#)
+        try sessionManager.didLoadHistory(param: history)
+        XCTAssertNil(sessionManager.channels["previous"])
+        XCTAssertNil(sessionManager.channels["other"])
+        XCTAssertEqual(sessionManager.channels.current.expectedHistoryLength, -1)
+    }
+}
+
+extension XCTestCase {
+    fileprivate func message(_ id: String) -> ChatMessage {
+        TextMessage(timestamp: Date(), messageID: id, mine: false, sender: nil, content: id, attachment: nil)
+    }
+}
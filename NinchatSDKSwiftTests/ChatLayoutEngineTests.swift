@@ -0,0 +1,104 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import UIKit
+import XCTest
+@testable import NinchatSDKSwift
+
+final class ChatLayoutEngineTests: XCTestCase {
+    private var engine: ChatLayoutEngine!
+    private let user = ChannelUser(userID: "11", realName: "Hassan Shahbazi", displayName: "Hassan", iconURL: "", guest: false, info: nil)
+
+    override func setUp() {
+        engine = ChatLayoutEngine()
+    }
+
+    func test_text_layout() {
+        let short = self.message(id: "1", content: "Hei")
+        let long = self.message(id: "2", content: String(repeating: "Tervetuloa chattiin. ", count: 20))
+
+        let shortLayout = engine.layout(for: short, width: 375)
+        let longLayout = engine.layout(for: long, width: 375)
+        XCTAssertNotNil(shortLayout)
+        XCTAssertNotNil(longLayout)
+        XCTAssertGreaterThan(longLayout!.height, shortLayout!.height)
+        XCTAssertNotNil(shortLayout?.timestamp)
+
+        /// A narrower width wraps into more lines
+        let narrowLayout = engine.layout(for: long, width: 200)
+        XCTAssertGreaterThan(narrowLayout!.height, longLayout!.height)
+    }
+
+    func test_series_and_deleted() {
+        var message = self.message(id: "1", content: "Hei")
+        let first = engine.layout(for: message, width: 375)!
+
+        message.series = true
+        let series = engine.layout(for: message, width: 375)!
+        XCTAssertLessThan(series.height, first.height)
+
+        message.isDeleted = true
+        let deleted = engine.layout(for: message, width: 375)!
+        XCTAssertNil(deleted.timestamp)
+    }
+
+    func test_media_layout() {
+        let attachment = FileInfo(fileID: "file", name: "image.png", mimeType: "image/png", size: 1024, aspectRatio: 0.5)
+        let message = TextMessage(timestamp: Date(), messageID: "1", mine: false, sender: user, content: nil, attachment: attachment)
+
+        let layout = engine.layout(for: message, width: 375)
+        XCTAssertEqual(layout?.bubbleSize.width, 187.5)
+        XCTAssertEqual(layout?.bubbleSize.height, 375)
+        /// The info container is above the media frame
+        XCTAssertEqual(layout?.height, ChatLayoutMetrics.infoHeight + 375)
+    }
+
+    func test_unsupported_messages() {
+        let meta = MetaMessage(timestamp: Date(), messageID: "1", text: "Chat closed", closeChatButtonTitle: nil)
+        XCTAssertNil(engine.layout(for: meta, width: 375))
+    }
+
+    func test_cache() {
+        let message = self.message(id: "1", content: "Hei")
+        XCTAssertNil(engine.cached(message, width: 375))
+
+        let layout = engine.layout(for: message, width: 375)
+        XCTAssertEqual(engine.cached(message, width: 375), layout)
+        XCTAssertNil(engine.cached(message, width: 320))
+        XCTAssertEqual(engine.count, 1)
+
+        engine.remove(messageID: "1")
+        XCTAssertNil(engine.cached(message, width: 375))
+    }
+
+    func test_prepare() {
+        let messages = (0..<100).map { self.message(id: "\($0)", content: "Message \($0)") }
+
+        let expect = self.expectation(description: "Expected to get all layouts computed in the background")
+        engine.prepare(messages, width: 375) {
+            XCTAssertTrue(Thread.isMainThread)
+            XCTAssertEqual(self.engine.count, 100)
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 5.0)
+    }
+
+    // MARK: - Benchmark
+
+    func test_benchmark_10k_messages() {
+        let messages = (0..<10_000).map { self.message(id: "\($0)", content: String(repeating: "Hei, tervetuloa! ", count: $0 % 10 + 1)) }
+        self.measure {
+            let engine = ChatLayoutEngine()
+            messages.forEach { _ = engine.layout(for: $0, width: 375) }
+        }
+    }
+}
+
+extension ChatLayoutEngineTests {
+    private func message(id: String, content: String) -> TextMessage {
+        TextMessage(timestamp: Date(), messageID: id, mine: false, sender: user, content: content, attachment: nil)
+    }
+}
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class ChatMessageStoreTests: XCTestCase {
+    private var store: ChatMessageStore!
+    private let user = ChannelUser(userID: "11", realName: "Hassan Shahbazi", displayName: "Hassan", iconURL: "", guest: false, info: nil)
+
+    override func setUp() {
+        store = ChatMessageStore()
+    }
+
+    func test_versions() {
+        XCTAssertEqual(store.snapshot.version, 0)
+
+        let (first, diff) = store.update { $0.insert(self.message("1"), at: 0) }
+        XCTAssertEqual(first.version, 1)
+        XCTAssertEqual(diff.from, 0)
+        XCTAssertEqual(diff.to, 1)
+        XCTAssertEqual(diff.inserted, [0])
+
+        /// Earlier snapshots are not affected by later updates
+        store.update { $0.removeAll() }
+        XCTAssertEqual(first.messages.count, 1)
+        XCTAssertEqual(store.snapshot.version, 2)
+        XCTAssertTrue(store.snapshot.messages.isEmpty)
+    }
+
+    func test_diff_insert_remove() {
+        store.update { $0 = ["5", "3", "1"].map { self.message($0) } }
+
+        let diff = store.update { $0 = ["5", "4", "1"].map { self.message($0) } }.diff
+        XCTAssertEqual(diff.removed, [1])
+        XCTAssertEqual(diff.inserted, [1])
+        XCTAssertTrue(diff.updated.isEmpty)
+        XCTAssertFalse(diff.reload)
+    }
+
+    func test_diff_updates() {
+        store.update { $0 = ["2", "1"].map { self.message($0) } }
+
+        /// Explicit updates
+        XCTAssertEqual(store.update(updated: ["1"]) { _ in }.diff.updated, [1])
+
+        /// Series changes are detected
+        let diff = store.update { messages in
+            var message = messages[0] as! TextMessage
+            message.series = true
+            messages[0] = message
+        }.diff
+        XCTAssertEqual(diff.updated, [0])
+
+        /// Nothing changed
+        XCTAssertTrue(store.update { _ in }.diff.isEmpty)
+    }
+
+    func test_diff_reorder() {
+        store.update { $0 = ["2", "1"].map { self.message($0) } }
+        XCTAssertTrue(store.update { $0.reverse() }.diff.reload)
+    }
+
+    func test_contains_and_counts() {
+        store = ChatMessageStore(snapshot: ChatSnapshot(version: 3, messages: [message("2"), MetaMessage(timestamp: Date(), messageID: "1", text: "meta", closeChatButtonTitle: nil)]))
+        XCTAssertTrue(store.contains(messageID: "1_1"))
+        XCTAssertEqual(store.channelMessageCount, 1)
+
+        store.update { $0 = [self.message("4"), self.message("3"), $0[0]] }
+        XCTAssertTrue(store.contains(messageID: "4"))
+        XCTAssertFalse(store.contains(messageID: "1_1"))
+        XCTAssertEqual(store.channelMessageCount, 3)
+    }
+
+    func test_session_manager_publishes_a_batch_once() {
+        let sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        var diffs: [ChatSnapshotDiff] = []
+        sessionManager.onMessagesChanged = { _, diff in diffs.append(diff) }
+
+        /// Newest first, each with the number of messages that still follow
+        (0..<100).reversed().forEach { sessionManager.add(message: message(String(format: "%04d", $0)), remained: .success($0)) }
+        XCTAssertEqual(diffs.count, 1)
+        XCTAssertEqual(diffs.first?.inserted.count, 100)
+        XCTAssertEqual(sessionManager.chatMessages.first?.messageID, "0099")
+        XCTAssertFalse(sessionManager.add(message: message("0050")), "Expected a published message not to be added again")
+
+        /// A batch ending with a known message is published too
+        sessionManager.add(message: message("0100"), remained: .success(1))
+        XCTAssertFalse(sessionManager.add(message: message("0050"), remained: .success(0)))
+        XCTAssertEqual(sessionManager.chatMessages.count, 101)
+    }
+
+    func test_session_manager_flushes_an_unfinished_batch() throws {
+        let sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        sessionManager.batchTimeout = 0.2
+
+        /// On an error
+        sessionManager.add(message: message("0001"), remained: .success(5))
+        sessionManager.add(message: message("0002"), remained: .success(4))
+        XCTAssertTrue(sessionManager.chatMessages.isEmpty)
+        try sessionManager.handleError(param: ClientProps(json: #"{"event": "error", "error_type": "internal"}"#))
+        XCTAssertEqual(sessionManager.chatMessages.count, 2)
+
+        /// Ahead of the next change
+        sessionManager.add(message: message("0003"), remained: .success(3))
+        sessionManager.commit { _ in }
+        XCTAssertEqual(sessionManager.chatMessages.count, 3)
+
+        /// Once the rest has not arrived in time
+        let flushed = self.expectation(description: "Expected the batch to be published after the timeout")
+        sessionManager.onMessagesChanged = { snapshot, _ in
+            XCTAssertEqual(snapshot.messages.count, 4)
+            flushed.fulfill()
+        }
+        sessionManager.add(message: message("0004"), remained: .success(2))
+        waitForExpectations(timeout: 2.0)
+    }
+
+    func test_concurrent_readers() {
+        let expect = self.expectation(description: "Readers should always see a complete version")
+        expect.expectedFulfillmentCount = 2
+
+        DispatchQueue.global().async {
+            (0..<1000).forEach { index in
+                self.store.update { $0 = (0...index).map { self.message("\($0)") } }
+            }
+            expect.fulfill()
+        }
+        DispatchQueue.global().async {
+            (0..<1000).forEach { _ in
+                let snapshot = self.store.snapshot
+                XCTAssertEqual(snapshot.messages.count, snapshot.version)
+            }
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 10.0)
+    }
+}
+
+extension ChatMessageStoreTests {
+    private func message(_ id: String) -> TextMessage {
+        TextMessage(timestamp: Date(), messageID: id, mine: false, sender: user, content: "content", attachment: nil)
+    }
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 17.4.2020 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class ClientPropsTests: XCTestCase {
+
+    func test_initializer_action() {
+        let props1 = ClientProps.initiate(action: .deleteUser)
+        XCTAssertEqual(props1["action"], .string(NINLowLevelClientActions.deleteUser.rawValue))
+
+        let props2 = ClientProps.initiate(action: .describeQueue, name: "name_2")
+        XCTAssertEqual(props2["action"], .string(NINLowLevelClientActions.describeQueue.rawValue))
+        XCTAssertEqual(props2.name.value, "name_2")
+
+        let props3 = ClientProps.initiate()
+        XCTAssertNil(props3["action"])
+        XCTAssertEqual(props3.name.value, "")
+    }
+
+    func test_initializer_credentials() {
+        let credentials = NINSessionCredentials(userID: "user_id_1", userAuth: "user_auth_1", sessionID: "session_id_1")
+        let props = ClientProps.initiate(credentials: credentials)
+
+        XCTAssertEqual(props.userID.value, "user_id_1")
+        XCTAssertEqual(props.userAuth.value, "user_auth_1")
+        XCTAssertEqual(props.sessionID.value, "")
+    }
+
+    func test_initializer_dictionary() {
+        let props1 = ClientProps.initiate(metadata: ["key1": "value1"])
+        XCTAssertEqual(props1["key1"], .string("value1"))
+
+        let props2 = ClientProps.initiate(metadata: ["key2": "value2", "key3": 3, "key4": true, "key5": 5.2, "key6": 6.8])
+        XCTAssertEqual(props2["key2"], .string("value2"))
+
+        let value3: NINResult<Int> = props2.get(forKey: "key3")
+        XCTAssertEqual(value3.value, 3)
+
+        let value4: NINResult<Bool> = props2.get(forKey: "key4")
+        XCTAssertEqual(value4.value, true)
+
+        let value5: NINResult<Double> = props2.get(forKey: "key5")
+        XCTAssertEqual(value5.value, 5.2)
+
+        let value6: NINResult<Double> = props2.get(forKey: "key6")
+        XCTAssertEqual(value6.value, 6.8)
+    }
+
+    func test_initializer_nested_dictionary() {
+        let level1 = ClientProps.initiate(metadata: ["secure-key": "secure-value"])
+        XCTAssertEqual(level1["secure-key"], .string("secure-value"))
+
+        let level2 = ClientProps.initiate(metadata: ["normal-key": "normal-value", "secure-dic": level1] as [String:Any])
+        XCTAssertEqual(level2["normal-key"], .string("normal-value"))
+
+        let secureDic: NINResult<ClientProps> = level2.get(forKey: "secure-dic")
+        XCTAssertEqual(secureDic.optional?["secure-key"], .string("secure-value"))
+    }
+
+    func test_initializer_preQuestionnaire() {
+        let answers: [String:AnyHashable] = ["Koronavirus-jatko": "Näytä muut aiheet", "language": "English", "number-of-messages": 3.2]
+        let props = ClientProps.initiate(preQuestionnaireAnswers: answers)
+
+        let metadata: NINResult<ClientProps> = props.get(forKey: "pre_answers")
+        XCTAssertNotNil(metadata.optional)
+
+        let value1: NINResult<String> = metadata.value.get(forKey: "Koronavirus-jatko")
+        XCTAssertEqual(value1.value, "Näytä muut aiheet")
+
+        let value2: NINResult<Double> = metadata.value.get(forKey: "number-of-messages")
+        XCTAssertEqual(value2.value, 3.2)
+    }
+
+    func test_simple_binding() {
+        var props = ClientProps.initiate()
+        props.messageFold = .success(false)
+        props.messageType = .success(.text)
+        props.set(value: 6.5, forKey: "message_time")
+        props.set(value: "id", forKey: "message_id")
+        props.historyOrder = .success(HistoryOrder.ASC.rawValue)
+
+        XCTAssertEqual(props.messageFold.value, false)
+        XCTAssertEqual(props.messageType.value, .text)
+        XCTAssertEqual(props.messageTime.value, 6.5)
+        XCTAssertEqual(props.messageID.value, "id")
+        XCTAssertEqual(props.historyOrder.value, 1)
+    }
+
+    func test_missing_values() {
+        let props = ClientProps()
+
+        /// As with the low level client, scalars read as their zero values
+        XCTAssertEqual(props.messageID.value, "")
+        XCTAssertEqual(props.historyLength.value, 0)
+        XCTAssertEqual(props.messageFold.value, false)
+        XCTAssertNil(props.channelAttributes.optional)
+        XCTAssertNil(props.recipients.optional)
+        XCTAssertNil(props.stunServers.optional)
+    }
+
+    func test_wrong_type_fails() {
+        let props = ClientProps(["message_id": .number(1), "channel_attrs": .string("closed")])
+
+        XCTAssertNil(props.messageID.optional)
+        XCTAssertNil(props.channelAttributes.optional)
+    }
+
+    func test_json_round_trip() throws {
+        let json = #"{"channel_attrs":{"closed":true},"channel_id":"channel","history_length":5,"message_time":6.5,"recipients":["a","b"],"stun_servers":[{"urls":["stun:1"]}]}"#
+        let props = try ClientProps(json: json)
+
+        XCTAssertEqual(props.channelClosed.value, true)
+        XCTAssertEqual(props.historyLength.value, 5)
+        XCTAssertEqual(props.recipients.value, ["a", "b"])
+        XCTAssertEqual(props.stunServers.value.first?.serversURL.value, ["stun:1"])
+        XCTAssertEqual(try ClientProps(json: props.json), props)
+    }
+}
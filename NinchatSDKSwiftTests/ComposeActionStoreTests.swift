@@ -0,0 +1,119 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class ComposeActionStoreTests: XCTestCase {
+    private var store: ComposeActionStore!
+
+    override func setUp() {
+        store = ComposeActionStore()
+    }
+
+    func test_action_after_its_message() {
+        XCTAssertTrue(store.insert(message("1", buttons: ["yes", "no"])).isEmpty)
+
+        XCTAssertEqual(store.match(action("no")), "1")
+        XCTAssertNil(store.match(action("maybe")))
+        XCTAssertEqual(store.pending.map { $0.target.id }, ["maybe"])
+    }
+
+    func test_action_before_its_message() {
+        XCTAssertNil(store.match(action("yes")))
+        XCTAssertNil(store.match(action("yes")), "Expected a duplicate to be dropped")
+        XCTAssertEqual(store.pending.count, 1)
+
+        let matches = store.insert(message("1", buttons: ["yes", "no"]))
+        XCTAssertEqual(matches.map { $0.messageID }, ["1"])
+        XCTAssertEqual(matches.map { $0.action.target.id }, ["yes"])
+        XCTAssertTrue(store.pending.isEmpty, "Expected the action to be matched once")
+    }
+
+    func test_reused_content_stays_with_the_most_recent_message() {
+        /// A history arrives newest first
+        XCTAssertTrue(store.insert(message("2", buttons: ["yes"])).isEmpty)
+        XCTAssertTrue(store.insert(message("1", buttons: ["yes", "no"])).isEmpty)
+        XCTAssertEqual(store.match(action("yes")), "2")
+        XCTAssertEqual(store.match(action("no")), "1")
+
+        XCTAssertTrue(store.insert(message("3", buttons: ["yes"])).isEmpty)
+        XCTAssertEqual(store.match(action("yes")), "3")
+
+        /// Removing an older message keeps the most recent one
+        store.remove(message("1", buttons: ["yes", "no"]))
+        XCTAssertEqual(store.match(action("yes")), "3")
+    }
+
+    func test_reused_content_falls_back_to_an_older_message() {
+        XCTAssertTrue(store.insert(message("1", buttons: ["yes"])).isEmpty)
+        XCTAssertTrue(store.insert(message("2", buttons: ["yes"])).isEmpty)
+        XCTAssertTrue(store.insert(message("3", buttons: ["yes"])).isEmpty)
+
+        /// Removing the most recent one gives the content back to the most recent left
+        store.remove(message("3", buttons: ["yes"]))
+        XCTAssertEqual(store.match(action("yes")), "2")
+        store.remove(message("2", buttons: ["yes"]))
+        XCTAssertEqual(store.match(action("yes")), "1")
+
+        store.remove(message("1", buttons: ["yes"]))
+        XCTAssertNil(store.match(action("yes")), "Expected the action to wait once no message holds the content")
+    }
+
+    func test_applies_the_store_diffs() {
+        let messages = ChatMessageStore()
+        func update(_ transform: (inout [ChatMessage]) -> Void) -> [ComposeActionStore.Match] {
+            let previous = messages.snapshot
+            let (snapshot, diff) = messages.update(transform)
+            return store.apply(diff, from: previous, to: snapshot)
+        }
+
+        XCTAssertNil(store.match(action("b")))
+        XCTAssertEqual(update { $0 = [message("2", buttons: ["b"]), message("1", buttons: ["a"])] }.map { $0.messageID }, ["2"])
+        XCTAssertEqual(store.match(action("a")), "1")
+
+        _ = update { $0.removeAll() }
+        XCTAssertNil(store.match(action("a")), "Expected a removed message not to be matched")
+    }
+
+    func test_session_manager_applies_each_action_once() {
+        let sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        var applied: [String] = []
+        sessionManager.onComposeActionUpdated = { id, action in applied.append("\(id):\(action.target.id ?? "")") }
+
+        /// A bot conversation replayed with the actions ahead of their messages
+        (0..<100).forEach { sessionManager.addCompose(action: action("button-\($0)")) }
+        XCTAssertEqual(sessionManager.composeActions.count, 100)
+
+        (0..<100).forEach { sessionManager.add(message: message(String(format: "%04d", $0), buttons: ["button-\($0)"])) }
+        XCTAssertEqual(applied.count, 100)
+        XCTAssertEqual(applied.first, "0000:button-0")
+        XCTAssertTrue(sessionManager.composeActions.isEmpty)
+
+        /// Later messages do not apply the actions again
+        sessionManager.add(message: TextMessage(timestamp: Date(), messageID: "0100", mine: false, sender: nil, content: "text", attachment: nil))
+        XCTAssertEqual(applied.count, 100)
+
+        sessionManager.addCompose(action: action("button-5"))
+        XCTAssertEqual(applied.last, "0005:button-5")
+    }
+}
+
+extension ComposeActionStoreTests {
+    private func message(_ id: String, buttons: [String]) -> ComposeMessage {
+        ComposeMessage(timestamp: Date(), messageID: id, mine: false, sender: nil, content: buttons.map {
+            ComposeContent(className: nil, link: nil, id: $0, label: $0, name: $0, element: .button, options: nil)
+        })
+    }
+
+    private func action(_ target: String) -> ComposeUIAction {
+        ComposeUIAction(action: .click, target: ComposeContent(className: nil, link: nil, id: target, label: target, name: target, element: .button, options: nil))
+    }
+}
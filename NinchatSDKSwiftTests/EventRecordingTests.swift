@@ -0,0 +1,130 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class EventRecordingTests: XCTestCase {
+    private var uptime: UInt64 = 0
+    private var recorder: EventRecorder!
+
+    override func setUp() {
+        uptime = 0
+        recorder = EventRecorder(capacity: 3, uptime: { self.uptime })
+        recorder.isEnabled = true
+    }
+
+    func test_disabled_recorder_records_nothing() {
+        recorder.isEnabled = false
+        recorder.record(session: props(event: "session_created"))
+        XCTAssertTrue(recorder.recording.entries.isEmpty)
+    }
+
+    func test_recording_round_trip() throws {
+        recorder.record(session: props(event: "session_created"))
+        uptime = 250_000_000
+        recorder.record(event: props(event: "message_received"), payload: payload(#"{"text":"Hei öäå"}"#, binary: Data([0xFF, 0x00])), lastReply: true)
+
+        let recording = try EventRecording(data: recorder.recording.data)
+        XCTAssertEqual(recording.entries.map { $0.kind }, [.session, .event])
+        XCTAssertEqual(recording.entries.map { $0.event }, ["session_created", "message_received"])
+        XCTAssertEqual(recording.entries.last?.offset, 0.25)
+        XCTAssertEqual(recording.entries.last?.lastReply, true)
+
+        let frames = try XCTUnwrap(recording.entries.last?.payload)
+        XCTAssertEqual(String(data: frames[0], encoding: .utf8), #"{"text":"xxxxxxx"}"#)
+        XCTAssertEqual(frames[1], Data([0xFF, 0x00]))
+    }
+
+    func test_message_text_is_kept_when_not_scrubbing() throws {
+        recorder.scrubsMessageText = false
+        recorder.record(event: props(event: "message_received"), payload: payload(#"{"text":"Hello"}"#), lastReply: false)
+
+        let recording = try EventRecording(data: recorder.recording.data)
+        XCTAssertEqual(recording.entries.first?.payload.first.flatMap { String(data: $0, encoding: .utf8) }, #"{"text":"Hello"}"#)
+    }
+
+    func test_recording_is_bounded() {
+        (1...5).forEach { _ in recorder.record(session: props(event: "session_created")) }
+        XCTAssertEqual(recorder.recording.entries.count, 3)
+    }
+
+    func test_invalid_entry_is_reported() {
+        let data = Data(#"{"k":"e","t":0,"p":{}}\#nnot json\#n"#.utf8)
+        XCTAssertThrowsError(try EventRecording(data: data)) { error in
+            guard case EventRecordingError.invalidEntry(let line) = error else { return XCTFail("Unexpected error: \(error)") }
+            XCTAssertEqual(line, 2)
+        }
+    }
+
+    func test_replay_at_maximum_speed() {
+        recorder.record(session: props(event: "session_created"))
+        recorder.record(event: props(event: "message_received"), payload: payload(#"{"text":"Hello"}"#), lastReply: false)
+        recorder.record(event: props(event: "message_received"), payload: payload(#"{"text":"World"}"#), lastReply: true)
+
+        let handlers = RecordingEventHandlers()
+        var report: EventReplayer.Report?
+        EventReplayer(recording: recorder.recording, memoryFootprint: { 1024 }).replay(into: handlers) { report = $0 }
+
+        XCTAssertEqual(handlers.handled, ["session_created", "message_received", "message_received"])
+        XCTAssertEqual(handlers.lastReplies, [false, true])
+        XCTAssertEqual(report?.events, 3)
+        XCTAssertEqual(report?.costs["message_received"]?.count, 2)
+        XCTAssertEqual(report?.costs["session_created"]?.count, 1)
+        XCTAssertEqual(report?.peakMemory, 1024)
+    }
+
+    func test_replay_at_recorded_speed_keeps_the_order() {
+        recorder.record(event: props(event: "channel_joined"), payload: [], lastReply: true)
+        uptime = 50_000_000
+        recorder.record(event: props(event: "history_results"), payload: [], lastReply: true)
+
+        let expect = self.expectation(description: "Expected the replay to finish")
+        let handlers = RecordingEventHandlers()
+        EventReplayer(recording: recorder.recording).replay(into: handlers, speed: .recorded) { report in
+            XCTAssertEqual(handlers.handled, ["channel_joined", "history_results"])
+            XCTAssertGreaterThanOrEqual(report.duration, 0.05)
+            expect.fulfill()
+        }
+        XCTAssertTrue(handlers.handled.isEmpty)
+
+        waitForExpectations(timeout: 1.0)
+    }
+}
+
+extension EventRecordingTests {
+    private func props(event: String) -> ClientProps {
+        var props = ClientProps.initiate()
+        props.set(value: event, forKey: "event")
+        return props
+    }
+
+    private func payload(_ text: String, binary: Data? = nil) -> ClientPayload {
+        [Data(text.utf8)] + (binary.map { [$0] } ?? [])
+    }
+}
+
+private final class RecordingEventHandlers: NINChatSessionManagerEventHandlers {
+    private(set) var handled: [String] = []
+    private(set) var lastReplies: [Bool] = []
+
+    func onSessionEvent(param: ClientProps) {
+        handled.append(param.event.optional ?? "")
+    }
+
+    func onEvent(param: ClientProps, payload: ClientPayload, lastReplay: Bool) {
+        handled.append(param.event.optional ?? "")
+        lastReplies.append(lastReplay)
+    }
+
+    func onCloseEvent() {}
+    func onLogEvent(value: String) {}
+    func onConnStateEvent(state: String) {}
+}
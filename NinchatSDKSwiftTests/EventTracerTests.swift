@@ -0,0 +1,130 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class EventTracerTests: XCTestCase {
+    private var uptime: UInt64 = 0
+    private var tracer: EventTracer!
+
+    override func setUp() {
+        uptime = 0
+        tracer = EventTracer(capacity: 10, awaitingCapacity: 2, uptime: { self.uptime })
+        tracer.isEnabled = true
+    }
+
+    func test_disabled_tracer_does_not_trace() {
+        tracer.isEnabled = false
+        XCTAssertNil(tracer.begin())
+
+        var handled = false
+        tracer.dispatch(nil) { handled = true }
+        XCTAssertTrue(handled)
+        XCTAssertTrue(tracer.histograms.isEmpty)
+    }
+
+    func test_event_without_message_finishes_when_handled() {
+        let trace = tracer.begin()
+        uptime = milliseconds(2)
+        tracer.dispatch(trace) {
+            self.tracer.current?.event = "channel_updated"
+            self.uptime = milliseconds(3)
+        }
+
+        let histograms = tracer.histograms["channel_updated"]
+        XCTAssertEqual(histograms?.total.count, 1)
+        XCTAssertEqual(histograms?.total.max, milliseconds(2))
+        XCTAssertEqual(histograms?.stages["received→dispatched"]?.count, 1)
+    }
+
+    func test_message_waits_for_render() {
+        let trace = tracer.begin()
+        uptime = milliseconds(1)
+        tracer.dispatch(trace) {
+            self.tracer.current?.event = "message_received"
+            self.uptime = milliseconds(2)
+            self.tracer.mark(.decoded)
+            self.uptime = milliseconds(3)
+            self.tracer.committed(version: 5)
+        }
+        XCTAssertTrue(tracer.histograms.isEmpty)
+
+        /// An older version does not include the message
+        uptime = milliseconds(10)
+        tracer.rendered(version: 4)
+        XCTAssertTrue(tracer.histograms.isEmpty)
+
+        uptime = milliseconds(20)
+        tracer.rendered(version: 6)
+        let histograms = tracer.histograms["message_received"]
+        XCTAssertEqual(histograms?.total.count, 1)
+        XCTAssertEqual(histograms?.total.max, milliseconds(20))
+        XCTAssertEqual(Set(histograms?.stages.keys.map { $0 } ?? []), ["received→dispatched", "dispatched→decoded", "decoded→committed", "committed→rendered"])
+        XCTAssertEqual(histograms?.stages["committed→rendered"]?.max, milliseconds(17))
+    }
+
+    func test_synchronous_render_is_counted_once() {
+        let trace = tracer.begin()
+        tracer.dispatch(trace) {
+            self.tracer.current?.event = "message_received"
+            self.tracer.committed(version: 1)
+            self.tracer.committed(version: 2)
+            self.tracer.rendered(version: 2)
+        }
+        XCTAssertEqual(tracer.histograms["message_received"]?.total.count, 1)
+    }
+
+    func test_unrendered_traces_are_bounded() {
+        (1...3).forEach { version in
+            tracer.dispatch(tracer.begin()) {
+                self.tracer.current?.event = "message_received"
+                self.tracer.committed(version: version)
+            }
+        }
+        /// The oldest one is given up on
+        XCTAssertEqual(tracer.histograms["message_received"]?.total.count, 1)
+        XCTAssertNil(tracer.histograms["message_received"]?.stages["committed→rendered"])
+    }
+
+    func test_histogram_percentiles() {
+        var histogram = LatencyHistogram()
+        XCTAssertNil(histogram.percentile(0.5))
+
+        (1...99).forEach { _ in histogram.record(nanoseconds: milliseconds(1)) }
+        histogram.record(nanoseconds: milliseconds(500))
+        XCTAssertEqual(histogram.count, 100)
+        /// 1ms falls in the bucket below 1024µs
+        XCTAssertEqual(histogram.percentile(0.5) ?? 0, 0.001024, accuracy: 0.000001)
+        XCTAssertEqual(histogram.percentile(0.99) ?? 0, 0.001024, accuracy: 0.000001)
+        /// Capped to the maximum
+        XCTAssertEqual(histogram.percentile(1.0) ?? 0, 0.5, accuracy: 0.000001)
+    }
+
+    func test_export_trace() throws {
+        let trace = tracer.begin()
+        uptime = milliseconds(1)
+        tracer.dispatch(trace) { self.tracer.current?.event = "message_received" }
+
+        let data = try XCTUnwrap(tracer.exportTrace())
+        let json = try XCTUnwrap(try JSONSerialization.jsonObject(with: data) as? [String:Any])
+        let events = try XCTUnwrap(json["traceEvents"] as? [[String:Any]])
+        XCTAssertEqual(events.count, 1)
+        XCTAssertEqual(events.first?["name"] as? String, "received→dispatched")
+        XCTAssertEqual(events.first?["dur"] as? Double, 1000)
+        XCTAssertEqual(tracer.latencies.map { $0.event }, ["message_received"])
+    }
+}
+
+extension EventTracerTests {
+    private func milliseconds(_ value: UInt64) -> UInt64 {
+        value * 1_000_000
+    }
+}
@@ -6,7 +6,6 @@
 
 import UIKit
 import XCTest
-import NinchatLowLevelClient
 @testable import NinchatSDKSwift
 
 final class ExtensionsTests: XCTestCase {
@@ -203,18 +202,16 @@ final class ExtensionsTests: XCTestCase {
     }
 
     func test_userDefaults_lowLevelTypes() {
-        let error: NSErrorPointer = nil
-        let metadata = NINLowLevelClientProps.initiate(metadata: ["key-21": "value-21", "key-31": 2]).marshalJSON(error)
-        XCTAssertNil(error)
+        let metadata = ClientProps.initiate(metadata: ["key-21": "value-21", "key-31": 2]).json
         UserDefaults.save(["key-1": metadata], key: .metadata)
 
         let fetchedValue: [String:Any]? = UserDefaults.load(forKey: .metadata)
         XCTAssertNotNil(fetchedValue)
         XCTAssertEqual(fetchedValue?["key-1"] as? String, "{\"key-21\":\"value-21\",\"key-31\":2}")
 
-        let fetchedMetadata = NINLowLevelClientProps.initiate()
-        XCTAssertNoThrow(try fetchedMetadata.unmarshalJSON(fetchedValue?["key-1"] as? String))
-        XCTAssertEqual(try? fetchedMetadata.getString("key-21"), "value-21")
+        let fetchedMetadata = try? ClientProps(json: fetchedValue?["key-1"] as? String ?? "")
+        XCTAssertNotNil(fetchedMetadata)
+        XCTAssertEqual(fetchedMetadata?["key-21"], .string("value-21"))
     }
     
     func test_ordered_set() {
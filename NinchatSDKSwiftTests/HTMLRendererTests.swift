@@ -0,0 +1,118 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import UIKit
+import XCTest
+@testable import NinchatSDKSwift
+
+final class HTMLRendererTests: XCTestCase {
+    private var renderer: HTMLRenderer!
+    private let style = HTMLStyle(font: .ninchat, alignment: .left, color: .black, width: 300)
+
+    private let sample = """
+                         <p>Hei! <b>Tervetuloa</b> <i>chattiin</i>.</p>
+                         <p>Lue lisää <a href="https://www.ninchat.com">täältä</a> &amp; vastaa:</p>
+                         <ul><li>ensimmäinen</li><li>toinen</li></ul>
+                         """
+
+    override func setUp() {
+        renderer = HTMLRenderer()
+        renderer.imageLoader = { _, completion in completion(UIColor.blueButton.toImage) }
+    }
+
+    func test_link() {
+        let attrString = renderer.render("<a href=\"https://www.ninchat.com\">salaries_by_field_of_study_2018.pdf</a>", style: style)
+        XCTAssertEqual(attrString.string, "salaries_by_field_of_study_2018.pdf")
+
+        let link = attrString.attribute(.link, at: 0, effectiveRange: nil) as? URL
+        XCTAssertEqual(link?.absoluteString, "https://www.ninchat.com")
+
+        let paragraph = attrString.attribute(.paragraphStyle, at: 0, effectiveRange: nil) as? NSParagraphStyle
+        XCTAssertEqual(paragraph?.alignment, .left)
+    }
+
+    func test_paragraphs_lists_entities() {
+        let attrString = renderer.render(sample, style: style)
+        XCTAssertEqual(attrString.string, "Hei! Tervetuloa chattiin.\nLue lisää täältä & vastaa:\n\u{2022} ensimmäinen\n\u{2022} toinen")
+
+        let ordered = renderer.render("<ol><li>one</li><li>two</li></ol>", style: style)
+        XCTAssertEqual(ordered.string, "1. one\n2. two")
+
+        XCTAssertEqual(renderer.render("a<br>b<br/>c &lt;3 &#8364;", style: style).string, "a\nb\nc <3 €")
+        XCTAssertEqual(renderer.render("<head><style>p { color: red; }</style></head><p>body</p>", style: style).string, "body")
+    }
+
+    func test_bold_italic() {
+        let attrString = renderer.render("plain <b>bold</b> <i>italic</i>", style: style)
+        let plainFont = attrString.attribute(.font, at: 0, effectiveRange: nil) as? UIFont
+        let boldFont = attrString.attribute(.font, at: 6, effectiveRange: nil) as? UIFont
+        let italicFont = attrString.attribute(.font, at: 11, effectiveRange: nil) as? UIFont
+
+        XCTAssertNotNil(plainFont)
+        XCTAssertNotEqual(plainFont, boldFont)
+        XCTAssertNotEqual(plainFont, italicFont)
+        XCTAssertEqual(boldFont?.pointSize, plainFont?.pointSize)
+    }
+
+    func test_image_width() {
+        let expect = self.expectation(description: "Expected to get the string with its image")
+        renderer.render("<img src=\"https://www.ninchat.com/image.png\" width=\"600\" height=\"300\">", style: style) { attrString in
+            let attachment = attrString.attribute(.attachment, at: 0, effectiveRange: nil) as? NSTextAttachment
+            XCTAssertNotNil(attachment)
+            XCTAssertEqual(attachment?.bounds.width, 300)
+            XCTAssertEqual(attachment?.bounds.height, 150)
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 5.0)
+    }
+
+    func test_images_are_not_loaded_synchronously() {
+        var loaded = 0
+        renderer.imageLoader = { _, _ in loaded += 1 }
+        let text = "<p>text</p><img src=\"https://www.ninchat.com/image.png\">"
+
+        XCTAssertEqual(renderer.render(text, style: style).string, "text")
+        XCTAssertEqual(loaded, 0)
+        XCTAssertNil(renderer.cached(text, style: style), "Expected a string without its images not to be cached")
+    }
+
+    func test_cache() {
+        XCTAssertNil(renderer.cached(sample, style: style))
+        let rendered = renderer.render(sample, style: style)
+        XCTAssertTrue(renderer.cached(sample, style: style) === rendered)
+
+        /// A different width is a different entry
+        XCTAssertNil(renderer.cached(sample, style: HTMLStyle(font: .ninchat, alignment: .left, color: .black, width: 200)))
+    }
+
+    func test_background_rendering() {
+        let expect = self.expectation(description: "Expected to get the rendered string on the main thread")
+        renderer.render(sample, style: style) { attrString in
+            XCTAssertTrue(Thread.isMainThread)
+            XCTAssertFalse(attrString.string.isEmpty)
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 5.0)
+    }
+
+    // MARK: - Benchmark
+
+    func test_benchmark_native() {
+        self.measure {
+            (0..<50).forEach { index in
+                _ = HTMLRenderer().render(sample + "\(index)", style: style)
+            }
+        }
+    }
+
+    func test_benchmark_webkit() {
+        self.measure {
+            (0..<50).forEach { index in
+                _ = (sample + "\(index)").htmlAttributedString(withFont: .ninchat, alignment: .left, color: .black, width: 300)
+            }
+        }
+    }
+}
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class ICEServerCacheTests: XCTestCase {
+    private var now = Date(timeIntervalSince1970: 0)
+    private var requests: [ICEServerCache.Completion] = []
+    private var cache: ICEServerCache!
+    private let stun = [WebRTCServerInfo(url: "stun:stun.ninchat.com", username: nil, credential: nil)]
+
+    override func setUp() {
+        now = Date(timeIntervalSince1970: 0)
+        requests = []
+        cache = ICEServerCache(ttl: 60, now: { self.now }) { completion in
+            self.requests.append(completion)
+        }
+    }
+
+    func test_prefetch_completes_waiters() {
+        cache.prefetch()
+        XCTAssertTrue(cache.isFetching)
+
+        var received: [WebRTCServerInfo]?
+        cache.servers { error, stunServers, _ in
+            XCTAssertNil(error)
+            received = stunServers
+        }
+        /// Only the prefetch request is sent
+        XCTAssertEqual(requests.count, 1)
+
+        requests[0](nil, stun, [])
+        XCTAssertEqual(received?.count, 1)
+        XCTAssertFalse(cache.isFetching)
+    }
+
+    func test_ttl() {
+        cache.servers { _, _, _ in }
+        requests[0](nil, stun, [])
+
+        now.addTimeInterval(30)
+        var cached = false
+        cache.servers { _, stunServers, _ in cached = stunServers != nil }
+        XCTAssertTrue(cached)
+        XCTAssertEqual(requests.count, 1)
+
+        now.addTimeInterval(31)
+        XCTAssertNil(cache.cached)
+        cache.prefetch()
+        XCTAssertEqual(requests.count, 2)
+    }
+
+    func test_failures_are_not_kept() {
+        var errors = 0
+        cache.servers { error, _, _ in if error != nil { errors += 1 } }
+        requests[0](NINSessionExceptions.noActiveSession, nil, nil)
+
+        XCTAssertEqual(errors, 1)
+        XCTAssertNil(cache.cached)
+        cache.prefetch()
+        XCTAssertEqual(requests.count, 2)
+    }
+
+    func test_throwing_fetch() {
+        let cache = ICEServerCache { _ in throw NINSessionExceptions.noActiveSession }
+
+        var received: Error?
+        cache.servers { error, _, _ in received = error }
+        XCTAssertNotNil(received)
+        XCTAssertFalse(cache.isFetching)
+    }
+
+    func test_call_setup_timings() {
+        let timings = CallSetupTimings(now: { self.now })
+        var completed = false
+        timings.onCompleted = { _ in completed = true }
+
+        timings.mark(.call)
+        now.addTimeInterval(2)
+        timings.mark(.offer)
+        timings.mark(.iceServers)
+        now.addTimeInterval(0.5)
+        timings.mark(.answer)
+        now.addTimeInterval(1)
+        /// Only the first occurrence is kept
+        timings.mark(.offer)
+        timings.mark(.connected)
+
+        XCTAssertTrue(completed)
+        XCTAssertEqual(timings.interval(from: .call, to: .offer), 2)
+        XCTAssertEqual(timings.interval(from: .offer, to: .connected), 1.5)
+        XCTAssertEqual(timings.total, 3.5)
+    }
+}
@@ -0,0 +1,156 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class JitsiDiscoveryCacheTests: XCTestCase {
+    private var now = Date(timeIntervalSince1970: 0)
+    private var channelID: String? = "channel-1"
+    private var requests: [CompletionWithJitsiCredentials] = []
+    private var cache: JitsiDiscoveryCache!
+
+    override func setUp() {
+        now = Date(timeIntervalSince1970: 0)
+        channelID = "channel-1"
+        requests = []
+        cache = JitsiDiscoveryCache(fallbackTTL: 300, expiryMargin: 30, now: { self.now }, channelID: { self.channelID }) { completion in
+            self.requests.append(completion)
+        }
+    }
+
+    func test_prefetch_completes_waiters() {
+        cache.prefetch()
+        XCTAssertTrue(cache.isDiscovering)
+
+        var received: JitsiCredentials?
+        cache.credentials { result in
+            if case let .success(credentials) = result { received = credentials }
+        }
+        /// Only the prefetch request is sent
+        XCTAssertEqual(requests.count, 1)
+
+        requests[0](.success((room: "room", token: "token")))
+        XCTAssertEqual(received?.room, "room")
+        XCTAssertFalse(cache.isDiscovering)
+        XCTAssertNotNil(cache.cached)
+    }
+
+    func test_prefetch_skips_when_cached() {
+        cache.prefetch()
+        requests[0](.success((room: "room", token: "token")))
+
+        cache.prefetch()
+        cache.credentials { _ in }
+        XCTAssertEqual(requests.count, 1)
+    }
+
+    func test_channel_change_misses() {
+        cache.prefetch()
+        requests[0](.success((room: "room", token: "token")))
+
+        channelID = "channel-2"
+        XCTAssertNil(cache.cached)
+        cache.prefetch()
+        XCTAssertEqual(requests.count, 2)
+    }
+
+    func test_channel_change_drops_inflight() {
+        var results: [NINResult<JitsiCredentials>?] = []
+        cache.credentials { results.append($0) }
+
+        channelID = "channel-2"
+        cache.credentials { results.append($0) }
+        XCTAssertEqual(requests.count, 2)
+        /// The waiter of the former channel is completed without credentials
+        XCTAssertEqual(results.count, 1)
+        XCTAssertNil(results[0] ?? nil)
+
+        /// The late result of the former channel is ignored
+        requests[0](.success((room: "room-1", token: "token")))
+        XCTAssertNil(cache.cached)
+
+        requests[1](.success((room: "room-2", token: "token")))
+        XCTAssertEqual(cache.cached?.room, "room-2")
+        XCTAssertEqual(results.count, 2)
+    }
+
+    func test_token_expiry_with_margin() {
+        let token = self.jwt(exp: 120)
+        XCTAssertEqual(JitsiDiscoveryCache.expiry(of: token), Date(timeIntervalSince1970: 120))
+
+        cache.prefetch()
+        requests[0](.success((room: "room", token: token)))
+
+        now = Date(timeIntervalSince1970: 89)
+        XCTAssertNotNil(cache.cached)
+        now = Date(timeIntervalSince1970: 90)
+        XCTAssertNil(cache.cached)
+    }
+
+    func test_fallback_ttl() {
+        XCTAssertNil(JitsiDiscoveryCache.expiry(of: "token"))
+
+        cache.prefetch()
+        requests[0](.success((room: "room", token: "token")))
+
+        now = Date(timeIntervalSince1970: 269)
+        XCTAssertNotNil(cache.cached)
+        now = Date(timeIntervalSince1970: 270)
+        XCTAssertNil(cache.cached)
+    }
+
+    func test_error_is_not_cached() {
+        var failed = false
+        cache.credentials { result in
+            if case .failure = result { failed = true }
+        }
+        requests[0](.failure(NinchatError(type: "unknown", props: nil)))
+        XCTAssertTrue(failed)
+        XCTAssertNil(cache.cached)
+
+        cache.prefetch()
+        XCTAssertEqual(requests.count, 2)
+    }
+
+    func test_no_channel() {
+        channelID = nil
+        var failed = false
+        cache.credentials { result in
+            if case .failure = result { failed = true }
+        }
+        XCTAssertTrue(failed)
+        XCTAssertTrue(requests.isEmpty)
+    }
+
+    func test_join_latency() {
+        var latency = JitsiJoinLatency(startedAt: Date(timeIntervalSince1970: 0))
+        XCTAssertNil(latency.total)
+
+        latency.credentialsAt = Date(timeIntervalSince1970: 0.2)
+        latency.loadStartedAt = Date(timeIntervalSince1970: 0.25)
+        latency.joinedAt = Date(timeIntervalSince1970: 2.25)
+        XCTAssertEqual(latency.discovery ?? 0, 0.2, accuracy: 0.001)
+        XCTAssertEqual(latency.load ?? 0, 2.0, accuracy: 0.001)
+        XCTAssertEqual(latency.total ?? 0, 2.25, accuracy: 0.001)
+    }
+}
+
+extension JitsiDiscoveryCacheTests {
+    private func jwt(exp: Int) -> String {
+        func encode(_ string: String) -> String {
+            Data(string.utf8).base64EncodedString()
+                .replacingOccurrences(of: "=", with: "")
+                .replacingOccurrences(of: "+", with: "-")
+                .replacingOccurrences(of: "/", with: "_")
+        }
+        return [encode("{\"alg\":\"HS256\"}"), encode("{\"exp\":\(exp)}"), "signature"].joined(separator: ".")
+    }
+}
@@ -0,0 +1,524 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+/// A stand-in for the Ninchat API, in process, to run the SDK under latency, packet loss, large
+/// histories and queue churn without the real service.
+///
+/// It answers the part of the v2 protocol the SDK uses: creating the session, `describe_realm_queues`,
+/// `request_audience`, `load_history`, `send_message`, `describe_file`, `update_member`, `part_channel`
+/// and `delete_user`; other actions get an error. The site configurations are served at `/config/<key>`.
+/// `install(in:)` points a session manager at the server through the `LowLevelClientSession` seam and
+/// the service manager's URL protocols, so the session manager runs unchanged.
+///
+/// The events of a connection arrive in the order they were sent, each after `delay` and up to `jitter`
+/// more. A lost event arrives `retransmission` later, holding back the ones after it, as it would after
+/// the client reconnects. The jitter and the losses are drawn from a seeded generator, so a run repeats.
+final class LocalNinchatServer {
+    struct Conditions {
+        var delay: TimeInterval = 0
+        var jitter: TimeInterval = 0
+        /// The share of events lost, from 0 to 1
+        var lossRate: Double = 0
+        var retransmission: TimeInterval = 1.0
+        var seed: UInt64 = 1
+    }
+
+    /// What the server has, and what it does on its own
+    struct Scenario {
+        var realmID = "local-realm"
+        /// Names by queue id
+        var queues: [String:String] = ["local-queue": "Local queue"]
+        /// Positions reported after joining a queue, `queueInterval` apart, before the agent accepts
+        var queuePositions: [Int] = [1]
+        var queueInterval: TimeInterval = 0
+        /// Messages in the channel before it is joined
+        var historyLength = 0
+        /// Sent by the agent after the channel is joined, `agentInterval` apart
+        var agentMessages: [String] = []
+        var agentInterval: TimeInterval = 0
+        /// By configuration key; `configurationKey` is served a configuration for the realm and
+        /// its queues unless given here
+        var siteConfigurations: [String:[String:Any]] = [:]
+    }
+
+    static let configurationKey = "local"
+
+    let address: String
+    let scenario: Scenario
+    let conditions: Conditions
+
+    private let queue = DispatchQueue(label: "com.ninchat.sdk.swift.local-server")
+    private var generator: SeededGenerator
+    private var actions: [String:Int] = [:]
+    private var lastMessageID = 0
+
+    init(scenario: Scenario = Scenario(), conditions: Conditions = Conditions()) {
+        self.address = "local-\(UUID().uuidString.lowercased()).ninchat.test"
+        self.scenario = scenario
+        self.conditions = conditions
+        self.generator = SeededGenerator(seed: conditions.seed)
+        LocalNinchatServer.register(self)
+    }
+
+    deinit {
+        LocalNinchatServer.unregister(self.address)
+    }
+
+    /// Points the session manager at the server
+    func install(in sessionManager: NINChatSessionManagerImpl) {
+        sessionManager.serverAddress = self.address
+        sessionManager.makeLowLevelSession = { self.connect() }
+        sessionManager.serviceManager.protocolClasses = [ConfigurationProtocol.self]
+    }
+
+    func connect() -> Connection {
+        Connection(server: self)
+    }
+
+    /// The number of actions received, by action
+    var receivedActions: [String:Int] {
+        self.queue.sync { self.actions }
+    }
+
+    // MARK: - Network conditions
+
+    /// On the server's queue
+    private func latency() -> TimeInterval {
+        var latency = self.conditions.delay
+        if self.conditions.jitter > 0 {
+            latency += Double.random(in: 0...self.conditions.jitter, using: &self.generator)
+        }
+        if self.conditions.lossRate > 0, Double.random(in: 0..<1, using: &self.generator) < self.conditions.lossRate {
+            latency += self.conditions.retransmission
+        }
+        return latency
+    }
+
+    /// Message ids grow, and sort as text in the same order
+    private func nextMessageID() -> String {
+        self.lastMessageID += 1
+        return String(format: "%012d", self.lastMessageID)
+    }
+
+    // MARK: - Site configuration
+
+    private func siteConfiguration(for key: String) -> Data? {
+        let configuration = self.scenario.siteConfigurations[key] ?? ((key == LocalNinchatServer.configurationKey) ? [
+            "default": [
+                "audienceRealmId": self.scenario.realmID,
+                "audienceQueues": self.scenario.queues.keys.sorted()
+            ] as [String:Any]
+        ] : nil)
+        return configuration.flatMap { try? JSONSerialization.data(withJSONObject: $0) }
+    }
+
+    private static let registryLock = DispatchQueue(label: "com.ninchat.sdk.swift.local-server.registry")
+    private static var servers: [String:WeakServer] = [:]
+
+    private static func register(_ server: LocalNinchatServer) {
+        self.registryLock.sync { self.servers[server.address] = WeakServer(server: server) }
+    }
+
+    private static func unregister(_ address: String) {
+        self.registryLock.sync { self.servers[address] = nil }
+    }
+
+    fileprivate static func server(at host: String?) -> LocalNinchatServer? {
+        guard let host = host else { return nil }
+        return self.registryLock.sync { self.servers[host]?.server }
+    }
+}
+
+// MARK: - Connection
+
+extension LocalNinchatServer {
+    /// A client's connection, given to the session manager instead of the low level client's session
+    final class Connection: LowLevelClientSession {
+        private enum Event {
+            case session([String:Any])
+            case event([String:Any], payload: [Data], lastReply: Bool)
+        }
+
+        private let server: LocalNinchatServer
+        /// The rest is accessed on the server's queue
+        private weak var handler: LowLevelClientHandler?
+        private var address: String?
+        private var params: [String:Any] = [:]
+        private var isOpen = false
+        private var lastActionID = 0
+        private var userID = ""
+        private var channelID: String?
+        /// In the order they were sent
+        private var pending: [(deadline: UInt64, event: Event)] = []
+        private var lastDeadline: UInt64 = 0
+
+        fileprivate init(server: LocalNinchatServer) {
+            self.server = server
+        }
+
+        func setAddress(_ address: String?) {
+            self.server.queue.sync { self.address = address }
+        }
+
+        func setHeader(_ key: String?, value: String?) {}
+
+        func setParams(_ params: ClientProps) throws {
+            let values = try params.dictionary()
+            self.server.queue.sync { self.params = values }
+        }
+
+        func setHandler(_ handler: LowLevelClientHandler) {
+            self.server.queue.sync { self.handler = handler }
+        }
+
+        func open() throws {
+            self.server.queue.sync {
+                guard !self.isOpen else { return }
+                self.isOpen = true
+                self.createSession()
+            }
+        }
+
+        /// The handler is called once off the server's queue, as it may call back into the connection
+        func close() {
+            let handler: LowLevelClientHandler? = self.server.queue.sync {
+                guard self.isOpen else { return nil }
+                self.isOpen = false
+                self.pending.removeAll()
+                return self.handler
+            }
+            handler?.onClose()
+        }
+
+        func send(_ param: ClientProps, _ payload: ClientPayload?) throws -> Int {
+            let action = try param.dictionary()
+            let frames = payload ?? []
+
+            return try self.server.queue.sync {
+                guard self.isOpen else { throw NINSessionExceptions.noActiveSession }
+
+                self.lastActionID += 1
+                self.receive(action: action, actionID: self.lastActionID, payload: frames)
+                return self.lastActionID
+            }
+        }
+
+        // MARK: - Protocol
+
+        private func createSession() {
+            self.userID = self.params["user_id"] as? String ?? "local-user-\(UUID().uuidString.prefix(8).lowercased())"
+            self.emit(.session([
+                "event": Events.sessionCreated.rawValue,
+                "session_id": "local-session-\(UUID().uuidString.prefix(8).lowercased())",
+                "user_id": self.userID,
+                "user_auth": "local-auth",
+                "user_attrs": LocalNinchatServer.userAttributes(name: "Guest", guest: true)
+            ]))
+        }
+
+        private func receive(action: [String:Any], actionID: Int, payload: [Data]) {
+            let name = action["action"] as? String ?? ""
+            self.server.actions[name, default: 0] += 1
+
+            switch NINLowLevelClientActions(rawValue: name) {
+            case .describeRealmQueues?:
+                self.describeQueues(action["queue_ids"] as? [String], actionID: actionID)
+            case .requestAudience?:
+                self.requestAudience(queueID: action["queue_id"] as? String ?? "", actionID: actionID)
+            case .loadHistory?:
+                self.loadHistory(actionID: actionID)
+            case .sendMessage?:
+                self.emit(self.message(from: self.userID, type: action["message_type"] as? String ?? MessageType.text.rawValue, actionID: actionID), payload: payload)
+            case .describeFile?:
+                let fileID = action["file_id"] as? String ?? ""
+                self.emit(.event([
+                    "event": Events.fileFound.rawValue,
+                    "action_id": actionID,
+                    "file_id": fileID,
+                    "file_url": "https://\(self.server.address)/files/\(fileID)",
+                    "url_expiry": Date().timeIntervalSince1970 + 3600,
+                    "file_attrs": ["name": "\(fileID).jpg", "type": "image/jpeg", "size": 1024, "thumbnail": ["width": 200, "height": 100]] as [String:Any]
+                ], payload: [], lastReply: true))
+            case .updateMember?:
+                self.emit(.event([
+                    "event": Events.channelMemberUpdated.rawValue,
+                    "action_id": actionID,
+                    "channel_id": action["channel_id"] as? String ?? "",
+                    "user_id": action["user_id"] as? String ?? self.userID,
+                    "member_attrs": action["member_attrs"] ?? [String:Any]()
+                ], payload: [], lastReply: true))
+            case .partChannel?:
+                self.channelID = nil
+                self.emit(.event(["event": Events.channelParted.rawValue, "action_id": actionID, "channel_id": action["channel_id"] as? String ?? ""], payload: [], lastReply: true))
+            case .deleteUser?:
+                self.emit(.session(["event": Events.userDeleted.rawValue, "action_id": actionID, "user_id": self.userID]))
+            default:
+                self.emit(.event(["event": Events.error.rawValue, "action_id": actionID, "error_type": "action_not_supported", "error_reason": name], payload: [], lastReply: true))
+            }
+        }
+
+        private func describeQueues(_ queueIDs: [String]?, actionID: Int) {
+            let queues = self.server.scenario.queues.filter { queueIDs?.contains($0.key) ?? true }
+            self.emit(.event([
+                "event": Events.realmQueueFound.rawValue,
+                "action_id": actionID,
+                "realm_id": self.server.scenario.realmID,
+                "realm_queues": queues.mapValues { name -> [String:Any] in
+                    ["queue_attrs": ["name": name, "closed": false, "upload": "member"] as [String:Any], "queue_position": 0]
+                }
+            ], payload: [], lastReply: true))
+        }
+
+        private func requestAudience(queueID: String, actionID: Int) {
+            let scenario = self.server.scenario
+            guard scenario.queues[queueID] != nil else {
+                self.emit(.event(["event": Events.error.rawValue, "action_id": actionID, "error_type": "queue_not_found", "error_reason": queueID], payload: [], lastReply: true)); return
+            }
+
+            let positions = scenario.queuePositions.isEmpty ? [1] : scenario.queuePositions
+            self.emit(.event(["event": Events.audienceEnqueued.rawValue, "action_id": actionID, "queue_id": queueID, "queue_position": positions[0]], payload: [], lastReply: true))
+            positions.dropFirst().enumerated().forEach { index, position in
+                self.later(scenario.queueInterval * Double(index + 1)) {
+                    self.emit(.event(["event": Events.queueUpdated.rawValue, "action_id": 0, "queue_id": queueID, "queue_position": position], payload: [], lastReply: true))
+                }
+            }
+            self.later(scenario.queueInterval * Double(positions.count)) {
+                self.joinChannel(queueID: queueID)
+            }
+        }
+
+        private func joinChannel(queueID: String) {
+            let channelID = "local-channel-\(UUID().uuidString.prefix(8).lowercased())"
+            self.channelID = channelID
+            self.emit(.event([
+                "event": Events.channelJoined.rawValue,
+                "action_id": 0,
+                "channel_id": channelID,
+                "realm_id": self.server.scenario.realmID,
+                "channel_attrs": ["closed": false, "suspended": false, "queue_id": queueID] as [String:Any],
+                "channel_members": [
+                    LocalNinchatServer.agentID: ["user_attrs": LocalNinchatServer.userAttributes(name: "Agent", guest: false), "member_attrs": [String:Any]()],
+                    self.userID: ["user_attrs": LocalNinchatServer.userAttributes(name: "Guest", guest: true), "member_attrs": [String:Any]()]
+                ] as [String:[String:Any]]
+            ], payload: [], lastReply: true))
+
+            let scenario = self.server.scenario
+            scenario.agentMessages.enumerated().forEach { index, text in
+                self.later(scenario.agentInterval * Double(index + 1)) {
+                    guard self.channelID == channelID else { return }
+                    self.emit(self.message(from: LocalNinchatServer.agentID, type: MessageType.text.rawValue, actionID: 0), payload: [LocalNinchatServer.text(text)])
+                }
+            }
+        }
+
+        /// The history is sent newest first, each message with the number that still follow
+        private func loadHistory(actionID: Int) {
+            let length = self.server.scenario.historyLength
+            self.emit(.event(["event": Events.historyResult.rawValue, "action_id": actionID, "channel_id": self.channelID ?? "", "history_length": length], payload: [], lastReply: length == 0))
+
+            let now = Date().timeIntervalSince1970
+            let messageIDs = (0..<length).map { _ in self.server.nextMessageID() }.reversed()
+            messageIDs.enumerated().forEach { index, messageID in
+                let remaining = length - index - 1
+                let sender = (index % 2 == 0) ? LocalNinchatServer.agentID : self.userID
+                self.emit(.event([
+                    "event": Events.receivedMessage.rawValue,
+                    "action_id": actionID,
+                    "channel_id": self.channelID ?? "",
+                    "message_id": messageID,
+                    "message_user_id": sender,
+                    "message_time": now - Double(index),
+                    "message_type": MessageType.text.rawValue,
+                    "history_length": remaining
+                ], payload: [LocalNinchatServer.text("History message \(remaining + 1)")], lastReply: remaining == 0))
+            }
+        }
+
+        private func message(from userID: String, type: String, actionID: Int) -> [String:Any] {
+            [
+                "event": Events.receivedMessage.rawValue,
+                "action_id": actionID,
+                "channel_id": self.channelID ?? "",
+                "message_id": self.server.nextMessageID(),
+                "message_user_id": userID,
+                "message_time": Date().timeIntervalSince1970,
+                "message_type": type
+            ]
+        }
+
+        // MARK: - Delivery
+
+        private func emit(_ params: [String:Any], payload: [Data]) {
+            self.emit(.event(params, payload: payload, lastReply: true))
+        }
+
+        /// Sends the event over the simulated network; on the server's queue
+        private func emit(_ event: Event) {
+            let deadline = max(DispatchTime.now().uptimeNanoseconds + UInt64(self.server.latency() * 1_000_000_000), self.lastDeadline)
+            self.lastDeadline = deadline
+            self.pending.append((deadline, event))
+
+            self.server.queue.asyncAfter(deadline: DispatchTime(uptimeNanoseconds: deadline)) { [weak self] in
+                self?.flush()
+            }
+        }
+
+        /// Timers of equal deadlines may fire in any order, so the due events are taken from the front
+        private func flush() {
+            let now = DispatchTime.now().uptimeNanoseconds
+            while let first = self.pending.first, first.deadline <= now {
+                self.pending.removeFirst()
+                self.deliver(first.event)
+            }
+        }
+
+        private func deliver(_ event: Event) {
+            guard self.isOpen, let handler = self.handler else { return }
+
+            switch event {
+            case .session(let params):
+                handler.onSessionEvent(ClientProps.local(params))
+            case .event(let params, let payload, let lastReply):
+                handler.onEvent(ClientProps.local(params), payload: payload, lastReply: lastReply)
+            }
+        }
+
+        /// Runs on the server's queue after the scenario's interval, unless the connection is closed
+        private func later(_ interval: TimeInterval, _ block: @escaping () -> Void) {
+            self.server.queue.asyncAfter(deadline: .now() + interval) { [weak self] in
+                guard self?.isOpen ?? false else { return }
+                block()
+            }
+        }
+    }
+
+    fileprivate static let agentID = "local-agent"
+
+    fileprivate static func userAttributes(name: String, guest: Bool) -> [String:Any] {
+        ["name": name, "realname": name, "iconurl": "", "guest": guest]
+    }
+
+    fileprivate static func text(_ text: String) -> Data {
+        (try? JSONSerialization.data(withJSONObject: ["text": text])) ?? Data()
+    }
+}
+
+// MARK: - Site configuration endpoint
+
+extension LocalNinchatServer {
+    /// Answers `https://<address>/config/<key>` for the servers in this process
+    final class ConfigurationProtocol: URLProtocol {
+        override class func canInit(with request: URLRequest) -> Bool {
+            LocalNinchatServer.server(at: request.url?.host) != nil
+        }
+
+        override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+            request
+        }
+
+        override func startLoading() {
+            guard let url = self.request.url, let server = LocalNinchatServer.server(at: url.host) else {
+                self.client?.urlProtocol(self, didFailWithError: URLError(.cannotFindHost)); return
+            }
+
+            let components = url.pathComponents
+            let configuration = (components.count == 3 && components[1] == "config") ? server.siteConfiguration(for: components[2]) : nil
+            let latency = server.queue.sync { server.latency() }
+
+            server.queue.asyncAfter(deadline: .now() + latency) {
+                let response = HTTPURLResponse(url: url, statusCode: (configuration == nil) ? 404 : 200, httpVersion: "HTTP/1.1", headerFields: ["Content-Type": "application/json"])!
+                self.client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+                self.client?.urlProtocol(self, didLoad: configuration ?? Data())
+                self.client?.urlProtocolDidFinishLoading(self)
+            }
+        }
+
+        override func stopLoading() {}
+    }
+}
+
+// MARK: - Test fixture
+
+extension XCTestCase {
+    /// Opens a session on the server and waits in the default queue until its channel is joined.
+    /// Returns the queue positions reported on the way.
+    @discardableResult
+    func joinQueue(_ sessionManager: NINChatSessionManagerImpl, on server: LocalNinchatServer) throws -> [Int] {
+        server.install(in: sessionManager)
+
+        let fetched = self.expectation(description: "Expected the configuration to be fetched")
+        sessionManager.fetchSiteConfiguration(config: LocalNinchatServer.configurationKey, environments: nil) { _ in fetched.fulfill() }
+        wait(for: [fetched], timeout: 2.0)
+
+        let opened = self.expectation(description: "Expected the session to be created")
+        try sessionManager.openSession { credentials, _, error in
+            XCTAssertNil(error)
+            XCTAssertNotNil(credentials)
+            opened.fulfill()
+        }
+        wait(for: [opened], timeout: 2.0)
+
+        let described = self.expectation(description: "Expected the queues to be described")
+        try sessionManager.describe(queuesID: sessionManager.siteConfiguration.audienceQueues) { error in
+            XCTAssertNil(error)
+            described.fulfill()
+        }
+        wait(for: [described], timeout: 2.0)
+
+        var positions: [Int] = []
+        let joined = self.expectation(description: "Expected the channel to be joined")
+        try sessionManager.join(queue: "local-queue", progress: { _, _, position in positions.append(position) }, completion: { joined.fulfill() })
+        wait(for: [joined], timeout: 2.0)
+        return positions
+    }
+
+    func wait(until condition: @escaping () -> Bool, _ description: String, timeout: TimeInterval = 5.0) {
+        let expect = self.expectation(for: NSPredicate { _, _ in condition() }, evaluatedWith: nil)
+        expect.expectationDescription = description
+        wait(for: [expect], timeout: timeout)
+    }
+}
+
+// MARK: - Helpers
+
+private struct WeakServer {
+    weak var server: LocalNinchatServer?
+}
+
+/// SplitMix64, so the simulated network repeats for a seed
+private struct SeededGenerator: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        self.state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        self.state &+= 0x9E3779B97F4A7C15
+        var value = self.state
+        value = (value ^ (value >> 30)) &* 0xBF58476D1CE4E5B9
+        value = (value ^ (value >> 27)) &* 0x94D049BB133111EB
+        return value ^ (value >> 31)
+    }
+}
+
+private extension ClientProps {
+    static func local(_ values: [String:Any]) -> ClientProps {
+        guard let data = try? JSONSerialization.data(withJSONObject: values) else { return ClientProps() }
+        return (try? ClientProps(json: String(decoding: data, as: UTF8.self))) ?? ClientProps()
+    }
+
+    func dictionary() throws -> [String:Any] {
+        (try JSONSerialization.jsonObject(with: Data(self.json.utf8))) as? [String:Any] ?? [:]
+    }
+}
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class LocalNinchatServerTests: XCTestCase {
+    private var sessionManager: NINChatSessionManagerImpl!
+
+    override func setUp() {
+        sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+    }
+
+    func test_site_configuration_is_served() {
+        let server = LocalNinchatServer(conditions: LocalNinchatServer.Conditions(delay: 0.01))
+        server.install(in: sessionManager)
+
+        let expect = self.expectation(description: "Expected the configuration to be fetched")
+        sessionManager.fetchSiteConfiguration(config: LocalNinchatServer.configurationKey, environments: nil) { error in
+            XCTAssertNil(error)
+            XCTAssertEqual(self.sessionManager.siteConfiguration.audienceRealm, "local-realm")
+            XCTAssertEqual(self.sessionManager.siteConfiguration.audienceQueues, ["local-queue"])
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+    }
+
+    func test_unknown_site_configuration_is_not_found() {
+        let server = LocalNinchatServer()
+        server.install(in: sessionManager)
+
+        let expect = self.expectation(description: "Expected the configuration to be missing")
+        sessionManager.fetchSiteConfiguration(config: "unknown", environments: nil) { error in
+            guard case ServiceResultError.invalidStatusCode(404)? = error as? ServiceResultError else { XCTFail("Unexpected error: \(String(describing: error))"); return }
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+    }
+
+    func test_queue_churn_until_the_channel_is_joined() throws {
+        let server = LocalNinchatServer(scenario: LocalNinchatServer.Scenario(queuePositions: [3, 2, 1], queueInterval: 0.01), conditions: LocalNinchatServer.Conditions(delay: 0.005, jitter: 0.005))
+        XCTAssertEqual(try joinQueue(sessionManager, on: server), server.scenario.queuePositions)
+        XCTAssertNotNil(sessionManager.currentChannelID)
+        XCTAssertEqual(server.receivedActions["request_audience"], 1)
+    }
+
+    func test_history_and_messages_are_received() throws {
+        let server = LocalNinchatServer(scenario: LocalNinchatServer.Scenario(historyLength: 50), conditions: LocalNinchatServer.Conditions(delay: 0.001))
+        try joinQueue(sessionManager, on: server)
+
+        try sessionManager.loadHistory { _ in }
+        wait(until: { self.textMessages == 50 }, "Expected the history to be loaded")
+
+        try sessionManager.send(message: "Hello") { _ in }
+        wait(until: { self.textMessages == 51 }, "Expected the message to be echoed")
+        XCTAssertEqual(sessionManager.chatMessages.compactMap({ $0 as? TextMessage }).first?.content, "Hello")
+    }
+
+    func test_events_keep_their_order_under_jitter_and_loss() throws {
+        let server = LocalNinchatServer(conditions: LocalNinchatServer.Conditions(delay: 0.01, jitter: 0.02, lossRate: 0.2, retransmission: 0.05))
+        let handler = RecordingHandler()
+        let connection = server.connect()
+        connection.setHandler(handler)
+        try connection.open()
+
+        let started = Date()
+        let actionIDs = try (0..<20).map { _ in try connection.send(ClientProps.initiate(action: .describeRealmQueues)) }
+        wait(until: { handler.actionIDs.count == actionIDs.count }, "Expected every action to be answered")
+
+        XCTAssertEqual(handler.actionIDs, actionIDs)
+        XCTAssertGreaterThanOrEqual(Date().timeIntervalSince(started), 0.01)
+        XCTAssertEqual(handler.sessionEvents, ["session_created"])
+        XCTAssertEqual(server.receivedActions["describe_realm_queues"], 20)
+    }
+}
+
+extension LocalNinchatServerTests {
+    private var textMessages: Int {
+        sessionManager.chatMessages.filter { $0 is TextMessage }.count
+    }
+}
+
+/// Records the events of a connection, in the order they arrive
+private final class RecordingHandler: NSObject, LowLevelClientHandler {
+    private let lock = DispatchQueue(label: "com.ninchat.sdk.swift.tests.recording-handler")
+    private var events: [String] = []
+    private var replies: [Int] = []
+
+    var sessionEvents: [String] {
+        lock.sync { events }
+    }
+
+    var actionIDs: [Int] {
+        lock.sync { replies }
+    }
+
+    func onSessionEvent(_ params: ClientProps) {
+        guard let event = params.event.optional else { return }
+        lock.sync { events.append(event) }
+    }
+
+    func onEvent(_ params: ClientProps, payload: ClientPayload, lastReply: Bool) {
+        guard let actionID = params.actionID.optional else { return }
+        lock.sync { replies.append(actionID) }
+    }
+
+    func onClose() {}
+
+    func onLog(_ msg: String) {}
+
+    func onConnState(_ state: String) {}
+}
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class LowLevelClientSessionTests: XCTestCase {
+    private var client: FakeLowLevelClientSession!
+    private var sessionManager: NINChatSessionManagerImpl!
+
+    override func setUp() {
+        client = FakeLowLevelClientSession()
+        sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "api.ninchat.com", configuration: nil)
+        sessionManager.makeLowLevelSession = { self.client }
+        sessionManager.siteConfiguration = SiteConfigurationImpl(configuration: ["default": ["audienceRealmId": "realm-1"]], environments: nil)
+    }
+
+    func test_open_session_configures_the_client() throws {
+        try sessionManager.openSession { _, _, _ in }
+
+        XCTAssertTrue(client.isOpen)
+        XCTAssertEqual(client.address, "api.ninchat.com")
+        XCTAssertTrue(client.headers["User-Agent"]?.hasPrefix("ninchat-sdk-ios") ?? false)
+        XCTAssertNotNil(client.handler)
+        XCTAssertEqual(sessionManager.realmID, "realm-1")
+    }
+
+    func test_session_created_event_completes_opening() throws {
+        let expect = self.expectation(description: "Expected the session to be created")
+        try sessionManager.openSession { credentials, _, error in
+            XCTAssertNil(error)
+            XCTAssertEqual(credentials?.userID, "user-1")
+            XCTAssertEqual(credentials?.sessionID, "session-1")
+            expect.fulfill()
+        }
+
+        var event = ClientProps.initiate()
+        event.set(value: "session_created", forKey: "event")
+        event.set(value: "user-1", forKey: "user_id")
+        event.set(value: "auth-1", forKey: "user_auth")
+        event.set(value: "session-1", forKey: "session_id")
+        client.handler?.onSessionEvent(event)
+
+        waitForExpectations(timeout: 1.0)
+    }
+
+    func test_actions_are_sent_to_the_client() throws {
+        try sessionManager.openSession { _, _, _ in }
+        try sessionManager.describe(queuesID: ["queue-1"]) { _ in }
+
+        let action = try XCTUnwrap(client.sent.last)
+        let name: NINResult<String> = action.get(forKey: "action")
+        XCTAssertEqual(name.value, "describe_realm_queues")
+        XCTAssertEqual(action.realmID.value, "realm-1")
+        XCTAssertEqual(client.sent.count, 1)
+    }
+
+    func test_disconnect_closes_the_client() throws {
+        try sessionManager.openSession { _, _, _ in }
+        sessionManager.disconnect()
+
+        XCTAssertFalse(client.isOpen)
+        XCTAssertNil(sessionManager.session)
+    }
+
+    func test_reset_drops_the_session_state() throws {
+        try sessionManager.openSession { _, _, _ in }
+        let queue = Queue(queueID: "queue-1", name: "Queue", isClosed: false, permissions: QueuePermissions(upload: false), position: 0)
+        sessionManager.queueRegistry.insert(queue)
+        sessionManager.currentQueueID = queue.queueID
+        sessionManager.describedQueue = queue
+        sessionManager.myUserID = "user-1"
+
+        var bound = 0
+        sessionManager.bindQueueUpdate(closure: { _, _, _ in bound += 1 }, to: self)
+        sessionManager.resetSession()
+
+        XCTAssertFalse(client.isOpen)
+        XCTAssertNil(sessionManager.session)
+        XCTAssertEqual(sessionManager.queueRegistry.count, 0)
+        XCTAssertNil(sessionManager.currentQueueID)
+        XCTAssertNil(sessionManager.describedQueue)
+        XCTAssertNil(sessionManager.myUserID)
+
+        /// The views stay bound for the next session
+        sessionManager.queueRegistry.notify(.queueUpdated, queue: queue, error: nil)
+        XCTAssertEqual(bound, 1)
+    }
+}
+
+extension LowLevelClientSessionTests: QueueUpdateCapture {
+    var desc: String {
+        "LowLevelClientSessionTests"
+    }
+}
+
+/// Records what the session manager asks from the low level client
+private final class FakeLowLevelClientSession: LowLevelClientSession {
+    private(set) var address: String?
+    private(set) var headers: [String:String] = [:]
+    private(set) var params: ClientProps?
+    private(set) var handler: LowLevelClientHandler?
+    private(set) var isOpen = false
+    private(set) var sent: [ClientProps] = []
+
+    func setAddress(_ address: String?) {
+        self.address = address
+    }
+
+    func setHeader(_ key: String?, value: String?) {
+        guard let key = key else { return }
+        self.headers[key] = value
+    }
+
+    func setParams(_ params: ClientProps) throws {
+        self.params = params
+    }
+
+    func setHandler(_ handler: LowLevelClientHandler) {
+        self.handler = handler
+    }
+
+    func open() throws {
+        self.isOpen = true
+    }
+
+    func close() {
+        self.isOpen = false
+    }
+
+    func send(_ param: ClientProps, _ payload: ClientPayload?) throws -> Int {
+        self.sent.append(param)
+        return self.sent.count
+    }
+}
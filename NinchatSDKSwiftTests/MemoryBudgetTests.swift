@@ -0,0 +1,83 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+/// Long synthetic sessions against `LocalNinchatServer`, checking what the SDK keeps against budgets
+final class MemoryBudgetTests: XCTestCase {
+    private enum Budget {
+        /// Physical footprint added by the messages, models and views' data included
+        static let residentBytesPerThousandMessages = 8 * 1024 * 1024
+        /// Closures bound to actions that were answered
+        static let pendingActionClosures = 0
+    }
+
+    private var sessionManager: NINChatSessionManagerImpl!
+    private var server: LocalNinchatServer!
+
+    override func setUpWithError() throws {
+        sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        server = LocalNinchatServer(conditions: LocalNinchatServer.Conditions(delay: 0.001))
+        try joinQueue(sessionManager, on: server)
+    }
+
+    override func tearDown() {
+        sessionManager.deallocateSession()
+        sessionManager = nil
+        server = nil
+    }
+
+    func test_resident_memory_per_thousand_messages() throws {
+        /// Warm up, so the caches and the first allocations are not counted
+        try drive(messages: 100, writing: 0, files: 0)
+
+        let before = residentMemory
+        try drive(messages: 2_000, writing: 0, files: 0)
+        let perThousand = (residentMemory - before) / 2
+
+        XCTAssertLessThanOrEqual(perThousand, Budget.residentBytesPerThousandMessages, "\(perThousand / 1024) kB per 1k messages")
+    }
+
+    func test_pending_closures_do_not_grow() throws {
+        try (0..<3).forEach { round in
+            try drive(messages: 500, writing: 500, files: 100)
+            XCTAssertLessThanOrEqual(sessionManager.pendingActionClosures, Budget.pendingActionClosures, "After round \(round)")
+        }
+        XCTAssertEqual(server.receivedActions["describe_file"], 300)
+    }
+}
+
+extension MemoryBudgetTests {
+    /// Physical footprint of the process, as the system accounts it against the app's memory limit
+    private var residentMemory: Int {
+        ProcessInfo.processInfo.memoryFootprint.map { Int($0) } ?? 0
+    }
+
+    /// Sends the messages, typing updates and file lookups, and waits for every one to be answered
+    private func drive(messages: Int, writing: Int, files: Int) throws {
+        var answered = 0
+        let expected = messages + writing + files
+        let messageCount = sessionManager.chatMessages.count
+
+        try (0..<messages).forEach { index in
+            try sessionManager.send(message: "Message \(messageCount + index)") { _ in answered += 1 }
+        }
+        try (0..<writing).forEach { index in
+            try sessionManager.update(isWriting: index % 2 == 0) { _ in answered += 1 }
+        }
+        try (0..<files).forEach { index in
+            try sessionManager.describe(file: "file-\(index)") { _, _ in answered += 1 }
+        }
+
+        wait(until: { answered == expected }, "Expected \(expected) actions to be answered", timeout: 60.0)
+        XCTAssertEqual(sessionManager.chatMessages.count, messageCount + messages)
+    }
+}
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class MessageSearchIndexTests: XCTestCase {
+    private var index: MessageSearchIndex!
+
+    override func setUp() {
+        index = MessageSearchIndex()
+    }
+
+    func test_terms() {
+        XCTAssertEqual(MessageSearchIndex.terms(in: "Hyvää päivää, Åsa!"), ["hyvaa", "paivaa", "asa"])
+        XCTAssertEqual(MessageSearchIndex.terms(in: "report_2026-10.pdf"), ["report", "2026", "10", "pdf"])
+        XCTAssertTrue(MessageSearchIndex.terms(in: " .,- ").isEmpty)
+    }
+
+    func test_prefix_and_diacritics() {
+        index.index(message("1", "Hyvää päivää"))
+        index.index(message("2", "Good morning"))
+        index.index(message("3", "Päivällä tavataan"))
+
+        XCTAssertEqual(index.search("paiv"), ["3", "1"])
+        XCTAssertEqual(index.search("PÄIVÄÄ"), ["1"])
+        XCTAssertEqual(index.search("good morn"), ["2"])
+        XCTAssertTrue(index.search("good evening").isEmpty)
+        XCTAssertTrue(index.search("").isEmpty)
+    }
+
+    func test_attachment_names() {
+        let file = FileInfo(fileID: "file", name: "Lääkärintodistus.pdf", mimeType: "application/pdf", size: 1024)
+        index.index(TextMessage(timestamp: Date(), messageID: "1", mine: true, sender: nil, content: nil, attachment: file))
+
+        XCTAssertEqual(index.search("laakari"), ["1"])
+        XCTAssertEqual(index.search("pdf"), ["1"])
+    }
+
+    func test_updates_and_deletes() {
+        index.index(message("1", "first answer"))
+        index.index(message("2", "second answer"))
+
+        index.index(TextMessage(timestamp: Date(), messageID: "1", mine: false, sender: nil, content: "first answer", attachment: nil, isDeleted: true))
+        XCTAssertEqual(index.search("answer"), ["2"], "Expected a deleted message not to be found")
+
+        index.remove(messageID: "2")
+        XCTAssertTrue(index.search("answer").isEmpty)
+        XCTAssertEqual(index.count, 0)
+
+        index.index(message("3", "another answer"))
+        XCTAssertEqual(index.search("ans"), ["3"])
+    }
+
+    func test_limit_keeps_the_most_recent() {
+        (0..<200).forEach { index.index(message(String(format: "%04d", $0), "Message \($0)")) }
+
+        XCTAssertEqual(index.search("message", limit: 3), ["0199", "0198", "0197"])
+        XCTAssertEqual(index.search("message 19", limit: 100).count, 11, "Expected 19 and 190 to 199")
+    }
+
+    func test_applies_the_store_diffs() {
+        let store = ChatMessageStore()
+        func update(_ transform: (inout [ChatMessage]) -> Void) {
+            let previous = store.snapshot
+            let (snapshot, diff) = store.update(transform)
+            index.apply(diff, from: previous, to: snapshot)
+        }
+
+        update { $0 = [message("2", "kiitos"), message("1", "hei")] }
+        XCTAssertEqual(index.search("kiitos"), ["2"])
+
+        update { $0.remove(at: 0) }
+        XCTAssertTrue(index.search("kiitos").isEmpty)
+        XCTAssertEqual(index.search("hei"), ["1"])
+    }
+
+    func test_codable() throws {
+        index.index(message("1", "Hyvää päivää"))
+        index.index(message("2", "Good day"))
+
+        var decoded = try JSONDecoder().decode(MessageSearchIndex.self, from: try JSONEncoder().encode(index))
+        XCTAssertEqual(decoded.count, 2)
+        XCTAssertEqual(decoded.search("pai"), ["1"])
+        XCTAssertEqual(decoded.search("day"), ["2"])
+    }
+
+    func test_session_manager_keeps_the_index() {
+        let sessionManager = NINChatSessionManagerImpl(session: nil, serverAddress: "", configuration: nil)
+        sessionManager.add(message: message("1", "Ennen indeksointia"))
+        XCTAssertTrue(sessionManager.searchMessages(matching: "ennen", limit: 10).isEmpty)
+
+        sessionManager.indexesMessages = true
+        XCTAssertEqual(sessionManager.searchMessages(matching: "ennen", limit: 10), ["1"])
+
+        sessionManager.add(message: message("2", "Uusi viesti"))
+        XCTAssertEqual(sessionManager.searchMessages(matching: "uus", limit: 10), ["2"])
+
+        sessionManager.removeMessage(atIndex: 0)
+        XCTAssertTrue(sessionManager.searchMessages(matching: "uus", limit: 10).isEmpty)
+    }
+}
+
+extension MessageSearchIndexTests {
+    private func message(_ id: String, _ text: String) -> TextMessage {
+        TextMessage(timestamp: Date(), messageID: id, mine: false, sender: nil, content: text, attachment: nil)
+    }
+}
@@ -113,9 +113,7 @@ extension NINChatViewModelTests {
     }
     
     private func simulateChatQueue() {
-        (sessionManager as! NINChatSessionManagerImpl).queueUpdateBoundClosures.forEach {
-            $0.value(.audienceEnqueued, Queue(queueID: "1", name: "Name", isClosed: false, permissions: QueuePermissions(upload: false), position: 0), nil)
-        }
+        sessionManager.queueRegistry.notify(.audienceEnqueued, queue: Queue(queueID: "1", name: "Name", isClosed: false, permissions: QueuePermissions(upload: false), position: 0), error: nil)
     }
     
     private func simulateChatInsertMessage() {
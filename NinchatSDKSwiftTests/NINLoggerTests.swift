@@ -0,0 +1,85 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class NINLoggerTests: XCTestCase {
+    private var logger: NINLogger!
+    private var evaluations = 0
+
+    override func setUp() {
+        logger = NINLogger(capacity: 3)
+        logger.minimumLevel = .debug
+        logger.printsToConsole = false
+        evaluations = 0
+    }
+
+    func test_ring_buffer_keeps_latest() {
+        var buffer = NINRingBuffer<Int>(capacity: 3)
+        (1...5).forEach { buffer.append($0) }
+        XCTAssertEqual(buffer.count, 3)
+        XCTAssertEqual(buffer.elements, [3, 4, 5])
+
+        buffer.removeAll()
+        buffer.append(6)
+        XCTAssertEqual(buffer.elements, [6])
+    }
+
+    func test_entries_are_bounded() {
+        (1...5).forEach { logger.debug(.event, "message \($0)") }
+        XCTAssertEqual(logger.entries.map { $0.message }, ["message 3", "message 4", "message 5"])
+        XCTAssertEqual(logger.dump().components(separatedBy: "\n").count, 3)
+    }
+
+    func test_level_below_minimum_is_not_evaluated() {
+        logger.minimumLevel = .info
+        logger.debug(.event, self.message())
+        XCTAssertEqual(evaluations, 0)
+        XCTAssertTrue(logger.entries.isEmpty)
+
+        logger.info(.event, self.message())
+        XCTAssertEqual(evaluations, 1)
+        XCTAssertEqual(logger.entries.first?.level, .info)
+    }
+
+    func test_disabled_category_is_not_evaluated() {
+        logger.categories = [.rtc]
+        logger.error(.event, self.message())
+        XCTAssertEqual(evaluations, 0)
+
+        logger.error(.rtc, self.message())
+        XCTAssertEqual(evaluations, 1)
+        XCTAssertEqual(logger.entries.first?.category, .rtc)
+    }
+
+    func test_disabled_logger_is_not_evaluated() {
+        logger.isEnabled = false
+        logger.error(.event, self.message())
+        logger.log(.error, .event, self.message(), output: { _ in XCTFail("output of a disabled logger") })
+        XCTAssertEqual(evaluations, 0)
+        XCTAssertTrue(logger.entries.isEmpty)
+    }
+
+    func test_output_receives_message() {
+        var output: [String] = []
+        logger.log(.info, .session, self.message(), output: { output.append($0) })
+        XCTAssertEqual(output, ["message"])
+        XCTAssertEqual(evaluations, 1)
+        XCTAssertEqual(logger.entries.count, 1)
+    }
+}
+
+extension NINLoggerTests {
+    private func message() -> String {
+        evaluations += 1
+        return "message"
+    }
+}
@@ -5,15 +5,14 @@
 //
 
 import XCTest
-import NinchatLowLevelClient
 @testable import NinchatSDKSwift
 
 final class NINQuestionnaireViewModelTests: XCTestCase {
     private lazy var questionnaire_preAudience: AudienceQuestionnaire = {
         AudienceQuestionnaire(from: try! openAsset(forResource: "questionnaire-mock"), for: "preAudienceQuestionnaire")
     }()
-    private lazy var answers: NINLowLevelClientProps = {
-        NINLowLevelClientProps.initiate(preQuestionnaireAnswers: ["pre-answer1": "1", "pre-answer2": "2", "Phone":"+358123456789"])
+    private lazy var answers: ClientProps = {
+        ClientProps.initiate(preQuestionnaireAnswers: ["pre-answer1": "1", "pre-answer2": "2", "Phone":"+358123456789"])
     }()
     private lazy var session: NINChatSessionManagerImpl! = {
         let siteConfiguration = SiteConfigurationImpl(configuration: try! openAsset(forResource: "site-configuration-mock"), environments: ["default"])
@@ -165,7 +164,7 @@ final class NINQuestionnaireViewModelTests: XCTestCase {
         self.viewModel?.pageNumber = 0
         XCTAssertTrue(self.viewModel?.shouldWaitForNextButton ?? false)
 
-        let element = self.connector.items.compactMap({ $0.elements }).first(where: { $0.first(where: { $0.questionnaireConfiguration?.name == "Aiheet" }) != nil })?.first
+        let element = self.element(named: "Aiheet")
         XCTAssertNotNil(element)
 
         self.viewModel?.answers = ["Aiheet": "Mikä on koronavirus"]
@@ -185,7 +184,7 @@ final class NINQuestionnaireViewModelTests: XCTestCase {
             expect.fulfill()
         }
 
-        let element = self.connector.items.compactMap({ $0.elements }).first(where: { $0.first(where: { $0.questionnaireConfiguration?.name == "audienceCompletedText" }) != nil })?.first
+        let element = self.element(named: "audienceCompletedText")
         XCTAssertNotNil(element)
 
         let page = self.viewModel?.redirectTargetPage(element!)
@@ -205,7 +204,7 @@ final class NINQuestionnaireViewModelTests: XCTestCase {
             expect.fulfill()
         }
 
-        let element = self.connector.items.compactMap({ $0.elements }).first(where: { $0.first(where: { $0.questionnaireConfiguration?.name == "audienceRegisteredText" }) != nil })?.first
+        let element = self.element(named: "audienceRegisteredText")
         XCTAssertNotNil(element)
 
         let page = self.viewModel?.redirectTargetPage(element!)
@@ -380,3 +379,12 @@ final class NINQuestionnaireViewModelTests: XCTestCase {
         waitForExpectations(timeout: 2.0)
     }
 }
+
+extension NINQuestionnaireViewModelTests {
+    /// The connector only keeps the pages, the views are created for the page the element belongs to
+    private func element(named name: String) -> QuestionnaireElement? {
+        let parser = QuestionnaireParser(configurations: self.connector.configurations, style: .conversation)
+        guard let page = self.connector.pages.first(where: { $0.configuration.name == name }) else { return nil }
+        return parser.elements(for: page).first
+    }
+}
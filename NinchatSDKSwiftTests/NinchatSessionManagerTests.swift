@@ -5,7 +5,6 @@
 //
 
 import XCTest
-import NinchatLowLevelClient
 @testable import NinchatSDKSwift
 
 // MARK: - Tests
@@ -16,7 +15,7 @@ class NinchatSessionManagerTests: XCTestCase {
     
     override func setUp() {
         sessionSwift = NINChatSession(configKey: "")
-        sessionManager = NINChatSessionManagerImpl(session: sessionSwift, serverAddress: "", audienceMetadata: NINLowLevelClientProps.initiate(metadata: ["metadata":"value"]) ,configuration: nil)
+        sessionManager = NINChatSessionManagerImpl(session: sessionSwift, serverAddress: "", audienceMetadata: ClientProps.initiate(metadata: ["metadata":"value"]) ,configuration: nil)
         (sessionManager as! NINChatSessionManagerImpl).setSiteConfiguration(SiteConfigurationImpl(configuration: try! openAsset(forResource: "site-configuration-mock"), environments: ["fi-restart"]))
     }
 
@@ -139,6 +138,42 @@ class NinchatSessionManagerPrivateTests: XCTestCase {
         self.simulateRemoveMessage(at: 3) /// message_id = 2
         waitForExpectations(timeout: 5.0)
     }
+
+    func testMessages_Snapshots() {
+        self.simulateAddMessage(id: 1)
+        let version = self.sessionManager.messageSnapshot.version
+
+        let expect = self.expectation(description: "Expected to get the next version with its diff")
+        self.sessionManager.onMessagesChanged = { snapshot, diff in
+            XCTAssertEqual(diff.from, version)
+            XCTAssertEqual(diff.to, snapshot.version)
+            XCTAssertEqual(diff.inserted, [0])
+            XCTAssertEqual(snapshot.messages.map { $0.messageID }, ["2", "1"])
+            expect.fulfill()
+        }
+        self.simulateAddMessage(id: 2)
+        waitForExpectations(timeout: 5.0)
+    }
+
+    func testMessages_FilePlaceholder() throws {
+        let file: [String:Any] = ["file_id": "file", "file_attrs": ["name": "image.png", "type": "image/png", "size": 1024, "thumbnail": ["width": 200, "height": 100]]]
+        let payload = [try JSONSerialization.data(withJSONObject: ["files": [file]])]
+
+        /// The file is not described yet, but the message should be added anyway
+        let expect = self.expectation(description: "The file message should be added before it is described")
+        self.sessionManager.onMessageAdded = { index in
+            XCTAssertEqual(index, 0)
+
+            let attachment = (self.sessionManager.chatMessages.first as? TextMessage)?.attachment
+            XCTAssertNotNil(attachment)
+            XCTAssertNil(attachment?.url)
+            XCTAssertEqual(attachment?.aspectRatio, 2.0)
+            expect.fulfill()
+        }
+
+        try self.sessionManager.handleInbound(message: "1", user: nil, time: Date().timeIntervalSince1970, actionID: 0, remained: .success(0), payload: payload)
+        waitForExpectations(timeout: 5.0)
+    }
 }
 
 extension NinchatSessionManagerPrivateTests {
@@ -240,9 +275,7 @@ class NinchatSessionManagerClosureHandlersTests: XCTestCase {
 
 extension NinchatSessionManagerClosureHandlersTests {
     private func simulateChatQueue() {
-        sessionManager.queueUpdateBoundClosures.forEach {
-            $0.value(.audienceEnqueued, Queue(queueID: "1", name: "Name", isClosed: false, permissions: QueuePermissions(upload: false), position: 0), NINExceptions.mainThread)
-        }
+        sessionManager.queueRegistry.notify(.audienceEnqueued, queue: Queue(queueID: "1", name: "Name", isClosed: false, permissions: QueuePermissions(upload: false), position: 0), error: NINExceptions.mainThread)
     }
 }
 
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+@testable import NinchatSDKSwift
+
+final class QuestionnaireElementCacheTests: XCTestCase {
+    private var created: [Int] = []
+
+    override func setUp() {
+        created = []
+    }
+
+    func test_reuse() {
+        let cache = self.cache(capacity: 2)
+        let first = cache.elements(at: 0)
+        let second = cache.elements(at: 0)
+
+        XCTAssertEqual(created, [0])
+        XCTAssertTrue(first?.first === second?.first)
+    }
+
+    func test_eviction() {
+        let cache = self.cache(capacity: 2)
+        _ = cache.elements(at: 0)
+        _ = cache.elements(at: 1)
+        /// Touching the first page keeps it
+        _ = cache.elements(at: 0)
+        _ = cache.elements(at: 2)
+
+        XCTAssertEqual(cache.count, 2)
+        XCTAssertTrue(cache.contains(page: 0))
+        XCTAssertFalse(cache.contains(page: 1))
+        XCTAssertEqual(created, [0, 1, 2])
+    }
+
+    func test_logic_pages() {
+        let cache = self.cache(capacity: 2)
+        XCTAssertNil(cache.elements(at: -1))
+        XCTAssertEqual(cache.count, 0)
+    }
+
+    func test_prefetch() {
+        let cache = self.cache(capacity: 2)
+        cache.prefetch(page: 1)
+        XCTAssertFalse(cache.contains(page: 1))
+
+        let expect = self.expectation(description: "Expected the page to be created on the next run loop")
+        DispatchQueue.main.async {
+            XCTAssertTrue(cache.contains(page: 1))
+            _ = cache.elements(at: 1)
+            XCTAssertEqual(self.created, [1])
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+    }
+}
+
+extension QuestionnaireElementCacheTests {
+    private func cache(capacity: Int) -> QuestionnaireElementCache {
+        QuestionnaireElementCache(capacity: capacity) { [unowned self] page in
+            guard page >= 0 else { return nil }
+            self.created.append(page)
+            return [QuestionnaireElementText(frame: .zero)]
+        }
+    }
+}
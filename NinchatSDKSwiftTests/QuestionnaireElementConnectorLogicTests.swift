@@ -43,8 +43,7 @@ final class QuestionnaireElementConnectorLogicTests: XCTestCase {
         XCTAssertNotNil(targetElement.0)
         XCTAssertNotNil(targetElement.1)
 
-        XCTAssertEqual(targetElement.0?.count, 1)
-        XCTAssertNotNil(targetElement.0?.first as? QuestionnaireElementRadio)
+        XCTAssertEqual(targetElement.0?.elementTypes, [.radio])
         XCTAssertEqual(targetElement.1, 0)
     }
 
@@ -80,9 +79,7 @@ final class QuestionnaireElementConnectorLogicTests: XCTestCase {
         XCTAssertNotNil(targetElement.0)
         XCTAssertNotNil(targetElement.1)
 
-        XCTAssertEqual(targetElement.0?.count, 2)
-        XCTAssertNotNil(targetElement.0?[0] as? QuestionnaireElementText)
-        XCTAssertNotNil(targetElement.0?[1] as? QuestionnaireElementRadio)
+        XCTAssertEqual(targetElement.0?.elementTypes, [.text, .radio])
         XCTAssertEqual(targetElement.1, 1)
     }
 }
@@ -97,9 +97,7 @@ final class QuestionnaireElementConnectorRedirectTests: XCTestCase {
         XCTAssertNotNil(targetElement.0)
         XCTAssertNotNil(targetElement.1)
 
-        XCTAssertEqual(targetElement.0?.count, 2)
-        XCTAssertNotNil(targetElement.0?[0] as? QuestionnaireElementText)
-        XCTAssertNotNil(targetElement.0?[1] as? QuestionnaireElementRadio)
+        XCTAssertEqual(targetElement.0?.elementTypes, [.text, .radio])
         XCTAssertEqual(targetElement.1, 1)
     }
 
@@ -130,9 +128,7 @@ final class QuestionnaireElementConnectorRedirectTests: XCTestCase {
         XCTAssertNotNil(targetElement.0)
         XCTAssertNotNil(targetElement.1)
 
-        XCTAssertEqual(targetElement.0?.count, 2)
-        XCTAssertNotNil(targetElement.0?[0] as? QuestionnaireElementText)
-        XCTAssertNotNil(targetElement.0?[1] as? QuestionnaireElementRadio)
+        XCTAssertEqual(targetElement.0?.elementTypes, [.text, .radio])
         XCTAssertEqual(targetElement.1, 1)
     }
 }
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+import AnyCodable
+@testable import NinchatSDKSwift
+
+/// Checks the compiled evaluator against the uncompiled lookups on the questionnaire fixture
+final class QuestionnaireLogicEvaluatorTests: XCTestCase {
+    private var configurations: [QuestionnaireConfiguration] = []
+    private lazy var connector: QuestionnaireElementConnectorImpl = {
+        QuestionnaireElementConnectorImpl(configurations: self.configurations, style: .conversation)
+    }()
+
+    override func setUp() {
+        super.setUp()
+
+        do {
+            self.configurations = AudienceQuestionnaire(from: try openAsset(forResource: "questionnaire-mock"), for: "preAudienceQuestionnaire").questionnaireConfiguration ?? []
+        } catch {
+            XCTFail(error.localizedDescription)
+        }
+    }
+
+    func test_logic_parity() {
+        let blocks = self.flatten(self.configurations).compactMap { $0.logic }
+        XCTAssertFalse(blocks.isEmpty)
+
+        let evaluator = QuestionnaireLogicEvaluator(configurations: self.configurations, pages: self.connector.pages)
+        var accumulated: [String:AnyHashable] = [:]
+        self.answerSets(for: blocks).forEach { answers in
+            accumulated.merge(answers) { _, new in new }
+            [answers, accumulated].forEach { answers in
+                blocks.forEach { block in
+                    XCTAssertEqual(evaluator.isSatisfied(block, answers: answers), block.satisfy(dictionary: answers), "\(block.target): \(answers)")
+                }
+            }
+        }
+    }
+
+    func test_redirect_parity() {
+        let evaluator = QuestionnaireLogicEvaluator(configurations: self.configurations, pages: self.connector.pages)
+        let configurations = self.flatten(self.configurations).filter { $0.redirects != nil }
+        XCTAssertFalse(configurations.isEmpty)
+
+        configurations.forEach { configuration in
+            var inputs: [AnyHashable] = ["", "40", "Sovitut", true, false]
+            inputs.append(contentsOf: configuration.redirects?.compactMap { $0.pattern } ?? [])
+            inputs.append(contentsOf: self.flatten([configuration]).compactMap { $0.options }.joined().compactMap { $0.value })
+
+            inputs.forEach { input in
+                XCTAssertEqual(evaluator.redirect(for: input, in: configuration)?.target, self.referenceRedirect(for: input, in: configuration)?.target, "\(configuration.name): \(input)")
+            }
+        }
+    }
+
+    func test_page_index_parity() {
+        let evaluator = QuestionnaireLogicEvaluator(configurations: self.configurations, pages: self.connector.pages)
+        self.configurations.forEach { configuration in
+            XCTAssertEqual(evaluator.page(named: configuration.name), self.connector.findTargetElement(for: configuration).1, configuration.name)
+        }
+        XCTAssertNil(evaluator.page(named: "_register"))
+    }
+
+    func test_dependent_answers() {
+        guard let block = self.flatten(self.configurations).first(where: { $0.name == "Riskiryhmät-Logic2" })?.logic else {
+            XCTFail("Expected the fixture to have the logic block"); return
+        }
+        let evaluator = QuestionnaireLogicEvaluator(configurations: self.configurations, pages: self.connector.pages)
+
+        var answers: [String:AnyHashable] = ["Riskiryhmät-jatko": "Muut aiheet", "condition1": "satisfied"]
+        XCTAssertTrue(evaluator.isSatisfied(block, answers: answers))
+
+        /// An answer the block does not read keeps the result
+        answers["comments"] = "This is unit test"
+        XCTAssertTrue(evaluator.isSatisfied(block, answers: answers))
+
+        answers.removeValue(forKey: "Riskiryhmät-jatko")
+        XCTAssertEqual(evaluator.isSatisfied(block, answers: answers), block.satisfy(dictionary: answers))
+    }
+
+    func test_appended_configurations() {
+        var connector = QuestionnaireElementConnectorImpl(configurations: Array(self.configurations.prefix(1)), style: .conversation)
+        let appended = Array(self.configurations.dropFirst())
+        connector.appendPages(appended.compactMap { QuestionnaireParser.page(of: $0) }, configurations: appended)
+
+        self.configurations.forEach { configuration in
+            XCTAssertEqual(connector.evaluator.page(named: configuration.name), self.connector.findTargetElement(for: configuration).1, configuration.name)
+        }
+    }
+}
+
+extension QuestionnaireLogicEvaluatorTests {
+    private func flatten(_ configurations: [QuestionnaireConfiguration]) -> [QuestionnaireConfiguration] {
+        configurations.flatMap { [$0] + self.flatten($0.elements ?? []) }
+    }
+
+    /// Answers satisfying each clause, and the same answers with one of them changed
+    private func answerSets(for blocks: [LogicQuestionnaire]) -> [[String:AnyHashable]] {
+        let clauses = blocks.flatMap { ($0.and ?? []) + ($0.or ?? []) }
+        return [[:]] + clauses.flatMap { clause -> [[String:AnyHashable]] in
+            let answers = clause.compactMapValues { $0.value as? AnyHashable }
+            guard let key = answers.keys.sorted().first else { return [answers] }
+
+            var changed = answers
+            changed[key] = "not-an-answer"
+            return [answers, changed]
+        }
+    }
+
+    /// The redirect lookup as it was before the patterns were compiled
+    private func referenceRedirect(for input: AnyHashable, in configuration: QuestionnaireConfiguration) -> ElementRedirect? {
+        if let strInput = input as? String,
+           let redirect = configuration
+                .redirects?
+                .filter({ ($0.pattern as? String) != nil })
+                .first(where: { strInput.extractRegex(withPattern: $0.pattern as! String)?.count ?? 0 > 0 }) {
+            return redirect
+        } else if let redirect = configuration.redirects?.first(where: { $0.pattern ?? AnyHashable("") == input }) {
+            return redirect
+        }
+        return configuration.redirects?.first(where: { $0.pattern == nil })
+    }
+}
@@ -0,0 +1,123 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class QueueRegistryTests: XCTestCase {
+    private var registry: QueueRegistry!
+
+    override func setUp() {
+        registry = QueueRegistry()
+    }
+
+    func test_insert_lookup() {
+        XCTAssertTrue(registry.insert(queue("1")))
+        XCTAssertTrue(registry.insert(queue("2")))
+        XCTAssertFalse(registry.insert(queue("1", closed: true)))
+
+        XCTAssertEqual(registry.all.map { $0.queueID }, ["1", "2"])
+        XCTAssertEqual(registry["1"]?.isClosed, false)
+        XCTAssertNil(registry["3"])
+    }
+
+    func test_audience() {
+        ["1", "2", "3"].forEach { registry.insert(queue($0)) }
+        XCTAssertEqual(registry.audience.map { $0.queueID }, ["1", "2", "3"])
+
+        /// Configured IDs define the order, unknown IDs are skipped
+        registry.audienceIDs = ["3", "4", "1"]
+        XCTAssertEqual(registry.audience.map { $0.queueID }, ["3", "1"])
+        XCTAssertNotNil(registry.audienceQueue("1"))
+        XCTAssertNil(registry.audienceQueue("2"))
+    }
+
+    func test_deltas() {
+        registry.insert(queue("1"))
+        registry.insert(queue("2"))
+
+        var updates: [Queue] = []
+        registry.bind(receiver: "test", queueID: "1") { event, queue, _ in
+            XCTAssertEqual(event, .queueUpdated)
+            updates.append(queue)
+        }
+
+        registry.update(queueID: "1", position: 3)
+        XCTAssertEqual(registry["1"]?.position, 3)
+
+        /// Nothing changed
+        registry.update(queueID: "1", position: 3, isClosed: false)
+        /// Not observed
+        registry.update(queueID: "2", isClosed: true)
+        XCTAssertEqual(registry["2"]?.isClosed, true)
+
+        registry.update(queueID: "1", isClosed: true)
+        XCTAssertEqual(updates.map { $0.position }, [3, 3])
+        XCTAssertEqual(updates.map { $0.isClosed }, [false, true])
+
+        XCTAssertNil(registry.update(queueID: "3", position: 1))
+    }
+
+    func test_notifications() {
+        var received: [String] = []
+        registry.bind(receiver: "one") { _, queue, _ in received.append("one:\(queue.queueID)") }
+        registry.bind(receiver: "two") { _, queue, _ in received.append("two:\(queue.queueID)") }
+        registry.bind(receiver: "two") { _, _, _ in XCTFail("Expected a receiver to be bound once") }
+
+        registry.notify(.audienceEnqueued, queue: queue("1"), error: nil)
+        XCTAssertEqual(received.sorted(), ["one:1", "two:1"])
+
+        received.removeAll()
+        registry.unbind(receiver: "two")
+        registry.notify(.audienceEnqueued, queue: queue("2"), error: nil)
+        XCTAssertEqual(received, ["one:2"])
+    }
+
+    func test_scoped_notifications() {
+        var received: [String] = []
+        registry.bind(receiver: "one", queueID: "1") { _, queue, _ in received.append("one:\(queue.queueID)") }
+        registry.bind(receiver: "any") { _, queue, _ in received.append("any:\(queue.queueID)") }
+
+        registry.notify(.audienceEnqueued, queue: queue("1"), error: nil)
+        registry.notify(.audienceEnqueued, queue: queue("2"), error: nil)
+        XCTAssertEqual(received, ["one:1", "any:1", "any:2"])
+
+        /// Unbinding drops the receiver from every scope
+        received.removeAll()
+        registry.unbind(receiver: "one")
+        registry.notify(.audienceEnqueued, queue: queue("1"), error: nil)
+        XCTAssertEqual(received, ["any:1"])
+    }
+
+    func test_batched_describe() {
+        var requests: [[String]] = []
+        let batcher = QueueDescribeBatcher(window: 0.1) { ids, completion in
+            requests.append(ids)
+            completion(nil)
+        }
+
+        let expect = self.expectation(description: "Expected every caller to be completed by one request")
+        expect.expectedFulfillmentCount = 3
+        ["1", "2", "1"].forEach { id in
+            batcher.request(queueID: id) { error in
+                XCTAssertNil(error)
+                expect.fulfill()
+            }
+        }
+        waitForExpectations(timeout: 2.0)
+        XCTAssertEqual(requests, [["1", "2"]])
+    }
+}
+
+extension QueueRegistryTests {
+    private func queue(_ id: String, closed: Bool = false) -> Queue {
+        Queue(queueID: id, name: "Queue \(id)", isClosed: closed, permissions: QueuePermissions(upload: false), position: 0)
+    }
+}
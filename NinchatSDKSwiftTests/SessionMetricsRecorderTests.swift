@@ -0,0 +1,87 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class SessionMetricsRecorderTests: XCTestCase {
+    private var now: TimeInterval = 0
+    private var updates: [NINSessionMetrics] = []
+    private var recorder: SessionMetricsRecorder!
+
+    override func setUp() {
+        now = 0
+        updates = []
+        recorder = SessionMetricsRecorder(now: { self.now })
+        recorder.isEnabled = true
+        recorder.onUpdate = { self.updates.append($0) }
+    }
+
+    func test_disabled_recorder_records_nothing() {
+        recorder.isEnabled = false
+        recorder.start(.sessionOpen)
+        now = 1
+        recorder.end(.sessionOpen)
+        recorder.eventReceived()
+        recorder.sent(bytes: 10)
+
+        XCTAssertNil(recorder.snapshot.sessionOpenDuration)
+        XCTAssertEqual(recorder.snapshot.eventBacklog, 0)
+        XCTAssertEqual(recorder.snapshot.bytesSent, 0)
+        XCTAssertTrue(updates.isEmpty)
+    }
+
+    func test_interval_is_recorded_once() {
+        recorder.start(.firstMessage)
+        now = 1.5
+        recorder.end(.firstMessage)
+        now = 3
+        recorder.end(.firstMessage)
+
+        XCTAssertEqual(recorder.snapshot.timeToFirstMessage, 1.5)
+        XCTAssertEqual(updates.count, 1)
+        XCTAssertEqual(updates.first?.timeToFirstMessage, 1.5)
+    }
+
+    func test_restarted_interval_replaces_the_former() {
+        recorder.start(.historyLoad)
+        now = 1
+        recorder.end(.historyLoad)
+
+        recorder.start(.historyLoad)
+        now = 1.25
+        recorder.end(.historyLoad)
+        XCTAssertEqual(recorder.snapshot.historyLoadDuration, 0.25)
+    }
+
+    func test_end_without_start_is_ignored() {
+        recorder.end(.firstQueuePosition)
+        XCTAssertNil(recorder.snapshot.timeToFirstQueuePosition)
+        XCTAssertTrue(updates.isEmpty)
+    }
+
+    func test_backlog_and_bytes() {
+        recorder.eventReceived()
+        recorder.eventReceived()
+        recorder.eventHandled()
+        recorder.eventReceived()
+        recorder.eventHandled()
+        recorder.eventHandled()
+        recorder.eventHandled()
+        XCTAssertEqual(recorder.snapshot.eventBacklog, 0)
+        XCTAssertEqual(recorder.snapshot.maxEventBacklog, 2)
+
+        recorder.sent(bytes: 100)
+        recorder.received(bytes: 40)
+        recorder.received(bytes: 2)
+        XCTAssertEqual(recorder.snapshot.bytesSent, 100)
+        XCTAssertEqual(recorder.snapshot.bytesReceived, 42)
+    }
+}
@@ -0,0 +1,48 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class SiteConfigurationCacheTests: XCTestCase {
+    private let suiteName = "com.ninchat.sdk.swift.tests.site-configuration"
+    private var cache: SiteConfigurationCache!
+
+    override func setUp() {
+        UserDefaults().removePersistentDomain(forName: suiteName)
+        cache = SiteConfigurationCache(storage: UserDefaults(suiteName: suiteName)!)
+    }
+
+    override func tearDown() {
+        UserDefaults().removePersistentDomain(forName: suiteName)
+    }
+
+    func test_missing_configuration() {
+        XCTAssertNil(cache.configuration(for: "key", serverAddress: "api.ninchat.com"))
+    }
+
+    func test_configuration_is_kept_per_server_and_key() {
+        cache.save(["default": ["audienceRealmId": "realm-1"]], for: "key", serverAddress: "api.ninchat.com")
+        cache.save(["default": ["audienceRealmId": "realm-2"]], for: "key", serverAddress: "test.ninchat.com")
+
+        let configuration = SiteConfigurationImpl(configuration: cache.configuration(for: "key", serverAddress: "api.ninchat.com"), environments: nil)
+        XCTAssertEqual(configuration.audienceRealm, "realm-1")
+        XCTAssertNil(cache.configuration(for: "other", serverAddress: "api.ninchat.com"))
+    }
+
+    func test_latest_configuration_replaces_the_former() {
+        cache.save(["default": ["audienceRealmId": "realm-1"]], for: "key", serverAddress: "api.ninchat.com")
+        cache.save(["default": ["audienceRealmId": "realm-2", "audienceQueues": ["queue-1"]] as [String:Any]], for: "key", serverAddress: "api.ninchat.com")
+
+        let configuration = SiteConfigurationImpl(configuration: cache.configuration(for: "key", serverAddress: "api.ninchat.com"), environments: nil)
+        XCTAssertEqual(configuration.audienceRealm, "realm-2")
+        XCTAssertEqual(configuration.queueIDs, ["queue-1"])
+    }
+}
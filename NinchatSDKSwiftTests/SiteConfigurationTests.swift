@@ -45,5 +45,19 @@ final class SiteConfigurationTests: XCTestCase {
         XCTAssertEqual(siteConfiguration?.audienceRealm, "5lmphjc200m3g", "They key should be read from 'fi-restart' since 'fi' doesn't contain that.")
         XCTAssertEqual(siteConfiguration?.welcome, "fi", "The key is present in all env, but it should be read from 'fi' according to the reversed sort of the given array")
     }
+
+    func test_30_queueIDs() {
+        XCTAssertEqual(siteConfiguration?.queueIDs, ["5lmpjrbl00m3g", "706rc4gq00ib8"], "Queues should be read from the same environments as the other keys")
+    }
+
+    func test_31_questionnaire_queueIDs() {
+        let configuration = SiteConfigurationImpl(configuration: ["default": [
+            "audienceQueues": ["queue-1", ""],
+            "audienceAutoQueue": "queue-1",
+            "preAudienceQuestionnaire": [["name": "pre", "logic": ["queueId": "queue-2"]]] as [[String:AnyHashable]],
+            "postAudienceQuestionnaire": [["name": "post", "logic": ["queueId": "queue-3"]]] as [[String:AnyHashable]]
+        ] as [String:Any]], environments: nil)
+        XCTAssertEqual(configuration.queueIDs, ["queue-1", "queue-2", "queue-3"])
+    }
 }
 
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import XCTest
+#if canImport(NinchatCore)
+@testable import NinchatCore
+#else
+@testable import NinchatSDKSwift
+#endif
+
+final class TypingPresenceTests: XCTestCase {
+    private var now = Date(timeIntervalSince1970: 0)
+    private var presence: TypingPresence!
+    private let agent = ChannelUser(userID: "11", realName: "Hassan Shahbazi", displayName: "Hassan", iconURL: "", guest: false, info: nil)
+    private let guest = ChannelUser(userID: "12", realName: "Guest", displayName: "Guest", iconURL: "", guest: true, info: nil)
+
+    override func setUp() {
+        now = Date(timeIntervalSince1970: 0)
+        presence = TypingPresence(timeout: 30.0, now: { self.now })
+    }
+
+    func test_update() {
+        var changes = 0
+        presence.onChange = { _ in changes += 1 }
+
+        presence.update(user: agent, isWriting: true)
+        XCTAssertTrue(presence.isTyping(userID: "11"))
+        XCTAssertEqual(changes, 1)
+
+        /// Refreshing keeps the start time and does not notify
+        now.addTimeInterval(10)
+        presence.update(user: agent, isWriting: true)
+        XCTAssertEqual(presence.typing.first?.since, Date(timeIntervalSince1970: 0))
+        XCTAssertEqual(changes, 1)
+
+        presence.update(user: guest, isWriting: true)
+        XCTAssertEqual(presence.typing.map { $0.user.userID }, ["11", "12"])
+        XCTAssertEqual(changes, 2)
+
+        /// Only the given user is removed
+        presence.update(user: agent, isWriting: false)
+        XCTAssertEqual(presence.typing.map { $0.user.userID }, ["12"])
+        XCTAssertEqual(changes, 3)
+
+        /// Not typing users are ignored
+        presence.update(user: agent, isWriting: false)
+        XCTAssertEqual(changes, 3)
+    }
+
+    func test_expire() {
+        presence.update(user: agent, isWriting: true)
+        now.addTimeInterval(20)
+        presence.update(user: guest, isWriting: true)
+
+        now.addTimeInterval(15)
+        presence.expire()
+        XCTAssertEqual(presence.typing.map { $0.user.userID }, ["12"])
+
+        now.addTimeInterval(15)
+        presence.expire()
+        XCTAssertTrue(presence.typing.isEmpty)
+    }
+
+    func test_removeAll() {
+        let expect = self.expectation(description: "Expected to get an empty list")
+        presence.update(user: agent, isWriting: true)
+        presence.onChange = { typing in
+            XCTAssertTrue(typing.isEmpty)
+            expect.fulfill()
+        }
+        presence.removeAll()
+        XCTAssertFalse(presence.isTyping(userID: "11"))
+        waitForExpectations(timeout: 1.0)
+    }
+
+    func test_expiry_timer() {
+        let presence = TypingPresence(timeout: 0.2)
+        let expect = self.expectation(description: "Expected the flag to expire without refreshes")
+        presence.update(user: agent, isWriting: true)
+        presence.onChange = { typing in
+            XCTAssertTrue(typing.isEmpty)
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+    }
+
+    func test_early_expiry_timer_is_armed_again() {
+        let presence = TypingPresence(timeout: 0.2, now: { self.now })
+        let expect = self.expectation(description: "Expected the flag to expire after an early tick")
+        presence.update(user: agent, isWriting: true)
+
+        /// A tick ahead of the expiry drops nothing
+        presence.expire()
+        XCTAssertTrue(presence.isTyping(userID: "11"))
+
+        presence.onChange = { typing in
+            XCTAssertTrue(typing.isEmpty)
+            expect.fulfill()
+        }
+        now.addTimeInterval(1)
+        waitForExpectations(timeout: 2.0)
+    }
+}
+
+final class WritingStateDebouncerTests: XCTestCase {
+    func test_coalesce() {
+        var sent: [Bool] = []
+        let debouncer = WritingStateDebouncer(interval: 0.3, idleTimeout: 10.0) { sent.append($0) }
+
+        /// The first change is sent right away, the quick toggles are coalesced to the last state
+        debouncer.update(isWriting: true)
+        debouncer.update(isWriting: false)
+        debouncer.update(isWriting: true)
+        debouncer.update(isWriting: false)
+        XCTAssertEqual(sent, [true])
+
+        let expect = self.expectation(description: "Expected the latest state after the interval")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.6) {
+            XCTAssertEqual(sent, [true, false])
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+    }
+
+    func test_only_changes() {
+        var sent: [Bool] = []
+        let debouncer = WritingStateDebouncer(interval: 0.1, idleTimeout: 10.0) { sent.append($0) }
+
+        debouncer.update(isWriting: false)
+        XCTAssertTrue(sent.isEmpty)
+
+        debouncer.update(isWriting: true)
+        let expect = self.expectation(description: "Expected repeated states to be skipped")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.3) {
+            debouncer.update(isWriting: true)
+            XCTAssertEqual(sent, [true])
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+    }
+
+    func test_idle() {
+        var sent: [Bool] = []
+        let debouncer = WritingStateDebouncer(interval: 0.1, idleTimeout: 0.3) { sent.append($0) }
+        debouncer.update(isWriting: true)
+
+        let expect = self.expectation(description: "Expected to stop writing when idle")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.6) {
+            XCTAssertEqual(sent, [true, false])
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+    }
+}
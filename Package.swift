@@ -0,0 +1,129 @@
+// swift-tools-version:5.3
+//
+// Copyright (c) 19.10.2026 Somia Reality Oy. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+//
+
+import PackageDescription
+
+/// `NinchatCore` is the SDK's session logic built without UIKit, WebRTC and the Go client, so it and
+/// its unit tests run headlessly with `swift test`. The SDK itself is still built with CocoaPods.
+let package = Package(
+    name: "NinchatCore",
+    platforms: [
+        .iOS(.v14), .macOS(.v10_15)
+    ],
+    products: [
+        .library(name: "NinchatCore", targets: ["NinchatCore"])
+    ],
+    dependencies: [
+        .package(name: "AnyCodable", url: "https://github.com/Flight-School/AnyCodable", from: "0.2.3")
+    ],
+    targets: [
+        .target(
+            name: "NinchatCore",
+            dependencies: ["AnyCodable"],
+            path: "NinchatSDKSwift",
+            sources: [
+                "Implementations/Extensions/Array+Extension.swift",
+                "Implementations/Extensions/Bundle+Extension.swift",
+                "Implementations/Extensions/ClientProps+Extension.swift",
+                "Implementations/Extensions/Data+Extension.swift",
+                "Implementations/Extensions/Date+Extension.swift",
+                "Implementations/Extensions/Encodable+Extension.swift",
+                "Implementations/Extensions/NSUserDefaults+Extension.swift",
+                "Implementations/Extensions/ProcessInfo+Extension.swift",
+                "Implementations/Extensions/Thread+Extension.swift",
+                "Implementations/Extensions/URL+Extension.swift",
+                "Implementations/Managers/Channels/ChannelRegistry.swift",
+                "Implementations/Managers/Channels/ComposeActionStore.swift",
+                "Implementations/Managers/Jitsi/JitsiDiscoveryCache.swift",
+                "Implementations/Managers/Jitsi/JitsiJoinLatency.swift",
+                "Implementations/Managers/Metadata/AudienceMetadataStore.swift",
+                "Implementations/Managers/Metrics/SessionMetricsRecorder.swift",
+                "Implementations/Managers/NINChatSession Internal/NINChatSessionInternalDelegate.swift",
+                "Implementations/Managers/Presence/TypingPresence.swift",
+                "Implementations/Managers/Queues/QueueRegistry.swift",
+                "Implementations/Managers/RTC Client/AdaptiveCaptureController.swift",
+                "Implementations/Managers/RTC Client/CallSetupTimings.swift",
+                "Implementations/Managers/RTC Client/ICEServerCache.swift",
+                "Implementations/Managers/Search/MessageSearchIndex.swift",
+                "Implementations/Managers/Session Manager/LowLevelClientSession.swift",
+                "Implementations/Managers/Session Manager/NINChatSeesionManagerPrivate.swift",
+                "Implementations/Managers/Session Manager/NINChatSessionManager.swift",
+                "Implementations/Managers/Session Manager/NINChatSessionManagerClosures.swift",
+                "Implementations/Managers/Session Manager/NINChatSessionManagerEventHandlers.swift",
+                "Implementations/Managers/Session Manager/NINChatSessionManagerImpl.swift",
+                "Implementations/Managers/Tracing/EventRecorder.swift",
+                "Implementations/Managers/Tracing/EventRecording.swift",
+                "Implementations/Managers/Tracing/EventReplayer.swift",
+                "Implementations/Managers/Tracing/EventTracer.swift",
+                "Implementations/Managers/Tracing/LatencyHistogram.swift",
+                "Implementations/Models/AvatarConfig.swift",
+                "Implementations/Models/CallStatistics.swift",
+                "Implementations/Models/ChannelMessagePayload.swift",
+                "Implementations/Models/ChannelUser.swift",
+                "Implementations/Models/Chat Messages/ChannelMessage.swift",
+                "Implementations/Models/Chat Messages/ChatMessage.swift",
+                "Implementations/Models/Chat Messages/ChatMessageStore.swift",
+                "Implementations/Models/Chat Messages/ComposeMessage.swift",
+                "Implementations/Models/Chat Messages/MetaMessage.swift",
+                "Implementations/Models/Chat Messages/TextMessage.swift",
+                "Implementations/Models/ChatMessagePayload.swift",
+                "Implementations/Models/ClientProps.swift",
+                "Implementations/Models/ComposeUIAction.swift",
+                "Implementations/Models/EventLatency.swift",
+                "Implementations/Models/FileInfo.swift",
+                "Implementations/Models/NINChatError.swift",
+                "Implementations/Models/QuestionnaireConfiguration.swift",
+                "Implementations/Models/Queue.swift",
+                "Implementations/Models/RTCSignal.swift",
+                "Implementations/Models/SessionMetrics.swift",
+                "Implementations/Models/SiteConfiguration.swift",
+                "Implementations/Models/WebRTCServerInfo.swift",
+                "Implementations/NINChatExceptions.swift",
+                "Implementations/Network/Empty.swift",
+                "Implementations/Network/Requests/CloseSession.swift",
+                "Implementations/Network/Requests/SiteConfigRequest.swift",
+                "Implementations/Network/ServiceManager.swift",
+                "Implementations/Network/ServiceRequest.swift",
+                "Implementations/SDKConstants.swift",
+                "Implementations/Utilities/NINLogger.swift",
+                "Implementations/Utilities/SiteConfigurationCache.swift",
+                "NINChatDevHelper.swift",
+                "NINSessionCredentials.swift",
+                "NINSiteConfiguration.swift"
+            ],
+            swiftSettings: [
+                .define("NINCHAT_CORE")
+            ]
+        ),
+        .testTarget(
+            name: "NinchatCoreTests",
+            dependencies: ["NinchatCore"],
+            path: "NinchatSDKSwiftTests",
+            sources: [
+                "AudienceMetadataStoreTests.swift",
+                "ChannelRegistryTests.swift",
+                "ChatMessageStoreTests.swift",
+                "ClientPropsTests.swift",
+                "ComposeActionStoreTests.swift",
+                "EventRecordingTests.swift",
+                "EventTracerTests.swift",
+                "ICEServerCacheTests.swift",
+                "JitsiDiscoveryCacheTests.swift",
+                "LocalNinchatServer.swift",
+                "LocalNinchatServerTests.swift",
+                "LowLevelClientSessionTests.swift",
+                "MemoryBudgetTests.swift",
+                "MessageSearchIndexTests.swift",
+                "NINLoggerTests.swift",
+                "QueueRegistryTests.swift",
+                "SessionMetricsRecorderTests.swift",
+                "SiteConfigurationCacheTests.swift",
+                "TypingPresenceTests.swift"
+            ]
+        )
+    ]
+)